@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 import argparse
+import shlex
 import subprocess
 import math
 from typing import Dict, Tuple
@@ -14,10 +15,36 @@ DCO_FREQ_HZ = 500_000_000  # 500 MHz nominal DCO frequency (default for 8A3400x)
 
 # ---------- Utility for running shell commands ----------
 
+# While not None, dplltool commands are collected here instead of run, and
+# flush_dplltool_batch() sends them to one `dplltool --batch` (one process,
+# one SPI session, validated up front, rolled back on failure).
+_dplltool_batch = None
+
+
 def run(cmd, dry_run: bool = False):
     print("RUN:", " ".join(cmd))
-    if not dry_run:
-        subprocess.run(cmd, check=True)
+    if dry_run:
+        return
+    if _dplltool_batch is not None and cmd[0] == "dplltool":
+        _dplltool_batch.append(cmd[1:])
+        return
+    subprocess.run(cmd, check=True)
+
+
+def begin_dplltool_batch():
+    global _dplltool_batch
+    _dplltool_batch = []
+
+
+def flush_dplltool_batch(dry_run: bool = False):
+    global _dplltool_batch
+    lines, _dplltool_batch = _dplltool_batch, None
+    if dry_run or not lines:
+        return
+    script = "".join(shlex.join(args) + "\n" for args in lines)
+    print(f"RUN: dplltool --batch - --transaction  ({len(lines)} commands)")
+    subprocess.run(["dplltool", "--batch", "-", "--transaction"],
+                   input=script, text=True, check=True)
 
 
 # Helper: User (Rear) vs HW (Front) mapping for logging
@@ -726,19 +753,25 @@ def configure_dpll_outputs(cfg: TimingConfig, dry_run: bool = False):
 
 # ---------- High-level apply function ----------
 
-def apply_timing(config_path: str, dry_run: bool = False):
+def apply_timing(config_path: str, dry_run: bool = False, batch: bool = True):
     print(f"Loading timing config from: {config_path}")
     cfg = load_config(config_path)
 
     print("\n[1/3] Configuring board multiplexers (gpioset)...")
     configure_muxes(cfg, dry_run=dry_run)
 
+    if batch:
+        begin_dplltool_batch()
+
     print("\n[2/3] Configuring DPLL inputs and channel priorities...")
     configure_dpll_inputs(cfg, dry_run=dry_run)
 
     print("\n[3/3] Configuring DPLL outputs...")
     configure_dpll_outputs(cfg, dry_run=dry_run)
 
+    if batch:
+        flush_dplltool_batch(dry_run=dry_run)
+
     print("\nDone applying timing configuration.")
 
 
@@ -758,9 +791,14 @@ def main():
         action="store_true",
         help="Print commands without executing them.",
     )
+    parser.add_argument(
+        "--no-batch",
+        action="store_true",
+        help="Run each dplltool command as its own process instead of one batch.",
+    )
     args = parser.parse_args()
 
-    apply_timing(args.config, dry_run=args.dry_run)
+    apply_timing(args.config, dry_run=args.dry_run, batch=not args.no_batch)
 
 
 if __name__ == "__main__":
@@ -1,6 +1,8 @@
 #!/usr/bin/env python3
 import json
 import argparse
+import shutil
+import subprocess
 from dataclasses import dataclass, asdict
 from enum import Enum
 from typing import List, Optional, Dict
@@ -331,6 +333,88 @@ def derive_plan(cfg: TimingConfig) -> DerivedPlan:
     )
 
 
+# ---------- Frequency plan checks (dplltool plan-batch) ----------
+
+def plan_batch(requests: List[str], dplltool: str = "dplltool") -> Optional[List[dict]]:
+    """
+    Plan many candidate frequencies with one offline dplltool call.
+
+    Each request is a plan-batch line, e.g. "input 25000000" or
+    "output 156250000 1". Returns one dict per request, in order:
+      {"ok": True, "exact": bool, "div": [int], "actual": [str], "ppb": [float]}
+      {"ok": False, "rc": int}
+    or None if dplltool is not installed (e.g. running on a workstation).
+    """
+    if not requests:
+        return []
+    if shutil.which(dplltool) is None:
+        return None
+    proc = subprocess.run(
+        [dplltool, "plan-batch", "-", "--json"],
+        input="\n".join(requests) + "\n",
+        capture_output=True, text=True, check=False,
+    )
+    if proc.returncode != 0:
+        return None
+
+    results = []
+    for line in proc.stdout.splitlines():
+        r = json.loads(line)
+        if not r["ok"]:
+            results.append({"ok": False, "rc": r.get("rc", -1)})
+            continue
+        results.append({
+            "ok": True,
+            "exact": r["exact"],
+            "div": r["div"],
+            "actual": r["actual"],
+            "ppb": r["err_ppb"],
+        })
+    return results if len(results) == len(requests) else None
+
+
+def check_frequency_plans(cfg: TimingConfig, plan: DerivedPlan) -> None:
+    """
+    Plan the Q10/Q11 pair and every SMA input frequency in one batch and
+    add a warning for inexact plans / an error for impossible ones.
+    """
+    ptp_role = PtpRole(cfg.ptp_role)
+    by_name = {s.name: s for s in cfg.smas}
+
+    # Same defaults as apply_timing.configure_dpll_outputs()
+    sma2 = by_name.get("SMA2")
+    q10_hz = sma2.frequency_hz if (sma2 and sma2.direction == "OUTPUT" and sma2.frequency_hz) else 1
+    sma1 = by_name.get("SMA1")
+    if ptp_role != PtpRole.GM and sma1 and sma1.direction == "OUTPUT" and sma1.frequency_hz:
+        q11_hz = sma1.frequency_hz
+    else:
+        q11_hz = 1
+
+    labels = [f"Q10/Q11 ({q10_hz} Hz / {q11_hz} Hz)"]
+    requests = [f"output {q10_hz} {q11_hz}"]
+    for sma in cfg.smas:
+        if sma.direction == SmaDirection.INPUT.value and sma.frequency_hz:
+            labels.append(f"{sma.name} input ({sma.frequency_hz} Hz)")
+            requests.append(f"input {sma.frequency_hz}")
+
+    results = plan_batch(requests)
+    print("\nFrequency plan check:")
+    if results is None:
+        print("  (dplltool not available, skipped)")
+        return
+
+    for label, res in zip(labels, results):
+        if not res["ok"]:
+            print(f"  {label}: no plan (rc={res['rc']})")
+            plan.errors.append(f"{label}: the DPLL cannot synthesize this frequency.")
+        elif res["exact"]:
+            print(f"  {label}: exact")
+        else:
+            worst = max(abs(e) for e in res["ppb"])
+            print(f"  {label}: not exact, worst error {worst:.3g} ppb")
+            plan.warnings.append(f"{label}: closest plan is off by {worst:.3g} ppb.")
+
+
 # ---------- SMA Mapping Helpers ----------
 
 def hw_to_user_sma(hw_name: str) -> str:
@@ -464,6 +548,8 @@ def validate_config(cfg: TimingConfig) -> DerivedPlan:
         else:
             print(f"  {label}: UNUSED")
 
+    check_frequency_plans(cfg, plan)
+
     if plan.warnings:
         print("\nWarnings:")
         for w in plan.warnings:
@@ -0,0 +1,377 @@
+// clockmatrix.c
+// libclockmatrix stable C ABI (see clockmatrix.h), on top of the internal
+// modules: linux_dpll (spidev), the register tables, cm_shadow, cm_freqplan,
+// tcs_dpll, cm_status and cm_snapshot. Nothing here may expose their types.
+
+#include "clockmatrix.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cm_dpll_utils.h"
+#include "cm_freqplan.h"
+#include "cm_shadow.h"
+#include "cm_snapshot.h"
+#include "cm_status.h"
+#include "linux_dpll.h"
+#include "renesas_cm8a34001_tables.h"
+#include "tcs_dpll.h"
+
+_Static_assert(CM_LIB_MAX_OUTPUTS == CM_FP_MAX_OUTPUTS, "plan output count");
+_Static_assert(CM_LIB_NUM_DPLLS == CM_STATUS_NUM_DPLLS, "status DPLL count");
+_Static_assert(CM_LIB_NUM_INPUTS == CM_STATUS_NUM_INPUTS, "status input count");
+_Static_assert(CM_LIB_STATUS_PHASE == CM_STATUS_PHASE &&
+               CM_LIB_STATUS_INPUTS == CM_STATUS_INPUTS, "status flags");
+
+struct cm_dev {
+    pthread_mutex_t mu;       // held for every cm_dev_* call
+    int             fd;
+    int             fd_storage;
+    cm_bus_t        spi_bus;  // straight to spidev
+    cm_shadow_t     shadow;
+    int             shadow_on;
+    cm_bus_t        bus;      // what table accesses use (shadow or spi_bus)
+};
+
+unsigned cm_lib_version(void)
+{
+    return ((unsigned)CM_LIB_VERSION_MAJOR << 16) | ((unsigned)CM_LIB_VERSION_MINOR << 8) |
+           (unsigned)CM_LIB_VERSION_PATCH;
+}
+
+const char *cm_lib_strerror(int rc)
+{
+    switch (rc) {
+    case CM_LIB_OK:      return "ok";
+    case CM_LIB_EINVAL:  return "invalid argument";
+    case CM_LIB_ENOENT:  return "no such module, instance, register or field";
+    case CM_LIB_EIO:     return "I/O error";
+    case CM_LIB_ENOPLAN: return "no frequency plan";
+    case CM_LIB_ENOMEM:  return "out of memory";
+    default:             return "unknown error";
+    }
+}
+
+const char *cm_lib_state_str(uint8_t state)
+{
+    return dpll_state_str(state);
+}
+
+// ---------------------------------------------------------------------------
+// Device handle
+// ---------------------------------------------------------------------------
+
+cm_dev_t *cm_dev_open(const char *spidev_path, uint32_t hz, uint8_t mode, unsigned flags)
+{
+    if (!spidev_path || mode > 3) {
+        errno = EINVAL;
+        return NULL;
+    }
+    cm_dev_t *dev = (cm_dev_t *)calloc(1, sizeof(*dev));
+    if (!dev) return NULL;
+
+    dev->fd = dpll_spi_open_quiet(spidev_path, hz ? hz : 1000000u, mode);
+    if (dev->fd < 0) {
+        const int e = errno;
+        free(dev);
+        errno = e;
+        return NULL;
+    }
+    cm_bus_init_spi(&dev->spi_bus, &dev->fd_storage, dev->fd);
+    dev->bus = dev->spi_bus;
+
+    if (flags & CM_DEV_SHADOW_CACHE) {
+        if (cm_shadow_init(&dev->shadow, &dev->spi_bus) != 0) {
+            dpll_spi_close(dev->fd);
+            free(dev);
+            errno = ENOMEM;
+            return NULL;
+        }
+        cm_shadow_bus(&dev->shadow, &dev->bus);
+        dev->shadow_on = 1;
+    }
+    pthread_mutex_init(&dev->mu, NULL);
+    return dev;
+}
+
+void cm_dev_close(cm_dev_t *dev)
+{
+    if (!dev) return;
+    if (dev->shadow_on) cm_shadow_free(&dev->shadow);
+    dpll_spi_close(dev->fd);
+    pthread_mutex_destroy(&dev->mu);
+    free(dev);
+}
+
+// ---------------------------------------------------------------------------
+// Register access
+// ---------------------------------------------------------------------------
+
+static int cm_lib_io(int rc)
+{
+    return rc ? CM_LIB_EIO : CM_LIB_OK;
+}
+
+#define CM_LIB_PAGE 0x80u
+
+// cm_bus_t read/write stay inside one 128-byte page; split per page.
+static int cm_dev_rw(cm_dev_t *dev, uint16_t addr, uint8_t *rbuf, const uint8_t *wbuf,
+                     size_t len)
+{
+    int rc = 0;
+    pthread_mutex_lock(&dev->mu);
+    while (len > 0 && rc == 0) {
+        size_t chunk = CM_LIB_PAGE - (addr & (CM_LIB_PAGE - 1));
+        if (chunk > len) chunk = len;
+        if (rbuf) {
+            rc = dev->bus.read(dev->bus.user, addr, rbuf, chunk);
+            rbuf += chunk;
+        } else {
+            rc = dev->bus.write(dev->bus.user, addr, wbuf, chunk);
+            wbuf += chunk;
+        }
+        addr = (uint16_t)(addr + chunk);
+        len -= chunk;
+    }
+    pthread_mutex_unlock(&dev->mu);
+    return cm_lib_io(rc);
+}
+
+int cm_dev_read(cm_dev_t *dev, uint16_t addr, uint8_t *buf, size_t len)
+{
+    if (!dev || (!buf && len)) return CM_LIB_EINVAL;
+    if ((size_t)addr + len > 0x10000u) return CM_LIB_EINVAL;
+    return cm_dev_rw(dev, addr, buf, NULL, len);
+}
+
+int cm_dev_write(cm_dev_t *dev, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    if (!dev || (!buf && len)) return CM_LIB_EINVAL;
+    if ((size_t)addr + len > 0x10000u) return CM_LIB_EINVAL;
+    return cm_dev_rw(dev, addr, NULL, buf, len);
+}
+
+static int cm_lib_resolve(const char *module, unsigned inst, const char *reg,
+                          const cm_reg_desc_t **reg_out, uint16_t *addr_out)
+{
+    const cm_module_desc_t *mod = NULL;
+    const cm_reg_desc_t *r = NULL;
+    if (!module || !reg) return CM_LIB_EINVAL;
+    if (cm_find_module(module, &mod) != 0 || inst >= mod->count) return CM_LIB_ENOENT;
+    if (cm_find_reg(mod, reg, &r) != 0) return CM_LIB_ENOENT;
+    if (reg_out) *reg_out = r;
+    *addr_out = (uint16_t)(mod->bases[inst] + r->offset);
+    return CM_LIB_OK;
+}
+
+int cm_lib_reg_addr(const char *module, unsigned inst, const char *reg, uint16_t *addr_out)
+{
+    if (!addr_out) return CM_LIB_EINVAL;
+    return cm_lib_resolve(module, inst, reg, NULL, addr_out);
+}
+
+int cm_dev_reg_read(cm_dev_t *dev, const char *module, unsigned inst, const char *reg,
+                    uint8_t *buf, size_t len)
+{
+    uint16_t addr = 0;
+    int rc = cm_lib_resolve(module, inst, reg, NULL, &addr);
+    return rc ? rc : cm_dev_read(dev, addr, buf, len);
+}
+
+int cm_dev_reg_write(cm_dev_t *dev, const char *module, unsigned inst, const char *reg,
+                     const uint8_t *buf, size_t len)
+{
+    uint16_t addr = 0;
+    int rc = cm_lib_resolve(module, inst, reg, NULL, &addr);
+    return rc ? rc : cm_dev_write(dev, addr, buf, len);
+}
+
+static int cm_lib_resolve_field(const char *module, unsigned inst, const char *reg,
+                                const char *field, uint16_t *addr_out,
+                                const cm_field_desc_t **field_out)
+{
+    const cm_reg_desc_t *r = NULL;
+    if (!field) return CM_LIB_EINVAL;
+    int rc = cm_lib_resolve(module, inst, reg, &r, addr_out);
+    if (rc) return rc;
+    return cm_find_field(r, field, field_out) ? CM_LIB_ENOENT : CM_LIB_OK;
+}
+
+int cm_dev_field_read(cm_dev_t *dev, const char *module, unsigned inst, const char *reg,
+                      const char *field, uint8_t *value_out)
+{
+    uint16_t addr = 0;
+    const cm_field_desc_t *f = NULL;
+    if (!dev || !value_out) return CM_LIB_EINVAL;
+    int rc = cm_lib_resolve_field(module, inst, reg, field, &addr, &f);
+    if (rc) return rc;
+    pthread_mutex_lock(&dev->mu);
+    rc = cm_field_read8(&dev->bus, addr, f->shift, f->width, value_out);
+    pthread_mutex_unlock(&dev->mu);
+    return cm_lib_io(rc);
+}
+
+int cm_dev_field_write(cm_dev_t *dev, const char *module, unsigned inst, const char *reg,
+                       const char *field, uint8_t value)
+{
+    uint16_t addr = 0;
+    const cm_field_desc_t *f = NULL;
+    if (!dev) return CM_LIB_EINVAL;
+    int rc = cm_lib_resolve_field(module, inst, reg, field, &addr, &f);
+    if (rc) return rc;
+    pthread_mutex_lock(&dev->mu);
+    rc = cm_field_write8(&dev->bus, addr, f->shift, f->width, value);
+    pthread_mutex_unlock(&dev->mu);
+    return cm_lib_io(rc);
+}
+
+// ---------------------------------------------------------------------------
+// Frequency planners
+// ---------------------------------------------------------------------------
+
+static int cm_lib_plan_rc(int rc)
+{
+    if (rc == 0) return CM_LIB_OK;
+    return rc == -2 ? CM_LIB_ENOPLAN : CM_LIB_EINVAL;
+}
+
+int cm_lib_plan_input(const char *freq_hz, cm_lib_input_plan_t *out)
+{
+    cm_fp_batch_req_t req;
+    cm_fp_batch_res_t res;
+    if (!freq_hz || !out) return CM_LIB_EINVAL;
+
+    memset(&req, 0, sizeof(req));
+    req.kind = CM_FP_BATCH_INPUT;
+    req.nfreq = 1;
+    if (cm_freq_parse(freq_hz, &req.freq[0]) != 0) return CM_LIB_EINVAL;
+    if (cm_fp_plan_batch(&req, 1, NULL, &res) < 0) return CM_LIB_ENOMEM;
+    if (res.rc != 0) return cm_lib_plan_rc(res.rc);
+
+    const cm_fp_plan_t *p = &res.plan;
+    memset(out, 0, sizeof(*out));
+    out->m = p->m;
+    out->n = p->n;
+    out->n_reg = p->n_reg;
+    out->actual_num = p->actual[0].num;
+    out->actual_den = p->actual[0].den;
+    out->actual_hz = cm_freq_to_double(p->actual[0]);
+    out->err_ppb = p->err_ppb[0];
+    out->exact = p->exact;
+    return CM_LIB_OK;
+}
+
+int cm_lib_plan_dco(const char *const *freqs_hz, unsigned n, cm_lib_dco_plan_t *out)
+{
+    cm_freq_t targets[CM_FP_MAX_OUTPUTS];
+    cm_fp_plan_t p;
+    if (!freqs_hz || !out || n == 0 || n > CM_LIB_MAX_OUTPUTS) return CM_LIB_EINVAL;
+
+    for (unsigned i = 0; i < n; i++) {
+        if (!freqs_hz[i] || cm_freq_parse(freqs_hz[i], &targets[i]) != 0)
+            return CM_LIB_EINVAL;
+    }
+    int rc = cm_fp_plan_dco(targets, n, NULL, &p);
+    if (rc) return cm_lib_plan_rc(rc);
+
+    memset(out, 0, sizeof(*out));
+    out->m = p.m;
+    out->n = p.n;
+    out->n_reg = p.n_reg;
+    out->dco_hz = cm_freq_to_double(p.dco);
+    out->nout = n;
+    for (unsigned i = 0; i < n; i++) {
+        out->div[i] = p.div[i];
+        out->actual_hz[i] = cm_freq_to_double(p.actual[i]);
+        out->err_ppb[i] = p.err_ppb[i];
+    }
+    out->exact = p.exact;
+    return CM_LIB_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Configuration loaders
+// ---------------------------------------------------------------------------
+
+// The loaders write through the raw fd, behind the shadow cache.
+static void cm_dev_behind_bus(cm_dev_t *dev)
+{
+    if (dev->shadow_on) cm_shadow_invalidate(&dev->shadow);
+}
+
+int cm_dev_apply_tcs(cm_dev_t *dev, const char *path, int verbose)
+{
+    if (!dev || !path) return CM_LIB_EINVAL;
+    pthread_mutex_lock(&dev->mu);
+    dpll_result_t rc = dpll_apply_tcs_file(dev->fd, path, verbose);
+    cm_dev_behind_bus(dev);
+    pthread_mutex_unlock(&dev->mu);
+    return rc == DPLL_OK ? CM_LIB_OK : CM_LIB_EIO;
+}
+
+int cm_dev_apply_program_file(cm_dev_t *dev, const char *path, int verbose)
+{
+    if (!dev || !path) return CM_LIB_EINVAL;
+    pthread_mutex_lock(&dev->mu);
+    dpll_result_t rc = dpll_apply_program_file(dev->fd, path, verbose);
+    cm_dev_behind_bus(dev);
+    pthread_mutex_unlock(&dev->mu);
+    return rc == DPLL_OK ? CM_LIB_OK : CM_LIB_EIO;
+}
+
+int cm_dev_flash_hex(cm_dev_t *dev, const char *path, cm_lib_progress_cb cb, void *user)
+{
+    if (!dev || !path) return CM_LIB_EINVAL;
+    pthread_mutex_lock(&dev->mu);
+    dpll_result_t rc = dpll_eeprom_flash_hex(dev->fd, path, cb, user);
+    cm_dev_behind_bus(dev);
+    pthread_mutex_unlock(&dev->mu);
+    return rc == DPLL_OK ? CM_LIB_OK : CM_LIB_EIO;
+}
+
+// ---------------------------------------------------------------------------
+// Status
+// ---------------------------------------------------------------------------
+
+int cm_dev_status(cm_dev_t *dev, unsigned flags, cm_lib_status_t *out)
+{
+    dpll_status_snapshot_t snap;
+    if (!dev || !out || (flags & ~(CM_LIB_STATUS_PHASE | CM_LIB_STATUS_INPUTS)))
+        return CM_LIB_EINVAL;
+
+    pthread_mutex_lock(&dev->mu);
+    int rc = dpll_status_snapshot_read(&dev->bus, flags, &snap);
+    pthread_mutex_unlock(&dev->mu);
+    if (rc) return CM_LIB_EIO;
+
+    memset(out, 0, sizeof(*out));
+    for (unsigned ch = 0; ch < CM_LIB_NUM_DPLLS; ch++) {
+        out->ch[ch].state = snap.ch[ch].state;
+        out->ch[ch].lock_sticky = snap.ch[ch].lock_sticky;
+        out->ch[ch].holdover_sticky = snap.ch[ch].holdover_sticky;
+        out->ch[ch].ref_input = snap.ch[ch].ref_input;
+        out->ch[ch].phase_s36 = snap.ch[ch].phase_s36;
+        out->ch[ch].phase_sec = snap.ch[ch].phase_sec;
+    }
+    memcpy(out->in_mon, snap.in_mon, sizeof(out->in_mon));
+    out->has_phase = snap.has_phase;
+    out->has_inputs = snap.has_inputs;
+    return CM_LIB_OK;
+}
+
+int cm_dev_snapshot_save(cm_dev_t *dev, const char *path)
+{
+    cm_snapshot_t snap;
+    if (!dev || !path) return CM_LIB_EINVAL;
+
+    pthread_mutex_lock(&dev->mu);
+    int rc = cm_snapshot_capture(&dev->bus, &snap);
+    pthread_mutex_unlock(&dev->mu);
+    if (rc) return CM_LIB_EIO;
+
+    rc = cm_snapshot_save(&snap, path);
+    cm_snapshot_free(&snap);
+    return rc ? CM_LIB_EIO : CM_LIB_OK;
+}
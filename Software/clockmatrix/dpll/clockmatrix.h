@@ -0,0 +1,207 @@
+// clockmatrix.h
+//
+// Stable C ABI of libclockmatrix (libclockmatrix.a / libclockmatrix.so.1).
+//
+// This is the only header installed with the library. It covers what
+// dplltool does for other programs: an opaque device handle over spidev,
+// raw and by-name register access, the frequency planners, TCS / programming
+// file / EEPROM HEX loaders, the all-DPLL status snapshot and register
+// snapshots. Internal headers (cm_*.h, linux_dpll.h, ...) may change between
+// releases; the declarations below only change together with
+// CM_LIB_VERSION_MAJOR (the soname).
+//
+// Everything is plain C types and fixed-size structs so it can be used from
+// Python ctypes without a compiler:
+//
+//   lib = ctypes.CDLL("libclockmatrix.so.1")
+//   dev = lib.cm_dev_open(b"/dev/spidev1.0", 1000000, 0, 0)
+//
+// Functions return CM_LIB_OK (0) or a negative CM_LIB_E* code. A cm_dev_t
+// may be shared between threads: each call holds the handle's lock for its
+// whole duration, so a field read-modify-write is never interleaved with
+// another call on the same handle.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define CM_LIB_API __attribute__((visibility("default")))
+#else
+#define CM_LIB_API
+#endif
+
+#define CM_LIB_VERSION_MAJOR 1   // soname; bumped on any incompatible change
+#define CM_LIB_VERSION_MINOR 0   // bumped when functions are added
+#define CM_LIB_VERSION_PATCH 0
+
+#define CM_LIB_OK       0
+#define CM_LIB_EINVAL  -1   // bad argument or frequency syntax
+#define CM_LIB_ENOENT  -2   // unknown module / register / field, or instance out of range
+#define CM_LIB_EIO     -3   // SPI transfer, file or parse error
+#define CM_LIB_ENOPLAN -4   // no frequency plan within the chip limits
+#define CM_LIB_ENOMEM  -5
+
+// (major << 16) | (minor << 8) | patch of the library actually loaded.
+CM_LIB_API unsigned    cm_lib_version(void);
+
+// "ok", "invalid argument", ... for a CM_LIB_* code.
+CM_LIB_API const char *cm_lib_strerror(int rc);
+
+// ---------------------------------------------------------------------------
+// Device handle
+// ---------------------------------------------------------------------------
+
+typedef struct cm_dev cm_dev_t;
+
+// cm_dev_open() flags
+#define CM_DEV_SHADOW_CACHE 0x1u  // serve configuration register reads from a
+                                  // write-through cache (see cm_shadow.h)
+
+// Open spidev_path (e.g. "/dev/spidev1.0"); hz 0 = 1 MHz. Returns NULL on
+// error (errno from open/ioctl, or ENOMEM).
+CM_LIB_API cm_dev_t *cm_dev_open(const char *spidev_path, uint32_t hz, uint8_t mode,
+                                 unsigned flags);
+
+// Close the handle. NULL is ignored.
+CM_LIB_API void      cm_dev_close(cm_dev_t *dev);
+
+// ---------------------------------------------------------------------------
+// Register access
+// ---------------------------------------------------------------------------
+
+// len bytes at a 16-bit register address (page crossings are handled).
+CM_LIB_API int cm_dev_read(cm_dev_t *dev, uint16_t addr, uint8_t *buf, size_t len);
+CM_LIB_API int cm_dev_write(cm_dev_t *dev, uint16_t addr, const uint8_t *buf, size_t len);
+
+// Address of register `reg` of instance `inst` of `module`, e.g.
+// ("DPLL_Ctrl", 6, "FOD_FREQ_M_7_0"). Names are those of the register
+// tables (renesas_cm8a34001_regs.txt). Needs no device.
+CM_LIB_API int cm_lib_reg_addr(const char *module, unsigned inst, const char *reg,
+                               uint16_t *addr_out);
+
+// len bytes starting at a named register.
+CM_LIB_API int cm_dev_reg_read(cm_dev_t *dev, const char *module, unsigned inst,
+                               const char *reg, uint8_t *buf, size_t len);
+CM_LIB_API int cm_dev_reg_write(cm_dev_t *dev, const char *module, unsigned inst,
+                                const char *reg, const uint8_t *buf, size_t len);
+
+// A named bit field, right-aligned. The write is a read-modify-write of the
+// register; bits of value above the field width are ignored.
+CM_LIB_API int cm_dev_field_read(cm_dev_t *dev, const char *module, unsigned inst,
+                                 const char *reg, const char *field, uint8_t *value_out);
+CM_LIB_API int cm_dev_field_write(cm_dev_t *dev, const char *module, unsigned inst,
+                                  const char *reg, const char *field, uint8_t value);
+
+// ---------------------------------------------------------------------------
+// Frequency planners (no device, no plan cache, never print)
+// ---------------------------------------------------------------------------
+//
+// Frequencies are strings so they are exact: "25e6", "161132812.5",
+// "10000000/3".
+
+#define CM_LIB_MAX_OUTPUTS 16
+
+typedef struct {
+    uint64_t m;             // INPUT_IN_FREQ_M
+    uint32_t n;             // N (1..65536)
+    uint16_t n_reg;         // INPUT_IN_FREQ_N register value (0 means N = 1)
+    uint64_t actual_num;    // m / n as a reduced fraction, Hz
+    uint64_t actual_den;
+    double   actual_hz;
+    double   err_ppb;       // (actual - requested) / requested * 1e9
+    int      exact;         // 1 if actual == requested exactly
+} cm_lib_input_plan_t;
+
+typedef struct {
+    uint64_t m;             // DCO = m / n Hz exactly (FOD_FREQ_M / FOD_FREQ_N)
+    uint32_t n;
+    uint16_t n_reg;
+    double   dco_hz;
+    unsigned nout;          // = number of requested frequencies
+    uint32_t div[CM_LIB_MAX_OUTPUTS];        // OUT_DIV per frequency, in order
+    double   actual_hz[CM_LIB_MAX_OUTPUTS];
+    double   err_ppb[CM_LIB_MAX_OUTPUTS];
+    int      exact;         // 1 if every output is exact
+} cm_lib_dco_plan_t;
+
+// Input M/N for a reference of freq_hz.
+CM_LIB_API int cm_lib_plan_input(const char *freq_hz, cm_lib_input_plan_t *out);
+
+// One DCO plus integer dividers for n (1..CM_LIB_MAX_OUTPUTS) outputs; exact
+// if any exact plan exists, else the least total error.
+CM_LIB_API int cm_lib_plan_dco(const char *const *freqs_hz, unsigned n,
+                               cm_lib_dco_plan_t *out);
+
+// ---------------------------------------------------------------------------
+// Configuration loaders
+// ---------------------------------------------------------------------------
+//
+// These write behind the shadow cache, which is dropped afterwards.
+
+// Timing Commander .tcs register table / "Programming File" .txt export.
+// verbose != 0 logs every parsed write to stderr.
+CM_LIB_API int cm_dev_apply_tcs(cm_dev_t *dev, const char *path, int verbose);
+CM_LIB_API int cm_dev_apply_program_file(cm_dev_t *dev, const char *path, int verbose);
+
+// Called while flashing: bytes written so far, total (0 if unknown).
+typedef void (*cm_lib_progress_cb)(size_t written, size_t total, void *user);
+
+// Write an Intel HEX image into the EEPROM behind the chip's I2C master.
+// cb may be NULL.
+CM_LIB_API int cm_dev_flash_hex(cm_dev_t *dev, const char *path, cm_lib_progress_cb cb,
+                                void *user);
+
+// ---------------------------------------------------------------------------
+// Status
+// ---------------------------------------------------------------------------
+
+#define CM_LIB_NUM_DPLLS  8
+#define CM_LIB_NUM_INPUTS 16
+
+// DPLL_STATE values
+#define CM_LIB_STATE_FREERUN  0
+#define CM_LIB_STATE_LOCKACQ  1
+#define CM_LIB_STATE_LOCKREC  2
+#define CM_LIB_STATE_LOCKED   3
+#define CM_LIB_STATE_HOLDOVER 4
+#define CM_LIB_STATE_DISABLED 6
+
+// cm_dev_status() flags
+#define CM_LIB_STATUS_PHASE  0x1u  // also read DPLL<n>_PHASE_STATUS
+#define CM_LIB_STATUS_INPUTS 0x2u  // also read IN<n>_MON_STATUS
+
+typedef struct {
+    uint8_t state;            // DPLL_STATE (CM_LIB_STATE_*)
+    uint8_t lock_sticky;      // LOCK_STATE_CHANGE_STICKY
+    uint8_t holdover_sticky;  // HOLDOVER_STATE_CHANGE_STICKY
+    uint8_t ref_input;        // input the DPLL tracks
+    int64_t phase_s36;        // DPLL<n>_PHASE_STATUS, raw (CM_LIB_STATUS_PHASE)
+    double  phase_sec;        // the same in seconds
+} cm_lib_chan_status_t;
+
+typedef struct {
+    cm_lib_chan_status_t ch[CM_LIB_NUM_DPLLS];
+    uint8_t  in_mon[CM_LIB_NUM_INPUTS];  // raw IN<n>_MON_STATUS (CM_LIB_STATUS_INPUTS)
+    int      has_phase;
+    int      has_inputs;
+} cm_lib_status_t;
+
+// Status of every DPLL in one or two SPI bursts.
+CM_LIB_API int cm_dev_status(cm_dev_t *dev, unsigned flags, cm_lib_status_t *out);
+
+// "LOCKED", "FREERUN", ... ("UNKNOWN" for reserved codes).
+CM_LIB_API const char *cm_lib_state_str(uint8_t state);
+
+// Read every register named in the tables and save them in the
+// `dplltool snapshot` file format.
+CM_LIB_API int cm_dev_snapshot_save(cm_dev_t *dev, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+// cm_busstat.c
+// Counting / timing view of a cm_bus_t (see cm_busstat.h).
+
+#include "cm_busstat.h"
+
+#include <string.h>
+#include <time.h>
+
+static uint64_t cm_busstat_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+// Latency histogram
+// ---------------------------------------------------------------------------
+
+unsigned cm_lathist_bucket(uint64_t v)
+{
+    if (v < CM_LATHIST_SUB) return (unsigned)v;
+    if (v >> CM_LATHIST_MAX_LOG2) v = (1ull << CM_LATHIST_MAX_LOG2) - 1;
+    const unsigned e = 63u - (unsigned)__builtin_clzll(v);  // >= SUB_BITS
+    const unsigned shift = e - CM_LATHIST_SUB_BITS;
+    return CM_LATHIST_SUB * (shift + 1) + (unsigned)((v >> shift) & (CM_LATHIST_SUB - 1));
+}
+
+uint64_t cm_lathist_lo(unsigned bucket)
+{
+    if (bucket < CM_LATHIST_SUB) return bucket;
+    const unsigned shift = bucket / CM_LATHIST_SUB - 1;
+    return (uint64_t)(CM_LATHIST_SUB + bucket % CM_LATHIST_SUB) << shift;
+}
+
+uint64_t cm_lathist_hi(unsigned bucket)
+{
+    if (bucket < CM_LATHIST_SUB) return bucket + 1;
+    return cm_lathist_lo(bucket) + (1ull << (bucket / CM_LATHIST_SUB - 1));
+}
+
+uint64_t cm_lathist_quantile(const cm_lathist_t *h, uint64_t count, double q)
+{
+    if (count == 0) return 0;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+    uint64_t rank = (uint64_t)(q * (double)count + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t cum = 0;
+    for (unsigned i = 0; i < CM_LATHIST_BUCKETS; i++) {
+        cum += h->b[i];
+        if (cum >= rank) return cm_lathist_hi(i);
+    }
+    return cm_lathist_hi(CM_LATHIST_BUCKETS - 1);
+}
+
+uint64_t cm_busop_quantile(const cm_busop_stat_t *s, double q)
+{
+    const uint64_t v = cm_lathist_quantile(&s->hist, s->calls, q);
+    return v < s->ns_max ? v : s->ns_max;
+}
+
+// ---------------------------------------------------------------------------
+// Counters
+// ---------------------------------------------------------------------------
+
+void cm_busstat_record(cm_busstat_t *st, cm_busop_t op, uint16_t addr, size_t len,
+                       uint64_t ns, int rc)
+{
+    if (!st || (unsigned)op >= CM_BUSOP_COUNT) return;
+    cm_busop_stat_t *s = &st->op[op];
+
+    __atomic_fetch_add(&s->calls, 1, __ATOMIC_RELAXED);
+    if (rc) __atomic_fetch_add(&s->errors, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&s->bytes, (uint64_t)len, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&s->ns_sum, ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&s->hist.b[cm_lathist_bucket(ns)], 1, __ATOMIC_RELAXED);
+
+    uint64_t max = __atomic_load_n(&s->ns_max, __ATOMIC_RELAXED);
+    while (ns > max &&
+           !__atomic_compare_exchange_n(&s->ns_max, &max, ns, 1, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+
+    size_t slot = CM_BUSSTAT_MODULES - 1;
+    if (cm_module_for_addr(addr, &slot, NULL) != 0 || slot >= CM_BUSSTAT_MODULES - 1)
+        slot = CM_BUSSTAT_MODULES - 1;
+    cm_busmod_stat_t *m = &st->mod[slot];
+    __atomic_fetch_add(&m->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&m->bytes, (uint64_t)len, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&m->ns_sum, ns, __ATOMIC_RELAXED);
+}
+
+static void cm_busstat_add(cm_busstat_t *st, cm_busop_t op, uint16_t addr, size_t len,
+                           uint64_t t0, int rc)
+{
+    cm_busstat_record(st, op, addr, len, cm_busstat_now_ns() - t0, rc);
+}
+
+static int cm_stat_read8(void *user, uint16_t addr, uint8_t *val)
+{
+    cm_busstat_t *st = user;
+    const uint64_t t0 = cm_busstat_now_ns();
+    int rc = st->inner->read8(st->inner->user, addr, val);
+    cm_busstat_add(st, CM_BUSOP_READ8, addr, 1, t0, rc);
+    return rc;
+}
+
+static int cm_stat_write8(void *user, uint16_t addr, uint8_t val)
+{
+    cm_busstat_t *st = user;
+    const uint64_t t0 = cm_busstat_now_ns();
+    int rc = st->inner->write8(st->inner->user, addr, val);
+    cm_busstat_add(st, CM_BUSOP_WRITE8, addr, 1, t0, rc);
+    return rc;
+}
+
+static int cm_stat_read(void *user, uint16_t addr, uint8_t *buf, size_t len)
+{
+    cm_busstat_t *st = user;
+    const uint64_t t0 = cm_busstat_now_ns();
+    int rc = st->inner->read(st->inner->user, addr, buf, len);
+    cm_busstat_add(st, CM_BUSOP_READ, addr, len, t0, rc);
+    return rc;
+}
+
+static int cm_stat_write(void *user, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    cm_busstat_t *st = user;
+    const uint64_t t0 = cm_busstat_now_ns();
+    int rc = st->inner->write(st->inner->user, addr, buf, len);
+    cm_busstat_add(st, CM_BUSOP_WRITE, addr, len, t0, rc);
+    return rc;
+}
+
+int cm_bus_init_stat(cm_bus_t *bus, cm_busstat_t *st, const cm_bus_t *inner)
+{
+    if (!bus || !st || !inner) return -1;
+    cm_busstat_reset(st);
+    st->inner = inner;
+
+    bus->user   = st;
+    bus->read8  = cm_stat_read8;
+    bus->write8 = cm_stat_write8;
+    bus->read   = cm_stat_read;
+    bus->write  = cm_stat_write;
+    return 0;
+}
+
+void cm_busstat_reset(cm_busstat_t *st)
+{
+    const cm_bus_t *inner = st->inner;
+    memset(st, 0, sizeof(*st));
+    st->inner = inner;
+}
+
+void cm_busstat_snapshot(const cm_busstat_t *st, cm_busop_stat_t out[CM_BUSOP_COUNT],
+                         cm_busmod_stat_t mod[CM_BUSSTAT_MODULES])
+{
+    for (unsigned i = 0; i < CM_BUSOP_COUNT; i++) {
+        const cm_busop_stat_t *s = &st->op[i];
+        out[i].calls = __atomic_load_n(&s->calls, __ATOMIC_RELAXED);
+        out[i].errors = __atomic_load_n(&s->errors, __ATOMIC_RELAXED);
+        out[i].bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+        out[i].ns_sum = __atomic_load_n(&s->ns_sum, __ATOMIC_RELAXED);
+        out[i].ns_max = __atomic_load_n(&s->ns_max, __ATOMIC_RELAXED);
+        for (unsigned b = 0; b < CM_LATHIST_BUCKETS; b++)
+            out[i].hist.b[b] = __atomic_load_n(&s->hist.b[b], __ATOMIC_RELAXED);
+    }
+    if (!mod) return;
+    for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++) {
+        mod[i].calls = __atomic_load_n(&st->mod[i].calls, __ATOMIC_RELAXED);
+        mod[i].bytes = __atomic_load_n(&st->mod[i].bytes, __ATOMIC_RELAXED);
+        mod[i].ns_sum = __atomic_load_n(&st->mod[i].ns_sum, __ATOMIC_RELAXED);
+    }
+}
+
+const char *cm_busop_name(cm_busop_t op)
+{
+    static const char *const names[CM_BUSOP_COUNT] = {"read8", "write8", "read", "write",
+                                                      "page"};
+    return (unsigned)op < CM_BUSOP_COUNT ? names[op] : "unknown";
+}
+
+const char *cm_busstat_module_name(unsigned slot)
+{
+    const char *name = NULL;
+    if (slot < CM_BUSSTAT_MODULES - 1 && slot < cm_all_modules_count)
+        name = cm_module_name(cm_all_modules[slot]);
+    return name ? name : "other";
+}
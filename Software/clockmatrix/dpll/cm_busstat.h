@@ -0,0 +1,112 @@
+// cm_busstat.h
+//
+// Counting / timing view of a cm_bus_t.
+//
+// cm_bus_init_stat wraps a bus like cm_bus_init_locked does: every op is
+// passed to `inner` and counted per op type (calls, errors, bytes, total and
+// worst duration, latency histogram) and per register module (the
+// cm_all_modules[] entry whose span holds the op's start address).
+// Counters are updated with relaxed atomics, so one cm_busstat_t may sit
+// under several threads (put it below cm_bus_lock_t to time the transfer,
+// not the wait for the lock) and be read from another thread with
+// cm_busstat_snapshot while ops are running.
+//
+// cm_busstat_record feeds the same counters from elsewhere, e.g. the
+// linux_dpll transfer hook, which also sees the page register writes
+// (CM_BUSOP_PAGE) that a cm_bus_t op expands to.
+//
+// Latency histograms are HDR-style: exact below 8 ns, then 8 linear
+// sub-buckets per power of two, so any quantile is within 12.5% of the
+// true value from 8 ns up to ~18 minutes.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CM_BUSOP_READ8 = 0,
+    CM_BUSOP_WRITE8,
+    CM_BUSOP_READ,     // burst read
+    CM_BUSOP_WRITE,    // burst write
+    CM_BUSOP_PAGE,     // page register write (transfer level only)
+    CM_BUSOP_COUNT
+} cm_busop_t;
+
+#define CM_LATHIST_SUB_BITS 3
+#define CM_LATHIST_SUB      (1u << CM_LATHIST_SUB_BITS)
+#define CM_LATHIST_MAX_LOG2 40                      // larger values clamp
+#define CM_LATHIST_BUCKETS  (CM_LATHIST_SUB * (CM_LATHIST_MAX_LOG2 - CM_LATHIST_SUB_BITS + 1))
+
+typedef struct {
+    uint64_t b[CM_LATHIST_BUCKETS];
+} cm_lathist_t;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t errors;    // ops that returned non-zero
+    uint64_t bytes;     // payload bytes (1 for read8/write8)
+    uint64_t ns_sum;
+    uint64_t ns_max;
+    cm_lathist_t hist;  // ns
+} cm_busop_stat_t;
+
+// Per-module slots: cm_all_modules[] indices, then one for addresses outside
+// every module.
+#define CM_BUSSTAT_MODULES 32
+
+typedef struct {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t ns_sum;
+} cm_busmod_stat_t;
+
+typedef struct {
+    const cm_bus_t *inner;
+    cm_busop_stat_t op[CM_BUSOP_COUNT];
+    cm_busmod_stat_t mod[CM_BUSSTAT_MODULES];
+} cm_busstat_t;
+
+// Initialize `bus` as the counted view of `inner`. Both st and inner must
+// outlive bus. Returns 0 or -1.
+int  cm_bus_init_stat(cm_bus_t *bus, cm_busstat_t *st, const cm_bus_t *inner);
+
+// Zero all counters (inner is kept).
+void cm_busstat_reset(cm_busstat_t *st);
+
+// Count one op of len payload bytes at addr that took ns; rc != 0 is an error.
+void cm_busstat_record(cm_busstat_t *st, cm_busop_t op, uint16_t addr, size_t len,
+                       uint64_t ns, int rc);
+
+// Copy the counters (each one read atomically). mod may be NULL.
+void cm_busstat_snapshot(const cm_busstat_t *st, cm_busop_stat_t out[CM_BUSOP_COUNT],
+                         cm_busmod_stat_t mod[CM_BUSSTAT_MODULES]);
+
+// "read8", "write8", "read", "write", "page".
+const char *cm_busop_name(cm_busop_t op);
+
+// Module slot name: the cm_all_modules[] name, or "other" for the last slot
+// (and for names stripped with CM_STRIP_NAMES).
+const char *cm_busstat_module_name(unsigned slot);
+
+// Histogram bucket of a value, and the bucket's [lo, hi) bounds.
+unsigned cm_lathist_bucket(uint64_t v);
+uint64_t cm_lathist_lo(unsigned bucket);
+uint64_t cm_lathist_hi(unsigned bucket);
+
+// Value at quantile q (0..1) of a histogram holding `count` values: the
+// upper bound of the bucket the q-th value falls in (0 when empty).
+uint64_t cm_lathist_quantile(const cm_lathist_t *h, uint64_t count, double q);
+
+// Quantile of an op's latency (ns), capped at the observed worst case.
+uint64_t cm_busop_quantile(const cm_busop_stat_t *s, double q);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,13 @@
 //   S1 (step):    coarse output phase correction via OUTPUT_x.OUT_PHASE_ADJ (FOD cycles).
 //   S2 (slew):    continuous frequency steering via DPLL_WR_FREQ (write-frequency mode).
 //
+// Servo (--servo):
+//   pi      fixed-gain PI on phase (--kp/--ki), S0 averages for --s0-window.
+//   kalman  phase/frequency(/drift) Kalman filter (cm_kalman) whose measurement
+//           noise follows the innovations. S0 ends as soon as the phase estimate
+//           is good enough; S2 steers to the estimated frequency plus the
+//           estimated phase over --kf-tc seconds.
+//
 // Measurement source:
 //   STATUS.DPLL{meas}_PHASE_STATUS: signed 36-bit phase offset in ITDC_UI.
 //   Assuming default ITDC clock 625 MHz => ITDC_UI = 1/(32*625e6) = 50 ps.
@@ -19,100 +26,67 @@
 // Frequency slew:
 //   DPLL_Freq_Write[n].DPLL_WR_FREQ: signed 42-bit fractional frequency offset in units 2^-53.
 //   Target DPLL(s) must be configured in write-frequency mode.
+//
+// Loop timing:
+//   Every loop step waits on an absolute periodic timerfd (CLOCK_MONOTONIC), so
+//   SPI time and scheduling delays do not accumulate into the period. Missed
+//   deadlines are counted as overruns and the S2 integrator uses the real
+//   elapsed time. The deviation of each measured period from the nominal one
+//   is reported (--jitter-report, and always on exit). --rt-prio / --mlock
+//   run the loop under SCHED_FIFO with all memory locked.
+//
+// Register access and SPI glue come from cm_dpll_utils. All --wr-dplls are
+// steered together through cm_steer: one burst per run of adjacent DPLLs,
+// so they change frequency within microseconds of each other.
 
 #define _GNU_SOURCE
 
 #include <errno.h>
 #include <math.h>
+#include <sched.h>
+#include <signal.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
 #include <time.h>
 #include <unistd.h>
-#include <linux/spi/spidev.h>
 
 #include "linux_dpll.h"
-#include "tcs_dpll.h"
-#include "renesas_cm8a34001_tables.h"
+#include "cm_dpll_utils.h"
+#include "cm_kalman.h"
+#include "cm_steer.h"
 
 // ---------------------------- Constants ------------------------------------
 
-// Default Input TDC clock used by the ClockMatrix devices.
-#define CM_ITDC_HZ               625000000.0
-#define CM_ITDC_UI_SEC           (1.0 / (32.0 * CM_ITDC_HZ))  // 50 ps
-
-// DPLL_WR_FREQ is an FFO in units 2^-53 (fractional frequency).
-#define CM_WR_FREQ_FRAC_BITS     53
-
 // Sign conventions are messy across configs; keep a single global polarity knob.
 // If you find the loop runs away, flip --invert.
 #define CM_DEFAULT_POLARITY      (+1.0)
 
-// ---------------------------- SPI -> cm_bus --------------------------------
-
-static int g_spi_fd = -1;
-static cm_bus_t g_cm_bus;
-
-static int cm_spi_read8(void *user, uint16_t addr, uint8_t *val)
-{
-    int spi_fd = *(int *)user;
-    uint8_t tmp = 0;
-    dpll_result_t r = dpll_read8(spi_fd, addr, &tmp);
-    if (r != DPLL_OK) return -1;
-    *val = tmp;
-    return 0;
-}
-
-static int cm_spi_write8(void *user, uint16_t addr, uint8_t val)
-{
-    int spi_fd = *(int *)user;
-    dpll_result_t r = dpll_write8(spi_fd, addr, val);
-    return (r == DPLL_OK) ? 0 : -1;
-}
-
-static int cm_spi_read(void *user, uint16_t addr, uint8_t *buf, size_t len)
-{
-    int spi_fd = *(int *)user;
-    dpll_result_t r = dpll_read_seq(spi_fd, addr, buf, len);
-    return (r == DPLL_OK) ? 0 : -1;
-}
+// disc_wait() result when SIGINT/SIGTERM stopped the loop.
+#define DISC_STOPPED             1
 
-static int cm_spi_write(void *user, uint16_t addr, const uint8_t *buf, size_t len)
-{
-    int spi_fd = *(int *)user;
-    dpll_result_t r = dpll_write_seq(spi_fd, addr, buf, len);
-    return (r == DPLL_OK) ? 0 : -1;
-}
+static volatile sig_atomic_t g_disc_stop = 0;
 
-static void cm_init_bus_for_spi(int spi_fd)
-{
-    g_spi_fd = spi_fd;
-    g_cm_bus.user   = &g_spi_fd;
-    g_cm_bus.read8  = cm_spi_read8;
-    g_cm_bus.write8 = cm_spi_write8;
-    g_cm_bus.read   = cm_spi_read;
-    g_cm_bus.write  = cm_spi_write;
-}
+// WR_FREQ writer shared by S1->S2 and S2.
+static cm_steer_t g_steer;
 
 // ---------------------------- Utilities ------------------------------------
 
-static double now_monotonic_sec(void)
+static uint64_t now_monotonic_ns(void)
 {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
 }
 
-static void sleep_sec(double sec)
+static double now_monotonic_sec(void)
 {
-    if (sec <= 0.0) return;
-    struct timespec ts;
-    ts.tv_sec  = (time_t)sec;
-    ts.tv_nsec = (long)((sec - (double)ts.tv_sec) * 1e9);
-    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+    return (double)now_monotonic_ns() * 1e-9;
 }
 
 static double clamp_d(double x, double lo, double hi)
@@ -137,222 +111,172 @@ static double wrap_phase_sec(double x)
     return x;
 }
 
-static int parse_u32_list(const char *s, unsigned *out, size_t out_cap, size_t *out_n)
+static void disc_stop_signal(int sig)
 {
-    // Parses comma-separated list like "9,10,11".
-    // Returns 0 on success.
-    if (!s || !*s) return -1;
-
-    char *tmp = strdup(s);
-    if (!tmp) return -1;
-
-    size_t n = 0;
-    char *save = NULL;
-    for (char *tok = strtok_r(tmp, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
-        if (n >= out_cap) {
-            free(tmp);
-            return -1;
-        }
-        char *end = NULL;
-        long v = strtol(tok, &end, 0);
-        if (!end || *end != '\0' || v < 0) {
-            free(tmp);
-            return -1;
-        }
-        out[n++] = (unsigned)v;
-    }
-    free(tmp);
-    *out_n = n;
-    return (n > 0) ? 0 : -1;
+    (void)sig;
+    g_disc_stop = 1;
 }
 
-// ---------------------------- Register helpers -----------------------------
+// ---------------------------- Loop clock -----------------------------------
 
-// Read signed 36-bit PHASE_STATUS (stored in 5 bytes, sign in bit 35).
-static int read_phase_status_s36(const cm_bus_t *bus, unsigned meas_dpll, int64_t *out_s36)
-{
-    char reg_name[64];
-    snprintf(reg_name, sizeof(reg_name), "DPLL%u_PHASE_STATUS", meas_dpll);
-
-    uint8_t buf[5] = {0};
-    int rc = cm_string_read_bytes(bus, "Status", 0, reg_name, buf, sizeof(buf));
-    if (rc != 0) return rc;
-
-    // Little-endian 40 bits, but only bits[35:0] valid.
-    uint64_t v = 0;
-    v |= (uint64_t)buf[0] << 0;
-    v |= (uint64_t)buf[1] << 8;
-    v |= (uint64_t)buf[2] << 16;
-    v |= (uint64_t)buf[3] << 24;
-    v |= (uint64_t)buf[4] << 32;
-    v &= ((1ULL << 36) - 1ULL);
-
-    // Sign extend 36-bit.
-    int64_t s = (int64_t)v;
-    if (v & (1ULL << 35)) {
-        s |= ~((int64_t)((1ULL << 36) - 1ULL));
-    }
-
-    *out_s36 = s;
-    return 0;
-}
+// Period error = measured wake-to-wake time minus the nominal time for the
+// deadlines that elapsed in between.
+typedef struct {
+    uint64_t n;
+    int64_t  min_ns, max_ns;
+    double   sum_ns, sumsq_ns;
+    uint64_t late_max_ns;     // wake-up after the deadline
+    uint64_t overruns;        // deadlines that expired with nobody waiting
+} disc_jitter_t;
 
-static double phase_s36_to_seconds(int64_t phase_s36)
+typedef struct {
+    int      fd;
+    uint64_t period_ns;
+    uint64_t deadline_ns;     // next expiry (CLOCK_MONOTONIC)
+    uint64_t last_wake_ns;    // 0 before the first tick
+    unsigned last_periods;    // deadlines consumed by the last disc_wait()
+    unsigned pending_periods; // periods of dropped samples since the last used one
+
+    uint64_t report_ns;       // 0 = only report on exit
+    uint64_t next_report_ns;
+    disc_jitter_t win, total;
+} disc_clock_t;
+
+static void jitter_add(disc_jitter_t *j, int64_t err_ns, uint64_t late_ns, uint64_t overruns)
 {
-    return (double)phase_s36 * CM_ITDC_UI_SEC;
+    if (j->n == 0 || err_ns < j->min_ns) j->min_ns = err_ns;
+    if (j->n == 0 || err_ns > j->max_ns) j->max_ns = err_ns;
+    j->sum_ns += (double)err_ns;
+    j->sumsq_ns += (double)err_ns * (double)err_ns;
+    if (late_ns > j->late_max_ns) j->late_max_ns = late_ns;
+    j->overruns += overruns;
+    j->n++;
 }
 
-// DPLL_Ctrl.DPLL_FOD_FREQ is M/N (Hz). N==0 encodes 1.
-static int read_dpll_fod_freq_hz(const cm_bus_t *bus, unsigned dpll_idx, double *out_hz, uint64_t *M_out, uint16_t *N_out)
+static void jitter_print(const char *label, const disc_jitter_t *j)
 {
-    uint8_t bufM[6] = {0};
-    uint8_t bufN[2] = {0};
-
-    int rc = cm_string_read_bytes(bus, "DPLL_Ctrl", dpll_idx, "FOD_FREQ_M_7_0", bufM, sizeof(bufM));
-    if (rc) return rc;
-    rc = cm_string_read_bytes(bus, "DPLL_Ctrl", dpll_idx, "FOD_FREQ_N_7_0", bufN, sizeof(bufN));
-    if (rc) return rc;
-
-    uint64_t M = 0;
-    M |= (uint64_t)bufM[0] << 0;
-    M |= (uint64_t)bufM[1] << 8;
-    M |= (uint64_t)bufM[2] << 16;
-    M |= (uint64_t)bufM[3] << 24;
-    M |= (uint64_t)bufM[4] << 32;
-    M |= (uint64_t)bufM[5] << 40;
-
-    uint16_t N = (uint16_t)((uint16_t)bufN[0] | ((uint16_t)bufN[1] << 8));
-    if (N == 0) N = 1;
-
-    if (M_out) *M_out = M;
-    if (N_out) *N_out = N;
-
-    *out_hz = (double)M / (double)N;
-    return 0;
+    const double n = (double)j->n;
+    const double mean = j->n ? j->sum_ns / n : 0.0;
+    const double rms = j->n ? sqrt(j->sumsq_ns / n) : 0.0;
+
+    fprintf(stdout,
+            "jitter[%s]: periods=%llu err_us min=%+.3f max=%+.3f mean=%+.3f rms=%.3f "
+            "late_max_us=%.3f overruns=%llu\n",
+            label, (unsigned long long)j->n,
+            j->n ? (double)j->min_ns * 1e-3 : 0.0,
+            j->n ? (double)j->max_ns * 1e-3 : 0.0,
+            mean * 1e-3, rms * 1e-3,
+            (double)j->late_max_ns * 1e-3,
+            (unsigned long long)j->overruns);
+    fflush(stdout);
 }
 
-static int read_output_div_u32(const cm_bus_t *bus, unsigned out_idx, uint32_t *out_div)
+static int disc_clock_init(disc_clock_t *dc, double interval_sec, double report_sec)
 {
-    uint8_t b[4] = {0};
-    int rc = cm_string_read_bytes(bus, "Output", out_idx, "OUT_DIV", b, sizeof(b));
-    if (rc) return rc;
-    uint32_t v = 0;
-    v |= (uint32_t)b[0] << 0;
-    v |= (uint32_t)b[1] << 8;
-    v |= (uint32_t)b[2] << 16;
-    v |= (uint32_t)b[3] << 24;
-    *out_div = v;
+    memset(dc, 0, sizeof(*dc));
+    dc->period_ns = (uint64_t)llround(interval_sec * 1e9);
+    dc->report_ns = (report_sec > 0.0) ? (uint64_t)llround(report_sec * 1e9) : 0;
+    dc->last_periods = 1;
+
+    dc->fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (dc->fd < 0) return -1;
+
+    const uint64_t now = now_monotonic_ns();
+    dc->deadline_ns = now + dc->period_ns;
+    dc->next_report_ns = now + dc->report_ns;
+
+    struct itimerspec its;
+    its.it_value.tv_sec = (time_t)(dc->deadline_ns / 1000000000ull);
+    its.it_value.tv_nsec = (long)(dc->deadline_ns % 1000000000ull);
+    its.it_interval.tv_sec = (time_t)(dc->period_ns / 1000000000ull);
+    its.it_interval.tv_nsec = (long)(dc->period_ns % 1000000000ull);
+    if (timerfd_settime(dc->fd, TFD_TIMER_ABSTIME, &its, NULL) != 0) {
+        close(dc->fd);
+        dc->fd = -1;
+        return -1;
+    }
     return 0;
 }
 
-static int read_output_phase_adj_s32(const cm_bus_t *bus, unsigned out_idx, int32_t *out_adj)
+static void disc_clock_close(disc_clock_t *dc)
 {
-    uint8_t b[4] = {0};
-    int rc = cm_string_read_bytes(bus, "Output", out_idx, "OUT_PHASE_ADJ_7_0", b, sizeof(b));
-    if (rc) return rc;
-    uint32_t u = 0;
-    u |= (uint32_t)b[0] << 0;
-    u |= (uint32_t)b[1] << 8;
-    u |= (uint32_t)b[2] << 16;
-    u |= (uint32_t)b[3] << 24;
-    *out_adj = (int32_t)u;
-    return 0;
+    if (dc->fd >= 0) close(dc->fd);
+    dc->fd = -1;
 }
 
-static int write_output_phase_adj_s32(const cm_bus_t *bus, unsigned out_idx, int32_t adj,
-                                      int trace, int dry_run)
+// Block until the next loop deadline. Returns 0, DISC_STOPPED, or -1.
+static int disc_wait(disc_clock_t *dc)
 {
-    uint8_t b[4];
-    b[0] = (uint8_t)((uint32_t)adj & 0xFF);
-    b[1] = (uint8_t)(((uint32_t)adj >> 8) & 0xFF);
-    b[2] = (uint8_t)(((uint32_t)adj >> 16) & 0xFF);
-    b[3] = (uint8_t)(((uint32_t)adj >> 24) & 0xFF);
-
-    if (trace) {
-        fprintf(stdout,
-                "WRITE: Output[%u].OUT_PHASE_ADJ <= %d (0x%08x) bytes=%02x %02x %02x %02x %s\n",
-                out_idx, adj, (uint32_t)adj, b[0], b[1], b[2], b[3],
-                dry_run ? "(dry-run)" : "");
-        fflush(stdout);
+    uint64_t exp = 0;
+    for (;;) {
+        if (g_disc_stop) return DISC_STOPPED;
+        ssize_t n = read(dc->fd, &exp, sizeof(exp));
+        if (n == (ssize_t)sizeof(exp) && exp > 0) break;
+        if (n < 0 && errno != EINTR) {
+            perror("timerfd read");
+            return -1;
+        }
     }
 
-    if (dry_run) return 0;
+    const uint64_t now = now_monotonic_ns();
+    const uint64_t last_deadline = dc->deadline_ns + (exp - 1) * dc->period_ns;
+    const uint64_t late = (now > last_deadline) ? now - last_deadline : 0;
 
-    int rc = cm_string_write_bytes(bus, "Output", out_idx, "OUT_PHASE_ADJ_7_0", b, sizeof(b));
-
-    if (trace) {
-        fprintf(stdout, "WRITE: Output[%u].OUT_PHASE_ADJ rc=%d\n", out_idx, rc);
-        fflush(stdout);
-        if (rc == 0) {
-            int32_t rb = 0;
-            int rrc = read_output_phase_adj_s32(bus, out_idx, &rb);
-            fprintf(stdout,
-                    "WRITE: Output[%u].OUT_PHASE_ADJ readback=%d (0x%08x) rrc=%d\n",
-                    out_idx, rb, (uint32_t)rb, rrc);
-            fflush(stdout);
-        }
+    if (dc->last_wake_ns) {
+        const int64_t err = (int64_t)(now - dc->last_wake_ns) - (int64_t)(exp * dc->period_ns);
+        jitter_add(&dc->win, err, late, exp - 1);
+        jitter_add(&dc->total, err, late, exp - 1);
     }
+    dc->last_wake_ns = now;
+    dc->deadline_ns += exp * dc->period_ns;
+    dc->last_periods = (unsigned)exp;
+
+    if (dc->report_ns && now >= dc->next_report_ns) {
+        jitter_print("window", &dc->win);
+        memset(&dc->win, 0, sizeof(dc->win));
+        dc->next_report_ns = now + dc->report_ns;
+    }
+    return g_disc_stop ? DISC_STOPPED : 0;
+}
 
-    return rc;
+// A sample was read but not used: its period belongs to the next used one.
+static void disc_drop_sample(disc_clock_t *dc)
+{
+    dc->pending_periods += dc->last_periods;
 }
 
-static int write_dpll_wr_freq_s42(const cm_bus_t *bus, unsigned dpll_idx, int64_t word_s42,
-                                   int trace, int dry_run)
+// Periods since the previous used sample, dropped samples included. Call once
+// per used sample.
+static unsigned disc_take_periods(disc_clock_t *dc)
 {
-    // DPLL_WR_FREQ is a signed 42-bit FFO word in units of 2^(-53).
-    // Stored as 6 bytes little-endian; device uses low 42 bits.
-    uint64_t u = (uint64_t)word_s42 & ((1ULL << 42) - 1ULL);
-
-    uint8_t b[6];
-    b[0] = (uint8_t)(u & 0xFF);
-    b[1] = (uint8_t)((u >> 8) & 0xFF);
-    b[2] = (uint8_t)((u >> 16) & 0xFF);
-    b[3] = (uint8_t)((u >> 24) & 0xFF);
-    b[4] = (uint8_t)((u >> 32) & 0xFF);
-    b[5] = (uint8_t)((u >> 40) & 0xFF);
-
-    // For human readability: convert to fractional frequency and ppb.
-    const double cmd_frac = ldexp((double)word_s42, -53);
-    const double cmd_ppb = cmd_frac * 1e9;
+    const unsigned n = dc->pending_periods + dc->last_periods;
+    dc->pending_periods = 0;
+    return n;
+}
 
-    if (trace) {
-        fprintf(stdout,
-                "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ <= word_s42=%lld cmd=%.6f ppb bytes=%02x %02x %02x %02x %02x %02x %s\n",
-                dpll_idx, (long long)word_s42, cmd_ppb,
-                b[0], b[1], b[2], b[3], b[4], b[5],
-                dry_run ? "(dry-run)" : "");
-        fflush(stdout);
+// Optional real-time setup: lock memory first so the RT loop never page-faults.
+static int disc_setup_rt(int rt_prio, int do_mlock)
+{
+    if (do_mlock && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        perror("mlockall");
+        return -1;
     }
-
-    if (dry_run) return 0;
-
-    int rc = cm_string_write_bytes(bus, "DPLL_Freq_Write", dpll_idx, "DPLL_WR_FREQ_7_0", b, sizeof(b));
-
-    if (trace) {
-        fprintf(stdout, "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ rc=%d\n", dpll_idx, rc);
-        fflush(stdout);
-
-        if (rc == 0) {
-            uint8_t rb[6] = {0};
-            int rrc = cm_string_read_bytes(bus, "DPLL_Freq_Write", dpll_idx, "DPLL_WR_FREQ_7_0", rb, sizeof(rb));
-            uint64_t ru = 0;
-            for (int i = 0; i < 6; i++) ru |= ((uint64_t)rb[i]) << (8 * i);
-            ru &= ((1ULL << 42) - 1ULL);
-
-            int64_t rs = (int64_t)ru;
-            if (ru & (1ULL << 41)) rs |= ~((int64_t)((1ULL << 42) - 1ULL)); // sign extend
-            double rfrac = ldexp((double)rs, -53);
-            double rppb = rfrac * 1e9;
-
-            fprintf(stdout,
-                    "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ readback word_s42=%lld cmd=%.6f ppb bytes=%02x %02x %02x %02x %02x %02x rrc=%d\n",
-                    dpll_idx, (long long)rs, rppb,
-                    rb[0], rb[1], rb[2], rb[3], rb[4], rb[5], rrc);
-            fflush(stdout);
+    if (rt_prio > 0) {
+        const int lo = sched_get_priority_min(SCHED_FIFO);
+        const int hi = sched_get_priority_max(SCHED_FIFO);
+        if (rt_prio < lo || rt_prio > hi) {
+            fprintf(stderr, "--rt-prio must be %d..%d\n", lo, hi);
+            return -1;
+        }
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = rt_prio;
+        if (sched_setscheduler(0, SCHED_FIFO, &sp) != 0) {
+            perror("sched_setscheduler(SCHED_FIFO)");
+            return -1;
         }
     }
-
-    return rc;
+    return 0;
 }
 
 // ---------------------------- Discipline logic -----------------------------
@@ -363,6 +287,11 @@ typedef enum {
     ST_S2_SLEW    = 2,
 } discipline_state_t;
 
+typedef enum {
+    DISC_SERVO_PI     = 0,
+    DISC_SERVO_KALMAN = 1,
+} discipline_servo_t;
+
 typedef struct {
     // Measurement DPLL (phase measurement mode)
     unsigned meas_dpll;
@@ -370,6 +299,7 @@ typedef struct {
     // Slew target DPLLs (write-frequency mode)
     unsigned wr_dplls[8];
     size_t   wr_dplls_n;
+    unsigned wr_mask;      // bit n = DPLL n, from wr_dplls
 
     // Step outputs (Q9/Q10/Q11 => out_idx 9/10/11)
     unsigned step_outs[16];
@@ -377,6 +307,9 @@ typedef struct {
 
     // Servo timing
     double interval_sec;   // loop period
+    double jitter_report_sec; // print loop-period jitter this often (<=0: on exit only)
+    int    rt_prio;        // SCHED_FIFO priority (0 = leave the scheduler alone)
+    int    mlock;          // mlockall(MCL_CURRENT | MCL_FUTURE)
 
     // S0
     double s0_window_sec;  // how long to average before choosing state
@@ -394,6 +327,11 @@ typedef struct {
     double max_abs_ppb;   // clamp (<=0 disables)
     double s2_fallback_abs_sec; // if |phase| > this, go back to S1
 
+    // Servo selection; Kalman filter settings (--servo kalman)
+    discipline_servo_t servo;
+    cm_kf_cfg_t kf;
+    double kf_tc_sec;     // phase correction time constant
+
     // Measurement conditioning
     double max_abs_phase_sec;  // ignore samples with |phase| above this (<=0 disables)
 
@@ -447,7 +385,7 @@ static void sanity_print_dpll_fod(const cm_bus_t *bus, const discipline_cfg_t *c
     double hz = 0.0;
     uint64_t M = 0;
     uint16_t N = 0;
-    int rc = read_dpll_fod_freq_hz(bus, dpll_idx, &hz, &M, &N);
+    int rc = cm_read_dpll_fod_freq_hz(bus, dpll_idx, &hz, &M, &N);
     if (rc) {
         fprintf(stderr, "Sanity: failed to read DPLL%u FOD freq (rc=%d)\n", dpll_idx, rc);
         return;
@@ -468,12 +406,12 @@ static void sanity_print_outputs(const cm_bus_t *bus, const discipline_cfg_t *cf
         double fod_hz = 0.0;
         uint64_t M = 0;
         uint16_t N = 0;
-        int rc_f = read_dpll_fod_freq_hz(bus, fod_dpll, &fod_hz, &M, &N);
+        int rc_f = cm_read_dpll_fod_freq_hz(bus, fod_dpll, &fod_hz, &M, &N);
 
         uint32_t out_div = 0;
         int32_t out_adj = 0;
-        int rc_d = read_output_div_u32(bus, out_idx, &out_div);
-        int rc_a = read_output_phase_adj_s32(bus, out_idx, &out_adj);
+        int rc_d = cm_read_output_div_u32(bus, out_idx, &out_div);
+        int rc_a = cm_read_output_phase_adj_s32(bus, out_idx, &out_adj);
 
         double out_hz = 0.0;
         if (rc_f == 0 && rc_d == 0 && out_div != 0) out_hz = fod_hz / (double)out_div;
@@ -505,7 +443,6 @@ static void sanity_print_phase_once(const cm_bus_t *bus, const discipline_cfg_t
         return;
     }
     fprintf(stdout, "Sanity: phase_raw=%.9e sec phase_wrapped=%.9e sec (meas_dpll=%u)\n",
-            
             p_raw, p, cfg->meas_dpll);
     fflush(stdout);
 }
@@ -516,10 +453,10 @@ static void sanity_print_phase_once(const cm_bus_t *bus, const discipline_cfg_t
 static int read_phase_sec(const cm_bus_t *bus, const discipline_cfg_t *cfg, double *phase_raw, double *phase_wrapped)
 {
     int64_t s36 = 0;
-    int rc = read_phase_status_s36(bus, cfg->meas_dpll, &s36);
+    int rc = cm_read_phase_status_s36(bus, cfg->meas_dpll, &s36);
     if (rc) return rc;
 
-    double p = phase_s36_to_seconds(s36);
+    double p = cm_phase_s36_to_seconds(s36);
     if (cfg->invert) p = -p;
 
     *phase_raw = p;
@@ -527,7 +464,8 @@ static int read_phase_sec(const cm_bus_t *bus, const discipline_cfg_t *cfg, doub
     return 0;
 }
 
-static int do_s0_measure(const cm_bus_t *bus, const discipline_cfg_t *cfg, double *out_avg_phase)
+static int do_s0_measure(const cm_bus_t *bus, const discipline_cfg_t *cfg, disc_clock_t *dc,
+                         double *out_avg_phase)
 {
     const double t_start = now_monotonic_sec();
     double sum = 0.0;
@@ -554,7 +492,7 @@ static int do_s0_measure(const cm_bus_t *bus, const discipline_cfg_t *cfg, doubl
             sumw += 1.0;
             n++;
         }
-        sleep_sec(cfg->interval_sec);
+        if ((rc = disc_wait(dc)) != 0) return rc;
     }
 
     const double avg = (sumw > 0.0) ? (sum / sumw) : 0.0;
@@ -566,15 +504,14 @@ static int do_s0_measure(const cm_bus_t *bus, const discipline_cfg_t *cfg, doubl
     return 0;
 }
 
-// Apply a phase step to outputs by updating OUT_PHASE_ADJ for each output.
-// Returns 0 on success.
-
 // Apply a phase step to outputs by updating OUT_PHASE_ADJ for each output.
 // OUT_PHASE_ADJ units are *FOD cycles* for the corresponding output clock tree.
 // On this board:
 //   - Q9 uses FOD from DPLL5
 //   - Q10/Q11 use FOD from DPLL6
-static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, double phase_sec)
+// Returns 0 on success, after waiting one loop period for the step to settle.
+static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, disc_clock_t *dc,
+                      double phase_sec)
 {
     // Negative feedback: step opposite the measured phase (wrapped in [-0.5,0.5)).
     double step_sec = -phase_sec;
@@ -596,7 +533,7 @@ static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, double p
         uint64_t M = 0;
         uint16_t N = 0;
         double fod_hz = 0.0;
-        int rc = read_dpll_fod_freq_hz(bus, fod_dpll, &fod_hz, &M, &N);
+        int rc = cm_read_dpll_fod_freq_hz(bus, fod_dpll, &fod_hz, &M, &N);
         if (rc || fod_hz <= 0.0) {
             fprintf(stderr, "S1: failed to read FOD freq for OUT%u (uses DPLL%u) rc=%d fod_hz=%.6f\n", out_idx, fod_dpll, rc, fod_hz);
             return (rc != 0) ? rc : -1;
@@ -610,8 +547,8 @@ static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, double p
 
         uint32_t out_div = 0;
         int32_t old_adj = 0;
-        int rc1 = read_output_div_u32(bus, out_idx, &out_div);
-        int rc2 = read_output_phase_adj_s32(bus, out_idx, &old_adj);
+        int rc1 = cm_read_output_div_u32(bus, out_idx, &out_div);
+        int rc2 = cm_read_output_phase_adj_s32(bus, out_idx, &old_adj);
         if (rc1 || rc2) {
             fprintf(stderr, "S1: failed to read output %u (div rc=%d, adj rc=%d)\n", out_idx, rc1, rc2);
             return -1;
@@ -632,7 +569,7 @@ static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, double p
         }
 
         {
-            int wrc = write_output_phase_adj_s32(bus, out_idx, new_adj, want_print(cfg), cfg->dry_run);
+            int wrc = cm_write_output_phase_adj_s32(bus, out_idx, new_adj, want_print(cfg), cfg->dry_run);
             if (wrc) {
                 fprintf(stderr, "S1: failed to write OUT%u OUT_PHASE_ADJ (rc=%d)\n", out_idx, wrc);
                 return wrc;
@@ -640,13 +577,45 @@ static int do_s1_step(const cm_bus_t *bus, const discipline_cfg_t *cfg, double p
         }
     }
 
-    // Give it a moment to settle.
-    sleep_sec(0.2);
-    return 0;
+    // Give it a moment to settle: the next measurement is taken on the next deadline.
+    return disc_wait(dc);
 }
 
+// Write the same WR_FREQ word to every --wr-dplls DPLL in one coordinated
+// commit. When printing, the words are read back (one burst) and checked.
+static int write_wr_freq_all(const discipline_cfg_t *cfg, int64_t word, const char *tag)
+{
+    const int trace = want_print(cfg);
+    if (trace) {
+        fprintf(stdout, "WRITE: DPLL_Freq_Write[mask=0x%02x].DPLL_WR_FREQ <= word_s42=%lld cmd=%.6f ppb %s\n",
+                cfg->wr_mask, (long long)word, ldexp((double)word, -CM_WR_FREQ_FRAC_BITS) * 1e9,
+                cfg->dry_run ? "(dry-run)" : "");
+        fflush(stdout);
+    }
+    if (cfg->dry_run) return 0;
+
+    int64_t words[CM_STEER_MAX_DPLLS];
+    for (unsigned ch = 0; ch < CM_STEER_MAX_DPLLS; ch++) words[ch] = word;
+
+    cm_steer_result_t res;
+    int rc = cm_steer_commit(&g_steer, cfg->wr_mask, words, trace ? CM_STEER_VERIFY : 0, &res);
+    if (trace) {
+        fprintf(stdout, "WRITE: DPLL_WR_FREQ rc=%d bursts=%u skew=%.1f us%s\n",
+                rc, res.bursts, (double)res.skew_ns * 1e-3,
+                rc == -2 ? " readback MISMATCH" : "");
+        fflush(stdout);
+    }
+    // The readback is diagnostic (as the per-DPLL trace readback was): report
+    // a mismatch, keep steering.
+    if (rc == -2) {
+        fprintf(stderr, "%s: WR_FREQ readback mismatch on mask 0x%02x\n", tag, res.mismatch_mask);
+        rc = 0;
+    }
+    if (rc) fprintf(stderr, "%s: write WR_FREQ (mask=0x%02x) failed (rc=%d)\n", tag, cfg->wr_mask, rc);
+    return rc;
+}
 
-static int do_s2_slew(const cm_bus_t *bus, const discipline_cfg_t *cfg,
+static int do_s2_slew(const discipline_cfg_t *cfg,
                      double *integ_io, double phase_sec, double dt_sec,
                      double *cmd_ppb_out, int64_t *word_out)
 {
@@ -670,17 +639,7 @@ static int do_s2_slew(const cm_bus_t *bus, const discipline_cfg_t *cfg,
     word = clamp_s42(word);
 
     // Write to all requested DPLLs.
-    int rc = 0;
-    {
-        for (size_t i = 0; i < cfg->wr_dplls_n; i++) {
-            int wrc = write_dpll_wr_freq_s42(bus, cfg->wr_dplls[i], word, want_print(cfg), cfg->dry_run);
-            if (wrc) {
-                fprintf(stderr, "S2: write DPLL%u WR_FREQ failed (rc=%d)\n", cfg->wr_dplls[i], wrc);
-                rc = wrc;
-                break;
-            }
-        }
-    }
+    int rc = write_wr_freq_all(cfg, word, "S2");
 
     *integ_io = integ;
     if (cmd_ppb_out) *cmd_ppb_out = cmd_frac * 1e9;
@@ -688,7 +647,103 @@ static int do_s2_slew(const cm_bus_t *bus, const discipline_cfg_t *cfg,
     return rc;
 }
 
-static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
+// Prior on the Kalman frequency state: anything the clamp allows.
+static double kf_freq_var(const discipline_cfg_t *cfg)
+{
+    const double sig = (cfg->max_abs_ppb > 0.0) ? cfg->max_abs_ppb * 1e-9 : 1e-6;
+    return sig * sig;
+}
+
+// S0 with the Kalman servo: filter until the phase estimate is well inside
+// s1_exit (at least one sample per state), capped by s0_window_sec. *u_io is
+// set to the WR_FREQ command currently in effect on the first target DPLL.
+static int do_s0_kalman(const cm_bus_t *bus, const discipline_cfg_t *cfg, disc_clock_t *dc,
+                        cm_kf_t *kf, double *u_io, double *out_phase)
+{
+    int64_t w = 0;
+    *u_io = (cm_read_dpll_wr_freq_s42(bus, cfg->wr_dplls[0], &w, 0) == 0)
+                ? ldexp((double)w, -CM_WR_FREQ_FRAC_BITS) : 0.0;
+    cm_kf_reset(kf, *u_io, kf_freq_var(cfg));
+
+    const double t_start = now_monotonic_sec();
+    unsigned n = 0;
+    int done = 0;
+
+    while (!done) {
+        double p_raw = 0.0, p = 0.0;
+        int rc = read_phase_sec(bus, cfg, &p_raw, &p);
+        if (rc) return rc;
+
+        const int drop = (cfg->max_abs_phase_sec > 0.0 && fabs(p) > cfg->max_abs_phase_sec);
+        if (!drop) {
+            cm_kf_predict(kf, cfg->interval_sec * disc_take_periods(dc), *u_io);
+            cm_kf_update(kf, p);
+            n++;
+        } else {
+            disc_drop_sample(dc);
+        }
+        const double sig = sqrt(kf->P[0][0]);
+        if (want_print(cfg)) {
+            fprintf(stdout, "S0: t=%.3f raw=%.9e sec wrap=%.9e sec %s est=%.9e sigma=%.3e\n",
+                    now_monotonic_sec() - t_start, p_raw, p, drop ? "DROP" : "KEEP",
+                    kf->x[0], sig);
+            fflush(stdout);
+        }
+
+        done = (n > kf->cfg.nstates && sig < 0.25 * cfg->s1_exit_abs_sec) ||
+               (now_monotonic_sec() - t_start) >= cfg->s0_window_sec;
+        if ((rc = disc_wait(dc)) != 0) return rc;
+    }
+
+    if (want_print(cfg)) {
+        fprintf(stdout, "S0: samples=%u est_phase=%.9e sec est_freq=%.3f ppb\n",
+                n, kf->x[0], (kf->x[1] - *u_io) * 1e9);
+        fflush(stdout);
+    }
+    *out_phase = kf->x[0];
+    return 0;
+}
+
+// S2 with the Kalman servo: fold in the sample, then command the estimated
+// frequency (plus half an interval of drift) and remove the estimated phase
+// over kf_tc_sec. The filter is told what was actually written (after the
+// clamp and s42 rounding).
+static int do_s2_kalman(const discipline_cfg_t *cfg, cm_kf_t *kf,
+                        double *u_io, double phase_sec, double dt_sec, double t_rel)
+{
+    cm_kf_predict(kf, dt_sec, *u_io);
+    const int rejected = cm_kf_update(kf, phase_sec);
+
+    const double tc = (cfg->kf_tc_sec > cfg->interval_sec) ? cfg->kf_tc_sec : cfg->interval_sec;
+    double cmd_frac = kf->x[1] + 0.5 * kf->x[2] * cfg->interval_sec + kf->x[0] / tc;
+    if (cfg->max_abs_ppb > 0.0) {
+        const double max_frac = cfg->max_abs_ppb * 1e-9;
+        cmd_frac = clamp_d(cmd_frac, -max_frac, +max_frac);
+    }
+
+    int64_t word = (int64_t)llround(ldexp(cmd_frac, CM_WR_FREQ_FRAC_BITS));
+    word = clamp_s42(word);
+
+    int rc = write_wr_freq_all(cfg, word, "S2");
+    if (rc) return rc;
+    *u_io = ldexp((double)word, -CM_WR_FREQ_FRAC_BITS);
+
+    if (want_print(cfg)) {
+        fprintf(stdout,
+                "t=%.3f S2 phase=%.9e est=%.9e sigma=%.3e freq=%.3fppb drift=%.3eppb/s "
+                "meas_noise=%.3fns%s cmd=%.3fppb word_s42=%lld%s\n",
+                t_rel, phase_sec, kf->x[0], sqrt(kf->P[0][0]),
+                kf->x[1] * 1e9, kf->x[2] * 1e9, sqrt(kf->r) * 1e9,
+                rejected ? " (outlier)" : "",
+                *u_io * 1e9, (long long)word,
+                cfg->dry_run ? " (dry)" : "");
+        fflush(stdout);
+    }
+    return 0;
+}
+
+// Runs until SIGINT/SIGTERM (returns 0) or a bus/timer error (non-zero).
+static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg, disc_clock_t *dc)
 {
     discipline_state_t st = ST_S0_MEASURE;
     double integ = 0.0;
@@ -698,12 +753,21 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
     int have_prev = 0;
 
     unsigned s1_iter = 0;
+    int rc = 0;
 
-    while (1) {
+    // Kalman servo state; u_applied is the WR_FREQ command in effect.
+    cm_kf_t kf;
+    double u_applied = 0.0;
+    if (cfg->servo == DISC_SERVO_KALMAN && cm_kf_init(&kf, &cfg->kf) != 0) return -1;
+
+    while (rc == 0) {
         if (st == ST_S0_MEASURE) {
             double avg_phase = 0.0;
-            int rc = do_s0_measure(bus, cfg, &avg_phase);
-            if (rc) return rc;
+            if (cfg->servo == DISC_SERVO_KALMAN)
+                rc = do_s0_kalman(bus, cfg, dc, &kf, &u_applied, &avg_phase);
+            else
+                rc = do_s0_measure(bus, cfg, dc, &avg_phase);
+            if (rc) break;
 
             if (fabs(avg_phase) > cfg->s1_enter_abs_sec) {
                 if (want_print(cfg)) {
@@ -725,10 +789,10 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
         }
 
         double p_raw = 0.0, p = 0.0;
-        int rc = read_phase_sec(bus, cfg, &p_raw, &p);
+        rc = read_phase_sec(bus, cfg, &p_raw, &p);
         if (rc) {
             fprintf(stderr, "read phase failed (rc=%d)\n", rc);
-            return rc;
+            break;
         }
 
         const double t_now = now_monotonic_sec();
@@ -737,15 +801,20 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
         // Drop outliers if requested
         if (cfg->max_abs_phase_sec > 0.0 && fabs(p) > cfg->max_abs_phase_sec) {
             dbg(cfg, "drop sample |phase|=%.3f sec (>max_abs_phase_sec)\n", fabs(p));
-            sleep_sec(cfg->interval_sec);
+            disc_drop_sample(dc);
+            rc = disc_wait(dc);
             continue;
         }
 
+        // Time since the previous used sample: whole periods, overruns and
+        // dropped samples included.
+        const double dt_sec = cfg->interval_sec * disc_take_periods(dc);
+
         if (st == ST_S1_STEP) {
             // Coarse alignment: keep stepping until we're within exit threshold.
 
-            int rc1 = do_s1_step(bus, cfg, p);
-            if (rc1) return rc1;
+            rc = do_s1_step(bus, cfg, dc, p);
+            if (rc) break;
 
             // Verify
             double p_ver = 0.0;
@@ -753,33 +822,31 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
             int have_prev_pw = 0;
             double drift_sum_ppb = 0.0;
             unsigned drift_n = 0;
-            for (unsigned k = 0; k < cfg->s1_verify_samples; k++) {
+            for (unsigned k = 0; k < cfg->s1_verify_samples && rc == 0; k++) {
                 double pr = 0.0, pw = 0.0;
-                int rcv = read_phase_sec(bus, cfg, &pr, &pw);
-                if (rcv) return rcv;
+                rc = read_phase_sec(bus, cfg, &pr, &pw);
+                if (rc) break;
                 p_ver = pw;
 
-                if (want_print(cfg)) {
-                    if (have_prev_pw) {
-                        const double dphi = wrap_phase_sec(pw - prev_pw);
-                        const double drift_ppb = (cfg->interval_sec > 0.0) ? (dphi / cfg->interval_sec) * 1e9 : 0.0;
-                        fprintf(stdout, "S1: verify[%u] phase=%.9e sec  dphi=%.9e sec  drift=%.3f ppb\n", k, pw, dphi, drift_ppb);
-                    } else {
-                        fprintf(stdout, "S1: verify[%u] phase=%.9e sec\n", k, pw);
-                    }
-                    fflush(stdout);
-                }
-
                 if (have_prev_pw) {
+                    const double dt = cfg->interval_sec * dc->last_periods;
                     const double dphi = wrap_phase_sec(pw - prev_pw);
-                    const double drift_ppb = (cfg->interval_sec > 0.0) ? (dphi / cfg->interval_sec) * 1e9 : 0.0;
+                    const double drift_ppb = (dphi / dt) * 1e9;
                     drift_sum_ppb += drift_ppb;
                     drift_n++;
+                    if (want_print(cfg)) {
+                        fprintf(stdout, "S1: verify[%u] phase=%.9e sec  dphi=%.9e sec  drift=%.3f ppb\n", k, pw, dphi, drift_ppb);
+                        fflush(stdout);
+                    }
+                } else if (want_print(cfg)) {
+                    fprintf(stdout, "S1: verify[%u] phase=%.9e sec\n", k, pw);
+                    fflush(stdout);
                 }
                 prev_pw = pw;
                 have_prev_pw = 1;
-                sleep_sec(cfg->interval_sec);
+                rc = disc_wait(dc);
             }
+            if (rc) break;
 
             const double s1_avg_drift_ppb = (drift_n > 0) ? (drift_sum_ppb / (double)drift_n) : 0.0;
 
@@ -794,8 +861,8 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
                 }
 
                 // Final small phase correction (same stepping mechanism as S1).
-                int rcf = do_s1_step(bus, cfg, p_ver);
-                if (rcf) return rcf;
+                rc = do_s1_step(bus, cfg, dc, p_ver);
+                if (rc) break;
 
                 // One-shot frequency initialization based on measured drift during S1 verify.
                 // Sign convention matches do_s2_slew(): positive phase drift implies output is too slow -> increase frequency.
@@ -815,26 +882,18 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
                     fflush(stdout);
                 }
 
-                for (size_t i = 0; i < cfg->wr_dplls_n; i++) {
-                    int wrc = write_dpll_wr_freq_s42(bus, cfg->wr_dplls[i], word0, want_print(cfg), cfg->dry_run);
-                    if (wrc) {
-                        fprintf(stderr, "S1->S2: write DPLL%u WR_FREQ failed (rc=%d)\n", cfg->wr_dplls[i], wrc);
-                        return wrc;
-                    }
-                }
+                if ((rc = write_wr_freq_all(cfg, word0, "S1->S2")) != 0) break;
 
                 // Optional sign sanity-check: after applying initial WR_FREQ, measure the resulting phase slope.
                 // If the slope magnitude gets worse, flip the sign once.
-                if (!cfg->dry_run && cfg->debug && cfg->interval_sec > 0.0 && drift_n >= 2) {
+                if (!cfg->dry_run && cfg->debug && drift_n >= 2) {
                     double p0_raw = 0.0, p0 = 0.0, p1_raw = 0.0, p1 = 0.0;
-                    int rc_p0 = read_phase_sec(bus, cfg, &p0_raw, &p0);
-                    if (rc_p0) return rc_p0;
-                    sleep_sec(cfg->interval_sec);
-                    int rc_p1 = read_phase_sec(bus, cfg, &p1_raw, &p1);
-                    if (rc_p1) return rc_p1;
+                    if ((rc = read_phase_sec(bus, cfg, &p0_raw, &p0)) != 0) break;
+                    if ((rc = disc_wait(dc)) != 0) break;
+                    if ((rc = read_phase_sec(bus, cfg, &p1_raw, &p1)) != 0) break;
 
                     const double dphi_chk = wrap_phase_sec(p1 - p0);
-                    const double drift_chk_ppb = (dphi_chk / cfg->interval_sec) * 1e9;
+                    const double drift_chk_ppb = (dphi_chk / (cfg->interval_sec * dc->last_periods)) * 1e9;
 
                     dbg(cfg, "S1->S2: post-WR_FREQ drift check: p0=%.9e p1=%.9e dphi=%.9e drift=%.3f ppb (pre avg drift=%.3f)\n",
                         p0, p1, dphi_chk, drift_chk_ppb, s1_avg_drift_ppb);
@@ -850,13 +909,7 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
                                 cmd_ppb0, word0, (uint64_t)word0);
                         fflush(stdout);
 
-                        for (size_t i = 0; i < cfg->wr_dplls_n; i++) {
-                            int wrc = write_dpll_wr_freq_s42(bus, cfg->wr_dplls[i], word0, want_print(cfg), cfg->dry_run);
-                            if (wrc) {
-                                fprintf(stderr, "S1->S2: write DPLL%u WR_FREQ failed (rc=%d)\n", cfg->wr_dplls[i], wrc);
-                                return wrc;
-                            }
-                        }
+                        if ((rc = write_wr_freq_all(cfg, word0, "S1->S2")) != 0) break;
                     }
                 }
 
@@ -869,6 +922,13 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
                     integ = 0.0;
                 }
 
+                // The Kalman servo restarts from the phase after the step, with the
+                // initial command as its frequency prior.
+                if (cfg->servo == DISC_SERVO_KALMAN) {
+                    u_applied = ldexp((double)word0, -CM_WR_FREQ_FRAC_BITS);
+                    cm_kf_reset(&kf, u_applied, kf_freq_var(cfg));
+                }
+
                 st = ST_S2_SLEW;
                 have_prev = 0;
             }
@@ -886,19 +946,25 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
             continue;
         }
 
+        if (cfg->servo == DISC_SERVO_KALMAN) {
+            rc = do_s2_kalman(cfg, &kf, &u_applied, p, dt_sec, t_rel);
+            if (rc == 0) rc = disc_wait(dc);
+            continue;
+        }
+
         // Optional drift estimate for printing
         double drift_ppb = NAN;
         if (have_prev) {
             double dphi = wrap_phase_sec(p - phase_prev);
-            drift_ppb = (dphi / cfg->interval_sec) * 1e9;
+            drift_ppb = (dphi / dt_sec) * 1e9;
         }
         phase_prev = p;
         have_prev = 1;
 
         double cmd_ppb = 0.0;
         int64_t word = 0;
-        int rc2 = do_s2_slew(bus, cfg, &integ, p, cfg->interval_sec, &cmd_ppb, &word);
-        if (rc2) return rc2;
+        rc = do_s2_slew(cfg, &integ, p, dt_sec, &cmd_ppb, &word);
+        if (rc) break;
 
         if (want_print(cfg)) {
             char drift_str[64];
@@ -920,8 +986,18 @@ static int discipline_run(const cm_bus_t *bus, const discipline_cfg_t *cfg)
             fflush(stdout);
         }
 
-        sleep_sec(cfg->interval_sec);
+        rc = disc_wait(dc);
     }
+
+    if (cfg->servo == DISC_SERVO_KALMAN) {
+        fprintf(stdout, "kalman: updates=%llu rejected=%llu meas_noise=%.3fns\n",
+                (unsigned long long)kf.updates, (unsigned long long)kf.rejected,
+                sqrt(kf.r) * 1e9);
+        fflush(stdout);
+    }
+
+    (void)s1_iter;
+    return (rc == DISC_STOPPED) ? 0 : rc;
 }
 
 // ----------------------------- CLI -----------------------------------------
@@ -945,13 +1021,17 @@ static void usage(const char *argv0)
         "  --dry-run               don't write registers\n"
         "  --print                 print each adjustment\n"
         "  --debug                 extra debug prints\n\n"
+        "Loop timing:\n"
+        "  --rt-prio <n>           run under SCHED_FIFO at priority n (default: normal scheduling)\n"
+        "  --mlock                 lock all current and future memory (mlockall)\n"
+        "  --jitter-report <sec>   print loop-period jitter this often (default 60; 0 = on exit only)\n\n"
         "S0 (measure):\n"
         "  --s0-window <sec>       averaging window (default 5.0)\n\n"
         "S1 (step):\n"
         "  --step-outs <list>       outputs to phase-step, e.g. 9,10,11 (default 9,10,11)\n"
         "  --s1-enter <sec>         if |phase| > enter -> step (default 0.05)\n"
         "  --s1-exit <sec>          if |phase| <= exit -> go to S2 (default 0.002)\n"
-        "  --s1-max-step <sec>      max absolute phase correction per step (default 0.2)\n"
+        "  --s1-max-step <sec>      max absolute phase correction per step (default 0.05)\n"
         "  --s1-max-iters <n>       max step iterations (default 0; 0 = unlimited)\n"
         "  --s1-verify <n>          verify samples after a step (default 3)\n\n"
         "S2 (slew):\n"
@@ -959,7 +1039,17 @@ static void usage(const char *argv0)
         "  --ki <1/s^2>             integral gain on phase (default 0.0)\n"
         "  --max-ppb <ppb>          clamp frequency command (default 1000)\n"
         "  --s2-fallback <sec>      if |phase| exceeds this, go back to S1 (default 0.25)\n"
-        "  --max-phase <sec>        drop samples with |phase| > max (default 0.5)\n\n",
+        "  --max-phase <sec>        drop samples with |phase| > max (default 0.5)\n\n"
+        "Servo:\n"
+        "  --servo <pi|kalman>      S0/S2 servo (default pi)\n"
+        "  --kf-states <2|3>        phase+freq, or phase+freq+drift (default 3)\n"
+        "  --kf-tc <sec>            phase correction time constant (default 16)\n"
+        "  --kf-r <sec>             initial 1PPS noise rms (default 20e-9)\n"
+        "  --kf-adapt <n>           follow the measurement noise over ~n samples (default 32; 0 = fixed)\n"
+        "  --kf-gate <sigma>        reject innovations beyond sigma (default 5; 0 = off)\n"
+        "  --kf-q-phase <s^2/s>     white FM process noise (default 1e-20)\n"
+        "  --kf-q-freq <1/s>        random-walk FM process noise (default 1e-22)\n"
+        "  --kf-q-drift <1/s^3>     random-walk drift process noise (default 1e-30)\n\n",
         argv0);
 }
 
@@ -977,6 +1067,7 @@ int main(int argc, char **argv)
 
     cfg.meas_dpll = 5;
     cfg.interval_sec = 1.0;
+    cfg.jitter_report_sec = 60.0;
     cfg.s0_window_sec = 5.0;
 
     cfg.step_outs[0] = 9;
@@ -998,6 +1089,10 @@ int main(int argc, char **argv)
 
     cfg.print_each = 1;
 
+    cfg.servo = DISC_SERVO_PI;
+    cm_kf_default_cfg(&cfg.kf);
+    cfg.kf_tc_sec = 16.0;
+
     // wr_dplls default == target-dpll default 2
     cfg.wr_dplls[0] = 2;
     cfg.wr_dplls_n = 1;
@@ -1026,7 +1121,7 @@ int main(int argc, char **argv)
             cfg.wr_dplls_n = 1;
         } else if (!strcmp(a, "--wr-dplls") && i + 1 < argc) {
             size_t n = 0;
-            if (parse_u32_list(argv[++i], cfg.wr_dplls, 8, &n) != 0) {
+            if (cm_parse_u32_list(argv[++i], cfg.wr_dplls, 8, &n) != 0) {
                 fprintf(stderr, "bad --wr-dplls list\n");
                 return 1;
             }
@@ -1042,12 +1137,19 @@ int main(int argc, char **argv)
         } else if (!strcmp(a, "--debug") || !strcmp(a, "--disc-debug")) {
             cfg.debug = 1;
 
+        } else if (!strcmp(a, "--rt-prio") && i + 1 < argc) {
+            cfg.rt_prio = atoi(argv[++i]);
+        } else if (!strcmp(a, "--mlock")) {
+            cfg.mlock = 1;
+        } else if (!strcmp(a, "--jitter-report") && i + 1 < argc) {
+            cfg.jitter_report_sec = atof(argv[++i]);
+
         } else if (!strcmp(a, "--s0-window") && i + 1 < argc) {
             cfg.s0_window_sec = atof(argv[++i]);
 
         } else if (!strcmp(a, "--step-outs") && i + 1 < argc) {
             size_t n = 0;
-            if (parse_u32_list(argv[++i], cfg.step_outs, 16, &n) != 0) {
+            if (cm_parse_u32_list(argv[++i], cfg.step_outs, 16, &n) != 0) {
                 fprintf(stderr, "bad --step-outs list\n");
                 return 1;
             }
@@ -1074,6 +1176,34 @@ int main(int argc, char **argv)
             cfg.s2_fallback_abs_sec = atof(argv[++i]);
         } else if ((!strcmp(a, "--max-phase") || !strcmp(a, "--disc-max-phase")) && i + 1 < argc) {
             cfg.max_abs_phase_sec = atof(argv[++i]);
+
+        } else if (!strcmp(a, "--servo") && i + 1 < argc) {
+            const char *v = argv[++i];
+            if (!strcmp(v, "pi")) {
+                cfg.servo = DISC_SERVO_PI;
+            } else if (!strcmp(v, "kalman") || !strcmp(v, "kf")) {
+                cfg.servo = DISC_SERVO_KALMAN;
+            } else {
+                fprintf(stderr, "bad --servo (pi|kalman)\n");
+                return 1;
+            }
+        } else if (!strcmp(a, "--kf-states") && i + 1 < argc) {
+            cfg.kf.nstates = (unsigned)strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(a, "--kf-tc") && i + 1 < argc) {
+            cfg.kf_tc_sec = atof(argv[++i]);
+        } else if (!strcmp(a, "--kf-r") && i + 1 < argc) {
+            const double r = atof(argv[++i]);
+            cfg.kf.r0 = r * r;
+        } else if (!strcmp(a, "--kf-adapt") && i + 1 < argc) {
+            cfg.kf.adapt_n = (unsigned)strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(a, "--kf-gate") && i + 1 < argc) {
+            cfg.kf.gate_sigma = atof(argv[++i]);
+        } else if (!strcmp(a, "--kf-q-phase") && i + 1 < argc) {
+            cfg.kf.q_phase = atof(argv[++i]);
+        } else if (!strcmp(a, "--kf-q-freq") && i + 1 < argc) {
+            cfg.kf.q_freq = atof(argv[++i]);
+        } else if (!strcmp(a, "--kf-q-drift") && i + 1 < argc) {
+            cfg.kf.q_drift = atof(argv[++i]);
         } else {
             fprintf(stderr, "Unknown arg: %s\n", a);
             usage(argv[0]);
@@ -1095,6 +1225,14 @@ int main(int argc, char **argv)
         cfg.wr_dplls[0] = 2;
         cfg.wr_dplls_n = 1;
     }
+    cfg.wr_mask = 0;
+    for (size_t i = 0; i < cfg.wr_dplls_n; i++) {
+        if (cfg.wr_dplls[i] >= CM_STEER_MAX_DPLLS) {
+            fprintf(stderr, "bad --wr-dplls: DPLL%u (0..%d)\n", cfg.wr_dplls[i], CM_STEER_MAX_DPLLS - 1);
+            return 1;
+        }
+        cfg.wr_mask |= 1u << cfg.wr_dplls[i];
+    }
     if (cfg.step_outs_n == 0) {
         cfg.step_outs[0] = 9;
         cfg.step_outs[1] = 10;
@@ -1102,13 +1240,23 @@ int main(int argc, char **argv)
         cfg.step_outs_n = 3;
     }
 
+    if (cfg.servo == DISC_SERVO_KALMAN) {
+        cm_kf_t kf_check;
+        if (cm_kf_init(&kf_check, &cfg.kf) != 0) {
+            fprintf(stderr, "bad Kalman settings (--kf-states 2|3, --kf-r > 0, noise >= 0)\n");
+            return 1;
+        }
+    }
+
     // Open SPI
     int fd = dpll_spi_open(spidev, spi_hz, spi_mode);
     if (fd < 0) {
         perror("dpll_spi_open");
         return 1;
     }
-    cm_init_bus_for_spi(fd);
+    cm_bus_t bus;
+    int bus_fd = -1;
+    cm_bus_init_spi(&bus, &bus_fd, fd);
 
     if (want_print(&cfg)) {
         fprintf(stdout,
@@ -1121,18 +1269,52 @@ int main(int argc, char **argv)
         for (size_t i = 0; i < cfg.step_outs_n; i++) {
             fprintf(stdout, "%u%s", cfg.step_outs[i], (i + 1 < cfg.step_outs_n) ? "," : "");
         }
-        fprintf(stdout, " interval=%.3f dry=%d\n", cfg.interval_sec, cfg.dry_run);
+        fprintf(stdout, " interval=%.3f servo=%s dry=%d\n", cfg.interval_sec,
+                cfg.servo == DISC_SERVO_KALMAN ? "kalman" : "pi", cfg.dry_run);
         fflush(stdout);
 
         // Startup sanity checks (print even during S0 window when --print/--debug)
-        sanity_print_dpll_fod(&g_cm_bus, &cfg, 5);
-        sanity_print_dpll_fod(&g_cm_bus, &cfg, 6);
-        sanity_print_outputs(&g_cm_bus, &cfg);
-        sanity_print_phase_once(&g_cm_bus, &cfg);
+        sanity_print_dpll_fod(&bus, &cfg, 5);
+        sanity_print_dpll_fod(&bus, &cfg, 6);
+        sanity_print_outputs(&bus, &cfg);
+        sanity_print_phase_once(&bus, &cfg);
+    }
+
+    int src = cm_steer_init(&g_steer, &bus);
+    if (src != 0) {
+        fprintf(stderr, "DPLL_WR_FREQ steering setup failed (rc=%d)\n", src);
+        dpll_spi_close(fd);
+        return 1;
+    }
+
+    if (disc_setup_rt(cfg.rt_prio, cfg.mlock) != 0) {
+        dpll_spi_close(fd);
+        return 1;
+    }
+
+    // No SA_RESTART: a signal must interrupt the blocking timerfd read.
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = disc_stop_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    disc_clock_t dc;
+    if (disc_clock_init(&dc, cfg.interval_sec, cfg.jitter_report_sec) != 0) {
+        perror("timerfd");
+        dpll_spi_close(fd);
+        return 1;
     }
+    fprintf(stdout, "timing: timerfd CLOCK_MONOTONIC period=%.6f s sched=%s prio=%d mlock=%d\n",
+            cfg.interval_sec, cfg.rt_prio > 0 ? "SCHED_FIFO" : "SCHED_OTHER",
+            cfg.rt_prio, cfg.mlock);
+    fflush(stdout);
 
-    int rc = discipline_run(&g_cm_bus, &cfg);
+    int rc = discipline_run(&bus, &cfg, &dc);
 
+    jitter_print("total", &dc.total);
+    disc_clock_close(&dc);
     dpll_spi_close(fd);
     return (rc == 0) ? 0 : 1;
 }
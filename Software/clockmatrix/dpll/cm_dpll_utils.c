@@ -59,6 +59,61 @@ void cm_bus_init_spi(cm_bus_t *bus, int *spi_fd_user_storage, int spi_fd)
     bus->write  = cm_spi_write;
 }
 
+static int cm_locked_read8(void *user, uint16_t addr, uint8_t *val)
+{
+    cm_bus_lock_t *lk = user;
+    pthread_mutex_lock(&lk->mu);
+    int rc = lk->inner->read8(lk->inner->user, addr, val);
+    pthread_mutex_unlock(&lk->mu);
+    return rc;
+}
+
+static int cm_locked_write8(void *user, uint16_t addr, uint8_t val)
+{
+    cm_bus_lock_t *lk = user;
+    pthread_mutex_lock(&lk->mu);
+    int rc = lk->inner->write8(lk->inner->user, addr, val);
+    pthread_mutex_unlock(&lk->mu);
+    return rc;
+}
+
+static int cm_locked_read(void *user, uint16_t addr, uint8_t *buf, size_t len)
+{
+    cm_bus_lock_t *lk = user;
+    pthread_mutex_lock(&lk->mu);
+    int rc = lk->inner->read(lk->inner->user, addr, buf, len);
+    pthread_mutex_unlock(&lk->mu);
+    return rc;
+}
+
+static int cm_locked_write(void *user, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    cm_bus_lock_t *lk = user;
+    pthread_mutex_lock(&lk->mu);
+    int rc = lk->inner->write(lk->inner->user, addr, buf, len);
+    pthread_mutex_unlock(&lk->mu);
+    return rc;
+}
+
+int cm_bus_init_locked(cm_bus_t *bus, cm_bus_lock_t *lk, const cm_bus_t *inner)
+{
+    if (!bus || !lk || !inner) return -1;
+    if (pthread_mutex_init(&lk->mu, NULL) != 0) return -1;
+    lk->inner = inner;
+
+    bus->user   = lk;
+    bus->read8  = cm_locked_read8;
+    bus->write8 = cm_locked_write8;
+    bus->read   = cm_locked_read;
+    bus->write  = cm_locked_write;
+    return 0;
+}
+
+void cm_bus_lock_destroy(cm_bus_lock_t *lk)
+{
+    if (lk) pthread_mutex_destroy(&lk->mu);
+}
+
 // ---------------------------------------------------------------------------
 // Generic parsing helpers
 // ---------------------------------------------------------------------------
@@ -99,30 +154,8 @@ int cm_read_phase_status_s36(const cm_bus_t *bus, unsigned meas_dpll, int64_t *o
 {
     if (!bus || !out_s36) return -1;
 
-    char reg_name[64];
-    snprintf(reg_name, sizeof(reg_name), "DPLL%u_PHASE_STATUS", meas_dpll);
-
-    uint8_t buf[5] = {0};
-    int rc = cm_string_read_bytes(bus, "Status", 0, reg_name, buf, sizeof(buf));
-    if (rc != 0) return rc;
-
-    // Little-endian 40 bits, but only bits[35:0] valid.
-    uint64_t v = 0;
-    v |= (uint64_t)buf[0] << 0;
-    v |= (uint64_t)buf[1] << 8;
-    v |= (uint64_t)buf[2] << 16;
-    v |= (uint64_t)buf[3] << 24;
-    v |= (uint64_t)buf[4] << 32;
-    v &= ((1ULL << 36) - 1ULL);
-
-    // Sign-extend 36-bit.
-    int64_t s = (int64_t)v;
-    if (v & (1ULL << 35)) {
-        s |= ~((int64_t)((1ULL << 36) - 1ULL));
-    }
-
-    *out_s36 = s;
-    return 0;
+    // 5 bytes little-endian, only bits[35:0] valid; one burst, sign-extended.
+    return cm_read_s64_field(bus, CM_WF_DPLL_PHASE_STATUS, meas_dpll, out_s36);
 }
 
 double cm_phase_s36_to_seconds(int64_t phase_s36)
@@ -135,27 +168,16 @@ int cm_read_dpll_fod_freq_hz(const cm_bus_t *bus, unsigned dpll_idx,
 {
     if (!bus || !out_hz) return -1;
 
-    uint8_t bufM[6] = {0};
-    uint8_t bufN[2] = {0};
-
-    int rc = cm_string_read_bytes(bus, "DPLL_Ctrl", dpll_idx, "DPLL_FOD_FREQ_M_0_7", bufM, sizeof(bufM));
+    int64_t M = 0, N = 0;
+    int rc = cm_read_s64_field(bus, CM_WF_FOD_FREQ_M, dpll_idx, &M);
     if (rc) return rc;
-    rc = cm_string_read_bytes(bus, "DPLL_Ctrl", dpll_idx, "DPLL_FOD_FREQ_N_0_7", bufN, sizeof(bufN));
+    rc = cm_read_s64_field(bus, CM_WF_FOD_FREQ_N, dpll_idx, &N);
     if (rc) return rc;
 
-    uint64_t M = 0;
-    M |= (uint64_t)bufM[0] << 0;
-    M |= (uint64_t)bufM[1] << 8;
-    M |= (uint64_t)bufM[2] << 16;
-    M |= (uint64_t)bufM[3] << 24;
-    M |= (uint64_t)bufM[4] << 32;
-    M |= (uint64_t)bufM[5] << 40;
-
-    uint16_t N = (uint16_t)((uint16_t)bufN[0] | ((uint16_t)bufN[1] << 8));
     if (N == 0) N = 1;
 
-    if (M_out) *M_out = M;
-    if (N_out) *N_out = N;
+    if (M_out) *M_out = (uint64_t)M;
+    if (N_out) *N_out = (uint16_t)N;
 
     *out_hz = (double)M / (double)N;
     return 0;
@@ -164,30 +186,20 @@ int cm_read_dpll_fod_freq_hz(const cm_bus_t *bus, unsigned dpll_idx,
 int cm_read_output_div_u32(const cm_bus_t *bus, unsigned out_idx, uint32_t *out_div)
 {
     if (!bus || !out_div) return -1;
-    uint8_t b[4] = {0};
-    int rc = cm_string_read_bytes(bus, "Output", out_idx, "OUT_DIV", b, sizeof(b));
+    int64_t v = 0;
+    int rc = cm_read_s64_field(bus, CM_WF_OUT_DIV, out_idx, &v);
     if (rc) return rc;
-    uint32_t v = 0;
-    v |= (uint32_t)b[0] << 0;
-    v |= (uint32_t)b[1] << 8;
-    v |= (uint32_t)b[2] << 16;
-    v |= (uint32_t)b[3] << 24;
-    *out_div = v;
+    *out_div = (uint32_t)v;
     return 0;
 }
 
 int cm_read_output_phase_adj_s32(const cm_bus_t *bus, unsigned out_idx, int32_t *out_adj)
 {
     if (!bus || !out_adj) return -1;
-    uint8_t b[4] = {0};
-    int rc = cm_string_read_bytes(bus, "Output", out_idx, "OUT_PHASE_ADJ_7_0", b, sizeof(b));
+    int64_t v = 0;
+    int rc = cm_read_s64_field(bus, CM_WF_OUT_PHASE_ADJ, out_idx, &v);
     if (rc) return rc;
-    uint32_t u = 0;
-    u |= (uint32_t)b[0] << 0;
-    u |= (uint32_t)b[1] << 8;
-    u |= (uint32_t)b[2] << 16;
-    u |= (uint32_t)b[3] << 24;
-    *out_adj = (int32_t)u;
+    *out_adj = (int32_t)v;
     return 0;
 }
 
@@ -196,23 +208,17 @@ int cm_write_output_phase_adj_s32(const cm_bus_t *bus, unsigned out_idx, int32_t
 {
     if (!bus) return -1;
 
-    uint8_t b[4];
-    b[0] = (uint8_t)((uint32_t)adj & 0xFF);
-    b[1] = (uint8_t)(((uint32_t)adj >> 8) & 0xFF);
-    b[2] = (uint8_t)(((uint32_t)adj >> 16) & 0xFF);
-    b[3] = (uint8_t)(((uint32_t)adj >> 24) & 0xFF);
-
     if (trace) {
         fprintf(stdout,
-                "WRITE: Output[%u].OUT_PHASE_ADJ <= %d (0x%08x) bytes=%02x %02x %02x %02x %s\n",
-                out_idx, adj, (uint32_t)adj, b[0], b[1], b[2], b[3],
+                "WRITE: Output[%u].OUT_PHASE_ADJ <= %d (0x%08x) %s\n",
+                out_idx, adj, (uint32_t)adj,
                 dry_run ? "(dry-run)" : "");
         fflush(stdout);
     }
 
     if (dry_run) return 0;
 
-    int rc = cm_string_write_bytes(bus, "Output", out_idx, "OUT_PHASE_ADJ_7_0", b, sizeof(b));
+    int rc = cm_write_s64_field(bus, CM_WF_OUT_PHASE_ADJ, out_idx, adj);
 
     if (trace) {
         fprintf(stdout, "WRITE: Output[%u].OUT_PHASE_ADJ rc=%d\n", out_idx, rc);
@@ -236,26 +242,19 @@ int cm_read_dpll_wr_freq_s42(const cm_bus_t *bus, unsigned dpll_idx, int64_t *ou
 {
     if (!bus || !out_word_s42) return -1;
 
-    uint8_t rb[6] = {0};
-    int rc = cm_string_read_bytes(bus, "DPLL_Freq_Write", dpll_idx, "DPLL_WR_FREQ_7_0", rb, sizeof(rb));
+    int64_t rs = 0;
+    int rc = cm_read_s64_field(bus, CM_WF_DPLL_WR_FREQ, dpll_idx, &rs);
     if (rc) return rc;
 
-    uint64_t ru = 0;
-    for (int i = 0; i < 6; i++) ru |= ((uint64_t)rb[i]) << (8 * i);
-    ru &= ((1ULL << 42) - 1ULL);
-
-    int64_t rs = (int64_t)ru;
-    if (ru & (1ULL << 41)) rs |= ~((int64_t)((1ULL << 42) - 1ULL)); // sign extend
-
     *out_word_s42 = rs;
 
     if (trace) {
         const double frac = ldexp((double)rs, -CM_WR_FREQ_FRAC_BITS);
         const double ppb = frac * 1e9;
         fprintf(stdout,
-                "READ:  DPLL_Freq_Write[%u].DPLL_WR_FREQ word...s42=%lld cmd=%.6f ppb bytes=%02x %02x %02x %02x %02x %02x rc=%d\n",
+                "READ:  DPLL_Freq_Write[%u].DPLL_WR_FREQ word...s42=%lld cmd=%.6f ppb raw=0x%011llx rc=%d\n",
                 dpll_idx, (long long)rs, ppb,
-                rb[0], rb[1], rb[2], rb[3], rb[4], rb[5], rc);
+                (unsigned long long)((uint64_t)rs & ((1ULL << 42) - 1ULL)), rc);
         fflush(stdout);
     }
 
@@ -268,15 +267,7 @@ int cm_write_dpll_wr_freq_s42(const cm_bus_t *bus, unsigned dpll_idx, int64_t wo
     if (!bus) return -1;
 
     // Stored as 6 bytes little-endian; device uses low 42 bits.
-    uint64_t u = (uint64_t)word_s42 & ((1ULL << 42) - 1ULL);
-
-    uint8_t b[6];
-    b[0] = (uint8_t)(u & 0xFF);
-    b[1] = (uint8_t)((u >> 8) & 0xFF);
-    b[2] = (uint8_t)((u >> 16) & 0xFF);
-    b[3] = (uint8_t)((u >> 24) & 0xFF);
-    b[4] = (uint8_t)((u >> 32) & 0xFF);
-    b[5] = (uint8_t)((u >> 40) & 0xFF);
+    const uint64_t raw = (uint64_t)word_s42 & ((1ULL << 42) - 1ULL);
 
     // Human readability: convert to fractional frequency and ppb.
     const double cmd_frac = ldexp((double)word_s42, -CM_WR_FREQ_FRAC_BITS);
@@ -284,37 +275,31 @@ int cm_write_dpll_wr_freq_s42(const cm_bus_t *bus, unsigned dpll_idx, int64_t wo
 
     if (trace) {
         fprintf(stdout,
-                "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ <= word_s42=%lld cmd=%.6f ppb bytes=%02x %02x %02x %02x %02x %02x %s\n",
+                "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ <= word_s42=%lld cmd=%.6f ppb raw=0x%011llx %s\n",
                 dpll_idx, (long long)word_s42, cmd_ppb,
-                b[0], b[1], b[2], b[3], b[4], b[5],
+                (unsigned long long)raw,
                 dry_run ? "(dry-run)" : "");
         fflush(stdout);
     }
 
     if (dry_run) return 0;
 
-    int rc = cm_string_write_bytes(bus, "DPLL_Freq_Write", dpll_idx, "DPLL_WR_FREQ_7_0", b, sizeof(b));
+    int rc = cm_write_s64_field(bus, CM_WF_DPLL_WR_FREQ, dpll_idx, word_s42);
 
     if (trace) {
         fprintf(stdout, "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ rc=%d\n", dpll_idx, rc);
         fflush(stdout);
 
         if (rc == 0) {
-            uint8_t rb[6] = {0};
-            int rrc = cm_string_read_bytes(bus, "DPLL_Freq_Write", dpll_idx, "DPLL_WR_FREQ_7_0", rb, sizeof(rb));
-            uint64_t ru = 0;
-            for (int i = 0; i < 6; i++) ru |= ((uint64_t)rb[i]) << (8 * i);
-            ru &= ((1ULL << 42) - 1ULL);
-
-            int64_t rs = (int64_t)ru;
-            if (ru & (1ULL << 41)) rs |= ~((int64_t)((1ULL << 42) - 1ULL)); // sign extend
+            int64_t rs = 0;
+            int rrc = cm_read_s64_field(bus, CM_WF_DPLL_WR_FREQ, dpll_idx, &rs);
             double rfrac = ldexp((double)rs, -CM_WR_FREQ_FRAC_BITS);
             double rppb = rfrac * 1e9;
 
             fprintf(stdout,
-                    "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ readback word_s42=%lld cmd=%.6f ppb bytes=%02x %02x %02x %02x %02x %02x rrc=%d\n",
+                    "WRITE: DPLL_Freq_Write[%u].DPLL_WR_FREQ readback word_s42=%lld cmd=%.6f ppb raw=0x%011llx rrc=%d\n",
                     dpll_idx, (long long)rs, rppb,
-                    rb[0], rb[1], rb[2], rb[3], rb[4], rb[5], rrc);
+                    (unsigned long long)((uint64_t)rs & ((1ULL << 42) - 1ULL)), rrc);
             fflush(stdout);
         }
     }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -36,6 +37,21 @@ extern "C" {
 // as the user pointer. This makes it easy to keep the bus as a stack object.
 void cm_bus_init_spi(cm_bus_t *bus, int *spi_fd_user_storage, int spi_fd);
 
+// Share one bus between threads (e.g. cm_sampler and the main loop). Every
+// op of `inner` runs under lk->mu, so one thread's page select is never
+// followed by another thread's transfer. Read-modify-write sequences made of
+// several ops are not atomic; only one thread should write a given register.
+typedef struct {
+    const cm_bus_t  *inner;
+    pthread_mutex_t  mu;
+} cm_bus_lock_t;
+
+// Initialize `bus` as the locked view of `inner`. Both lk and inner must
+// outlive bus. Returns 0 or -1.
+int cm_bus_init_locked(cm_bus_t *bus, cm_bus_lock_t *lk, const cm_bus_t *inner);
+
+void cm_bus_lock_destroy(cm_bus_lock_t *lk);
+
 // ---------------------------------------------------------------------------
 // Generic parsing helpers
 // ---------------------------------------------------------------------------
@@ -0,0 +1,1059 @@
+// cm_freqplan.c
+// Exact rational frequency planning for the 8A34004 (128-bit integer math).
+
+#include "cm_freqplan.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+const cm_fp_limits_t cm_fp_limits_8a34004 = {
+    500000000ull,           // dco_min_hz
+    750000000ull,           // dco_max_hz
+    (1ull << 48) - 1,       // max_m
+    65535u,                 // max_n
+    0xFFFFFFFFu,            // max_div
+};
+
+// Integer-Hz fraction for the tables below.
+#define CM_FP_HZ(x) {(x), 1}
+
+const cm_fp_topology_t cm_fp_topology_any = {
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+    {{0, 0}},
+};
+
+const cm_fp_topology_t cm_fp_topology_switchberry = {
+    // Q9 -> FOD5 (Ch5, SMA3), Q10/Q11 -> FOD6 (SMA2, SMA1/CM4 1PPS)
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 1u << 5, 1u << 6, 1u << 6},
+    {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, CM_FP_HZ(500000000ull), {0, 0}, {0, 0}},
+};
+
+#define CM_U128_MAX (~(cm_u128)0)
+
+// Fraction parts above this are rejected so products of two stay in 128 bits.
+#define CM_FP_PART_LIMIT ((cm_u128)1 << 96)
+
+// ---------------------------------------------------------------------------
+// Integer helpers
+// ---------------------------------------------------------------------------
+
+static cm_u128 cm_fp_gcd(cm_u128 a, cm_u128 b)
+{
+    while (b) {
+        cm_u128 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static cm_u128 cm_fp_absdiff(cm_u128 a, cm_u128 b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+// Reduce num/den into a cm_freq_t. Returns -2 if either part needs > 64 bits.
+static int cm_fp_reduce(cm_u128 num, cm_u128 den, cm_freq_t *out)
+{
+    if (num == 0 || den == 0) return -2;
+    cm_u128 g = cm_fp_gcd(num, den);
+    num /= g;
+    den /= g;
+    if (num > UINT64_MAX || den > UINT64_MAX) return -2;
+    out->num = (uint64_t)num;
+    out->den = (uint64_t)den;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Rational frequencies
+// ---------------------------------------------------------------------------
+
+int cm_freq_make(uint64_t num, uint64_t den, cm_freq_t *out)
+{
+    if (!out || num == 0 || den == 0) return -1;
+    return cm_fp_reduce(num, den, out);
+}
+
+int cm_freq_parse(const char *s, cm_freq_t *out)
+{
+    if (!s || !out) return -1;
+
+    const char *p = s;
+    while (isspace((unsigned char)*p)) p++;
+
+    cm_u128 mant = 0;
+    int digits = 0, frac_digits = 0, seen_dot = 0;
+    for (;; p++) {
+        if (*p == '.' && !seen_dot) {
+            seen_dot = 1;
+            continue;
+        }
+        if (!isdigit((unsigned char)*p)) break;
+        if (mant >= CM_FP_PART_LIMIT) return -2;
+        mant = mant * 10 + (cm_u128)(*p - '0');
+        digits++;
+        if (seen_dot) frac_digits++;
+    }
+    if (digits == 0) return -1;
+
+    int exp10 = 0;
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        int neg = 0;
+        if (*p == '+' || *p == '-') neg = (*p++ == '-');
+        if (!isdigit((unsigned char)*p)) return -1;
+        while (isdigit((unsigned char)*p)) {
+            if (exp10 > 100) return -2;
+            exp10 = exp10 * 10 + (*p++ - '0');
+        }
+        if (neg) exp10 = -exp10;
+    }
+    exp10 -= frac_digits;
+
+    cm_u128 num = mant, den = 1;
+    for (; exp10 > 0; exp10--) {
+        if (num >= CM_FP_PART_LIMIT) return -2;
+        num *= 10;
+    }
+    for (; exp10 < 0; exp10++) {
+        if (den >= CM_FP_PART_LIMIT) return -2;
+        den *= 10;
+    }
+
+    if (*p == '/') {
+        p++;
+        cm_u128 d = 0;
+        if (!isdigit((unsigned char)*p)) return -1;
+        while (isdigit((unsigned char)*p)) {
+            if (d >= CM_FP_PART_LIMIT) return -2;
+            d = d * 10 + (cm_u128)(*p++ - '0');
+        }
+        if (d == 0) return -2;
+        cm_u128 g = cm_fp_gcd(num, d);
+        num /= g;
+        d /= g;
+        if (d > CM_U128_MAX / den) return -2;
+        den *= d;
+    }
+
+    while (isspace((unsigned char)*p)) p++;
+    if (*p != '\0') return -1;
+
+    return cm_fp_reduce(num, den, out);
+}
+
+int cm_freq_from_double(double hz, cm_freq_t *out)
+{
+    cm_u128 num, den;
+    if (!out || cm_fp_exact_double(hz, &num, &den)) return -1;
+
+    // Smallest denominator bound (power of two) whose best fraction
+    // converts back to hz.
+    for (uint64_t bound = 1; bound <= 0xFFFFFFFFull; bound <<= 1) {
+        uint64_t m;
+        uint32_t n;
+        if (cm_fp_best_ratio(num, den, UINT64_MAX, (uint32_t)bound, &m, &n))
+            continue;
+        if ((double)((long double)m / (long double)n) == hz)
+            return cm_fp_reduce(m, n, out);
+    }
+
+    // Fall back to the binary fraction itself.
+    return cm_fp_reduce(num, den, out) ? -1 : 0;
+}
+
+double cm_freq_to_double(cm_freq_t f)
+{
+    if (f.den == 0) return 0.0;
+    return (double)((long double)f.num / (long double)f.den);
+}
+
+int cm_freq_cmp(cm_freq_t a, cm_freq_t b)
+{
+    cm_u128 l = (cm_u128)a.num * b.den;
+    cm_u128 r = (cm_u128)b.num * a.den;
+    return (l > r) - (l < r);
+}
+
+const char *cm_freq_str(cm_freq_t f, char *buf, size_t len)
+{
+    if (!buf || len == 0) return buf;
+    if (f.den == 1)
+        snprintf(buf, len, "%llu", (unsigned long long)f.num);
+    else
+        snprintf(buf, len, "%llu/%llu", (unsigned long long)f.num,
+                 (unsigned long long)f.den);
+    return buf;
+}
+
+// ---------------------------------------------------------------------------
+// Best rational approximation
+// ---------------------------------------------------------------------------
+
+int cm_fp_exact_double(double x, cm_u128 *num, cm_u128 *den)
+{
+    if (!num || !den || !(x > 0.0) || !isfinite(x)) return -1;
+
+    int e = 0;
+    double f = frexp(x, &e);                // x = f * 2^e, 0.5 <= f < 1
+    uint64_t mant = (uint64_t)ldexp(f, 53);
+    int sh = 53 - e;                        // x = mant / 2^sh
+    while (sh > 0 && !(mant & 1u)) {
+        mant >>= 1;
+        sh--;
+    }
+    if (sh > 96 || sh < -40) return -1;
+
+    if (sh >= 0) {
+        *num = mant;
+        *den = (cm_u128)1 << sh;
+    } else {
+        *num = (cm_u128)mant << -sh;
+        *den = 1;
+    }
+    return 0;
+}
+
+int cm_fp_best_ratio(cm_u128 num, cm_u128 den, uint64_t max_m, uint32_t max_n,
+                     uint64_t *m_out, uint32_t *n_out)
+{
+    if (!m_out || !n_out || num == 0 || den == 0 || max_m == 0 || max_n == 0)
+        return -1;
+    if (num >= CM_FP_PART_LIMIT || den >= CM_FP_PART_LIMIT) return -1;
+    if (num / den > max_m) return -1;
+
+    // Convergents p1/q1 (current) and p0/q0 (previous).
+    uint64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    cm_u128 n = num, d = den;
+    while (d != 0) {
+        cm_u128 a = n / d;
+        cm_u128 a_max = CM_U128_MAX;
+        if (p1 && (cm_u128)((max_m - p0) / p1) < a_max) a_max = (max_m - p0) / p1;
+        if (q1 && (cm_u128)((max_n - q0) / q1) < a_max) a_max = (max_n - q0) / q1;
+        if (a > a_max) break;
+
+        uint64_t p2 = p0 + (uint64_t)a * p1;
+        uint64_t q2 = q0 + (uint64_t)a * q1;
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+
+        cm_u128 r = n - a * d;
+        n = d;
+        d = r;
+    }
+    if (q1 == 0) return -1;
+
+    uint64_t best_m = p1, best_n = q1;
+
+    if (d != 0) {
+        // Not exact: the largest semiconvergent may beat the last convergent.
+        uint64_t k = (max_n - q0) / q1;
+        if (p1 && (max_m - p0) / p1 < k) k = (max_m - p0) / p1;
+        uint64_t sm = p0 + k * p1;
+        uint64_t sn = q0 + k * q1;
+
+        if (sn != 0 && sm != 0) {
+            // |x - a/b| * den * b = |num*b - a*den|; compare cross-multiplied.
+            // Ties keep the convergent, which has the smaller denominator.
+            cm_u128 dist_c = cm_fp_absdiff(num * q1, (cm_u128)p1 * den);
+            cm_u128 dist_s = cm_fp_absdiff(num * sn, (cm_u128)sm * den);
+            if (dist_s * q1 < dist_c * sn) {
+                best_m = sm;
+                best_n = sn;
+            }
+        }
+    }
+    if (best_m == 0) return -1;
+
+    *m_out = best_m;
+    *n_out = (uint32_t)best_n;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// DCO + divider planning
+// ---------------------------------------------------------------------------
+
+// Fill plan for DCO = m/n and the given dividers; errors are exact fractions.
+static void cm_fp_plan_fill(cm_fp_plan_t *plan, const cm_freq_t *targets,
+                            size_t count, uint64_t m, uint32_t n,
+                            const uint32_t *div)
+{
+    plan->m = m;
+    plan->n = n;
+    plan->n_reg = (n == 1) ? 0 : (uint16_t)n;
+    cm_fp_reduce(m, n, &plan->dco);
+    plan->nout = count;
+    plan->exact = 1;
+
+    for (size_t i = 0; i < count; i++) {
+        // actual = m / (n * div); error = (m*den - n*div*num) / (n*div*num)
+        cm_u128 got  = (cm_u128)m * targets[i].den;
+        cm_u128 want = (cm_u128)n * div[i] * targets[i].num;
+        cm_u128 diff = cm_fp_absdiff(got, want);
+
+        plan->div[i] = div[i];
+        cm_fp_reduce(m, (cm_u128)n * div[i], &plan->actual[i]);
+        plan->err_sign[i] = (got > want) - (got < want);
+        plan->err_ppb[i] = (double)((long double)plan->err_sign[i] *
+                                    (long double)diff / (long double)want * 1e9L);
+        if (diff) plan->exact = 0;
+    }
+}
+
+// Exact plans only. Every DCO F with F / f_i integral for all i is a
+// multiple k of L = lcm(num_i) / gcd(den_i) (num/den reduced and coprime),
+// and the reduced denominator of k*L divides g = gcd(den_i). For each
+// admissible denominator d | g (ascending), the smallest k that is a multiple
+// of g/d and lands in the DCO range is the answer.
+static int cm_fp_plan_exact(const cm_freq_t *targets, size_t count,
+                            const cm_fp_limits_t *lim, cm_fp_plan_t *plan)
+{
+    cm_u128 g = 0;
+    for (size_t i = 0; i < count; i++) g = cm_fp_gcd(g, targets[i].den);
+
+    // Any usable L satisfies lnum <= dco_max * g; stop before overflow.
+    const cm_u128 lnum_cap = (cm_u128)lim->dco_max_hz * g;
+    cm_u128 lnum = 1;
+    for (size_t i = 0; i < count; i++) {
+        cm_u128 step = targets[i].num / cm_fp_gcd(lnum, targets[i].num);
+        if (step > lnum_cap / lnum) return -2;
+        lnum *= step;
+    }
+
+    cm_u128 kmin = ((cm_u128)lim->dco_min_hz * g + lnum - 1) / lnum;
+    cm_u128 kmax = lnum_cap / lnum;
+    if (kmin == 0) kmin = 1;
+    if (kmin > kmax) return -2;
+
+    uint32_t div[CM_FP_MAX_OUTPUTS];
+    for (cm_u128 d = 1; d <= g && d <= lim->max_n; d++) {
+        if (g % d) continue;
+        cm_u128 s = g / d;
+        cm_u128 k = (kmin + s - 1) / s * s;
+        if (k > kmax) continue;
+
+        // F = k * lnum / g, reduced denominator is exactly d.
+        cm_u128 fnum = k * lnum / s;
+        if (fnum > lim->max_m) continue;
+
+        int ok = 1;
+        for (size_t i = 0; i < count && ok; i++) {
+            cm_u128 q = fnum * targets[i].den / (d * targets[i].num);
+            ok = (q >= 1 && q <= lim->max_div);
+            div[i] = (uint32_t)q;
+        }
+        if (!ok) continue;
+
+        cm_fp_plan_fill(plan, targets, count, (uint64_t)fnum, (uint32_t)d, div);
+        plan->exhaustive = 1;
+        return 0;
+    }
+    return -2;
+}
+
+// Dividers nearest to DCO m/n for each target; returns the total relative
+// error (exact differences, summed as long double) or -1 if a divider is out
+// of range.
+static long double cm_fp_eval(const cm_freq_t *targets, size_t count,
+                              const cm_fp_limits_t *lim, uint64_t m, uint32_t n,
+                              uint32_t *div)
+{
+    long double cost = 0.0L;
+    for (size_t i = 0; i < count; i++) {
+        cm_u128 top = (cm_u128)m * targets[i].den;
+        cm_u128 bot = (cm_u128)n * targets[i].num;
+        cm_u128 q = (2 * top + bot) / (2 * bot);   // round(top / bot)
+        if (q == 0 || q > lim->max_div) return -1.0L;
+
+        cm_u128 want = bot * q;
+        cost += (long double)cm_fp_absdiff(top, want) / (long double)want;
+        div[i] = (uint32_t)q;
+    }
+    return cost;
+}
+
+// 1 once CLOCK_MONOTONIC reached deadline (never for NULL).
+static int cm_fp_past(const struct timespec *deadline)
+{
+    if (!deadline) return 0;
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec > deadline->tv_sec ||
+           (t.tv_sec == deadline->tv_sec && t.tv_nsec >= deadline->tv_nsec);
+}
+
+// 1PPS plans: ranges smaller than this are scanned on the calling thread.
+#define CM_FP_PPS_PAR_MIN_STEPS 65536u
+#define CM_FP_PPS_MAX_THREADS   16
+
+// Shared by the slices of one search, updated with atomics.
+typedef struct {
+    uint64_t best_bits;   // lowest cost so far as a double rounded up (>= 0,
+                          // so the bit patterns order like the values)
+    uint64_t zero_d;      // smallest D of an exact plan, UINT64_MAX if none
+    const struct timespec *deadline;  // NULL = none
+    int      timed_out;   // set by the first slice that saw the deadline
+} cm_fp_pps_shared_t;
+
+// One slice [dlo, dhi] of the anchor divider range.
+typedef struct {
+    const cm_freq_t      *targets;
+    size_t                count;
+    const cm_fp_limits_t *lim;
+    cm_freq_t             fh;       // anchor (highest target)
+    cm_u128               dlo, dhi;
+    cm_fp_pps_shared_t   *shared;
+    long double           best;     // < 0: no plan in this slice
+    uint64_t              best_m;
+    uint32_t              best_div[CM_FP_MAX_OUTPUTS];
+} cm_fp_pps_slice_t;
+
+// The shared state is re-read every this many dividers.
+#define CM_FP_PPS_SYNC_MASK 0xFFFu
+
+static void cm_fp_pps_publish(cm_fp_pps_shared_t *sh, long double cost, cm_u128 D)
+{
+    double c = (double)cost;
+    if ((long double)c < cost) c = nextafter(c, INFINITY);
+    uint64_t bits, cur = __atomic_load_n(&sh->best_bits, __ATOMIC_RELAXED);
+    memcpy(&bits, &c, sizeof(bits));
+    while (bits < cur &&
+           !__atomic_compare_exchange_n(&sh->best_bits, &cur, bits, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+    if (cost == 0.0L) {
+        cur = __atomic_load_n(&sh->zero_d, __ATOMIC_RELAXED);
+        while ((uint64_t)D < cur &&
+               !__atomic_compare_exchange_n(&sh->zero_d, &cur, (uint64_t)D, 0,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+    }
+}
+
+// Integer-Hz DCO F = round(D * fh) for every D in the slice. D * fh is kept
+// as q + r/den and advanced by fh per step, so the loop does no division.
+// The anchor's share of the cost, e / (D * num) with e = |F * den - D * num|,
+// bounds the total from below (fh > 1 Hz makes D its nearest divider), and
+// D * num <= (F + 1/2) * den. A candidate is skipped when that bound, with a
+// margin for rounding, reaches this slice's best (an earlier D wins ties) or
+// exceeds the best any slice has published. A slice stops once another one
+// holds an exact plan at a smaller D, or when the deadline has passed.
+static void *cm_fp_pps_scan(void *arg)
+{
+    cm_fp_pps_slice_t *sl = (cm_fp_pps_slice_t *)arg;
+    cm_fp_pps_shared_t *sh = sl->shared;
+    const cm_fp_limits_t *lim = sl->lim;
+    const cm_u128 num = sl->fh.num, den = sl->fh.den;
+    const cm_u128 sq = num / den, sr = num % den;
+    cm_u128 q = sl->dlo * num / den, r = sl->dlo * num % den;
+    const long double den_ld = (long double)sl->fh.den;
+    const long double margin = 1.0L + 1e-15L;
+    long double skip = -1.0L;   // skip if e >= skip * (F + 1/2) * den
+    uint64_t zero_d = UINT64_MAX;
+    uint32_t div[CM_FP_MAX_OUTPUTS];
+
+    sl->best = -1.0L;
+    for (cm_u128 D = sl->dlo; D <= sl->dhi; D++, q += sq, r += sr) {
+        if (r >= den) {
+            r -= den;
+            q++;
+        }
+        if (((uint64_t)D & CM_FP_PPS_SYNC_MASK) == 0 || D == sl->dlo) {
+            uint64_t bits = __atomic_load_n(&sh->best_bits, __ATOMIC_RELAXED);
+            double c;
+            memcpy(&c, &bits, sizeof(c));
+            if (isfinite(c) && (skip < 0.0L || c * margin < skip)) skip = c * margin;
+            zero_d = __atomic_load_n(&sh->zero_d, __ATOMIC_RELAXED);
+            if (__atomic_load_n(&sh->timed_out, __ATOMIC_RELAXED)) break;
+            if (cm_fp_past(sh->deadline)) {
+                __atomic_store_n(&sh->timed_out, 1, __ATOMIC_RELAXED);
+                break;
+            }
+        }
+        if (D > zero_d) break;
+
+        const int up = 2 * r >= den;
+        const uint64_t F = (uint64_t)q + (uint64_t)up;
+        if (F < lim->dco_min_hz || F > lim->dco_max_hz) continue;
+
+        const uint64_t e = (uint64_t)(up ? den - r : r);   // < den
+        if (skip >= 0.0L && (long double)e >= skip * ((long double)F + 0.5L) * den_ld)
+            continue;
+
+        long double cost = cm_fp_eval(sl->targets, sl->count, lim, F, 1, div);
+        if (cost < 0.0L) continue;
+        if (sl->best < 0.0L || cost < sl->best) {
+            sl->best = cost;
+            sl->best_m = F;
+            memcpy(sl->best_div, div, sl->count * sizeof(div[0]));
+            if (skip < 0.0L || cost * margin < skip) skip = cost * margin;
+            cm_fp_pps_publish(sh, cost, D);
+            if (cost == 0.0L) break;
+        }
+    }
+    return NULL;
+}
+
+// 1PPS plan: with a 1 Hz target the DCO must be integer Hz for that output
+// to be exact. Anchored on the highest target like cm_fp_plan_nearest(), but
+// only integer F are tried and the whole divider range is searched. Slices
+// keep the smallest D on equal cost, so the result does not depend on the
+// number of threads. Returns 1 if the request is not a 1PPS one (no 1 Hz
+// target, or none above 1 Hz to anchor on), 2 if the deadline passed first.
+static int cm_fp_plan_pps(const cm_freq_t *targets, size_t count,
+                          const cm_fp_limits_t *lim, const struct timespec *deadline,
+                          cm_fp_plan_t *plan)
+{
+    const cm_freq_t one = {1, 1};
+    size_t hi = 0;
+    int pps = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (cm_freq_cmp(targets[i], one) == 0) pps = 1;
+        if (cm_freq_cmp(targets[i], targets[hi]) > 0) hi = i;
+    }
+    const cm_freq_t fh = targets[hi];
+    if (!pps || cm_freq_cmp(fh, one) <= 0) return 1;
+    if (cm_fp_past(deadline)) return 2;
+
+    cm_u128 dmin = ((cm_u128)lim->dco_min_hz * fh.den + fh.num - 1) / fh.num;
+    cm_u128 dmax = (cm_u128)lim->dco_max_hz * fh.den / fh.num;
+    if (dmin == 0) dmin = 1;
+    if (dmax > lim->max_div) dmax = lim->max_div;
+    if (dmin > dmax) return -2;
+
+    const cm_u128 steps = dmax - dmin + 1;
+    unsigned nslices = 1;
+    if (steps >= CM_FP_PPS_PAR_MIN_STEPS) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        if (ncpu > 1)
+            nslices = ncpu > CM_FP_PPS_MAX_THREADS ? CM_FP_PPS_MAX_THREADS : (unsigned)ncpu;
+    }
+
+    cm_fp_pps_slice_t slices[CM_FP_PPS_MAX_THREADS];
+    pthread_t tids[CM_FP_PPS_MAX_THREADS];
+    int started[CM_FP_PPS_MAX_THREADS] = {0};
+    const cm_u128 per = (steps + nslices - 1) / nslices;
+    const double inf = INFINITY;
+    cm_fp_pps_shared_t shared;
+    memcpy(&shared.best_bits, &inf, sizeof(shared.best_bits));
+    shared.zero_d = UINT64_MAX;
+    shared.deadline = deadline;
+    shared.timed_out = 0;
+
+    for (unsigned t = 0; t < nslices; t++) {
+        cm_fp_pps_slice_t *sl = &slices[t];
+        sl->targets = targets;
+        sl->count = count;
+        sl->lim = lim;
+        sl->fh = fh;
+        sl->dlo = dmin + per * t;
+        sl->dhi = sl->dlo + per - 1 < dmax ? sl->dlo + per - 1 : dmax;
+        sl->shared = &shared;
+        sl->best = -1.0L;
+        if (t > 0 && sl->dlo <= sl->dhi &&
+            pthread_create(&tids[t], NULL, cm_fp_pps_scan, sl) == 0)
+            started[t] = 1;
+    }
+    cm_fp_pps_scan(&slices[0]);
+    for (unsigned t = 1; t < nslices; t++) {
+        if (started[t])
+            pthread_join(tids[t], NULL);
+        else if (slices[t].dlo <= slices[t].dhi)
+            cm_fp_pps_scan(&slices[t]);   // thread creation failed: run inline
+    }
+
+    if (shared.timed_out) return 2;
+    const cm_fp_pps_slice_t *best = NULL;
+    for (unsigned t = 0; t < nslices; t++) {
+        if (slices[t].best < 0.0L) continue;
+        if (!best || slices[t].best < best->best) best = &slices[t];
+    }
+    if (!best) return -2;
+    cm_fp_plan_fill(plan, targets, count, best->best_m, 1, best->best_div);
+    plan->exhaustive = 1;
+    return 0;
+}
+
+// Nearest plan: anchor the DCO on the highest target (F = D * f_hi for every
+// D that keeps F in range), represent F as the best m/n, and also try the
+// nearest integer-Hz DCO so 1PPS-style outputs can stay exact. Stops after
+// CM_FP_MAX_STEPS dividers, or once the deadline has passed and a plan is
+// known (checked every CM_FP_NEAREST_SYNC_MASK + 1 dividers).
+#define CM_FP_NEAREST_SYNC_MASK 0x3Fu
+
+static int cm_fp_plan_nearest(const cm_freq_t *targets, size_t count,
+                              const cm_fp_limits_t *lim, const struct timespec *deadline,
+                              cm_fp_plan_t *plan)
+{
+    size_t hi = 0;
+    for (size_t i = 1; i < count; i++)
+        if (cm_freq_cmp(targets[i], targets[hi]) > 0) hi = i;
+    const cm_freq_t fh = targets[hi];
+
+    cm_u128 dmin = ((cm_u128)lim->dco_min_hz * fh.den + fh.num - 1) / fh.num;
+    cm_u128 dmax = (cm_u128)lim->dco_max_hz * fh.den / fh.num;
+    if (dmin == 0) dmin = 1;
+    if (dmax > lim->max_div) dmax = lim->max_div;
+    if (dmin > dmax) return -2;
+
+    long double best = -1.0L;
+    uint64_t best_m = 0;
+    uint32_t best_n = 1;
+    uint32_t best_div[CM_FP_MAX_OUTPUTS];
+    uint32_t div[CM_FP_MAX_OUTPUTS];
+    uint32_t steps = 0;
+
+    plan->exhaustive = 1;
+    for (cm_u128 D = dmin; D <= dmax; D++) {
+        if (++steps > CM_FP_MAX_STEPS ||
+            (best >= 0.0L && (steps & CM_FP_NEAREST_SYNC_MASK) == 0 && cm_fp_past(deadline))) {
+            plan->exhaustive = 0;
+            break;
+        }
+
+        cm_u128 fnum = D * fh.num, fden = fh.den;
+        cm_u128 g = cm_fp_gcd(fnum, fden);
+        fnum /= g;
+        fden /= g;
+
+        uint64_t cand_m[2];
+        uint32_t cand_n[2];
+        int ncand = 0;
+        if (fden <= lim->max_n && fnum <= lim->max_m) {
+            cand_m[ncand] = (uint64_t)fnum;
+            cand_n[ncand++] = (uint32_t)fden;
+        } else if (!cm_fp_best_ratio(fnum, fden, lim->max_m, lim->max_n,
+                                     &cand_m[ncand], &cand_n[ncand])) {
+            ncand++;
+        }
+        if (fden != 1) {
+            cand_m[ncand] = (uint64_t)((2 * fnum + fden) / (2 * fden));
+            cand_n[ncand++] = 1;
+        }
+
+        for (int c = 0; c < ncand; c++) {
+            uint64_t m = cand_m[c];
+            uint32_t n = cand_n[c];
+            if ((cm_u128)m < (cm_u128)lim->dco_min_hz * n ||
+                (cm_u128)m > (cm_u128)lim->dco_max_hz * n)
+                continue;
+
+            long double cost = cm_fp_eval(targets, count, lim, m, n, div);
+            if (cost < 0.0L) continue;
+            if (best < 0.0L || cost < best) {
+                best = cost;
+                best_m = m;
+                best_n = n;
+                memcpy(best_div, div, count * sizeof(div[0]));
+            }
+        }
+    }
+
+    if (best < 0.0L) return -2;
+    cm_fp_plan_fill(plan, targets, count, best_m, best_n, best_div);
+    return 0;
+}
+
+// cm_fp_plan_dco() with a deadline for the searches (NULL = none). A 1PPS
+// search cut short by it falls back to the nearest search, which then stops
+// at its first check past the deadline; either way plan->exhaustive is 0.
+static int cm_fp_plan_dco_by(const cm_freq_t *targets, size_t n,
+                             const cm_fp_limits_t *lim, const struct timespec *deadline,
+                             cm_fp_plan_t *plan)
+{
+    if (!targets || !plan || n == 0 || n > CM_FP_MAX_OUTPUTS) return -1;
+    if (!lim) lim = &cm_fp_limits_8a34004;
+    for (size_t i = 0; i < n; i++)
+        if (targets[i].num == 0 || targets[i].den == 0) return -1;
+
+    memset(plan, 0, sizeof(*plan));
+    if (cm_fp_plan_exact(targets, n, lim, plan) == 0) return 0;
+    int rc = cm_fp_plan_pps(targets, n, lim, deadline, plan);
+    if (rc == 0) return 0;
+    int nrc = cm_fp_plan_nearest(targets, n, lim, deadline, plan);
+    if (rc == 2) plan->exhaustive = 0;
+    return nrc;
+}
+
+int cm_fp_plan_dco(const cm_freq_t *targets, size_t n,
+                   const cm_fp_limits_t *lim, cm_fp_plan_t *plan)
+{
+    return cm_fp_plan_dco_by(targets, n, lim, NULL, plan);
+}
+
+// ---------------------------------------------------------------------------
+// Batch planning
+// ---------------------------------------------------------------------------
+
+// Input M/N for an exact frequency (what dpll_compute_input_ratio() solves).
+static int cm_fp_plan_input(cm_freq_t f, const cm_fp_limits_t *lim,
+                            cm_fp_plan_t *plan)
+{
+    uint64_t m;
+    uint32_t n;
+    if (cm_fp_best_ratio(f.num, f.den, lim->max_m, lim->max_n, &m, &n)) return -3;
+
+    const uint32_t one = 1;
+    memset(plan, 0, sizeof(*plan));
+    cm_fp_plan_fill(plan, &f, 1, m, n, &one);
+    plan->exhaustive = 1;
+    return 0;
+}
+
+static int cm_fp_batch_same(const cm_fp_batch_req_t *a, const cm_fp_batch_req_t *b)
+{
+    return a->kind == b->kind && a->nfreq == b->nfreq && a->nfreq <= CM_FP_MAX_OUTPUTS &&
+           memcmp(a->freq, b->freq, a->nfreq * sizeof(a->freq[0])) == 0;
+}
+
+static uint64_t cm_fp_batch_hash(const cm_fp_batch_req_t *r)
+{
+    uint64_t h = 1469598103934665603ull ^ ((uint64_t)r->kind << 32 | r->nfreq);
+    for (size_t i = 0; i < r->nfreq && i < CM_FP_MAX_OUTPUTS; i++) {
+        h = (h ^ r->freq[i].num) * 1099511628211ull;
+        h = (h ^ r->freq[i].den) * 1099511628211ull;
+    }
+    return h ^ (h >> 29);
+}
+
+static int cm_fp_batch_solve(const cm_fp_batch_req_t *r, const cm_fp_limits_t *lim,
+                             cm_fp_plan_t *plan)
+{
+    if (r->kind == CM_FP_BATCH_DCO) return cm_fp_plan_dco(r->freq, r->nfreq, lim, plan);
+
+    memset(plan, 0, sizeof(*plan));
+    if (r->kind != CM_FP_BATCH_INPUT || r->nfreq != 1 || !r->freq[0].num || !r->freq[0].den)
+        return -1;
+    return cm_fp_plan_input(r->freq[0], lim, plan);
+}
+
+int cm_fp_plan_batch(const cm_fp_batch_req_t *req, size_t n,
+                     const cm_fp_limits_t *lim, cm_fp_batch_res_t *res)
+{
+    if (!req || !res) return -1;
+    if (n == 0) return 0;
+    if (!lim) lim = &cm_fp_limits_8a34004;
+
+    // Open-addressed table of first occurrences (index + 1, 0 = empty).
+    size_t cap = 16;
+    while (cap < 2 * n) cap <<= 1;
+    size_t *seen = (size_t *)calloc(cap, sizeof(*seen));
+    if (!seen) return -1;
+
+    int nok = 0;
+    for (size_t k = 0; k < n; k++) {
+        const cm_fp_batch_req_t *r = &req[k];
+        size_t slot = (size_t)cm_fp_batch_hash(r) & (cap - 1);
+        while (seen[slot] && !cm_fp_batch_same(&req[seen[slot] - 1], r))
+            slot = (slot + 1) & (cap - 1);
+
+        if (seen[slot]) {
+            res[k] = res[seen[slot] - 1];
+            res[k].shared = 1;
+        } else {
+            seen[slot] = k + 1;
+            res[k].shared = 0;
+            res[k].rc = cm_fp_batch_solve(r, lim, &res[k].plan);
+        }
+        nok += (res[k].rc == 0);
+    }
+
+    free(seen);
+    return nok;
+}
+
+// ---------------------------------------------------------------------------
+// Multi-output planning
+// ---------------------------------------------------------------------------
+
+#define CM_FP_SETS       (1u << CM_FP_NUM_OUTPUTS)
+#define CM_FP_BUDGET_MS  50u
+
+// Dividers for a DCO that must stay where it is.
+static int cm_fp_plan_fixed(const cm_freq_t *targets, size_t count,
+                            const cm_fp_limits_t *lim, cm_freq_t dco,
+                            cm_fp_plan_t *plan)
+{
+    uint32_t div[CM_FP_MAX_OUTPUTS];
+    if (dco.num > lim->max_m || dco.den > lim->max_n) return -1;
+    if (cm_fp_eval(targets, count, lim, dco.num, (uint32_t)dco.den, div) < 0.0L)
+        return -2;
+
+    memset(plan, 0, sizeof(*plan));
+    cm_fp_plan_fill(plan, targets, count, dco.num, (uint32_t)dco.den, div);
+    plan->exhaustive = 1;
+    return 0;
+}
+
+typedef struct {
+    const cm_fp_request_t  *req;
+    size_t                  nreq;
+    const cm_fp_topology_t *topo;
+    unsigned                fod_set[CM_FP_NUM_FODS];  // requests FOD f may take
+    const struct timespec  *deadline;  // heuristic mode: end of the budget, else NULL
+    // Memoised group errors: one table for free FODs, one per fixed FOD.
+    double                 *err;
+    uint8_t                *known;
+} cm_fp_ctx_t;
+
+static int cm_fp_fixed(const cm_fp_ctx_t *ctx, int fod)
+{
+    return ctx->topo->fixed_dco[fod].num != 0;
+}
+
+// Plan FOD fod for the requests in set (bit i = request i).
+static int cm_fp_group_plan(const cm_fp_ctx_t *ctx, int fod, unsigned set,
+                            cm_fp_plan_t *plan)
+{
+    cm_freq_t t[CM_FP_NUM_OUTPUTS];
+    size_t n = 0;
+    for (size_t i = 0; i < ctx->nreq; i++)
+        if (set & (1u << i)) t[n++] = ctx->req[i].freq;
+
+    if (cm_fp_fixed(ctx, fod))
+        return cm_fp_plan_fixed(t, n, &cm_fp_limits_8a34004,
+                                ctx->topo->fixed_dco[fod], plan);
+    return cm_fp_plan_dco_by(t, n, NULL, ctx->deadline, plan);
+}
+
+// Sum of |err_ppb| for the group, INFINITY if it cannot be planned.
+static double cm_fp_group_err(cm_fp_ctx_t *ctx, int fod, unsigned set)
+{
+    if (!set) return 0.0;
+
+    size_t slot = ((size_t)(cm_fp_fixed(ctx, fod) ? fod : CM_FP_NUM_FODS)
+                   << CM_FP_NUM_OUTPUTS) | set;
+    if (!ctx->known[slot]) {
+        cm_fp_plan_t plan;
+        double e = INFINITY;
+        if (cm_fp_group_plan(ctx, fod, set, &plan) == 0) {
+            e = 0.0;
+            for (size_t i = 0; i < plan.nout; i++) e += fabs(plan.err_ppb[i]);
+        }
+        ctx->err[slot] = e;
+        ctx->known[slot] = 1;
+    }
+    return ctx->err[slot];
+}
+
+// (err, nfods) ordering: less error first, then fewer FODs.
+static int cm_fp_better(double err_a, unsigned nf_a, double err_b, unsigned nf_b)
+{
+    return err_a < err_b || (err_a == err_b && nf_a < nf_b);
+}
+
+typedef struct {
+    double   err;
+    uint16_t pick;     // requests given to the FOD at this step
+    uint8_t  nfods;
+    uint8_t  valid;
+} cm_fp_cell_t;
+
+// dp[f][S]: best way to serve requests S with FODs 0..f-1. Each FOD takes
+// any subset of the remaining requests it can reach, so the search is
+// CM_FP_NUM_FODS * 3^nreq group lookups, each planned once.
+static int cm_fp_assign_exact(cm_fp_ctx_t *ctx, unsigned *group)
+{
+    const unsigned full = (1u << ctx->nreq) - 1;
+    const size_t nsets = (size_t)full + 1;
+    cm_fp_cell_t *dp = (cm_fp_cell_t *)calloc((CM_FP_NUM_FODS + 1) * nsets,
+                                              sizeof(*dp));
+    if (!dp) return -1;
+
+    dp[0].valid = 1;
+    for (int f = 0; f < CM_FP_NUM_FODS; f++) {
+        const cm_fp_cell_t *cur = &dp[(size_t)f * nsets];
+        cm_fp_cell_t *next = &dp[(size_t)(f + 1) * nsets];
+        for (unsigned S = 0; S <= full; S++) {
+            if (!cur[S].valid) continue;
+            unsigned R = ~S & full & ctx->fod_set[f];
+            for (unsigned G = R;; G = (G - 1) & R) {
+                double e = cm_fp_group_err(ctx, f, G);
+                if (isfinite(e)) {
+                    double err = cur[S].err + e;
+                    unsigned nf = cur[S].nfods + (G != 0);
+                    cm_fp_cell_t *c = &next[S | G];
+                    if (!c->valid || cm_fp_better(err, nf, c->err, c->nfods)) {
+                        c->err = err;
+                        c->nfods = (uint8_t)nf;
+                        c->pick = (uint16_t)G;
+                        c->valid = 1;
+                    }
+                }
+                if (G == 0) break;
+            }
+        }
+    }
+
+    int rc = -2;
+    if (dp[(size_t)CM_FP_NUM_FODS * nsets + full].valid) {
+        unsigned S = full;
+        for (int f = CM_FP_NUM_FODS - 1; f >= 0; f--) {
+            group[f] = dp[(size_t)(f + 1) * nsets + S].pick;
+            S &= ~group[f];
+        }
+        rc = 0;
+    }
+    free(dp);
+    return rc;
+}
+
+// Greedy placement (highest frequency first) followed by single-output moves
+// that lower (err, nfods), until nothing improves or the deadline passes. The
+// same deadline cuts the DCO searches behind cm_fp_group_err() short, so the
+// greedy pass finishes quickly once it has passed.
+static int cm_fp_assign_heuristic(cm_fp_ctx_t *ctx, unsigned *group)
+{
+    size_t order[CM_FP_NUM_OUTPUTS];
+    for (size_t i = 0; i < ctx->nreq; i++) order[i] = i;
+    for (size_t i = 1; i < ctx->nreq; i++) {
+        for (size_t j = i; j > 0 &&
+             cm_freq_cmp(ctx->req[order[j]].freq, ctx->req[order[j - 1]].freq) > 0; j--) {
+            size_t t = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = t;
+        }
+    }
+
+    int fod_of[CM_FP_NUM_OUTPUTS];
+    memset(group, 0, CM_FP_NUM_FODS * sizeof(*group));
+
+    for (size_t k = 0; k < ctx->nreq; k++) {
+        size_t i = order[k];
+        unsigned bit = 1u << i;
+        int best = -1;
+        double best_d = 0.0;
+        unsigned best_nf = 0;
+        for (int f = 0; f < CM_FP_NUM_FODS; f++) {
+            if (!(ctx->fod_set[f] & bit)) continue;
+            double d = cm_fp_group_err(ctx, f, group[f] | bit) -
+                       cm_fp_group_err(ctx, f, group[f]);
+            unsigned nf = (group[f] == 0);
+            if (!isfinite(d)) continue;
+            if (best < 0 || cm_fp_better(d, nf, best_d, best_nf)) {
+                best = f;
+                best_d = d;
+                best_nf = nf;
+            }
+        }
+        if (best < 0) return -2;
+        group[best] |= bit;
+        fod_of[i] = best;
+    }
+
+    for (int improved = 1; improved && !cm_fp_past(ctx->deadline);) {
+        improved = 0;
+        for (size_t i = 0; i < ctx->nreq; i++) {
+            unsigned bit = 1u << i;
+            int from = fod_of[i];
+            for (int to = 0; to < CM_FP_NUM_FODS; to++) {
+                if (to == from || !(ctx->fod_set[to] & bit)) continue;
+                double old_e = cm_fp_group_err(ctx, from, group[from]) +
+                               cm_fp_group_err(ctx, to, group[to]);
+                double new_e = cm_fp_group_err(ctx, from, group[from] & ~bit) +
+                               cm_fp_group_err(ctx, to, group[to] | bit);
+                unsigned old_nf = (group[from] != 0) + (group[to] != 0);
+                unsigned new_nf = ((group[from] & ~bit) != 0) + 1;
+                if (!cm_fp_better(new_e, new_nf, old_e, old_nf)) continue;
+
+                group[from] &= ~bit;
+                group[to] |= bit;
+                fod_of[i] = to;
+                from = to;
+                improved = 1;
+            }
+            if (cm_fp_past(ctx->deadline)) break;
+        }
+    }
+    return 0;
+}
+
+int cm_fp_plan_outputs(const cm_fp_request_t *req, size_t nreq,
+                       const cm_fp_topology_t *topo, cm_fp_mode_t mode,
+                       unsigned budget_ms, cm_fp_multi_plan_t *plan)
+{
+    if (!req || !plan || nreq == 0 || nreq > CM_FP_NUM_OUTPUTS) return -1;
+    if (!topo) topo = &cm_fp_topology_any;
+    if (!budget_ms) budget_ms = CM_FP_BUDGET_MS;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += budget_ms / 1000u;
+    deadline.tv_nsec += (long)(budget_ms % 1000u) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    cm_fp_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.req = req;
+    ctx.nreq = nreq;
+    ctx.topo = topo;
+    ctx.deadline = (mode == CM_FP_MODE_EXACT) ? NULL : &deadline;
+
+    unsigned seen = 0;
+    for (size_t i = 0; i < nreq; i++) {
+        unsigned q = req[i].output;
+        if (q >= CM_FP_NUM_OUTPUTS || (seen & (1u << q)) || !topo->fod_mask[q] ||
+            !req[i].freq.num || !req[i].freq.den)
+            return -1;
+        seen |= 1u << q;
+        for (int f = 0; f < CM_FP_NUM_FODS; f++)
+            if (topo->fod_mask[q] & (1u << f)) ctx.fod_set[f] |= 1u << i;
+    }
+
+    const size_t slots = (size_t)(CM_FP_NUM_FODS + 1) * CM_FP_SETS;
+    ctx.err = (double *)malloc(slots * sizeof(*ctx.err));
+    ctx.known = (uint8_t *)calloc(slots, 1);
+    if (!ctx.err || !ctx.known) {
+        free(ctx.err);
+        free(ctx.known);
+        return -1;
+    }
+
+    unsigned group[CM_FP_NUM_FODS] = {0};
+    int rc = (mode == CM_FP_MODE_EXACT) ? cm_fp_assign_exact(&ctx, group)
+                                        : cm_fp_assign_heuristic(&ctx, group);
+
+    if (rc == 0) {
+        memset(plan, 0, sizeof(*plan));
+        plan->nreq = nreq;
+        plan->exact = 1;
+        plan->optimal = (mode == CM_FP_MODE_EXACT);
+
+        for (int f = 0; f < CM_FP_NUM_FODS && rc == 0; f++) {
+            if (!group[f]) continue;
+            rc = cm_fp_group_plan(&ctx, f, group[f], &plan->fod[f]);
+            if (rc) break;
+            plan->nfods++;
+            plan->exact &= plan->fod[f].exact;
+
+            size_t k = 0;
+            for (size_t i = 0; i < nreq; i++) {
+                if (!(group[f] & (1u << i))) continue;
+                cm_fp_output_plan_t *o = &plan->out[i];
+                o->fod = f;
+                o->div = plan->fod[f].div[k];
+                o->actual = plan->fod[f].actual[k];
+                o->err_ppb = plan->fod[f].err_ppb[k];
+                plan->total_err_ppb += fabs(o->err_ppb);
+                k++;
+            }
+        }
+    }
+
+    free(ctx.err);
+    free(ctx.known);
+    return rc;
+}
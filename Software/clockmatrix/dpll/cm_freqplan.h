@@ -0,0 +1,204 @@
+// cm_freqplan.h
+// Exact rational frequency planning for the 8A34004 (128-bit integer math).
+//
+// Frequencies are reduced fractions num/den Hz. Whether a plan is exact is
+// decided with integer arithmetic only; the ppb figures are derived from the
+// exact error fraction for display.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned __int128 cm_u128;
+
+// A positive frequency in Hz: num / den, reduced, den > 0.
+typedef struct {
+    uint64_t num;
+    uint64_t den;
+} cm_freq_t;
+
+// Hardware bounds the planner must respect.
+typedef struct {
+    uint64_t dco_min_hz;  // FOD/DCO range, inclusive, integer Hz
+    uint64_t dco_max_hz;
+    uint64_t max_m;       // FOD M: 48-bit
+    uint32_t max_n;       // FOD N: 16-bit (register 0 encodes N=1)
+    uint32_t max_div;     // output integer divider: 32-bit
+} cm_fp_limits_t;
+
+extern const cm_fp_limits_t cm_fp_limits_8a34004;
+
+// Bump whenever a solver can return a different plan for the same request;
+// persisted plans (cm_plancache) from other versions are discarded.
+#define CM_FP_PLANNER_VERSION 2u
+
+#define CM_FP_MAX_OUTPUTS 16
+
+// Approximate search gives up after this many anchor dividers. The 1PPS path
+// of cm_fp_plan_dco() has no limit: it is taken when no exact plan exists,
+// one target is exactly 1 Hz and the highest target is above 1 Hz. All
+// other requests use the limited search and report exhaustive = 0 when it
+// stops. That includes a 1 Hz output whose companions are all at or below
+// 1 Hz (e.g. 0.314 Hz): the search is anchored on the 1 Hz target, so the
+// DCO is still integer Hz and 1PPS stays exact, but only the first
+// CM_FP_MAX_STEPS DCOs are tried.
+#define CM_FP_MAX_STEPS 1000000u
+
+// One DCO (FOD) driving nout outputs through integer dividers.
+typedef struct {
+    uint64_t  m;            // DCO = m / n Hz exactly
+    uint32_t  n;
+    uint16_t  n_reg;        // chip encoding of n (0 means 1)
+    cm_freq_t dco;
+    size_t    nout;
+    uint32_t  div[CM_FP_MAX_OUTPUTS];
+    cm_freq_t actual[CM_FP_MAX_OUTPUTS];   // dco / div[i], reduced
+    int       err_sign[CM_FP_MAX_OUTPUTS]; // -1, 0, +1: sign of actual - target
+    double    err_ppb[CM_FP_MAX_OUTPUTS];  // (actual - target) / target * 1e9
+    int       exact;        // 1 if every output is exact (proven, not rounded)
+    int       exhaustive;   // 0 if the approximate search hit CM_FP_MAX_STEPS
+} cm_fp_plan_t;
+
+// ---------------------------------------------------------------------------
+// Rational frequencies
+// ---------------------------------------------------------------------------
+
+// Build num/den (reduced). Returns -1 if den == 0 or num == 0.
+int cm_freq_make(uint64_t num, uint64_t den, cm_freq_t *out);
+
+// Parse "156.25e6", "161132812.5", "10000000/3" or "1" exactly.
+// Returns 0 on success, -1 on syntax error, -2 on overflow / zero.
+int cm_freq_parse(const char *s, cm_freq_t *out);
+
+// Simplest fraction that converts back to exactly hz (e.g. 10e6/3.0 gives
+// 10000000/3). Returns -1 for non-positive or unrepresentable values.
+int cm_freq_from_double(double hz, cm_freq_t *out);
+
+double cm_freq_to_double(cm_freq_t f);
+
+// Returns <0, 0, >0 like strcmp.
+int cm_freq_cmp(cm_freq_t a, cm_freq_t b);
+
+// Print f into buf as "num" or "num/den". Returns buf.
+const char *cm_freq_str(cm_freq_t f, char *buf, size_t len);
+
+// ---------------------------------------------------------------------------
+// Solvers
+// ---------------------------------------------------------------------------
+
+// The exact value of a double as num/den (den a power of two <= 2^96).
+// Returns -1 for non-positive, non-finite or too small / too large values.
+int cm_fp_exact_double(double x, cm_u128 *num, cm_u128 *den);
+
+// Closest m/n to num/den with 1 <= n <= max_n and 1 <= m <= max_m
+// (continued-fraction convergents + best semiconvergent). num and den must
+// be below 2^96. Returns 0 on success, -1 if no m >= 1 fits.
+int cm_fp_best_ratio(cm_u128 num, cm_u128 den, uint64_t max_m, uint32_t max_n,
+                     uint64_t *m_out, uint32_t *n_out);
+
+// Plan one DCO + integer dividers for n targets (lim NULL = 8A34004).
+//
+// If any exact plan exists it is returned (plan->exact = 1), preferring the
+// smallest N and then the lowest DCO. The candidates are the multiples of
+// lcm(num_i)/gcd(den_i) inside the DCO range, so nothing is scanned.
+// Otherwise the DCO is anchored on the highest target and the plan with the
+// smallest total relative error is returned (plan->exact = 0). With a 1 Hz
+// target and a higher one, the DCO is kept to integer Hz so the 1PPS output
+// stays exact, and the whole anchor range is searched (split across threads
+// when large) instead of stopping at CM_FP_MAX_STEPS.
+//
+// Returns 0 on success, -1 on bad arguments, -2 if no DCO in range can
+// produce the targets with in-range dividers.
+int cm_fp_plan_dco(const cm_freq_t *targets, size_t n,
+                   const cm_fp_limits_t *lim, cm_fp_plan_t *plan);
+
+// ---------------------------------------------------------------------------
+// Batch planning (library callers: no output, one call for many candidates)
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    CM_FP_BATCH_INPUT = 0,   // input M/N for freq[0]; plan->div[0] = 1
+    CM_FP_BATCH_DCO   = 1,   // cm_fp_plan_dco(freq, nfreq)
+} cm_fp_batch_kind_t;
+
+typedef struct {
+    cm_fp_batch_kind_t kind;
+    size_t             nfreq;                    // 1 for CM_FP_BATCH_INPUT
+    cm_freq_t          freq[CM_FP_MAX_OUTPUTS];
+} cm_fp_batch_req_t;
+
+typedef struct {
+    int          rc;         // what the single-request solver returned
+    int          shared;     // 1 if copied from an identical earlier request
+    cm_fp_plan_t plan;       // valid when rc == 0
+} cm_fp_batch_res_t;
+
+// Plan every request (lim NULL = 8A34004). Identical requests are solved
+// once and the plan shared. Returns the number of requests with rc == 0, or
+// -1 on bad arguments / out of memory. Never prints.
+int cm_fp_plan_batch(const cm_fp_batch_req_t *req, size_t n,
+                     const cm_fp_limits_t *lim, cm_fp_batch_res_t *res);
+
+// ---------------------------------------------------------------------------
+// Multi-output planning (every FOD / output of the chip)
+// ---------------------------------------------------------------------------
+
+#define CM_FP_NUM_FODS    8     // DPLL_Ctrl instances (FOD_FREQ_M/N)
+#define CM_FP_NUM_OUTPUTS 12    // Output instances Q0..Q11 (OUT_DIV)
+
+// Which FODs may drive each output, and FODs whose DCO must not change.
+typedef struct {
+    uint8_t   fod_mask[CM_FP_NUM_OUTPUTS];   // bit f: Qn may use FOD f
+    cm_freq_t fixed_dco[CM_FP_NUM_FODS];     // num == 0: FOD is free to plan
+} cm_fp_topology_t;
+
+// Any output on any FOD, nothing fixed (what-if planning).
+extern const cm_fp_topology_t cm_fp_topology_any;
+// Switchberry board: Q9 on FOD5 (left at 500 MHz), Q10/Q11 on FOD6.
+extern const cm_fp_topology_t cm_fp_topology_switchberry;
+
+typedef struct {
+    unsigned  output;   // Q index, 0..CM_FP_NUM_OUTPUTS-1
+    cm_freq_t freq;
+} cm_fp_request_t;
+
+typedef enum {
+    CM_FP_MODE_EXACT = 0,      // best assignment (DP over FOD subsets), unbounded
+    CM_FP_MODE_HEURISTIC = 1,  // greedy + local moves within budget_ms
+} cm_fp_mode_t;
+
+typedef struct {
+    int       fod;      // FOD driving the output
+    uint32_t  div;
+    cm_freq_t actual;
+    double    err_ppb;
+} cm_fp_output_plan_t;
+
+typedef struct {
+    size_t              nreq;
+    cm_fp_output_plan_t out[CM_FP_NUM_OUTPUTS];  // in request order
+    cm_fp_plan_t        fod[CM_FP_NUM_FODS];     // fod[f].nout == 0: unused
+    unsigned            nfods;                   // FODs carrying outputs
+    double              total_err_ppb;           // sum of |err_ppb|
+    int                 exact;                   // every output exact
+    int                 optimal;                 // exact mode (full search)
+} cm_fp_multi_plan_t;
+
+// Assign requests to FODs, choosing DCOs and dividers so the total error is
+// minimal and, among equal errors, as few FODs as possible are used.
+// topo NULL = cm_fp_topology_any; budget_ms bounds the heuristic mode
+// (0 = 50 ms), including its DCO searches: past the budget they stop early
+// and the affected plans have exhaustive = 0. Returns 0 on success, -1 on bad arguments (duplicate or
+// unroutable output), -2 if no assignment can produce every request.
+int cm_fp_plan_outputs(const cm_fp_request_t *req, size_t nreq,
+                       const cm_fp_topology_t *topo, cm_fp_mode_t mode,
+                       unsigned budget_ms, cm_fp_multi_plan_t *plan);
+
+#ifdef __cplusplus
+}
+#endif
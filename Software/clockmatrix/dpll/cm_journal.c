@@ -0,0 +1,217 @@
+// cm_journal.c
+// Undo journal for the ClockMatrix register bus (see cm_journal.h).
+
+#include "cm_journal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Per-address state bits (cm_journal_t.state[]).
+#define CM_JOURNAL_CONFIG   0x01u  // named by at least one CM_REG_CONFIG register
+#define CM_JOURNAL_VOLATILE 0x02u  // named by at least one CM_REG_VOLATILE register
+#define CM_JOURNAL_SAVED    0x04u  // orig[] holds the value before begin()
+
+static int cm_journal_restorable(uint8_t st)
+{
+    // Same rule as the shadow cache: a volatile descriptor always wins.
+    return (st & (CM_JOURNAL_CONFIG | CM_JOURNAL_VOLATILE)) == CM_JOURNAL_CONFIG;
+}
+
+static size_t cm_journal_clip(uint16_t addr, size_t len)
+{
+    size_t room = CM_JOURNAL_SPACE - (size_t)addr;
+    return (len < room) ? len : room;
+}
+
+// Read the current value of every restorable, not yet saved byte in
+// [addr, addr + len), one burst per run of such bytes.
+static void cm_journal_save(cm_journal_t *j, uint16_t addr, size_t len)
+{
+    len = cm_journal_clip(addr, len);
+    size_t i = 0;
+    while (i < len) {
+        const uint8_t st = j->state[(size_t)addr + i];
+        if (!cm_journal_restorable(st) || (st & CM_JOURNAL_SAVED)) {
+            i++;
+            continue;
+        }
+        size_t n = 1;
+        while (i + n < len) {
+            const uint8_t s2 = j->state[(size_t)addr + i + n];
+            if (!cm_journal_restorable(s2) || (s2 & CM_JOURNAL_SAVED)) break;
+            n++;
+        }
+        const uint16_t a = (uint16_t)(addr + i);
+        if (j->lower.read(j->lower.user, a, &j->orig[a], n) != 0) {
+            j->err = 1;
+        } else {
+            for (size_t k = 0; k < n; k++) j->state[(size_t)a + k] |= CM_JOURNAL_SAVED;
+        }
+        i += n;
+    }
+}
+
+static void cm_journal_log(cm_journal_t *j, uint16_t addr, size_t len)
+{
+    if (j->nops == j->cap) {
+        size_t cap = j->cap ? j->cap * 2 : 64;
+        cm_journal_op_t *ops = (cm_journal_op_t *)realloc(j->ops, cap * sizeof(*ops));
+        if (!ops) {
+            j->err = 1;
+            return;
+        }
+        j->ops = ops;
+        j->cap = cap;
+    }
+    j->ops[j->nops].addr = addr;
+    j->ops[j->nops].len = (uint16_t)cm_journal_clip(addr, len);
+    j->nops++;
+}
+
+// ---------------------------------------------------------------------------
+// cm_bus_t callbacks (user points to the cm_journal_t)
+// ---------------------------------------------------------------------------
+
+static int cm_journal_rc(cm_journal_t *j, int rc)
+{
+    if (rc) j->errors++;
+    return rc;
+}
+
+static int cm_journal_read8(void *user, uint16_t addr, uint8_t *val)
+{
+    cm_journal_t *j = (cm_journal_t *)user;
+    return cm_journal_rc(j, j->lower.read8(j->lower.user, addr, val));
+}
+
+static int cm_journal_read(void *user, uint16_t addr, uint8_t *buf, size_t len)
+{
+    cm_journal_t *j = (cm_journal_t *)user;
+    return cm_journal_rc(j, j->lower.read(j->lower.user, addr, buf, len));
+}
+
+static int cm_journal_write(void *user, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    cm_journal_t *j = (cm_journal_t *)user;
+    if (j->active) {
+        cm_journal_save(j, addr, len);
+        // Logged even if it fails: part of it may have landed.
+        cm_journal_log(j, addr, len);
+    }
+    return cm_journal_rc(j, j->lower.write(j->lower.user, addr, buf, len));
+}
+
+static int cm_journal_write8(void *user, uint16_t addr, uint8_t val)
+{
+    cm_journal_t *j = (cm_journal_t *)user;
+    if (j->active) {
+        cm_journal_save(j, addr, 1);
+        cm_journal_log(j, addr, 1);
+    }
+    return cm_journal_rc(j, j->lower.write8(j->lower.user, addr, val));
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+int cm_journal_init(cm_journal_t *j, const cm_bus_t *lower)
+{
+    if (!j || !lower) return -1;
+    memset(j, 0, sizeof(*j));
+
+    j->orig  = (uint8_t *)calloc(CM_JOURNAL_SPACE, 1);
+    j->state = (uint8_t *)calloc(CM_JOURNAL_SPACE, 1);
+    if (!j->orig || !j->state) {
+        cm_journal_free(j);
+        return -1;
+    }
+    j->lower = *lower;
+
+    for (size_t m = 0; m < cm_all_modules_count; m++) {
+        const cm_module_desc_t *mod = cm_all_modules[m];
+        for (unsigned inst = 0; inst < mod->count; inst++) {
+            for (unsigned r = 0; r < mod->nregs; r++) {
+                const cm_reg_desc_t *reg = &mod->regs[r];
+                uint16_t a = (uint16_t)(mod->bases[inst] + reg->offset);
+                j->state[a] |= (reg->flags & CM_REG_VOLATILE) ? CM_JOURNAL_VOLATILE
+                                                               : CM_JOURNAL_CONFIG;
+            }
+        }
+    }
+    return 0;
+}
+
+void cm_journal_free(cm_journal_t *j)
+{
+    if (!j) return;
+    free(j->orig);
+    free(j->state);
+    free(j->ops);
+    j->orig = NULL;
+    j->state = NULL;
+    j->ops = NULL;
+    j->nops = j->cap = 0;
+}
+
+void cm_journal_bus(cm_journal_t *j, cm_bus_t *bus_out)
+{
+    if (!j || !bus_out) return;
+    bus_out->user   = j;
+    bus_out->read8  = cm_journal_read8;
+    bus_out->write8 = cm_journal_write8;
+    bus_out->read   = cm_journal_read;
+    bus_out->write  = cm_journal_write;
+}
+
+void cm_journal_begin(cm_journal_t *j)
+{
+    if (!j || !j->state) return;
+    for (size_t a = 0; a < CM_JOURNAL_SPACE; a++)
+        j->state[a] &= (uint8_t)~CM_JOURNAL_SAVED;
+    j->nops = 0;
+    j->err = 0;
+    j->active = 1;
+}
+
+void cm_journal_commit(cm_journal_t *j)
+{
+    if (!j) return;
+    j->active = 0;
+    j->nops = 0;
+}
+
+int cm_journal_rollback(cm_journal_t *j, size_t *restored_out, size_t *skipped_out)
+{
+    size_t restored = 0, skipped = 0;
+    int rc = 0;
+    if (!j || !j->state) return -1;
+    j->active = 0;
+
+    for (size_t o = 0; o < j->nops; o++) {
+        const cm_journal_op_t *op = &j->ops[o];
+        size_t i = 0;
+        while (i < op->len) {
+            const size_t a = (size_t)op->addr + i;
+            if (!(j->state[a] & CM_JOURNAL_SAVED)) {
+                skipped++;
+                i++;
+                continue;
+            }
+            // Longest run of saved bytes, written back as one burst.
+            size_t n = 1;
+            while (i + n < op->len && (j->state[a + n] & CM_JOURNAL_SAVED)) n++;
+            int wrc = (n == 1) ? j->lower.write8(j->lower.user, (uint16_t)a, j->orig[a])
+                               : j->lower.write(j->lower.user, (uint16_t)a, &j->orig[a], n);
+            if (wrc != 0) rc = -1;
+            restored += n;
+            i += n;
+        }
+    }
+    if (j->err) rc = -1;
+
+    j->nops = 0;
+    if (restored_out) *restored_out = restored;
+    if (skipped_out) *skipped_out = skipped;
+    return rc;
+}
@@ -0,0 +1,77 @@
+// cm_journal.h
+//
+// Undo journal for the ClockMatrix register bus.
+//
+// cm_journal wraps a cm_bus_t like cm_shadow does. Between cm_journal_begin()
+// and cm_journal_commit() / cm_journal_rollback() every write is logged: the
+// first write to a configuration register (CM_REG_CONFIG in the tables) reads
+// its current value from the device, and each write appends (addr, len) to
+// the log. Reads pass straight through.
+//
+// cm_journal_rollback() replays the logged writes in their original order with
+// the pre-transaction contents. Module blocks on the 8A3400x take effect when
+// their trigger register (e.g. DPLL_MODE, INPUT_IN_MODE) is written, so
+// replaying forward re-fires each trigger with the old block already in place.
+// Volatile registers (status, sticky, command) and addresses the tables do not
+// name are never read back or restored; rollback reports how many such bytes
+// were written.
+//
+// Writes that bypass the bus (raw dpll_write8() on the fd, TCS / programming
+// file apply, EEPROM) are not seen and cannot be undone.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t + table descriptors
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_JOURNAL_SPACE 0x10000u
+
+typedef struct {
+    uint16_t addr;
+    uint16_t len;
+} cm_journal_op_t;
+
+typedef struct cm_journal {
+    cm_bus_t         lower;
+    uint8_t         *orig;     // CM_JOURNAL_SPACE bytes: value before begin()
+    uint8_t         *state;    // CM_JOURNAL_SPACE bytes: per-address CM_JOURNAL_* bits
+    cm_journal_op_t *ops;      // writes since begin(), in order
+    size_t           nops;
+    size_t           cap;
+    int              active;   // between begin() and commit() / rollback()
+    int              err;      // a pre-read or log append failed: rollback is incomplete
+    uint64_t         errors;   // bus ops through the journal that failed; lets a
+                               // caller catch errors a command did not report
+} cm_journal_t;
+
+// Build the restorable-address map from the tables and take a copy of *lower.
+// Returns 0, or -1 on allocation failure.
+int  cm_journal_init(cm_journal_t *j, const cm_bus_t *lower);
+
+void cm_journal_free(cm_journal_t *j);
+
+// Fill *bus_out with a bus whose writes go through the journal.
+void cm_journal_bus(cm_journal_t *j, cm_bus_t *bus_out);
+
+// Start logging (drops any previous log).
+void cm_journal_begin(cm_journal_t *j);
+
+// Stop logging and keep the writes.
+void cm_journal_commit(cm_journal_t *j);
+
+// Stop logging and restore the pre-begin() contents of every configuration
+// register written since begin(). *restored_out / *skipped_out (may be NULL)
+// receive the bytes written back and the non-restorable bytes that had been
+// written. Returns 0, or -1 if a restore write failed or the log was
+// incomplete (j->err); the remaining writes are still attempted.
+int  cm_journal_rollback(cm_journal_t *j, size_t *restored_out, size_t *skipped_out);
+
+#ifdef __cplusplus
+}
+#endif
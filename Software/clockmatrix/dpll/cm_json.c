@@ -0,0 +1,135 @@
+// cm_json.c
+// Minimal streaming JSON writer (see cm_json.h).
+
+#include "cm_json.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+void cm_json_init(cm_json_t *j, FILE *out)
+{
+    memset(j, 0, sizeof(*j));
+    j->out = out;
+}
+
+static void cm_json_puts_escaped(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+        switch (*p) {
+        case '"':  fputs("\\\"", out); break;
+        case '\\': fputs("\\\\", out); break;
+        case '\n': fputs("\\n", out); break;
+        case '\r': fputs("\\r", out); break;
+        case '\t': fputs("\\t", out); break;
+        default:
+            if (*p < 0x20)
+                fprintf(out, "\\u%04x", (unsigned)*p);
+            else
+                fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Comma and "key": in front of the next member of the current level.
+// Returns -1 (nothing written) inside a level refused by cm_json_open().
+static int cm_json_member(cm_json_t *j, const char *key)
+{
+    if (j->skip) return -1;
+    if (j->depth == 0) return 0;
+    const unsigned d = j->depth - 1;
+    if (j->more[d]) fputc(',', j->out);
+    j->more[d] = 1;
+    if (!j->inarr[d] && key) {
+        cm_json_puts_escaped(j->out, key);
+        fputc(':', j->out);
+    }
+    return 0;
+}
+
+static int cm_json_open(cm_json_t *j, const char *key, int arr)
+{
+    if (j->skip || j->depth >= CM_JSON_MAX_DEPTH) {
+        j->skip++;
+        j->err = 1;
+        return -1;
+    }
+    cm_json_member(j, key);
+    fputc(arr ? '[' : '{', j->out);
+    j->inarr[j->depth] = (uint8_t)arr;
+    j->more[j->depth] = 0;
+    j->depth++;
+    return 0;
+}
+
+static void cm_json_close(cm_json_t *j, int arr)
+{
+    if (j->skip) {
+        j->skip--;
+        return;
+    }
+    if (j->depth) j->depth--;
+    fputc(arr ? ']' : '}', j->out);
+}
+
+int cm_json_obj_begin(cm_json_t *j, const char *key) { return cm_json_open(j, key, 0); }
+void cm_json_obj_end(cm_json_t *j) { cm_json_close(j, 0); }
+int cm_json_arr_begin(cm_json_t *j, const char *key) { return cm_json_open(j, key, 1); }
+void cm_json_arr_end(cm_json_t *j) { cm_json_close(j, 1); }
+
+void cm_json_str(cm_json_t *j, const char *key, const char *val)
+{
+    if (cm_json_member(j, key)) return;
+    if (val)
+        cm_json_puts_escaped(j->out, val);
+    else
+        fputs("null", j->out);
+}
+
+void cm_json_int(cm_json_t *j, const char *key, int64_t val)
+{
+    if (cm_json_member(j, key)) return;
+    fprintf(j->out, "%lld", (long long)val);
+}
+
+void cm_json_uint(cm_json_t *j, const char *key, uint64_t val)
+{
+    if (cm_json_member(j, key)) return;
+    fprintf(j->out, "%llu", (unsigned long long)val);
+}
+
+void cm_json_double(cm_json_t *j, const char *key, double val)
+{
+    if (cm_json_member(j, key)) return;
+    if (!isfinite(val)) {
+        fputs("null", j->out);
+        return;
+    }
+    // Shortest of %.15g / %.16g / %.17g that reads back as the same double
+    char buf[32];
+    for (int prec = 15; prec <= 17; prec++) {
+        snprintf(buf, sizeof(buf), "%.*g", prec, val);
+        if (strtod(buf, NULL) == val) break;
+    }
+    fputs(buf, j->out);
+}
+
+void cm_json_bool(cm_json_t *j, const char *key, int val)
+{
+    if (cm_json_member(j, key)) return;
+    fputs(val ? "true" : "false", j->out);
+}
+
+void cm_json_null(cm_json_t *j, const char *key)
+{
+    if (cm_json_member(j, key)) return;
+    fputs("null", j->out);
+}
+
+void cm_json_newline(cm_json_t *j)
+{
+    fputc('\n', j->out);
+    fflush(j->out);
+}
@@ -0,0 +1,63 @@
+// cm_json.h
+//
+// Minimal streaming JSON writer for dplltool --json.
+//
+// Output is compact (no whitespace) and written straight to a FILE*; the
+// writer only tracks, per nesting level, whether a comma is due. Keys are
+// passed with each value and ignored inside arrays (pass NULL there).
+//
+//   cm_json_t j;
+//   cm_json_init(&j, stdout);
+//   cm_json_obj_begin(&j, NULL);
+//   cm_json_str(&j, "state", "LOCKED");
+//   cm_json_obj_end(&j);          // {"state":"LOCKED"}
+//   cm_json_newline(&j);
+//
+// Doubles are written with the fewest digits (15..17) that read back to the
+// same value; NaN and infinities become null.
+//
+// At most CM_JSON_MAX_DEPTH levels nest. A begin past that returns -1 and
+// sets err; that object/array, everything written into it and its matching
+// end are dropped, so the output stays balanced.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_JSON_MAX_DEPTH 8
+
+typedef struct {
+    FILE    *out;
+    unsigned depth;                     // open levels, <= CM_JSON_MAX_DEPTH
+    unsigned skip;                      // levels refused past the limit, still open
+    int      err;                       // a begin was refused
+    uint8_t  inarr[CM_JSON_MAX_DEPTH];  // level is an array: keys are not written
+    uint8_t  more[CM_JSON_MAX_DEPTH];   // level already has a member
+} cm_json_t;
+
+void cm_json_init(cm_json_t *j, FILE *out);
+
+// Return 0, or -1 if the level would exceed CM_JSON_MAX_DEPTH.
+int  cm_json_obj_begin(cm_json_t *j, const char *key);
+void cm_json_obj_end(cm_json_t *j);
+int  cm_json_arr_begin(cm_json_t *j, const char *key);
+void cm_json_arr_end(cm_json_t *j);
+
+void cm_json_str(cm_json_t *j, const char *key, const char *val);   // NULL -> null
+void cm_json_int(cm_json_t *j, const char *key, int64_t val);
+void cm_json_uint(cm_json_t *j, const char *key, uint64_t val);
+void cm_json_double(cm_json_t *j, const char *key, double val);
+void cm_json_bool(cm_json_t *j, const char *key, int val);
+void cm_json_null(cm_json_t *j, const char *key);
+
+// End a top-level value: "\n" and flush, so line-based readers see it now.
+void cm_json_newline(cm_json_t *j);
+
+#ifdef __cplusplus
+}
+#endif
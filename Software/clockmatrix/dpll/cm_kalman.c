@@ -0,0 +1,155 @@
+// cm_kalman.c
+// Clock-model Kalman filter for phase-error measurements (see cm_kalman.h).
+
+#include "cm_kalman.h"
+
+#include <math.h>
+#include <string.h>
+
+// Prior on the drift state at (re)start: 1e-11 /s is far above any OCXO/TCXO.
+#define CM_KF_DRIFT_SIGMA0  1e-11
+
+void cm_kf_default_cfg(cm_kf_cfg_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->nstates = 3;
+    cfg->q_phase = 1e-20;          // ~1e-10 ADEV at 1 s
+    cfg->q_freq = 1e-22;
+    cfg->q_drift = 1e-30;
+    cfg->r0 = 20e-9 * 20e-9;       // 20 ns rms 1PPS until adapted
+    cfg->r_min = 1e-12 * 1e-12;
+    cfg->adapt_n = 32;
+    cfg->gate_sigma = 5.0;
+}
+
+int cm_kf_init(cm_kf_t *kf, const cm_kf_cfg_t *cfg)
+{
+    if (!kf || !cfg) return -1;
+    if (cfg->nstates < 2 || cfg->nstates > CM_KF_MAX_STATES) return -1;
+    if (!(cfg->r0 > 0.0) || cfg->r_min < 0.0 || cfg->q_phase < 0.0 || cfg->q_freq < 0.0 ||
+        cfg->q_drift < 0.0 || cfg->gate_sigma < 0.0)
+        return -1;
+
+    memset(kf, 0, sizeof(*kf));
+    kf->cfg = *cfg;
+    kf->r = cfg->r0;
+    return 0;
+}
+
+void cm_kf_reset(cm_kf_t *kf, double freq, double freq_var)
+{
+    kf->init = 0;
+    kf->freq0 = freq;
+    kf->freq0_var = freq_var;
+    kf->consec_rejects = 0;
+}
+
+void cm_kf_predict(cm_kf_t *kf, double dt, double u)
+{
+    if (!kf->init || !(dt > 0.0)) return;
+
+    const unsigned n = kf->cfg.nstates;
+    const double dt2 = dt * dt, dt3 = dt2 * dt;
+    double F[CM_KF_MAX_STATES][CM_KF_MAX_STATES] = {
+        {1.0, dt, 0.5 * dt2},
+        {0.0, 1.0, dt},
+        {0.0, 0.0, 1.0},
+    };
+    if (n == 2) F[0][2] = F[1][2] = 0.0;
+
+    // x = F x + B u, B = [-dt, 0, 0]
+    double x[CM_KF_MAX_STATES] = {0};
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++) x[i] += F[i][j] * kf->x[j];
+    x[0] -= u * dt;
+    memcpy(kf->x, x, sizeof(x));
+
+    // P = F P F^T + Q
+    double FP[CM_KF_MAX_STATES][CM_KF_MAX_STATES] = {{0}};
+    double P[CM_KF_MAX_STATES][CM_KF_MAX_STATES] = {{0}};
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++)
+            for (unsigned k = 0; k < n; k++) FP[i][j] += F[i][k] * kf->P[k][j];
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++)
+            for (unsigned k = 0; k < n; k++) P[i][j] += FP[i][k] * F[j][k];
+
+    const double q1 = kf->cfg.q_phase, q2 = kf->cfg.q_freq;
+    P[0][0] += q1 * dt + q2 * dt3 / 3.0;
+    P[0][1] += q2 * dt2 / 2.0;
+    P[1][0] += q2 * dt2 / 2.0;
+    P[1][1] += q2 * dt;
+    if (n == 3) {
+        const double q3 = kf->cfg.q_drift;
+        P[0][0] += q3 * dt3 * dt2 / 20.0;
+        P[0][1] += q3 * dt2 * dt2 / 8.0;
+        P[1][0] += q3 * dt2 * dt2 / 8.0;
+        P[0][2] += q3 * dt3 / 6.0;
+        P[2][0] += q3 * dt3 / 6.0;
+        P[1][1] += q3 * dt3 / 3.0;
+        P[1][2] += q3 * dt2 / 2.0;
+        P[2][1] += q3 * dt2 / 2.0;
+        P[2][2] += q3 * dt;
+    }
+    memcpy(kf->P, P, sizeof(P));
+}
+
+int cm_kf_update(cm_kf_t *kf, double z)
+{
+    const unsigned n = kf->cfg.nstates;
+
+    if (!kf->init) {
+        memset(kf->x, 0, sizeof(kf->x));
+        memset(kf->P, 0, sizeof(kf->P));
+        kf->x[0] = z;
+        kf->x[1] = kf->freq0;
+        kf->P[0][0] = kf->r;
+        kf->P[1][1] = kf->freq0_var;
+        if (n == 3) kf->P[2][2] = CM_KF_DRIFT_SIGMA0 * CM_KF_DRIFT_SIGMA0;
+        kf->innov = 0.0;
+        kf->innov_var = kf->r;
+        kf->init = 1;
+        kf->updates++;
+        return 0;
+    }
+
+    const double nu = z - kf->x[0];
+    const double p00 = kf->P[0][0];
+    double S = p00 + kf->r;
+    kf->innov = nu;
+    kf->innov_var = S;
+
+    // Gate only once the filter has settled, and never lock itself out.
+    const int settled = kf->updates > n;
+    if (settled && kf->cfg.gate_sigma > 0.0 &&
+        nu * nu > kf->cfg.gate_sigma * kf->cfg.gate_sigma * S &&
+        kf->consec_rejects < CM_KF_MAX_REJECTS) {
+        kf->consec_rejects++;
+        kf->rejected++;
+        return 1;
+    }
+    kf->consec_rejects = 0;
+
+    // Covariance matching: E[nu^2] = P00 + R.
+    if (settled && kf->cfg.adapt_n > 0) {
+        const double a = 1.0 / (double)kf->cfg.adapt_n;
+        double c = nu * nu - p00;
+        if (c < kf->cfg.r_min) c = kf->cfg.r_min;
+        kf->r = (1.0 - a) * kf->r + a * c;
+        S = p00 + kf->r;
+    }
+
+    double K[CM_KF_MAX_STATES];
+    for (unsigned i = 0; i < n; i++) K[i] = kf->P[i][0] / S;
+    for (unsigned i = 0; i < n; i++) kf->x[i] += K[i] * nu;
+
+    // P = (I - K H) P, kept symmetric
+    double P[CM_KF_MAX_STATES][CM_KF_MAX_STATES];
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++) P[i][j] = kf->P[i][j] - K[i] * kf->P[0][j];
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++) kf->P[i][j] = 0.5 * (P[i][j] + P[j][i]);
+
+    kf->updates++;
+    return 0;
+}
@@ -0,0 +1,83 @@
+// cm_kalman.h
+//
+// Clock-model Kalman filter for phase-error measurements.
+//
+// State (3-state mode; 2-state mode drops the drift term):
+//   x[0] phase      seconds, the measured phase error
+//   x[1] frequency  fractional, the phase slope with no steering applied
+//   x[2] drift      1/s, the frequency slope
+//
+// Model over one interval dt with a steering command u (fractional frequency
+// written to DPLL_WR_FREQ; positive u makes the phase fall, the same polarity
+// as the PI servo in cm_discipline.c):
+//
+//   phase' = phase + (freq - u) dt + drift dt^2 / 2
+//   freq'  = freq + drift dt
+//   drift' = drift
+//
+// Process noise is the usual clock model: white FM (q_phase, s^2/s),
+// random-walk FM (q_freq, 1/s) and random-walk drift (q_drift, 1/s^3),
+// integrated over dt. The measurement variance R starts at r0 and, with
+// adapt_n > 0, follows the innovations (covariance matching over roughly the
+// last adapt_n samples), so a noisy 1PPS source automatically gets a smaller
+// gain and a clean one a larger gain. Innovations beyond gate_sigma standard
+// deviations are rejected as outliers, but never more than a few in a row.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_KF_MAX_STATES      3
+#define CM_KF_MAX_REJECTS     3     // consecutive gated samples before one is forced in
+
+typedef struct {
+    unsigned nstates;         // 2 (phase, freq) or 3 (+ drift)
+    double   q_phase;         // white FM, s^2/s
+    double   q_freq;          // random-walk FM, 1/s
+    double   q_drift;         // random-walk drift, 1/s^3 (3-state only)
+    double   r0;              // initial measurement variance, s^2
+    double   r_min;           // floor for the adapted variance, s^2
+    unsigned adapt_n;         // innovation averaging length (0 = fixed R)
+    double   gate_sigma;      // reject |innovation| > gate_sigma * sqrt(S) (0 = off)
+} cm_kf_cfg_t;
+
+typedef struct {
+    cm_kf_cfg_t cfg;
+    int      init;            // 0 until the first measurement
+    double   x[CM_KF_MAX_STATES];
+    double   P[CM_KF_MAX_STATES][CM_KF_MAX_STATES];
+    double   r;               // current measurement variance, s^2
+
+    double   freq0, freq0_var;  // prior used by the first measurement
+
+    double   innov;           // last innovation, s
+    double   innov_var;       // its predicted variance S, s^2
+    uint64_t updates;
+    uint64_t rejected;
+    unsigned consec_rejects;
+} cm_kf_t;
+
+// Fill cfg with defaults for a DPLL steered from a GNSS 1PPS.
+void cm_kf_default_cfg(cm_kf_cfg_t *cfg);
+
+// Returns 0, or -1 on a bad configuration.
+int  cm_kf_init(cm_kf_t *kf, const cm_kf_cfg_t *cfg);
+
+// Forget the state. The next measurement sets the phase; freq/freq_var are
+// the prior for the frequency state (e.g. the command already applied).
+void cm_kf_reset(cm_kf_t *kf, double freq, double freq_var);
+
+// Propagate over dt seconds during which command u was applied.
+void cm_kf_predict(cm_kf_t *kf, double dt, double u);
+
+// Fold in a phase measurement z (seconds). Returns 0 if it was used, 1 if it
+// was rejected by the gate.
+int  cm_kf_update(cm_kf_t *kf, double z);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,456 @@
+// cm_metrics.c
+// OpenMetrics exporter for the DPLL monitor (see cm_metrics.h).
+
+#define _GNU_SOURCE
+
+#include "cm_metrics.h"
+
+#include "cm_monitor.h"
+#include "cm_status.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CM_METRICS_CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+#define CM_METRICS_REQ_MAX      2048
+#define CM_METRICS_POLL_MS      250     // stop-flag check interval of the server
+#define CM_METRICS_MAX_APPLY    8       // kinds kept in the apply file
+
+// |phase| bucket upper bounds, seconds.
+static const double cm_metrics_phase_le[CM_METRICS_PHASE_BUCKETS] = {
+    1e-9, 2e-9, 5e-9, 1e-8, 2e-8, 5e-8, 1e-7, 2e-7, 5e-7, 1e-6, 1e-5,
+};
+
+// DPLL_STATE values in the stateset.
+static const uint8_t cm_metrics_states[] = {
+    CM_DPLL_STATE_FREERUN, CM_DPLL_STATE_LOCKACQ,  CM_DPLL_STATE_LOCKREC,
+    CM_DPLL_STATE_LOCKED,  CM_DPLL_STATE_HOLDOVER, CM_DPLL_STATE_DISABLED,
+};
+
+static const char *const cm_metrics_roles[] = {"none", "freq", "gps"};
+
+// ---------------------------------------------------------------------------
+// Monitor hook
+// ---------------------------------------------------------------------------
+
+void cm_metrics_on_poll(const struct cm_mon *mon, int rc, void *user)
+{
+    cm_metrics_t *m = user;
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+
+    pthread_mutex_lock(&m->mu);
+    m->polls = mon->polls;
+    if (rc) {
+        m->poll_errors++;
+        pthread_mutex_unlock(&m->mu);
+        return;
+    }
+
+    m->have_poll = 1;
+    for (unsigned ch = 0; ch < CM_METRICS_NUM_DPLLS; ch++) {
+        cm_metrics_chan_t *c = &m->ch[ch];
+        const cm_mon_chan_t *mc = &mon->ch[ch];
+        c->state = mc->state;
+        c->role = (ch == cfg->freq_ch) ? 1 : 0;
+        for (size_t i = 0; i < cfg->ngps; i++)
+            if (cfg->gps_chans[i] == ch) c->role = 2;
+        c->state_changes = mc->sticky_polls;
+        c->relocks = mc->pulses;
+
+        // Phase is only meaningful with a reference (the monitor's rule).
+        c->has_phase = c->role && mon->snap.has_phase;
+        if (!c->has_phase) continue;
+        c->phase_sec = mon->snap.ch[ch].phase_sec;
+        if (c->state != CM_DPLL_STATE_LOCKED && c->state != CM_DPLL_STATE_LOCKACQ &&
+            c->state != CM_DPLL_STATE_LOCKREC)
+            continue;
+
+        const double a = fabs(c->phase_sec);
+        unsigned b = 0;
+        while (b < CM_METRICS_PHASE_BUCKETS && a > cm_metrics_phase_le[b]) b++;
+        c->hist[b]++;
+        c->abs_phase_count++;
+        c->abs_phase_sum += a;
+    }
+    pthread_mutex_unlock(&m->mu);
+}
+
+// ---------------------------------------------------------------------------
+// Apply durations (written by other dplltool processes)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    char   kind[16];
+    double when;
+    double duration;
+    int    ok;
+} cm_metrics_apply_t;
+
+static size_t cm_metrics_read_apply(const char *path, cm_metrics_apply_t *out, size_t cap)
+{
+    FILE *f = path ? fopen(path, "r") : NULL;
+    if (!f) return 0;
+    size_t n = 0;
+    char line[128];
+    while (n < cap && fgets(line, sizeof(line), f)) {
+        cm_metrics_apply_t *a = &out[n];
+        if (sscanf(line, "%15s %lf %lf %d", a->kind, &a->when, &a->duration, &a->ok) == 4)
+            n++;
+    }
+    fclose(f);
+    return n;
+}
+
+int cm_metrics_record_apply(const char *path, const char *kind, double duration_sec, int ok)
+{
+    cm_metrics_apply_t recs[CM_METRICS_MAX_APPLY];
+    size_t n = cm_metrics_read_apply(path, recs, CM_METRICS_MAX_APPLY - 1);
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+    FILE *f = fopen(tmp, "w");
+    if (!f) return -1;
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(recs[i].kind, kind) == 0) continue;
+        fprintf(f, "%s %.3f %.6f %d\n", recs[i].kind, recs[i].when, recs[i].duration,
+                recs[i].ok);
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    fprintf(f, "%s %.3f %.6f %d\n", kind, (double)now.tv_sec + (double)now.tv_nsec * 1e-9,
+            duration_sec, ok ? 1 : 0);
+    if (fclose(f) != 0 || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Exposition
+// ---------------------------------------------------------------------------
+
+static void cm_metrics_family(FILE *out, const char *name, const char *type,
+                              const char *unit, const char *help)
+{
+    fprintf(out, "# TYPE %s %s\n", name, type);
+    if (unit) fprintf(out, "# UNIT %s %s\n", name, unit);
+    fprintf(out, "# HELP %s %s\n", name, help);
+}
+
+// SPI counters of one cm_busstat_t, op types [0, nops): what = "operation"
+// (cm_bus_t ops) gives switchberry_spi_operations_total, _errors_total, ...;
+// "transfer" (spidev transfers) switchberry_spi_transfers_total,
+// _transfer_errors_total, ... plus the per-module families.
+static void cm_metrics_render_spi(FILE *out, const cm_busstat_t *st, const char *what,
+                                  unsigned nops)
+{
+    static const double q[] = {0.5, 0.9, 0.99, 0.999};
+    cm_busop_stat_t op[CM_BUSOP_COUNT];
+    cm_busmod_stat_t mod[CM_BUSSTAT_MODULES];
+    cm_busstat_snapshot(st, op, mod);
+    const char *sub = strcmp(what, "transfer") == 0 ? "transfer_" : "";
+    char name[96], help[128];
+
+    snprintf(name, sizeof(name), "switchberry_spi_%ss", what);
+    snprintf(help, sizeof(help), "SPI %ss by type.", what);
+    cm_metrics_family(out, name, "counter", NULL, help);
+    for (unsigned i = 0; i < nops; i++)
+        fprintf(out, "%s_total{op=\"%s\"} %llu\n", name, cm_busop_name((cm_busop_t)i),
+                (unsigned long long)op[i].calls);
+
+    snprintf(name, sizeof(name), "switchberry_spi_%serrors", sub);
+    snprintf(help, sizeof(help), "SPI %ss that failed.", what);
+    cm_metrics_family(out, name, "counter", NULL, help);
+    for (unsigned i = 0; i < nops; i++)
+        fprintf(out, "%s_total{op=\"%s\"} %llu\n", name, cm_busop_name((cm_busop_t)i),
+                (unsigned long long)op[i].errors);
+
+    snprintf(name, sizeof(name), "switchberry_spi_%sbytes", sub);
+    snprintf(help, sizeof(help), "SPI payload bytes by %s type.", what);
+    cm_metrics_family(out, name, "counter", "bytes", help);
+    for (unsigned i = 0; i < nops; i++)
+        fprintf(out, "%s_total{op=\"%s\"} %llu\n", name, cm_busop_name((cm_busop_t)i),
+                (unsigned long long)op[i].bytes);
+
+    snprintf(name, sizeof(name), "switchberry_spi_%s_seconds", what);
+    snprintf(help, sizeof(help), "SPI %s latency (quantiles within 12.5%%).", what);
+    cm_metrics_family(out, name, "summary", "seconds", help);
+    for (unsigned i = 0; i < nops; i++) {
+        const char *o = cm_busop_name((cm_busop_t)i);
+        for (size_t k = 0; k < sizeof(q) / sizeof(q[0]); k++)
+            fprintf(out, "%s{op=\"%s\",quantile=\"%g\"} %.9f\n", name, o, q[k],
+                    (double)cm_busop_quantile(&op[i], q[k]) * 1e-9);
+        fprintf(out, "%s_count{op=\"%s\"} %llu\n", name, o, (unsigned long long)op[i].calls);
+        fprintf(out, "%s_sum{op=\"%s\"} %.9f\n", name, o, (double)op[i].ns_sum * 1e-9);
+    }
+
+    snprintf(name, sizeof(name), "switchberry_spi_%s_max_seconds", what);
+    snprintf(help, sizeof(help), "Slowest SPI %s since start.", what);
+    cm_metrics_family(out, name, "gauge", "seconds", help);
+    for (unsigned i = 0; i < nops; i++)
+        fprintf(out, "%s{op=\"%s\"} %.9f\n", name, cm_busop_name((cm_busop_t)i),
+                (double)op[i].ns_max * 1e-9);
+
+    if (!*sub) return;
+
+    cm_metrics_family(out, "switchberry_spi_module_transfers", "counter", NULL,
+                      "SPI transfers by register module of the start address.");
+    for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++)
+        if (mod[i].calls)
+            fprintf(out, "switchberry_spi_module_transfers_total{module=\"%s\"} %llu\n",
+                    cm_busstat_module_name(i), (unsigned long long)mod[i].calls);
+    cm_metrics_family(out, "switchberry_spi_module_bytes", "counter", "bytes",
+                      "SPI payload bytes by register module.");
+    for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++)
+        if (mod[i].calls)
+            fprintf(out, "switchberry_spi_module_bytes_total{module=\"%s\"} %llu\n",
+                    cm_busstat_module_name(i), (unsigned long long)mod[i].bytes);
+    cm_metrics_family(out, "switchberry_spi_module_seconds", "counter", "seconds",
+                      "SPI transfer time by register module.");
+    for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++)
+        if (mod[i].calls)
+            fprintf(out, "switchberry_spi_module_seconds_total{module=\"%s\"} %.9f\n",
+                    cm_busstat_module_name(i), (double)mod[i].ns_sum * 1e-9);
+}
+
+int cm_metrics_render(cm_metrics_t *m, FILE *out)
+{
+    cm_metrics_chan_t ch[CM_METRICS_NUM_DPLLS];
+    pthread_mutex_lock(&m->mu);
+    const int have_poll = m->have_poll;
+    const uint64_t polls = m->polls, poll_errors = m->poll_errors;
+    memcpy(ch, m->ch, sizeof(ch));
+    pthread_mutex_unlock(&m->mu);
+
+    cm_metrics_family(out, "switchberry_monitor_polls", "counter", NULL,
+                      "Monitor poll cycles.");
+    fprintf(out, "switchberry_monitor_polls_total %llu\n", (unsigned long long)polls);
+    cm_metrics_family(out, "switchberry_monitor_poll_errors", "counter", NULL,
+                      "Monitor polls that failed on the bus.");
+    fprintf(out, "switchberry_monitor_poll_errors_total %llu\n",
+            (unsigned long long)poll_errors);
+
+    if (have_poll) {
+        cm_metrics_family(out, "switchberry_dpll_state", "stateset", NULL,
+                          "DPLL_STATE of each DPLL channel.");
+        for (unsigned c = 0; c < CM_METRICS_NUM_DPLLS; c++)
+            for (size_t i = 0; i < sizeof(cm_metrics_states); i++)
+                fprintf(out, "switchberry_dpll_state{dpll=\"%u\",switchberry_dpll_state=\"%s\"} %d\n",
+                        c, dpll_state_str(cm_metrics_states[i]),
+                        ch[c].state == cm_metrics_states[i]);
+
+        cm_metrics_family(out, "switchberry_dpll_phase_offset_seconds", "gauge", "seconds",
+                          "DPLL phase status at the last poll (monitored channels).");
+        for (unsigned c = 0; c < CM_METRICS_NUM_DPLLS; c++)
+            if (ch[c].has_phase)
+                fprintf(out, "switchberry_dpll_phase_offset_seconds{dpll=\"%u\",role=\"%s\"} %.6e\n",
+                        c, cm_metrics_roles[ch[c].role], ch[c].phase_sec);
+
+        cm_metrics_family(out, "switchberry_dpll_abs_phase_offset_seconds", "histogram",
+                          "seconds", "Absolute phase per poll while locked or locking.");
+        for (unsigned c = 0; c < CM_METRICS_NUM_DPLLS; c++) {
+            if (!ch[c].role) continue;
+            uint64_t cum = 0;
+            for (unsigned b = 0; b < CM_METRICS_PHASE_BUCKETS; b++) {
+                cum += ch[c].hist[b];
+                fprintf(out, "switchberry_dpll_abs_phase_offset_seconds_bucket{dpll=\"%u\","
+                             "role=\"%s\",le=\"%g\"} %llu\n",
+                        c, cm_metrics_roles[ch[c].role], cm_metrics_phase_le[b],
+                        (unsigned long long)cum);
+            }
+            fprintf(out, "switchberry_dpll_abs_phase_offset_seconds_bucket{dpll=\"%u\","
+                         "role=\"%s\",le=\"+Inf\"} %llu\n",
+                    c, cm_metrics_roles[ch[c].role], (unsigned long long)ch[c].abs_phase_count);
+            fprintf(out, "switchberry_dpll_abs_phase_offset_seconds_count{dpll=\"%u\","
+                         "role=\"%s\"} %llu\n",
+                    c, cm_metrics_roles[ch[c].role], (unsigned long long)ch[c].abs_phase_count);
+            fprintf(out, "switchberry_dpll_abs_phase_offset_seconds_sum{dpll=\"%u\","
+                         "role=\"%s\"} %.6e\n",
+                    c, cm_metrics_roles[ch[c].role], ch[c].abs_phase_sum);
+        }
+
+        cm_metrics_family(out, "switchberry_dpll_state_changes", "counter", NULL,
+                          "Polls that found LOCK_STATE_CHANGE_STICKY set.");
+        for (unsigned c = 0; c < CM_METRICS_NUM_DPLLS; c++)
+            if (ch[c].role)
+                fprintf(out, "switchberry_dpll_state_changes_total{dpll=\"%u\",role=\"%s\"} %llu\n",
+                        c, cm_metrics_roles[ch[c].role], (unsigned long long)ch[c].state_changes);
+
+        cm_metrics_family(out, "switchberry_dpll_relocks", "counter", NULL,
+                          "Relock pulses (FREERUN -> NORMAL) issued by the monitor.");
+        for (unsigned c = 0; c < CM_METRICS_NUM_DPLLS; c++)
+            if (ch[c].role == 2)
+                fprintf(out, "switchberry_dpll_relocks_total{dpll=\"%u\",role=\"gps\"} %llu\n",
+                        c, (unsigned long long)ch[c].relocks);
+    }
+
+    if (m->spi) cm_metrics_render_spi(out, m->spi, "operation", CM_BUSOP_PAGE);
+    if (m->xfer) cm_metrics_render_spi(out, m->xfer, "transfer", CM_BUSOP_COUNT);
+
+    cm_metrics_apply_t apply[CM_METRICS_MAX_APPLY];
+    size_t napply = cm_metrics_read_apply(m->apply_file, apply, CM_METRICS_MAX_APPLY);
+    if (napply) {
+        cm_metrics_family(out, "switchberry_dpll_apply_duration_seconds", "gauge", "seconds",
+                          "Duration of the last EEPROM flash / TCS apply.");
+        for (size_t i = 0; i < napply; i++)
+            fprintf(out, "switchberry_dpll_apply_duration_seconds{kind=\"%s\"} %.6f\n",
+                    apply[i].kind, apply[i].duration);
+        cm_metrics_family(out, "switchberry_dpll_apply_timestamp_seconds", "gauge", "seconds",
+                          "Unix time the last EEPROM flash / TCS apply finished.");
+        for (size_t i = 0; i < napply; i++)
+            fprintf(out, "switchberry_dpll_apply_timestamp_seconds{kind=\"%s\"} %.3f\n",
+                    apply[i].kind, apply[i].when);
+        cm_metrics_family(out, "switchberry_dpll_apply_success", "gauge", NULL,
+                          "1 if the last EEPROM flash / TCS apply succeeded.");
+        for (size_t i = 0; i < napply; i++)
+            fprintf(out, "switchberry_dpll_apply_success{kind=\"%s\"} %d\n", apply[i].kind,
+                    apply[i].ok);
+    }
+
+    fprintf(out, "# EOF\n");
+    return ferror(out) ? -1 : 0;
+}
+
+// ---------------------------------------------------------------------------
+// HTTP server
+// ---------------------------------------------------------------------------
+
+static void cm_metrics_send_all(int fd, const char *buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        buf += n;
+        len -= (size_t)n;
+    }
+}
+
+static void cm_metrics_reply(int fd, const char *status, const char *type,
+                             const char *body, size_t len)
+{
+    char hdr[256];
+    int n = snprintf(hdr, sizeof(hdr),
+                     "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n"
+                     "Connection: close\r\n\r\n",
+                     status, type, len);
+    cm_metrics_send_all(fd, hdr, (size_t)n);
+    cm_metrics_send_all(fd, body, len);
+}
+
+static void cm_metrics_serve(cm_metrics_t *m, int fd)
+{
+    // Scrapers send small requests; a slow client only delays the next one.
+    struct timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    char req[CM_METRICS_REQ_MAX];
+    size_t len = 0;
+    while (len < sizeof(req) - 1) {
+        ssize_t n = recv(fd, req + len, sizeof(req) - 1 - len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        len += (size_t)n;
+        req[len] = '\0';
+        if (strstr(req, "\r\n\r\n") || strstr(req, "\n\n")) break;
+    }
+    req[len] = '\0';
+
+    static const char text[] = "text/plain; charset=utf-8";
+    if (strncmp(req, "GET ", 4) != 0) {
+        cm_metrics_reply(fd, "405 Method Not Allowed", text, "GET only\n", 9);
+        return;
+    }
+    const char *path = req + 4;
+    size_t plen = strcspn(path, " ?\r\n");
+    if (!(plen == 8 && strncmp(path, "/metrics", 8) == 0)) {
+        cm_metrics_reply(fd, "404 Not Found", text, "see /metrics\n", 13);
+        return;
+    }
+
+    char *body = NULL;
+    size_t blen = 0;
+    FILE *out = open_memstream(&body, &blen);
+    if (!out) return;
+    int rc = cm_metrics_render(m, out);
+    if (fclose(out) == 0 && rc == 0) {
+        __atomic_fetch_add(&m->scrapes, 1, __ATOMIC_RELAXED);
+        cm_metrics_reply(fd, "200 OK", CM_METRICS_CONTENT_TYPE, body, blen);
+    } else {
+        cm_metrics_reply(fd, "500 Internal Server Error", text, "render failed\n", 14);
+    }
+    free(body);
+}
+
+static void *cm_metrics_thread(void *arg)
+{
+    cm_metrics_t *m = arg;
+    struct pollfd pfd = {m->fd, POLLIN, 0};
+
+    while (!__atomic_load_n(&m->stop, __ATOMIC_ACQUIRE)) {
+        if (poll(&pfd, 1, CM_METRICS_POLL_MS) <= 0) continue;
+        int c = accept4(m->fd, NULL, NULL, SOCK_CLOEXEC);
+        if (c < 0) continue;
+        cm_metrics_serve(m, c);
+        close(c);
+    }
+    return NULL;
+}
+
+int cm_metrics_start(cm_metrics_t *m, const char *bind_addr, unsigned port,
+                     const cm_busstat_t *spi, const cm_busstat_t *xfer)
+{
+    if (!m || !bind_addr || port == 0 || port > 65535) return -1;
+    memset(m, 0, sizeof(*m));
+    m->spi = spi;
+    m->xfer = xfer;
+    m->apply_file = CM_METRICS_APPLY_FILE;
+
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, bind_addr, &sa.sin_addr) != 1) return -1;
+
+    m->fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m->fd < 0) return -1;
+    int one = 1;
+    setsockopt(m->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(m->fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 || listen(m->fd, 8) != 0) {
+        close(m->fd);
+        return -1;
+    }
+
+    if (pthread_mutex_init(&m->mu, NULL) != 0) {
+        close(m->fd);
+        return -1;
+    }
+    if (pthread_create(&m->thread, NULL, cm_metrics_thread, m) != 0) {
+        pthread_mutex_destroy(&m->mu);
+        close(m->fd);
+        return -1;
+    }
+    m->running = 1;
+    return 0;
+}
+
+void cm_metrics_stop(cm_metrics_t *m)
+{
+    if (!m || !m->running) return;
+    __atomic_store_n(&m->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(m->thread, NULL);
+    close(m->fd);
+    pthread_mutex_destroy(&m->mu);
+    m->running = 0;
+}
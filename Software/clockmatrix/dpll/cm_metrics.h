@@ -0,0 +1,105 @@
+// cm_metrics.h
+//
+// OpenMetrics exporter for `dplltool monitor`.
+//
+// A server thread answers GET /metrics on a TCP port with the OpenMetrics
+// text format (application/openmetrics-text 1.0.0):
+//
+//   switchberry_dpll_state                stateset, every DPLL
+//   switchberry_dpll_phase_offset_seconds gauge, monitored channels
+//   switchberry_dpll_abs_phase_offset_seconds
+//                                         histogram of |phase| per poll while
+//                                         LOCKED/LOCKACQ/LOCKREC
+//   switchberry_dpll_state_changes_total  polls that saw the lock sticky bit
+//   switchberry_dpll_relocks_total        relock pulses issued by the monitor
+//   switchberry_monitor_polls_total, switchberry_monitor_poll_errors_total
+//   switchberry_spi_operations_total, switchberry_spi_errors_total,
+//   switchberry_spi_bytes_total,
+//   switchberry_spi_operation_seconds (summary), _max_seconds
+//                                         per cm_bus_t op type
+//   switchberry_spi_transfers_total, _transfer_errors_total,
+//   _transfer_bytes_total, _transfer_seconds (summary), _transfer_max_seconds
+//                                         per spidev transfer type (incl. page)
+//   switchberry_spi_module_transfers_total, _module_bytes_total,
+//   _module_seconds_total                 per register module
+//   switchberry_dpll_apply_duration_seconds, _timestamp_seconds, _success
+//                                         last EEPROM flash / TCS apply
+//
+// The monitor feeds it through cm_mon_cfg_t.on_poll (cm_metrics_on_poll);
+// scrapes only copy that state under a mutex, so a scrape never touches SPI
+// and never delays a poll by more than the copy. EEPROM and TCS applies run
+// in other dplltool processes, which leave their durations in
+// CM_METRICS_APPLY_FILE (cm_metrics_record_apply) for the exporter to read.
+
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "cm_busstat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_METRICS_DEFAULT_PORT  9469
+#define CM_METRICS_APPLY_FILE    "/tmp/switchberry-dpll-apply.times"
+#define CM_METRICS_NUM_DPLLS     8
+#define CM_METRICS_PHASE_BUCKETS 11   // finite buckets; +Inf is implicit
+
+struct cm_mon;
+
+typedef struct {
+    uint8_t  state;               // DPLL_STATE at the last poll
+    uint8_t  role;                // 0 unmonitored, 1 freq, 2 gps
+    int      has_phase;
+    double   phase_sec;           // last poll
+    uint64_t hist[CM_METRICS_PHASE_BUCKETS + 1];  // per bucket, last = +Inf
+    uint64_t abs_phase_count;
+    double   abs_phase_sum;
+    uint64_t state_changes;
+    uint64_t relocks;
+} cm_metrics_chan_t;
+
+typedef struct {
+    // Monitor state, under mu
+    pthread_mutex_t   mu;
+    int               have_poll;
+    cm_metrics_chan_t ch[CM_METRICS_NUM_DPLLS];
+    uint64_t          polls;
+    uint64_t          poll_errors;
+
+    const cm_busstat_t *spi;      // cm_bus_t ops, may be NULL
+    const cm_busstat_t *xfer;     // spidev transfers, may be NULL
+    const char       *apply_file;
+
+    // Server
+    int               fd;
+    pthread_t         thread;
+    int               running;
+    int               stop;       // atomic
+    uint64_t          scrapes;    // atomic
+} cm_metrics_t;
+
+// Listen on bind_addr:port (IPv4 dotted quad) and start the server thread.
+// spi (bus ops) and xfer (spidev transfers) may be NULL. Returns 0, or -1 on
+// a socket / thread error.
+int  cm_metrics_start(cm_metrics_t *m, const char *bind_addr, unsigned port,
+                      const cm_busstat_t *spi, const cm_busstat_t *xfer);
+
+void cm_metrics_stop(cm_metrics_t *m);
+
+// cm_mon_cfg_t.on_poll hook; user is the cm_metrics_t.
+void cm_metrics_on_poll(const struct cm_mon *mon, int rc, void *user);
+
+// Write the exposition (ending in "# EOF") to out. Returns 0 or -1.
+int  cm_metrics_render(cm_metrics_t *m, FILE *out);
+
+// Record an EEPROM/TCS apply for the exporter: replaces the line for `kind`
+// in path ("<kind> <unix time> <duration s> <ok>"). Returns 0 or -1.
+int  cm_metrics_record_apply(const char *path, const char *kind, double duration_sec, int ok);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,774 @@
+// cm_monitor.c
+// Native DPLL lock monitor / relocker (see cm_monitor.h).
+
+#define _GNU_SOURCE
+
+#include "cm_monitor.h"
+
+#include "cm_dpll_utils.h"
+#include "cm_json.h"
+#include "cm_status.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Lock-state sticky clear register (one bit per DPLL); not in the tables,
+// same raw write as dplltool clear_statechg_sticky.
+#define CM_MON_STICKY_CLEAR_ADDR 0xC166u
+
+// DPLL_MODE.STATE_MODE values
+#define CM_MON_OPER_NORMAL  0
+#define CM_MON_OPER_FREERUN 2
+
+// Heartbeat log interval per channel
+#define CM_MON_HEARTBEAT_SEC 10.0
+
+// "Never happened" for the last-event timestamps, so cooldowns start expired.
+#define CM_MON_LONG_AGO (-1e9)
+
+// Telemetry re-reads configuration registers (combo-bus slave) this often.
+#define CM_MON_CFG_REFRESH_SEC 10.0
+
+// Guard status files mirrored into the telemetry segment after our own.
+static const struct {
+    const char *name;
+    const char *path;
+} cm_mon_guards[CM_TELEM_NUM_GUARDS - 1] = {
+    {"ts2phc", "/tmp/switchberry-ts2phc.status"},
+    {"phc2sys", "/tmp/switchberry-phc2sys.status"},
+    {"chrony", "/tmp/switchberry-chrony.status"},
+};
+
+void cm_mon_cfg_defaults(cm_mon_cfg_t *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->poll_sec = 1.0;
+    cfg->startup_aggressive_sec = 60.0;
+    cfg->freq_ch = 5;
+    cfg->gps_chans[0] = 6;
+    cfg->ngps = 1;
+
+    cfg->freq.unlock_sec = 10.0;
+    cfg->freq.flap_window_sec = 5.0;
+    cfg->freq.flap_count = 6;
+    cfg->freq.unlock_sec_agg = 4.0;
+    cfg->freq.flap_window_sec_agg = 4.0;
+    cfg->freq.flap_count_agg = 4;
+    cfg->freq.reset_cooldown_sec = 12.0;
+    cfg->freq.reset_pulse_sec = 0.4;
+    cfg->freq.nochange_accept_sec = 10.0;
+
+    cfg->gps.unlock_sec = 20.0;
+    cfg->gps.flap_window_sec = 8.0;
+    cfg->gps.flap_count = 6;
+    cfg->gps.unlock_sec_agg = 10.0;
+    cfg->gps.flap_window_sec_agg = 6.0;
+    cfg->gps.flap_count_agg = 4;
+    cfg->gps.reset_cooldown_sec = 15.0;
+    cfg->gps.reset_pulse_sec = 0.25;
+    cfg->gps.nochange_accept_sec = 10.0;
+
+    cfg->freq_stable_lock_sec = 2.0;
+
+    cfg->phase_threshold_sec = 250e-9;
+    cfg->phase_clear_threshold_sec = 150e-9;
+    cfg->phase_exceed_sec = 20.0;
+    cfg->phase_check_interval_sec = 2.0;
+    cfg->phase_relock_cooldown_sec = 15.0;
+
+    cfg->freq_lock_event_gps_action = 1;
+    cfg->gps_boost_sec = 30.0;
+    cfg->gate_gps_on_freq_locked = 0;
+
+    cfg->status_file = CM_MON_STATUS_FILE;
+    cfg->status_holdoff_sec = 2.0;
+    cfg->telemetry_path = CM_TELEM_PATH;
+}
+
+double cm_mon_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void cm_mon_sleep(double sec)
+{
+    if (sec <= 0.0) return;
+    struct timespec ts;
+    ts.tv_sec = (time_t)sec;
+    ts.tv_nsec = (long)((sec - (double)ts.tv_sec) * 1e9);
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Logging + status file
+// ---------------------------------------------------------------------------
+
+static int cm_mon_json_log = 0;  // cfg.json_log of the last cm_mon_init()
+
+static void cm_mon_iso_time(char *buf, size_t len);
+
+__attribute__((format(printf, 1, 2)))
+static void cm_mon_log(const char *fmt, ...)
+{
+    if (cm_mon_json_log) {
+        char stamp[40], msg[512];
+        cm_mon_iso_time(stamp, sizeof(stamp));
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(msg, sizeof(msg), fmt, ap);
+        va_end(ap);
+
+        cm_json_t j;
+        cm_json_init(&j, stdout);
+        cm_json_obj_begin(&j, NULL);
+        cm_json_str(&j, "cmd", "monitor");
+        cm_json_str(&j, "time", stamp);
+        cm_json_str(&j, "msg", msg);
+        cm_json_obj_end(&j);
+        cm_json_newline(&j);
+        return;
+    }
+
+    char stamp[32];
+    time_t now = time(NULL);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+
+    printf("[%s] ", stamp);
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+    fflush(stdout);
+}
+
+// Same format as `date -Is`: 2024-05-01T12:00:00+02:00
+static void cm_mon_iso_time(char *buf, size_t len)
+{
+    time_t now = time(NULL);
+    struct tm tm;
+    char tz[8];
+    localtime_r(&now, &tm);
+    strftime(buf, len, "%Y-%m-%dT%H:%M:%S", &tm);
+    strftime(tz, sizeof(tz), "%z", &tm);
+    size_t n = strlen(buf);
+    if (strlen(tz) == 5 && n + 7 <= len)
+        snprintf(buf + n, len - n, "%.3s:%.2s", tz, tz + 3);
+}
+
+static void cm_mon_write_status(const cm_mon_t *mon, int ok, const char *msg)
+{
+    char tmp[512], iso[40];
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", mon->cfg.status_file, (long)getpid());
+    cm_mon_iso_time(iso, sizeof(iso));
+
+    FILE *f = fopen(tmp, "w");
+    if (!f) return;
+    fprintf(f, "%s\n%s\n%s\n", ok ? "OK" : "NOT_OK", iso, msg);
+    if (fclose(f) != 0 || rename(tmp, mon->cfg.status_file) != 0) unlink(tmp);
+}
+
+// Rewrite the status file only when state or message changed.
+static void cm_mon_set_status(cm_mon_t *mon, int ok, const char *msg)
+{
+    if (mon->status_state == ok && strcmp(mon->status_msg, msg) == 0) return;
+    cm_mon_write_status(mon, ok, msg);
+    mon->status_state = ok;
+    snprintf(mon->status_msg, sizeof(mon->status_msg), "%s", msg);
+}
+
+// ---------------------------------------------------------------------------
+// Register access (handles resolved in cm_mon_init)
+// ---------------------------------------------------------------------------
+
+// One burst over every DPLL<n>_STATUS (cm_status snapshot, states only; with
+// telemetry also the inputs, plus one burst for the phases).
+static int cm_mon_read_states(cm_mon_t *mon)
+{
+    dpll_status_snapshot_t snap;
+    int rc = dpll_status_snapshot_read(mon->bus, mon->status_flags, &snap);
+    mon->bursts += snap.bursts;
+    if (rc) return rc;
+
+    mon->snap = snap;
+    for (unsigned ch = 0; ch < CM_MON_MAX_CHANS; ch++) {
+        mon->ch[ch].state = snap.ch[ch].state;
+        mon->ch[ch].sticky = snap.ch[ch].lock_sticky;
+    }
+    return 0;
+}
+
+static int cm_mon_clear_sticky(cm_mon_t *mon, unsigned ch)
+{
+    mon->bursts++;
+    mon->ch[ch].sticky = 0;
+    return cm_write8(mon->bus, mon->sticky_clear_addr, (uint8_t)(1u << ch));
+}
+
+static int cm_mon_set_oper_state(cm_mon_t *mon, unsigned ch, uint8_t state)
+{
+    const cm_field_write_t *w = &mon->oper_state[ch];
+    mon->bursts += 2;  // read-modify-write
+    return cm_field_write8(mon->bus, w->addr, w->shift, w->width, state);
+}
+
+// Freshest sampler record older than this is not trusted (sampler stalled).
+#define CM_MON_RING_STALE_SEC 1.0
+
+static int cm_mon_read_phase(cm_mon_t *mon, unsigned ch, double *sec)
+{
+    if (mon->cfg.phase_ring) {
+        cm_phase_sample_t rec;
+        double t = cm_mon_now();
+        while (cm_phase_ring_pop(mon->cfg.phase_ring, &mon->phase_cur, &rec)) {
+            if (rec.rc) continue;
+            for (unsigned i = 0; i < CM_MON_MAX_CHANS; i++) {
+                if (!(rec.chan_mask & (1u << i))) continue;
+                mon->ring_phase[i] = rec.phase_s36[i];
+                mon->ring_phase_at[i] = t;
+            }
+        }
+        if (mon->ring_phase_at[ch] > 0.0 && t - mon->ring_phase_at[ch] < CM_MON_RING_STALE_SEC) {
+            *sec = cm_phase_s36_to_seconds(mon->ring_phase[ch]);
+            return 0;
+        }
+    }
+
+    // With telemetry this poll's burst already carries every phase.
+    if (mon->snap.has_phase) {
+        *sec = mon->snap.ch[ch].phase_sec;
+        return 0;
+    }
+
+    int64_t s36 = 0;
+    mon->bursts++;
+    int rc = cm_read_phase_status_s36(mon->bus, ch, &s36);
+    *sec = rc ? 0.0 : cm_phase_s36_to_seconds(s36);
+    return rc;
+}
+
+// ---------------------------------------------------------------------------
+// Decision logic
+// ---------------------------------------------------------------------------
+
+static int cm_mon_is_locked(uint8_t st) { return st == CM_DPLL_STATE_LOCKED; }
+
+static int cm_mon_is_trying(uint8_t st)
+{
+    return st == CM_DPLL_STATE_LOCKREC || st == CM_DPLL_STATE_LOCKACQ;
+}
+
+static void cm_mon_init_ch(cm_mon_t *mon, unsigned ch, double t)
+{
+    cm_mon_chan_t *c = &mon->ch[ch];
+    c->last_seen = t;
+    c->last_change = t;
+    c->flap_win_start = t;
+    c->flap_count = 0;
+    c->unlock_since = 0.0;
+    c->last_reset = CM_MON_LONG_AGO;
+    c->phase_exceed_since = 0.0;
+    c->last_phase_check = CM_MON_LONG_AGO;
+    c->last_phase_reset = CM_MON_LONG_AGO;
+    cm_mon_clear_sticky(mon, ch);
+}
+
+// FREERUN -> pulse -> NORMAL, clearing the sticky bit after each step.
+static void cm_mon_reset_pulse(cm_mon_t *mon, unsigned ch, double pulse)
+{
+    cm_mon_chan_t *c = &mon->ch[ch];
+    double t = cm_mon_now();
+    c->last_reset = t;
+    mon->last_intervention = t;
+    mon->pulses++;
+    c->pulses++;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "INTERVENING reset_pulse CH%u", ch);
+    cm_mon_set_status(mon, 0, msg);
+
+    cm_mon_log("ACTION: CH%u reset pulse: FREERUN (%gs) -> NORMAL", ch, pulse);
+    cm_mon_set_oper_state(mon, ch, CM_MON_OPER_FREERUN);
+    cm_mon_clear_sticky(mon, ch);
+    cm_mon_sleep(pulse);
+    cm_mon_set_oper_state(mon, ch, CM_MON_OPER_NORMAL);
+    cm_mon_clear_sticky(mon, ch);
+
+    // Reset local counters to avoid an immediate retrigger.
+    c->flap_win_start = cm_mon_now();
+    c->flap_count = 0;
+    c->unlock_since = 0.0;
+}
+
+static void cm_mon_update_sticky_and_flap(cm_mon_t *mon, unsigned ch, double t,
+                                          double win_sec)
+{
+    cm_mon_chan_t *c = &mon->ch[ch];
+    if (!c->sticky) return;
+
+    cm_mon_clear_sticky(mon, ch);
+    c->last_change = t;
+    if (t - c->flap_win_start > win_sec) {
+        c->flap_win_start = t;
+        c->flap_count = 0;
+    }
+    c->flap_count++;
+    cm_mon_log("INFO: CH%u sticky=1 state=%s flap_count=%u/%gs", ch,
+               dpll_state_str(c->state), c->flap_count, win_sec);
+}
+
+static void cm_mon_update_unlock_timer(cm_mon_t *mon, unsigned ch, double t)
+{
+    cm_mon_chan_t *c = &mon->ch[ch];
+    if (cm_mon_is_locked(c->state)) {
+        c->unlock_since = 0.0;
+    } else if (c->unlock_since == 0.0) {
+        c->unlock_since = t;
+        cm_mon_log("INFO: CH%u became UNLOCKED (state=%s)", ch, dpll_state_str(c->state));
+    }
+}
+
+// Unlocked with no state changes for accept_sec is a valid "no reference"
+// state only in FREERUN/HOLDOVER. LOCKREC/LOCKACQ see a reference and are
+// failing to lock; those are left to the relock logic.
+static int cm_mon_nochange_acceptable(const cm_mon_t *mon, unsigned ch, double t,
+                                      uint8_t st, double accept_sec)
+{
+    if (cm_mon_is_locked(st)) return 0;
+    if (t - mon->ch[ch].last_change < accept_sec) return 0;
+    if (cm_mon_is_trying(st)) return 0;
+    return 1;
+}
+
+static void cm_mon_update_freq_edge(cm_mon_t *mon, double t)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+    uint8_t st = mon->ch[cfg->freq_ch].state;
+
+    if (!cm_mon_is_locked(st)) {
+        mon->freq_locked_since = 0.0;
+        if (mon->freq_stably_locked)
+            cm_mon_log("EVENT: CH%u left LOCKED state (state=%s)", cfg->freq_ch,
+                       dpll_state_str(st));
+        mon->freq_stably_locked = 0;
+        return;
+    }
+
+    if (mon->freq_locked_since == 0.0) mon->freq_locked_since = t;
+    if (mon->freq_stably_locked || t - mon->freq_locked_since < cfg->freq_stable_lock_sec)
+        return;
+
+    mon->freq_stably_locked = 1;
+    cm_mon_log("EVENT: CH%u became STABLY LOCKED (>=%gs). Likely combo-bus freq step.",
+               cfg->freq_ch, cfg->freq_stable_lock_sec);
+
+    if (cfg->freq_lock_event_gps_action == 1) {
+        cm_mon_log("EVENT-ACTION: Forcing GPS Channels reset due to CH%u stable lock",
+                   cfg->freq_ch);
+        for (size_t i = 0; i < cfg->ngps; i++)
+            cm_mon_reset_pulse(mon, cfg->gps_chans[i], cfg->gps.reset_pulse_sec);
+    } else if (cfg->freq_lock_event_gps_action == 2) {
+        mon->gps_boost_until = t + cfg->gps_boost_sec;
+        cm_mon_log("EVENT-ACTION: Boost monitoring aggressiveness for GPS Chans for %gs",
+                   cfg->gps_boost_sec);
+    } else {
+        cm_mon_log("EVENT-ACTION: No special action configured (FREQ_LOCK_EVENT_GPS_ACTION=0)");
+    }
+}
+
+// Decision 3: |phase| above the trigger for phase_exceed_sec -> relock.
+static void cm_mon_check_phase(cm_mon_t *mon, unsigned ch, double t, double pulse)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+    cm_mon_chan_t *c = &mon->ch[ch];
+    const char *st = dpll_state_str(c->state);
+
+    if (t - c->last_phase_check < cfg->phase_check_interval_sec) return;
+    c->last_phase_check = t;
+
+    double phase;
+    cm_mon_read_phase(mon, ch, &phase);  // a failed read counts as 0, as before
+    double abs_phase = fabs(phase);
+
+    if (abs_phase > cfg->phase_threshold_sec) {
+        if (c->phase_exceed_since == 0.0) {
+            c->phase_exceed_since = t;
+            cm_mon_log("INFO: CH%u state=%s phase=%.12es exceeds threshold (%gs)", ch, st,
+                       phase, cfg->phase_threshold_sec);
+        }
+        double dur = t - c->phase_exceed_since;
+        if (dur >= cfg->phase_exceed_sec) {
+            if (t - c->last_phase_reset >= cfg->phase_relock_cooldown_sec) {
+                cm_mon_log("DECIDE: CH%u state=%s phase=%.12es > %gs for %.0fs -> relock", ch,
+                           st, phase, cfg->phase_threshold_sec, dur);
+                c->last_phase_reset = t;
+                cm_mon_reset_pulse(mon, ch, pulse);
+                c->phase_exceed_since = 0.0;
+            } else {
+                cm_mon_log("DECIDE: CH%u phase relock needed but cooldown active", ch);
+            }
+        }
+    } else if (c->phase_exceed_since > 0.0) {
+        // Hysteresis: only clear the timer below the clear threshold.
+        if (abs_phase < cfg->phase_clear_threshold_sec) {
+            cm_mon_log("INFO: CH%u phase=%.12es dropped below clear threshold (%gs) - timer "
+                       "cleared", ch, phase, cfg->phase_clear_threshold_sec);
+            c->phase_exceed_since = 0.0;
+        } else {
+            cm_mon_log("INFO: CH%u phase=%.12es in dead zone (%g..%gs), timer still running "
+                       "(%.0fs/%gs)", ch, phase, cfg->phase_clear_threshold_sec,
+                       cfg->phase_threshold_sec, t - c->phase_exceed_since,
+                       cfg->phase_exceed_sec);
+        }
+    }
+}
+
+static void cm_mon_channel(cm_mon_t *mon, unsigned ch, double t, int forced_aggressive)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+    cm_mon_chan_t *c = &mon->ch[ch];
+    const uint8_t st = c->state;
+    const char *st_str = dpll_state_str(st);
+
+    int aggressive = forced_aggressive || (t - mon->start < cfg->startup_aggressive_sec);
+    const cm_mon_chan_cfg_t *cc = (ch == cfg->freq_ch) ? &cfg->freq : &cfg->gps;
+    double unlock_sec = aggressive ? cc->unlock_sec_agg : cc->unlock_sec;
+    double flap_win = aggressive ? cc->flap_window_sec_agg : cc->flap_window_sec;
+    unsigned flap_cnt = aggressive ? cc->flap_count_agg : cc->flap_count;
+
+    cm_mon_update_sticky_and_flap(mon, ch, t, flap_win);
+    cm_mon_update_unlock_timer(mon, ch, t);
+
+    if (t - c->last_seen >= CM_MON_HEARTBEAT_SEC) {
+        double unlocked_for = (c->unlock_since > 0.0) ? t - c->unlock_since : 0.0;
+        cm_mon_log("CHECK: CH%u state=%s unlocked_for=%.0fs flap=%u mode=%s", ch, st_str,
+                   unlocked_for, c->flap_count, aggressive ? "aggressive" : "normal");
+        c->last_seen = t;
+    }
+
+    // Decision 1: flapping
+    if (c->flap_count >= flap_cnt) {
+        if (t - c->last_reset >= cc->reset_cooldown_sec) {
+            cm_mon_log("DECIDE: CH%u flapping (>=%u changes in %gs) -> reset", ch, flap_cnt,
+                       flap_win);
+            cm_mon_reset_pulse(mon, ch, cc->reset_pulse_sec);
+        } else {
+            cm_mon_log("DECIDE: CH%u flapping but cooldown active -> no action", ch);
+        }
+        return;
+    }
+
+    // Decision 2: unlocked too long
+    if (c->unlock_since > 0.0 && t - c->unlock_since >= unlock_sec) {
+        double unlocked_for = t - c->unlock_since;
+        if (cm_mon_nochange_acceptable(mon, ch, t, st, cc->nochange_accept_sec)) {
+            cm_mon_log("DECIDE: CH%u unlocked %.0fs but NO state changes for >=%gs -> accept "
+                       "(no ref), no reset", ch, unlocked_for, cc->nochange_accept_sec);
+            // damp repeated logs
+            c->unlock_since = t;
+            c->flap_win_start = t;
+            c->flap_count = 0;
+            return;
+        }
+        if (t - c->last_reset >= cc->reset_cooldown_sec) {
+            cm_mon_log("DECIDE: CH%u unlocked %.0fs (>=%gs) -> reset", ch, unlocked_for,
+                       unlock_sec);
+            cm_mon_reset_pulse(mon, ch, cc->reset_pulse_sec);
+        } else {
+            cm_mon_log("DECIDE: CH%u unlocked too long but cooldown active -> no action", ch);
+        }
+    }
+
+    // Decision 3: phase offset. The phase monitor is valid in LOCKED, LOCKREC
+    // and LOCKACQ; in FREERUN/HOLDOVER there is no reference to measure.
+    if (cm_mon_is_locked(st) || cm_mon_is_trying(st))
+        cm_mon_check_phase(mon, ch, t, cc->reset_pulse_sec);
+    else
+        c->phase_exceed_since = 0.0;
+}
+
+// OK unless intervening (or within the holdoff after an intervention); the
+// message hints LOCKED / NO_REF / UNLOCKED for humans.
+static void cm_mon_update_status(cm_mon_t *mon, double t)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+    char gps[128] = "";
+    size_t len = 0;
+    int all_locked = 1, all_no_ref = 1;
+
+    for (size_t i = 0; i < cfg->ngps; i++) {
+        unsigned ch = cfg->gps_chans[i];
+        uint8_t st = mon->ch[ch].state;
+        int n = snprintf(gps + len, sizeof(gps) - len, " CH%u=%s", ch, dpll_state_str(st));
+        if (n > 0 && (size_t)n < sizeof(gps) - len) len += (size_t)n;
+        if (!cm_mon_is_locked(st)) all_locked = 0;
+        if (!cm_mon_nochange_acceptable(mon, ch, t, st, cfg->gps.nochange_accept_sec))
+            all_no_ref = 0;
+    }
+
+    const char *freq_st = dpll_state_str(mon->ch[cfg->freq_ch].state);
+    char msg[192];
+    if (t - mon->last_intervention < cfg->status_holdoff_sec) {
+        double age = t - mon->last_intervention;
+        snprintf(msg, sizeof(msg), "INTERVENING age=%.0fs FREQ(CH%u)=%s%s",
+                 age > 0.0 ? age : 0.0, cfg->freq_ch, freq_st, gps);
+        cm_mon_set_status(mon, 0, msg);
+        return;
+    }
+
+    const char *hint = all_locked ? "LOCKED" : all_no_ref ? "NO_REF" : "UNLOCKED";
+    snprintf(msg, sizeof(msg), "%s FREQ(CH%u)=%s%s", hint, cfg->freq_ch, freq_st, gps);
+    cm_mon_set_status(mon, 1, msg);
+}
+
+// ---------------------------------------------------------------------------
+// Telemetry segment
+// ---------------------------------------------------------------------------
+
+static unsigned cm_mon_chan_flags(const cm_mon_t *mon, unsigned ch)
+{
+    unsigned flags = (ch == mon->cfg.freq_ch) ? CM_TELEM_CH_FREQ : 0u;
+    for (size_t i = 0; i < mon->cfg.ngps; i++)
+        if (mon->cfg.gps_chans[i] == ch) flags |= CM_TELEM_CH_GPS;
+    return flags;
+}
+
+// Open the segment and resolve what only telemetry reads. A segment that
+// cannot be created leaves the monitor running without it.
+static int cm_mon_telemetry_init(cm_mon_t *mon)
+{
+    const char *path = mon->cfg.telemetry_path;
+    int rc = cm_telem_open(&mon->telem, path);
+    if (rc) {
+        cm_mon_log("WARN: telemetry segment %s unavailable (rc=%d), not publishing", path, rc);
+        return 0;
+    }
+
+    mon->bursts++;
+    rc = cm_steer_init(&mon->wr_freq, mon->bus);
+    if (rc) {
+        cm_telem_close(&mon->telem);
+        return rc;
+    }
+    for (unsigned ch = 0; ch < CM_MON_MAX_CHANS; ch++) {
+        if (!cm_mon_chan_flags(mon, ch)) continue;
+        if (cm_string_field_resolve("DPLL_Config", ch, "DPLL_COMBO_SLAVE_CFG_0",
+                                    "PRI_COMBO_SRC_EN", 0, &mon->combo_en[ch]) != 0 ||
+            cm_string_field_resolve("DPLL_Config", ch, "DPLL_COMBO_SLAVE_CFG_0",
+                                    "PRI_COMBO_SRC_ID", 0, &mon->combo_src[ch]) != 0)
+            memset(&mon->combo_en[ch], 0, sizeof(mon->combo_en[ch]));
+    }
+    mon->status_flags |= CM_STATUS_PHASE | CM_STATUS_INPUTS;
+    mon->last_cfg_read = CM_MON_LONG_AGO;
+    return 0;
+}
+
+// Reads only telemetry needs: WR_FREQ every poll, the combo-bus slave
+// configuration of the monitored channels every CM_MON_CFG_REFRESH_SEC.
+static int cm_mon_read_telemetry(cm_mon_t *mon, double t)
+{
+    mon->bursts++;
+    int rc = cm_steer_read(&mon->wr_freq, mon->wr_freq_s42);
+    if (rc || t - mon->last_cfg_read < CM_MON_CFG_REFRESH_SEC) return rc;
+
+    mon->last_cfg_read = t;
+    for (unsigned ch = 0; ch < CM_MON_MAX_CHANS; ch++) {
+        if (!mon->combo_en[ch].width) continue;
+        mon->bursts++;
+        if ((rc = cm_read8(mon->bus, mon->combo_en[ch].addr, &mon->combo_cfg[ch])) != 0)
+            return rc;
+        mon->combo_valid |= (uint8_t)(1u << ch);
+    }
+    return 0;
+}
+
+static uint8_t cm_mon_field(uint8_t v, const cm_field_write_t *f)
+{
+    return (uint8_t)((v >> f->shift) & cm_mask8(f->width));
+}
+
+static void cm_mon_publish(cm_mon_t *mon, double t, int rc, int stopped)
+{
+    cm_telem_t tm;
+    struct timespec now;
+    memset(&tm, 0, sizeof(tm));
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    tm.pid = stopped ? 0 : (int32_t)getpid();
+    tm.last_rc = rc;
+    tm.updated_ns = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+    tm.polls = mon->polls;
+    tm.pulses = mon->pulses;
+    tm.bursts = mon->bursts;
+    tm.poll_sec = mon->cfg.poll_sec;
+    tm.freq_ch = (uint8_t)mon->cfg.freq_ch;
+    memcpy(tm.in_mon, mon->snap.in_mon, sizeof(tm.in_mon));
+
+    for (unsigned ch = 0; ch < CM_TELEM_NUM_DPLLS; ch++) {
+        const cm_mon_chan_t *c = &mon->ch[ch];
+        const dpll_chan_status_t *st = &mon->snap.ch[ch];
+        cm_telem_chan_t *o = &tm.ch[ch];
+
+        o->state = st->state;
+        o->lock_sticky = st->lock_sticky;
+        o->holdover_sticky = st->holdover_sticky;
+        o->ref_input = st->ref_input;
+        o->flags = (uint8_t)cm_mon_chan_flags(mon, ch);
+        if (mon->combo_valid & (1u << ch)) {
+            o->flags |= CM_TELEM_CH_COMBO;
+            o->combo_en = cm_mon_field(mon->combo_cfg[ch], &mon->combo_en[ch]);
+            o->combo_src = cm_mon_field(mon->combo_cfg[ch], &mon->combo_src[ch]);
+        }
+        o->lock_changes = c->sticky_polls;
+        o->relocks = c->pulses;
+        o->sticky_hist = c->sticky_hist;
+        o->phase_s36 = st->phase_s36;
+        o->phase_sec = st->phase_sec;
+        o->wr_freq_s42 = mon->wr_freq_s42[ch];
+        o->wr_freq_ppb = ldexp((double)mon->wr_freq_s42[ch], -CM_WR_FREQ_FRAC_BITS) * 1e9;
+        if (o->flags & CM_TELEM_CH_GPS) {
+            o->unlocked_sec = (c->unlock_since > 0.0) ? t - c->unlock_since : 0.0;
+            o->since_change_sec = t - c->last_change;
+        }
+    }
+
+    snprintf(tm.guard[0].name, sizeof(tm.guard[0].name), "clockmatrix");
+    cm_telem_read_guard(mon->cfg.status_file, &tm.guard[0]);
+    for (unsigned i = 0; i + 1 < CM_TELEM_NUM_GUARDS; i++) {
+        cm_telem_guard_t *g = &tm.guard[i + 1];
+        snprintf(g->name, sizeof(g->name), "%s", cm_mon_guards[i].name);
+        cm_telem_read_guard(cm_mon_guards[i].path, g);
+    }
+
+    cm_telem_publish(&mon->telem, &tm);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+int cm_mon_init(cm_mon_t *mon, const cm_bus_t *bus, const cm_mon_cfg_t *cfg)
+{
+    if (!mon || !bus || !cfg || !cfg->status_file) return -1;
+    if (cfg->freq_ch >= CM_MON_MAX_CHANS || cfg->ngps == 0 || cfg->ngps > CM_MON_MAX_CHANS)
+        return -1;
+
+    memset(mon, 0, sizeof(*mon));
+    mon->bus = bus;
+    mon->cfg = *cfg;
+    mon->status_state = -1;
+    mon->last_intervention = CM_MON_LONG_AGO;
+    mon->status_flags = cfg->status_flags;
+    cm_mon_json_log = cfg->json_log;
+
+    for (size_t i = 0; i < cfg->ngps; i++)
+        if (cfg->gps_chans[i] >= CM_MON_MAX_CHANS) return -1;
+
+    // Resolves the Status layout once; the monitor's polls then only burst.
+    dpll_status_snapshot_t snap;
+    int rc = dpll_status_snapshot_read(bus, 0, &snap);
+    mon->bursts += snap.bursts;
+    if (rc) return rc;
+    mon->sticky_clear_addr = CM_MON_STICKY_CLEAR_ADDR;
+    if (cfg->phase_ring) cm_phase_cursor_init(cfg->phase_ring, &mon->phase_cur, 0);
+
+    for (size_t i = 0; i < cfg->ngps; i++) {
+        unsigned ch = cfg->gps_chans[i];
+        rc = cm_string_field_resolve("DPLL_Config", ch, "DPLL_MODE", "STATE_MODE", 0,
+                                     &mon->oper_state[ch]);
+        if (rc) return rc;
+    }
+
+    if (cfg->telemetry_path && (rc = cm_mon_telemetry_init(mon)) != 0) return rc;
+
+    double t = cm_mon_now();
+    mon->start = t;
+    cm_mon_init_ch(mon, cfg->freq_ch, t);
+    for (size_t i = 0; i < cfg->ngps; i++) cm_mon_init_ch(mon, cfg->gps_chans[i], t);
+    return 0;
+}
+
+int cm_mon_poll(cm_mon_t *mon, double t)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+    mon->polls++;
+
+    int rc = cm_mon_read_states(mon);
+    if (rc) return rc;
+
+    for (unsigned ch = 0; ch < CM_MON_MAX_CHANS; ch++) {
+        cm_mon_chan_t *c = &mon->ch[ch];
+        c->sticky_hist = (c->sticky_hist << 1) | c->sticky;
+        if (c->sticky) c->sticky_polls++;
+    }
+
+    // FREQ_CH is observed for the stable-lock edge only, never relocked.
+    cm_mon_update_freq_edge(mon, t);
+    uint64_t pulses = mon->pulses;
+
+    if (!cfg->gate_gps_on_freq_locked || cm_mon_is_locked(mon->ch[cfg->freq_ch].state)) {
+        int forced = (mon->gps_boost_until > 0.0 && t < mon->gps_boost_until);
+        for (size_t i = 0; i < cfg->ngps; i++) {
+            // A relock pulse changed the states read at the top of the poll.
+            if (mon->pulses != pulses && (rc = cm_mon_read_states(mon)) != 0) return rc;
+            pulses = mon->pulses;
+            cm_mon_channel(mon, cfg->gps_chans[i], t, forced);
+        }
+    }
+
+    if (mon->pulses != pulses && (rc = cm_mon_read_states(mon)) != 0) return rc;
+    cm_mon_update_status(mon, t);
+    return mon->telem.shm ? cm_mon_read_telemetry(mon, t) : 0;
+}
+
+int cm_mon_run(cm_mon_t *mon, volatile sig_atomic_t *stop)
+{
+    const cm_mon_cfg_t *cfg = &mon->cfg;
+
+    cm_mon_log("dpll-monitor starting (poll=%gs, startup_aggressive=%gs)", cfg->poll_sec,
+               cfg->startup_aggressive_sec);
+    cm_mon_log("Config: FREQ_LOCK_EVENT_GPS_ACTION=%d (0=none,1=force reset,2=boost %gs)",
+               cfg->freq_lock_event_gps_action, cfg->gps_boost_sec);
+    cm_mon_log("Status file: %s (OK only unless intervening). Holdoff: %gs", cfg->status_file,
+               cfg->status_holdoff_sec);
+    cm_mon_log("No-ref accept: FREQ(CH%u)=%gs, GPS=%gs", cfg->freq_ch,
+               cfg->freq.nochange_accept_sec, cfg->gps.nochange_accept_sec);
+    if (mon->telem.shm) cm_mon_log("Telemetry: %s", cfg->telemetry_path);
+    cm_mon_set_status(mon, 1, "STARTING");
+
+    while (!*stop) {
+        double t = cm_mon_now();
+        int rc = cm_mon_poll(mon, t);
+        if (rc) cm_mon_log("WARN: SPI access failed (rc=%d), retrying next poll", rc);
+        if (mon->telem.shm) cm_mon_publish(mon, t, rc, 0);
+        if (cfg->on_poll) cfg->on_poll(mon, rc, cfg->on_poll_user);
+
+        double left = cfg->poll_sec - (cm_mon_now() - t);
+        if (left > 0.0 && !*stop) {
+            struct timespec ts;
+            ts.tv_sec = (time_t)left;
+            ts.tv_nsec = (long)((left - (double)ts.tv_sec) * 1e9);
+            nanosleep(&ts, NULL);  // a signal ends the sleep early
+        }
+    }
+
+    // If the monitor stops, make that explicit to consumers.
+    cm_mon_write_status(mon, 0, "STOPPED");
+    if (mon->telem.shm) {
+        cm_mon_publish(mon, cm_mon_now(), 0, 1);
+        cm_telem_close(&mon->telem);
+    }
+    cm_mon_log("dpll-monitor stopped after %llu polls, %llu SPI bursts",
+               (unsigned long long)mon->polls, (unsigned long long)mon->bursts);
+    return 0;
+}
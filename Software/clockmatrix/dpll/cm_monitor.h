@@ -0,0 +1,177 @@
+// cm_monitor.h
+//
+// Native DPLL lock monitor / relocker (the logic of fastlock_1pps_fix.sh).
+//
+// The script spawned dplltool for get_state, get_statechg_sticky,
+// clear_statechg_sticky and get-phase on every channel and every poll. This
+// module keeps one cm_bus_t, resolves every register address once in
+// cm_mon_init(), and reads the state + sticky bits of all channels with one
+// burst per poll (a cm_status snapshot without phase).
+//
+// Decisions are the script's, in the same order and with the same defaults:
+//   1. flapping (N state changes within a window)          -> relock pulse
+//   2. unlocked too long, unless steady FREERUN/HOLDOVER
+//      with no state changes ("no reference")              -> relock pulse
+//   3. |phase| above the trigger threshold for too long,
+//      cleared only below the lower clear threshold        -> relock pulse
+// with tighter thresholds during the first seconds after start, and the
+// FREQ_CH stable-lock edge (combo-bus frequency step) resetting or boosting
+// the GPS channels. Only the GPS channels are ever relocked.
+//
+// The status file is the same 3-line file the guards read:
+//   OK | NOT_OK
+//   ISO-8601 timestamp
+//   short message
+//
+// With cfg.telemetry_path set (the default) every poll is also published to
+// the cm_telemetry segment. The poll's burst then also covers the phase and
+// input monitor registers, and one more burst reads WR_FREQ of every DPLL
+// (3 per poll instead of 1); the phase check uses the poll's phase instead
+// of a separate read.
+
+#pragma once
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cm_sampler.h"
+#include "cm_status.h"
+#include "cm_steer.h"
+#include "cm_telemetry.h"
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_MON_STATUS_FILE  "/tmp/switchberry-clockmatrix.status"
+#define CM_MON_MAX_CHANS    8      // DPLL0..DPLL7
+
+struct cm_mon;
+
+// Thresholds for one channel class (FREQ_CH or GPS_CHANS).
+typedef struct {
+    double   unlock_sec;          // *_UNLOCK_SEC
+    double   flap_window_sec;     // *_FLAP_WINDOW_SEC
+    unsigned flap_count;          // *_FLAP_COUNT
+    double   unlock_sec_agg;      // *_AGG: used during startup / boost
+    double   flap_window_sec_agg;
+    unsigned flap_count_agg;
+    double   reset_cooldown_sec;  // *_RESET_COOLDOWN_SEC
+    double   reset_pulse_sec;     // *_RESET_PULSE_SEC
+    double   nochange_accept_sec; // *_NOCHANGE_ACCEPT_SEC
+} cm_mon_chan_cfg_t;
+
+typedef struct {
+    double            poll_sec;
+    double            startup_aggressive_sec;
+    unsigned          freq_ch;
+    unsigned          gps_chans[CM_MON_MAX_CHANS];
+    size_t            ngps;
+    cm_mon_chan_cfg_t freq;
+    cm_mon_chan_cfg_t gps;
+    double            freq_stable_lock_sec;
+
+    double            phase_threshold_sec;       // trigger level
+    double            phase_clear_threshold_sec; // hysteresis clear level
+    double            phase_exceed_sec;
+    double            phase_check_interval_sec;
+    double            phase_relock_cooldown_sec;
+
+    int               freq_lock_event_gps_action; // 0 none, 1 reset, 2 boost
+    double            gps_boost_sec;
+    int               gate_gps_on_freq_locked;
+
+    const char       *status_file;
+    double            status_holdoff_sec;
+    const char       *telemetry_path;  // NULL: no telemetry segment
+    unsigned          status_flags;    // extra CM_STATUS_* for the per-poll burst
+    int               json_log;        // log lines as {"cmd","time","msg"} objects
+
+    // Called by cm_mon_run after every poll (rc = the poll's bus result),
+    // e.g. cm_metrics_on_poll.
+    void (*on_poll)(const struct cm_mon *mon, int rc, void *user);
+    void             *on_poll_user;
+
+    // Phase source for decision 3: NULL reads DPLLn_PHASE_STATUS over SPI at
+    // each check; otherwise the latest record of a running cm_sampler is used
+    // (SPI fallback if it has no fresh sample for the channel).
+    const cm_phase_ring_t *phase_ring;
+} cm_mon_cfg_t;
+
+// The script's defaults (POLL_SEC=1, FREQ_CH=5, GPS_CHANS=(6), ...).
+void cm_mon_cfg_defaults(cm_mon_cfg_t *cfg);
+
+typedef struct {
+    double   last_seen;
+    double   last_change;
+    double   flap_win_start;
+    unsigned flap_count;
+    double   unlock_since;        // 0 = locked
+    double   last_reset;
+    double   phase_exceed_since;  // 0 = not exceeding
+    double   last_phase_check;
+    double   last_phase_reset;
+    uint8_t  state;               // DPLL_STATE from the last burst
+    uint8_t  sticky;              // LOCK_STATE_CHANGE_STICKY from the last burst
+    uint64_t sticky_hist;         // sticky at the start of each poll, bit 0 = last
+    uint32_t sticky_polls;        // polls that started with sticky set
+    uint32_t pulses;              // relock pulses issued on this channel
+} cm_mon_chan_t;
+
+typedef struct cm_mon {
+    const cm_bus_t *bus;
+    cm_mon_cfg_t    cfg;
+
+    // Resolved once by cm_mon_init()
+    uint16_t sticky_clear_addr;
+    cm_field_write_t oper_state[CM_MON_MAX_CHANS];  // DPLL_Config.DPLL_MODE.STATE_MODE
+
+    cm_mon_chan_t ch[CM_MON_MAX_CHANS];
+    cm_phase_cursor_t phase_cur;  // cfg.phase_ring consumer
+    int64_t  ring_phase[CM_MON_MAX_CHANS];
+    double   ring_phase_at[CM_MON_MAX_CHANS];  // cm_mon_now() when received, 0 = none
+    double   start;
+    double   freq_locked_since;
+    int      freq_stably_locked;
+    double   gps_boost_until;
+    double   last_intervention;
+    int      status_state;        // -1 none yet, 0 NOT_OK, 1 OK
+    char     status_msg[192];
+    uint64_t polls;
+    uint64_t pulses;              // relock pulses issued
+    uint64_t bursts;              // SPI bursts issued (reads + writes)
+
+    // Telemetry (cfg.telemetry_path)
+    unsigned status_flags;        // CM_STATUS_* for the per-poll burst
+    dpll_status_snapshot_t snap;  // last per-poll burst
+    cm_telem_writer_t telem;
+    cm_steer_t wr_freq;           // DPLL_WR_FREQ span, read with one burst
+    int64_t  wr_freq_s42[CM_MON_MAX_CHANS];
+    cm_field_write_t combo_en[CM_MON_MAX_CHANS];   // monitored channels only
+    cm_field_write_t combo_src[CM_MON_MAX_CHANS];
+    uint8_t  combo_cfg[CM_MON_MAX_CHANS];          // raw DPLL_COMBO_SLAVE_CFG_0
+    uint8_t  combo_valid;         // bit n: combo_cfg[n] has been read
+    double   last_cfg_read;
+} cm_mon_t;
+
+// Resolve register handles and clear the sticky bits of every monitored
+// channel. Returns 0 on success, -1 on bad config, or a bus / lookup error.
+int cm_mon_init(cm_mon_t *mon, const cm_bus_t *bus, const cm_mon_cfg_t *cfg);
+
+// One poll cycle at monotonic time `now` (seconds). Returns 0 or a bus error.
+int cm_mon_poll(cm_mon_t *mon, double now);
+
+// Poll every cfg.poll_sec until *stop becomes non-zero, then write
+// "NOT_OK STOPPED" to the status file (and publish it to the telemetry
+// segment, with pid 0). Bus errors are logged and retried on the next poll.
+// Returns 0.
+int cm_mon_run(cm_mon_t *mon, volatile sig_atomic_t *stop);
+
+// Monotonic clock in seconds.
+double cm_mon_now(void);
+
+#ifdef __cplusplus
+}
+#endif
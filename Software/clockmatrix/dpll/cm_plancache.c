@@ -0,0 +1,186 @@
+// cm_plancache.c
+// Persistent (mmap'd) cache of frequency plans.
+
+#define _GNU_SOURCE
+
+#include "cm_plancache.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CM_PLANCACHE_MAGIC   "CMPLAN01"
+#define CM_PLANCACHE_PROBES  16u
+
+typedef struct {
+    char     magic[8];
+    uint32_t planner_version;   // CM_FP_PLANNER_VERSION
+    uint32_t nslots;
+    uint32_t slot_size;         // sizeof(cm_plancache_slot_t)
+    uint32_t reserved[3];
+} cm_plancache_hdr_t;
+
+typedef struct {
+    uint32_t      used;         // written last, so a torn insert reads as empty
+    uint32_t      hash;
+    cm_plan_key_t key;
+    cm_plan_val_t val;
+} cm_plancache_slot_t;
+
+static size_t cm_plancache_size(uint32_t nslots)
+{
+    return sizeof(cm_plancache_hdr_t) + (size_t)nslots * sizeof(cm_plancache_slot_t);
+}
+
+static cm_plancache_slot_t *cm_plancache_slots(const cm_plancache_t *pc)
+{
+    return (cm_plancache_slot_t *)((uint8_t *)pc->map + sizeof(cm_plancache_hdr_t));
+}
+
+// FNV-1a over the key; the key has no padding (all 32/64-bit members).
+static uint32_t cm_plancache_hash(const cm_plan_key_t *key)
+{
+    const uint8_t *p = (const uint8_t *)key;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(*key); i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int cm_plancache_hdr_ok(const cm_plancache_hdr_t *h)
+{
+    return memcmp(h->magic, CM_PLANCACHE_MAGIC, sizeof(h->magic)) == 0 &&
+           h->planner_version == CM_FP_PLANNER_VERSION &&
+           h->nslots == CM_PLANCACHE_SLOTS &&
+           h->slot_size == sizeof(cm_plancache_slot_t);
+}
+
+// Create the last directory component of path if it is missing.
+static void cm_plancache_mkdir_parent(const char *path)
+{
+    char dir[256];
+    const char *slash = strrchr(path, '/');
+    if (!slash || slash == path || (size_t)(slash - path) >= sizeof(dir)) return;
+    memcpy(dir, path, (size_t)(slash - path));
+    dir[slash - path] = '\0';
+    (void)mkdir(dir, 0755);  // EEXIST is fine; open() reports real failures
+}
+
+int cm_plancache_open(cm_plancache_t *pc, const char *path)
+{
+    if (!pc) return -1;
+    memset(pc, 0, sizeof(*pc));
+    pc->fd = -1;
+    if (!path) path = CM_PLANCACHE_DEFAULT_PATH;
+
+    cm_plancache_mkdir_parent(path);
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    const size_t len = cm_plancache_size(CM_PLANCACHE_SLOTS);
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    // Validate (or rebuild) the file while holding the exclusive lock.
+    struct stat st;
+    cm_plancache_hdr_t hdr;
+    int valid = fstat(fd, &st) == 0 && (size_t)st.st_size == len &&
+                pread(fd, &hdr, sizeof(hdr), 0) == (ssize_t)sizeof(hdr) &&
+                cm_plancache_hdr_ok(&hdr);
+    if (!valid) {
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, CM_PLANCACHE_MAGIC, sizeof(hdr.magic));
+        hdr.planner_version = CM_FP_PLANNER_VERSION;
+        hdr.nslots = CM_PLANCACHE_SLOTS;
+        hdr.slot_size = sizeof(cm_plancache_slot_t);
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)len) != 0 ||
+            pwrite(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr)) {
+            flock(fd, LOCK_UN);
+            close(fd);
+            return -1;
+        }
+    }
+
+    void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    flock(fd, LOCK_UN);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+
+    pc->fd = fd;
+    pc->map = map;
+    pc->len = len;
+    pc->nslots = CM_PLANCACHE_SLOTS;
+    return 0;
+}
+
+void cm_plancache_close(cm_plancache_t *pc)
+{
+    if (!pc) return;
+    if (pc->map) munmap(pc->map, pc->len);
+    if (pc->fd >= 0) close(pc->fd);
+    pc->map = NULL;
+    pc->fd = -1;
+}
+
+int cm_plancache_lookup(cm_plancache_t *pc, const cm_plan_key_t *key,
+                        cm_plan_val_t *val)
+{
+    if (!pc || !pc->map || !key || !val) return -1;
+
+    const uint32_t h = cm_plancache_hash(key);
+    cm_plancache_slot_t *slots = cm_plancache_slots(pc);
+    int hit = 0;
+
+    flock(pc->fd, LOCK_SH);
+    for (uint32_t i = 0; i < CM_PLANCACHE_PROBES; i++) {
+        const cm_plancache_slot_t *s = &slots[(h + i) % pc->nslots];
+        if (!__atomic_load_n(&s->used, __ATOMIC_ACQUIRE)) break;
+        if (s->hash == h && memcmp(&s->key, key, sizeof(*key)) == 0) {
+            *val = s->val;
+            hit = 1;
+            break;
+        }
+    }
+    flock(pc->fd, LOCK_UN);
+
+    if (hit) pc->hits++;
+    else pc->misses++;
+    return hit;
+}
+
+int cm_plancache_store(cm_plancache_t *pc, const cm_plan_key_t *key,
+                       const cm_plan_val_t *val)
+{
+    if (!pc || !pc->map || !key || !val) return -1;
+
+    const uint32_t h = cm_plancache_hash(key);
+    cm_plancache_slot_t *slots = cm_plancache_slots(pc);
+    cm_plancache_slot_t *dst = &slots[h % pc->nslots];
+
+    flock(pc->fd, LOCK_EX);
+    for (uint32_t i = 0; i < CM_PLANCACHE_PROBES; i++) {
+        cm_plancache_slot_t *s = &slots[(h + i) % pc->nslots];
+        if (!s->used || (s->hash == h && memcmp(&s->key, key, sizeof(*key)) == 0)) {
+            dst = s;
+            break;
+        }
+    }
+
+    __atomic_store_n(&dst->used, 0, __ATOMIC_RELEASE);
+    dst->hash = h;
+    dst->key = *key;
+    dst->val = *val;
+    __atomic_store_n(&dst->used, 1, __ATOMIC_RELEASE);
+    msync(pc->map, pc->len, MS_ASYNC);
+    flock(pc->fd, LOCK_UN);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// cm_plancache.h
+//
+// Persistent cache of frequency plans, so a reboot that asks for the same
+// input/output frequencies looks the answer up instead of searching again.
+//
+// The cache is a fixed-size open-addressing hash table in a file that is
+// mmap'd shared. Keys are the exact requested frequencies (cm_freq_t) plus
+// the plan kind; the file header carries CM_FP_PLANNER_VERSION and the slot
+// layout, and a file written by a different planner is wiped on open.
+// Writers hold flock(LOCK_EX), readers flock(LOCK_SH), so concurrent
+// dplltool runs are safe. The cache is only an accelerator: every failure
+// (no directory, read-only filesystem, corrupt file) means "search".
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cm_freqplan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_PLANCACHE_DEFAULT_PATH "/var/cache/switchberry/dpll-plans.bin"
+#define CM_PLANCACHE_SLOTS        1024u
+
+typedef enum {
+    CM_PLAN_INPUT_RATIO = 1,   // dpll_compute_input_ratio(freq[0])
+    CM_PLAN_OUTPUT_PAIR = 2,   // cm_fp_plan_dco(freq[0], freq[1])
+} cm_plan_kind_t;
+
+typedef struct {
+    uint32_t  kind;      // cm_plan_kind_t
+    uint32_t  nfreq;     // 1 or 2
+    cm_freq_t freq[2];   // unused entries are {0, 0}
+} cm_plan_key_t;
+
+typedef struct {
+    uint64_t m;          // input M / FOD M
+    uint32_t n;          // N (1..65535)
+    uint32_t div[2];     // output dividers (output pairs only)
+    double   err_ppb[2];
+    int32_t  exact;
+    uint32_t search_us;  // how long the search that produced it took
+} cm_plan_val_t;
+
+typedef struct cm_plancache {
+    int      fd;
+    void    *map;
+    size_t   len;
+    uint32_t nslots;
+    uint64_t hits;
+    uint64_t misses;
+} cm_plancache_t;
+
+// Open (creating the file and its parent directory if needed). Returns 0 on
+// success, -1 if the cache cannot be used; pc is then safe to close.
+int  cm_plancache_open(cm_plancache_t *pc, const char *path);
+void cm_plancache_close(cm_plancache_t *pc);
+
+// Returns 1 and fills val on a hit, 0 on a miss, -1 if pc is not open.
+int  cm_plancache_lookup(cm_plancache_t *pc, const cm_plan_key_t *key,
+                         cm_plan_val_t *val);
+
+// Insert or replace. When the probe sequence is full the home slot is
+// overwritten. Returns 0 on success.
+int  cm_plancache_store(cm_plancache_t *pc, const cm_plan_key_t *key,
+                        const cm_plan_val_t *val);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+// cm_sampler.c
+// Fixed-rate DPLL phase sampler + SPMC broadcast ring (see cm_sampler.h).
+
+#define _GNU_SOURCE
+
+#include "cm_sampler.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cm_status.h"
+
+// ---------------------------------------------------------------------------
+// Ring
+// ---------------------------------------------------------------------------
+
+int cm_phase_ring_init(cm_phase_ring_t *r, size_t capacity)
+{
+    if (!r) return -1;
+    memset(r, 0, sizeof(*r));
+    if (capacity == 0) capacity = CM_SAMPLER_DEFAULT_RING;
+    if (capacity > ((size_t)1 << 24)) return -1;
+
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+
+    // seq 0 never matches a published record (2*i+2 >= 2)
+    r->slot = calloc(cap, sizeof(*r->slot));
+    if (!r->slot) return -1;
+    r->mask = cap - 1;
+    return 0;
+}
+
+void cm_phase_ring_free(cm_phase_ring_t *r)
+{
+    if (!r) return;
+    free(r->slot);
+    r->slot = NULL;
+}
+
+void cm_phase_ring_push(cm_phase_ring_t *r, const cm_phase_sample_t *s)
+{
+    const uint64_t i = __atomic_load_n(&r->head, __ATOMIC_RELAXED);  // only writer
+    cm_phase_slot_t *sl = &r->slot[i & r->mask];
+
+    __atomic_store_n(&sl->seq, 2 * i + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    sl->s = *s;
+    __atomic_store_n(&sl->seq, 2 * i + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->head, i + 1, __ATOMIC_RELEASE);
+}
+
+void cm_phase_cursor_init(const cm_phase_ring_t *r, cm_phase_cursor_t *c, int from_oldest)
+{
+    const uint64_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    const uint64_t cap = r->mask + 1;
+    c->lost = 0;
+    if (!from_oldest) c->next = head;
+    else c->next = (head > cap) ? head - cap : 0;
+}
+
+int cm_phase_ring_pop(const cm_phase_ring_t *r, cm_phase_cursor_t *c, cm_phase_sample_t *out)
+{
+    const uint64_t cap = r->mask + 1;
+
+    for (;;) {
+        const uint64_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+        if (c->next >= head) return 0;
+        if (head - c->next > cap) {
+            c->lost += head - cap - c->next;
+            c->next = head - cap;
+        }
+
+        const cm_phase_slot_t *sl = &r->slot[c->next & r->mask];
+        const uint64_t want = 2 * c->next + 2;
+        const uint64_t s1 = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE);
+        if (s1 == want) {
+            *out = sl->s;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&sl->seq, __ATOMIC_RELAXED) == want) {
+                c->next++;
+                return 1;
+            }
+        }
+
+        // The producer lapped us on this slot: the record is gone.
+        c->lost++;
+        c->next++;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sampler thread
+// ---------------------------------------------------------------------------
+
+uint64_t cm_sampler_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t cm_sampler_mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void *cm_sampler_main(void *arg)
+{
+    cm_sampler_t *s = arg;
+    const uint64_t period = (uint64_t)(1e9 / s->cfg.rate_hz + 0.5);
+    uint64_t deadline = cm_sampler_mono_ns();
+    uint64_t tick = 0;
+
+    while (!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE)) {
+        cm_phase_sample_t rec;
+        memset(&rec, 0, sizeof(rec));
+        rec.tick = tick;
+        rec.chan_mask = s->cfg.chan_mask;
+
+        const uint64_t t0 = cm_sampler_now_ns();
+        rec.rc = dpll_phase_status_read(s->bus, s->cfg.chan_mask, rec.phase_s36);
+        const uint64_t t1 = cm_sampler_now_ns();
+        rec.t_ns = t0 + (t1 - t0) / 2;
+        rec.burst_ns = (uint32_t)(t1 - t0);
+        cm_phase_ring_push(&s->ring, &rec);
+
+        __atomic_store_n(&s->ticks, s->ticks + 1, __ATOMIC_RELAXED);
+        if (rec.rc) __atomic_store_n(&s->errors, s->errors + 1, __ATOMIC_RELAXED);
+        if (rec.burst_ns > s->max_burst_ns)
+            __atomic_store_n(&s->max_burst_ns, rec.burst_ns, __ATOMIC_RELAXED);
+
+        // Fixed grid: a late tick is skipped, not squeezed in.
+        deadline += period;
+        tick++;
+        const uint64_t now = cm_sampler_mono_ns();
+        if (now >= deadline) {
+            const uint64_t skip = (now - deadline) / period + 1;
+            __atomic_store_n(&s->missed, s->missed + skip, __ATOMIC_RELAXED);
+            deadline += skip * period;
+            tick += skip;
+        }
+
+        struct timespec ts;
+        ts.tv_sec = (time_t)(deadline / 1000000000ull);
+        ts.tv_nsec = (long)(deadline % 1000000000ull);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0 &&
+               !__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE)) {
+        }
+    }
+    return NULL;
+}
+
+int cm_sampler_start(cm_sampler_t *s, const cm_bus_t *bus, const cm_sampler_cfg_t *cfg)
+{
+    if (!s || !bus || !cfg) return -1;
+    if (!cfg->chan_mask || (cfg->chan_mask >> CM_SAMPLER_MAX_CHANS)) return -1;
+    if (!(cfg->rate_hz >= CM_SAMPLER_MIN_HZ && cfg->rate_hz <= CM_SAMPLER_MAX_HZ)) return -1;
+
+    memset(s, 0, sizeof(*s));
+    s->bus = bus;
+    s->cfg = *cfg;
+    if (cm_phase_ring_init(&s->ring, cfg->ring_capacity) != 0) return -1;
+
+    int rc = pthread_create(&s->thread, NULL, cm_sampler_main, s);
+    if (rc != 0) {
+        cm_phase_ring_free(&s->ring);
+        return rc;
+    }
+    s->running = 1;
+    return 0;
+}
+
+void cm_sampler_stop(cm_sampler_t *s)
+{
+    if (!s || !s->running) return;
+    __atomic_store_n(&s->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(s->thread, NULL);
+    s->running = 0;
+    cm_phase_ring_free(&s->ring);
+}
+
+void cm_sampler_stats(const cm_sampler_t *s, cm_sampler_stats_t *out)
+{
+    out->ticks = __atomic_load_n(&s->ticks, __ATOMIC_RELAXED);
+    out->missed = __atomic_load_n(&s->missed, __ATOMIC_RELAXED);
+    out->errors = __atomic_load_n(&s->errors, __ATOMIC_RELAXED);
+    out->max_burst_ns = __atomic_load_n(&s->max_burst_ns, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,118 @@
+// cm_sampler.h
+//
+// Fixed-rate DPLL phase sampler feeding a lock-free broadcast ring.
+//
+// A sampler thread reads DPLL<n>_PHASE_STATUS for a set of channels at
+// 10..1000 Hz (one burst per tick, see dpll_phase_status_read) and pushes one
+// record per tick, timestamped with CLOCK_MONOTONIC_RAW, into a ring.
+//
+// The ring has a single producer and any number of consumers. Every consumer
+// owns a cursor and sees every record (broadcast, not a work queue); nobody
+// ever blocks the producer. A consumer that falls more than the ring capacity
+// behind skips ahead to the oldest record still present and the skipped
+// records are counted in cursor->lost. Each slot is a seqlock, so a reader
+// racing with the producer's overwrite retries instead of returning a torn
+// record.
+
+#pragma once
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_SAMPLER_MAX_CHANS     8
+#define CM_SAMPLER_MIN_HZ        10.0
+#define CM_SAMPLER_MAX_HZ        1000.0
+#define CM_SAMPLER_DEFAULT_RING  4096   // records; 4 s at 1 kHz
+
+typedef struct {
+    uint64_t t_ns;        // CLOCK_MONOTONIC_RAW at the middle of the burst
+    uint64_t tick;        // tick index since start; gaps are missed ticks
+    uint32_t chan_mask;   // channels present in phase_s36[]
+    int32_t  rc;          // 0, or the bus error (phase_s36[] not valid)
+    uint32_t burst_ns;    // duration of the SPI burst
+    uint32_t reserved;
+    int64_t  phase_s36[CM_SAMPLER_MAX_CHANS];  // ITDC_UI units
+} cm_phase_sample_t;
+
+typedef struct {
+    uint64_t          seq;  // 2*i+1 while record i is written, 2*i+2 once published
+    cm_phase_sample_t s;
+} cm_phase_slot_t;
+
+typedef struct {
+    cm_phase_slot_t *slot;
+    uint64_t         mask;  // capacity - 1
+    uint64_t         head;  // records published so far (atomic)
+} cm_phase_ring_t;
+
+typedef struct {
+    uint64_t next;          // index of the next record to read
+    uint64_t lost;          // records overwritten before this consumer read them
+} cm_phase_cursor_t;
+
+// capacity is rounded up to a power of two (0 = CM_SAMPLER_DEFAULT_RING).
+int  cm_phase_ring_init(cm_phase_ring_t *r, size_t capacity);
+void cm_phase_ring_free(cm_phase_ring_t *r);
+
+// Producer side: one thread only.
+void cm_phase_ring_push(cm_phase_ring_t *r, const cm_phase_sample_t *s);
+
+// Start a consumer at the next record to be published, or (from_oldest != 0)
+// at the oldest record still in the ring.
+void cm_phase_cursor_init(const cm_phase_ring_t *r, cm_phase_cursor_t *c, int from_oldest);
+
+// Copy the next record for this consumer. Returns 1 if *out was filled,
+// 0 if the consumer is up to date.
+int cm_phase_ring_pop(const cm_phase_ring_t *r, cm_phase_cursor_t *c, cm_phase_sample_t *out);
+
+// ---------------------------------------------------------------------------
+// Sampler thread
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned chan_mask;      // bit n = DPLL n
+    double   rate_hz;        // CM_SAMPLER_MIN_HZ..CM_SAMPLER_MAX_HZ
+    size_t   ring_capacity;  // 0 = CM_SAMPLER_DEFAULT_RING
+} cm_sampler_cfg_t;
+
+typedef struct {
+    const cm_bus_t  *bus;    // shared with other threads: use cm_bus_init_locked
+    cm_sampler_cfg_t cfg;
+    cm_phase_ring_t  ring;
+    pthread_t        thread;
+    int              running;
+    int              stop;   // atomic
+
+    // Written by the sampler thread, read with cm_sampler_stats().
+    uint64_t ticks;          // records pushed
+    uint64_t missed;         // ticks skipped because a burst overran the period
+    uint64_t errors;         // records with rc != 0
+    uint64_t max_burst_ns;
+} cm_sampler_t;
+
+typedef struct {
+    uint64_t ticks, missed, errors, max_burst_ns;
+} cm_sampler_stats_t;
+
+// Allocate the ring and start the thread. Returns 0, -1 on bad config or
+// allocation failure, or the pthread_create error.
+int  cm_sampler_start(cm_sampler_t *s, const cm_bus_t *bus, const cm_sampler_cfg_t *cfg);
+
+// Stop and join the thread and free the ring. Consumers must be done.
+void cm_sampler_stop(cm_sampler_t *s);
+
+void cm_sampler_stats(const cm_sampler_t *s, cm_sampler_stats_t *out);
+
+// CLOCK_MONOTONIC_RAW in nanoseconds (the sample timebase).
+uint64_t cm_sampler_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
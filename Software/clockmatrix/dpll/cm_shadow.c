@@ -0,0 +1,185 @@
+// cm_shadow.c
+// Write-through shadow cache for the ClockMatrix register bus.
+
+#include "cm_shadow.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Per-address state bits (cm_shadow_t.state[]).
+#define CM_SHADOW_CONFIG   0x01u  // named by at least one CM_REG_CONFIG register
+#define CM_SHADOW_VOLATILE 0x02u  // named by at least one CM_REG_VOLATILE register
+#define CM_SHADOW_VALID    0x04u  // val[] holds the device value
+
+static int cm_shadow_cacheable_state(uint8_t st)
+{
+    // A volatile descriptor always wins, e.g. where two modules share a base.
+    return (st & (CM_SHADOW_CONFIG | CM_SHADOW_VOLATILE)) == CM_SHADOW_CONFIG;
+}
+
+// Number of addresses from addr that lie inside the 16-bit register space.
+static size_t cm_shadow_clip(uint16_t addr, size_t len)
+{
+    size_t room = CM_SHADOW_SPACE - (size_t)addr;
+    return (len < room) ? len : room;
+}
+
+// ---------------------------------------------------------------------------
+// Cache fill / lookup
+// ---------------------------------------------------------------------------
+
+static void cm_shadow_fill(cm_shadow_t *sh, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    len = cm_shadow_clip(addr, len);
+    for (size_t i = 0; i < len; i++) {
+        size_t a = (size_t)addr + i;
+        if (!cm_shadow_cacheable_state(sh->state[a])) continue;
+        sh->val[a] = buf[i];
+        sh->state[a] |= CM_SHADOW_VALID;
+    }
+}
+
+// Returns 1 and copies into buf if every byte of the range is cached.
+static int cm_shadow_lookup(const cm_shadow_t *sh, uint16_t addr, uint8_t *buf, size_t len)
+{
+    if (cm_shadow_clip(addr, len) != len) return 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t st = sh->state[(size_t)addr + i];
+        if (!(st & CM_SHADOW_VALID) || !cm_shadow_cacheable_state(st)) return 0;
+    }
+    memcpy(buf, &sh->val[addr], len);
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// cm_bus_t callbacks (user points to the cm_shadow_t)
+// ---------------------------------------------------------------------------
+
+static int cm_shadow_read(void *user, uint16_t addr, uint8_t *buf, size_t len)
+{
+    cm_shadow_t *sh = (cm_shadow_t *)user;
+
+    if (cm_shadow_lookup(sh, addr, buf, len)) {
+        sh->hits++;
+        return 0;
+    }
+
+    sh->misses++;
+    int rc = sh->lower.read(sh->lower.user, addr, buf, len);
+    if (rc) return rc;
+    cm_shadow_fill(sh, addr, buf, len);
+    return 0;
+}
+
+static int cm_shadow_read8(void *user, uint16_t addr, uint8_t *val)
+{
+    cm_shadow_t *sh = (cm_shadow_t *)user;
+
+    if (cm_shadow_lookup(sh, addr, val, 1)) {
+        sh->hits++;
+        return 0;
+    }
+
+    sh->misses++;
+    int rc = sh->lower.read8(sh->lower.user, addr, val);
+    if (rc) return rc;
+    cm_shadow_fill(sh, addr, val, 1);
+    return 0;
+}
+
+static int cm_shadow_write(void *user, uint16_t addr, const uint8_t *buf, size_t len)
+{
+    cm_shadow_t *sh = (cm_shadow_t *)user;
+
+    int rc = sh->lower.write(sh->lower.user, addr, buf, len);
+    if (rc) {
+        // Part of the write may have landed; we no longer know the contents.
+        cm_shadow_invalidate_range(sh, addr, len);
+        return rc;
+    }
+    cm_shadow_fill(sh, addr, buf, len);
+    return 0;
+}
+
+static int cm_shadow_write8(void *user, uint16_t addr, uint8_t val)
+{
+    cm_shadow_t *sh = (cm_shadow_t *)user;
+
+    int rc = sh->lower.write8(sh->lower.user, addr, val);
+    if (rc) {
+        cm_shadow_invalidate_range(sh, addr, 1);
+        return rc;
+    }
+    cm_shadow_fill(sh, addr, &val, 1);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+int cm_shadow_init(cm_shadow_t *sh, const cm_bus_t *lower)
+{
+    if (!sh || !lower) return -1;
+    memset(sh, 0, sizeof(*sh));
+
+    sh->val   = (uint8_t *)calloc(CM_SHADOW_SPACE, 1);
+    sh->state = (uint8_t *)calloc(CM_SHADOW_SPACE, 1);
+    if (!sh->val || !sh->state) {
+        cm_shadow_free(sh);
+        return -1;
+    }
+    sh->lower = *lower;
+
+    for (size_t m = 0; m < cm_all_modules_count; m++) {
+        const cm_module_desc_t *mod = cm_all_modules[m];
+        for (unsigned inst = 0; inst < mod->count; inst++) {
+            for (unsigned r = 0; r < mod->nregs; r++) {
+                const cm_reg_desc_t *reg = &mod->regs[r];
+                uint16_t a = (uint16_t)(mod->bases[inst] + reg->offset);
+                sh->state[a] |= (reg->flags & CM_REG_VOLATILE) ? CM_SHADOW_VOLATILE
+                                                                : CM_SHADOW_CONFIG;
+            }
+        }
+    }
+    return 0;
+}
+
+void cm_shadow_free(cm_shadow_t *sh)
+{
+    if (!sh) return;
+    free(sh->val);
+    free(sh->state);
+    sh->val = NULL;
+    sh->state = NULL;
+}
+
+void cm_shadow_bus(cm_shadow_t *sh, cm_bus_t *bus_out)
+{
+    if (!sh || !bus_out) return;
+    bus_out->user   = sh;
+    bus_out->read8  = cm_shadow_read8;
+    bus_out->write8 = cm_shadow_write8;
+    bus_out->read   = cm_shadow_read;
+    bus_out->write  = cm_shadow_write;
+}
+
+void cm_shadow_invalidate(cm_shadow_t *sh)
+{
+    if (!sh || !sh->state) return;
+    cm_shadow_invalidate_range(sh, 0, CM_SHADOW_SPACE);
+}
+
+void cm_shadow_invalidate_range(cm_shadow_t *sh, uint16_t addr, size_t len)
+{
+    if (!sh || !sh->state) return;
+    len = cm_shadow_clip(addr, len);
+    for (size_t i = 0; i < len; i++)
+        sh->state[(size_t)addr + i] &= (uint8_t)~CM_SHADOW_VALID;
+}
+
+int cm_shadow_is_cacheable(const cm_shadow_t *sh, uint16_t addr)
+{
+    if (!sh || !sh->state) return 0;
+    return cm_shadow_cacheable_state(sh->state[addr]);
+}
@@ -0,0 +1,62 @@
+// cm_shadow.h
+//
+// Optional write-through shadow cache for the ClockMatrix register bus.
+//
+// cm_shadow wraps an existing cm_bus_t and exposes another cm_bus_t with the
+// same semantics. Reads of configuration registers (cm_reg_desc_t.flags ==
+// CM_REG_CONFIG) are served from memory once they have been read or written,
+// so a cm_field_write8() read-modify-write of a config register costs a single
+// SPI write. Volatile registers (status, sticky, TOD read, command/trigger) and
+// addresses not named by the tables always go to the device.
+//
+// Writes always go to the device first; the cache is only updated when the
+// write succeeded, and the affected range is invalidated when it failed.
+//
+// Anything that changes registers behind the bus (TCS / programming file apply,
+// EEPROM reload or flash, raw dpll_write8() on the fd, a device reset) must be
+// followed by cm_shadow_invalidate().
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t + table descriptors
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The 8A3400x register space is 16-bit addressed.
+#define CM_SHADOW_SPACE 0x10000u
+
+typedef struct cm_shadow {
+    cm_bus_t  lower;    // underlying (uncached) bus
+    uint8_t  *val;      // CM_SHADOW_SPACE bytes: cached register values
+    uint8_t  *state;    // CM_SHADOW_SPACE bytes: per-address CM_SHADOW_* bits
+    uint64_t  hits;     // reads fully served from memory
+    uint64_t  misses;   // reads that went to the device
+} cm_shadow_t;
+
+// Build the cacheable-address map from the tables and take a copy of *lower.
+// Returns 0 on success, -1 on allocation failure.
+int cm_shadow_init(cm_shadow_t *sh, const cm_bus_t *lower);
+
+void cm_shadow_free(cm_shadow_t *sh);
+
+// Fill *bus_out with a bus whose accesses go through the cache. *sh must stay
+// alive (and at the same address) for as long as bus_out is used.
+void cm_shadow_bus(cm_shadow_t *sh, cm_bus_t *bus_out);
+
+// Drop every cached value (the cacheable map itself is kept).
+void cm_shadow_invalidate(cm_shadow_t *sh);
+
+// Drop cached values for [addr, addr + len).
+void cm_shadow_invalidate_range(cm_shadow_t *sh, uint16_t addr, size_t len);
+
+// 1 if addr is named by a non-volatile table register and may be cached.
+int cm_shadow_is_cacheable(const cm_shadow_t *sh, uint16_t addr);
+
+#ifdef __cplusplus
+}
+#endif
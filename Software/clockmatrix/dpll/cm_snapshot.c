@@ -0,0 +1,454 @@
+// cm_snapshot.c
+// Whole-device register snapshot + decoded diff.
+
+#define _GNU_SOURCE
+
+#include "cm_snapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CM_SNAPSHOT_MAGIC      "CMSNAP01"
+#define CM_SNAPSHOT_HDR_LEN    32
+#define CM_SNAPSHOT_PAGE_SIZE  0x80   // one page register setting per burst
+
+// ---------------------------------------------------------------------------
+// Table walking
+// ---------------------------------------------------------------------------
+
+// Mark every address named by the tables. map must hold 0x10000 bytes.
+static void cm_snapshot_mark_mapped(uint8_t *map)
+{
+    for (size_t m = 0; m < cm_all_modules_count; m++) {
+        const cm_module_desc_t *mod = cm_all_modules[m];
+        for (unsigned inst = 0; inst < mod->count; inst++) {
+            for (uint16_t r = 0; r < mod->nregs; r++) {
+                uint16_t addr = (uint16_t)(mod->bases[inst] + mod->regs[r].offset);
+                map[addr] = 1;
+            }
+        }
+    }
+}
+
+static int cm_snapshot_push_span(cm_snapshot_span_t **spans, size_t *n, size_t *cap,
+                                 uint32_t start, uint32_t end)
+{
+    if (*n == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 64;
+        cm_snapshot_span_t *tmp = realloc(*spans, ncap * sizeof(**spans));
+        if (!tmp) return -1;
+        *spans = tmp;
+        *cap = ncap;
+    }
+    (*spans)[*n].addr = (uint16_t)start;
+    (*spans)[*n].len  = (uint16_t)(end - start);
+    (*spans)[*n].data = NULL;
+    (*n)++;
+    return 0;
+}
+
+// Build merged spans from the mapped-address map. Two mapped addresses share a
+// span when the gap between them is small and they sit on the same page, since
+// a page change costs a separate burst anyway.
+static int cm_snapshot_build_spans(const uint8_t *map, cm_snapshot_span_t **spans_out,
+                                   size_t *nspans_out)
+{
+    cm_snapshot_span_t *spans = NULL;
+    size_t n = 0, cap = 0;
+    uint32_t start = 0, end = 0;  // current span [start, end)
+    int open = 0;
+
+    for (uint32_t a = 0; a < 0x10000u; a++) {
+        if (!map[a]) continue;
+
+        if (open && a - end <= CM_SNAPSHOT_MERGE_GAP &&
+            (a / CM_SNAPSHOT_PAGE_SIZE) == ((end - 1) / CM_SNAPSHOT_PAGE_SIZE)) {
+            end = a + 1;
+            continue;
+        }
+        if (open && cm_snapshot_push_span(&spans, &n, &cap, start, end) != 0) {
+            free(spans);
+            return -1;
+        }
+        start = a;
+        end = a + 1;
+        open = 1;
+    }
+    if (open && cm_snapshot_push_span(&spans, &n, &cap, start, end) != 0) {
+        free(spans);
+        return -1;
+    }
+
+    *spans_out = spans;
+    *nspans_out = n;
+    return 0;
+}
+
+// Resolve a 2-byte identification register from the captured data.
+static uint16_t cm_snapshot_id16(const cm_snapshot_t *snap, const char *reg_name)
+{
+    const cm_module_desc_t *mod = NULL;
+    const cm_reg_desc_t *reg = NULL;
+    if (cm_find_module("DPLL_GeneralStatus", &mod) != 0) return 0;
+    if (cm_find_reg(mod, reg_name, &reg) != 0) return 0;
+
+    uint16_t addr = (uint16_t)(mod->bases[0] + reg->offset);
+    uint8_t lo = 0, hi = 0;
+    if (cm_snapshot_get(snap, addr, &lo) != 0) return 0;
+    if (cm_snapshot_get(snap, (uint16_t)(addr + 1), &hi) != 0) return 0;
+    return (uint16_t)(lo | (hi << 8));
+}
+
+// ---------------------------------------------------------------------------
+// Capture / free
+// ---------------------------------------------------------------------------
+
+int cm_snapshot_capture(const cm_bus_t *bus, cm_snapshot_t *snap)
+{
+    if (!bus || !snap) return -1;
+    memset(snap, 0, sizeof(*snap));
+
+    uint8_t *map = calloc(0x10000, 1);
+    if (!map) return -1;
+    cm_snapshot_mark_mapped(map);
+
+    int rc = cm_snapshot_build_spans(map, &snap->spans, &snap->nspans);
+    free(map);
+    if (rc) return rc;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    snap->timestamp_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    snap->table_version = cm_tables_version();
+
+    for (size_t i = 0; i < snap->nspans; i++) {
+        cm_snapshot_span_t *sp = &snap->spans[i];
+        sp->data = calloc(sp->len, 1);
+        if (!sp->data) {
+            cm_snapshot_free(snap);
+            return -1;
+        }
+
+        // bus->read does not cross page boundaries; split per page.
+        uint16_t addr = sp->addr;
+        size_t done = 0;
+        while (done < sp->len) {
+            size_t room  = CM_SNAPSHOT_PAGE_SIZE - (addr & (CM_SNAPSHOT_PAGE_SIZE - 1));
+            size_t chunk = sp->len - done;
+            if (chunk > room) chunk = room;
+            rc = bus->read(bus->user, addr, sp->data + done, chunk);
+            if (rc) {
+                fprintf(stderr, "cm_snapshot_capture: read 0x%04X+%zu failed\n",
+                        addr, chunk);
+                cm_snapshot_free(snap);
+                return rc;
+            }
+            addr = (uint16_t)(addr + chunk);
+            done += chunk;
+        }
+    }
+
+    snap->device_id  = cm_snapshot_id16(snap, "JTAG DEVICE ID");
+    snap->product_id = cm_snapshot_id16(snap, "PRODUCT ID");
+    return 0;
+}
+
+void cm_snapshot_free(cm_snapshot_t *snap)
+{
+    if (!snap) return;
+    for (size_t i = 0; i < snap->nspans; i++) free(snap->spans[i].data);
+    free(snap->spans);
+    snap->spans = NULL;
+    snap->nspans = 0;
+}
+
+int cm_snapshot_get(const cm_snapshot_t *snap, uint16_t addr, uint8_t *val)
+{
+    if (!snap || !val) return -1;
+    // Spans are sorted by address; binary search.
+    size_t lo = 0, hi = snap->nspans;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        const cm_snapshot_span_t *sp = &snap->spans[mid];
+        if (addr < sp->addr) {
+            hi = mid;
+        } else if (addr >= (uint32_t)sp->addr + sp->len) {
+            lo = mid + 1;
+        } else {
+            *val = sp->data[addr - sp->addr];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Save / load
+// ---------------------------------------------------------------------------
+
+static void put_le(uint8_t *p, uint64_t v, size_t n)
+{
+    for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint64_t get_le(const uint8_t *p, size_t n)
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+int cm_snapshot_save(const cm_snapshot_t *snap, const char *path)
+{
+    if (!snap || !path) return -1;
+
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        perror("cm_snapshot_save: fopen");
+        return -1;
+    }
+
+    uint32_t total = 0;
+    for (size_t i = 0; i < snap->nspans; i++) total += snap->spans[i].len;
+
+    uint8_t hdr[CM_SNAPSHOT_HDR_LEN];
+    memcpy(hdr, CM_SNAPSHOT_MAGIC, 8);
+    put_le(hdr + 8,  snap->timestamp_ns, 8);
+    put_le(hdr + 16, snap->device_id, 2);
+    put_le(hdr + 18, snap->product_id, 2);
+    put_le(hdr + 20, snap->table_version, 4);
+    put_le(hdr + 24, (uint64_t)snap->nspans, 4);
+    put_le(hdr + 28, total, 4);
+
+    int ok = fwrite(hdr, sizeof(hdr), 1, fp) == 1;
+    for (size_t i = 0; ok && i < snap->nspans; i++) {
+        uint8_t sh[4];
+        put_le(sh, snap->spans[i].addr, 2);
+        put_le(sh + 2, snap->spans[i].len, 2);
+        ok = fwrite(sh, sizeof(sh), 1, fp) == 1 &&
+             fwrite(snap->spans[i].data, 1, snap->spans[i].len, fp) == snap->spans[i].len;
+    }
+
+    if (fclose(fp) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "cm_snapshot_save: write to %s failed\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int cm_snapshot_load(cm_snapshot_t *snap, const char *path)
+{
+    if (!snap || !path) return -1;
+    memset(snap, 0, sizeof(*snap));
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        perror("cm_snapshot_load: fopen");
+        return -1;
+    }
+
+    uint8_t hdr[CM_SNAPSHOT_HDR_LEN];
+    if (fread(hdr, sizeof(hdr), 1, fp) != 1 || memcmp(hdr, CM_SNAPSHOT_MAGIC, 8) != 0) {
+        fprintf(stderr, "cm_snapshot_load: %s is not a register snapshot\n", path);
+        fclose(fp);
+        return -2;
+    }
+
+    snap->timestamp_ns  = get_le(hdr + 8, 8);
+    snap->device_id     = (uint16_t)get_le(hdr + 16, 2);
+    snap->product_id    = (uint16_t)get_le(hdr + 18, 2);
+    snap->table_version = (uint32_t)get_le(hdr + 20, 4);
+    uint32_t nspans     = (uint32_t)get_le(hdr + 24, 4);
+
+    if (nspans > 0x10000u) {
+        fprintf(stderr, "cm_snapshot_load: %s: bad span count %u\n", path, nspans);
+        fclose(fp);
+        return -2;
+    }
+
+    snap->spans = calloc(nspans ? nspans : 1, sizeof(*snap->spans));
+    if (!snap->spans) {
+        fclose(fp);
+        return -1;
+    }
+
+    uint32_t prev_end = 0;
+    for (uint32_t i = 0; i < nspans; i++) {
+        uint8_t sh[4];
+        if (fread(sh, sizeof(sh), 1, fp) != 1) goto truncated;
+
+        cm_snapshot_span_t *sp = &snap->spans[i];
+        sp->addr = (uint16_t)get_le(sh, 2);
+        sp->len  = (uint16_t)get_le(sh + 2, 2);
+        if (sp->len == 0 || sp->addr < prev_end ||
+            (uint32_t)sp->addr + sp->len > 0x10000u) {
+            fprintf(stderr, "cm_snapshot_load: %s: bad span %u\n", path, i);
+            cm_snapshot_free(snap);
+            fclose(fp);
+            return -2;
+        }
+        prev_end = (uint32_t)sp->addr + sp->len;
+
+        sp->data = malloc(sp->len);
+        if (!sp->data) {
+            cm_snapshot_free(snap);
+            fclose(fp);
+            return -1;
+        }
+        snap->nspans = i + 1;
+        if (fread(sp->data, 1, sp->len, fp) != sp->len) goto truncated;
+    }
+
+    fclose(fp);
+    return 0;
+
+truncated:
+    fprintf(stderr, "cm_snapshot_load: %s is truncated\n", path);
+    cm_snapshot_free(snap);
+    fclose(fp);
+    return -2;
+}
+
+// ---------------------------------------------------------------------------
+// Printing / diff
+// ---------------------------------------------------------------------------
+
+void cm_snapshot_print_header(const cm_snapshot_t *snap, const char *label,
+                              int (*printfn)(const char *fmt, ...))
+{
+    if (!snap || !printfn) return;
+
+    time_t secs = (time_t)(snap->timestamp_ns / 1000000000ull);
+    struct tm tmv;
+    char tbuf[32] = "?";
+    if (gmtime_r(&secs, &tmv)) strftime(tbuf, sizeof(tbuf), "%Y-%m-%dT%H:%M:%SZ", &tmv);
+
+    size_t total = 0;
+    for (size_t i = 0; i < snap->nspans; i++) total += snap->spans[i].len;
+
+    printfn("%s: %s device=0x%04X product=0x%04X tables=0x%08X spans=%zu bytes=%zu\n",
+            label ? label : "snapshot", tbuf, snap->device_id, snap->product_id,
+            snap->table_version, snap->nspans, total);
+}
+
+// Names are NULL in CM_STRIP_NAMES builds.
+static const char *cm_snapshot_name(const char *name, const char *fallback)
+{
+    return name ? name : fallback;
+}
+
+// Find the closest mapped register at or below addr (within 8 bytes) so that
+// bytes of multi-byte registers can still be attributed to a name.
+static int cm_snapshot_owner(uint16_t addr, const cm_module_desc_t **mod_out,
+                             unsigned *inst_out, const cm_reg_desc_t **reg_out)
+{
+    int best_dist = 8;
+    int found = 0;
+    for (size_t m = 0; m < cm_all_modules_count; m++) {
+        const cm_module_desc_t *mod = cm_all_modules[m];
+        for (unsigned inst = 0; inst < mod->count; inst++) {
+            for (uint16_t r = 0; r < mod->nregs; r++) {
+                uint16_t ra = (uint16_t)(mod->bases[inst] + mod->regs[r].offset);
+                if (ra > addr) continue;
+                int dist = addr - ra;
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    *mod_out = mod;
+                    *inst_out = inst;
+                    *reg_out = &mod->regs[r];
+                    found = 1;
+                }
+            }
+        }
+    }
+    return found ? best_dist : -1;
+}
+
+int cm_snapshot_diff(const cm_snapshot_t *a, const cm_snapshot_t *b,
+                     int (*printfn)(const char *fmt, ...))
+{
+    if (!a || !b || !printfn) return -1;
+
+    if (a->table_version != b->table_version) {
+        printfn("warning: snapshots were taken with different tables "
+                "(0x%08X vs 0x%08X); decoding with the current tables\n",
+                a->table_version, b->table_version);
+    }
+    if (a->device_id != b->device_id || a->product_id != b->product_id) {
+        printfn("warning: snapshots are from different devices\n");
+    }
+
+    uint8_t *map = calloc(0x10000, 1);
+    uint8_t *seen = calloc(0x10000, 1);
+    if (!map || !seen) {
+        free(map);
+        free(seen);
+        return -1;
+    }
+    cm_snapshot_mark_mapped(map);
+
+    int ndiff = 0;
+
+    // Mapped registers, in table order.
+    for (size_t m = 0; m < cm_all_modules_count; m++) {
+        const cm_module_desc_t *mod = cm_all_modules[m];
+        for (unsigned inst = 0; inst < mod->count; inst++) {
+            for (uint16_t r = 0; r < mod->nregs; r++) {
+                const cm_reg_desc_t *reg = &mod->regs[r];
+                uint16_t addr = (uint16_t)(mod->bases[inst] + reg->offset);
+                uint8_t va, vb;
+                if (cm_snapshot_get(a, addr, &va) || cm_snapshot_get(b, addr, &vb)) continue;
+                if (va == vb) continue;
+
+                if (!seen[addr]) ndiff++;
+                seen[addr] = 1;
+
+                printfn("%s[%u].%s @0x%04X: 0x%02X -> 0x%02X\n",
+                        cm_snapshot_name(cm_module_name(mod), "(module)"), inst,
+                        cm_snapshot_name(cm_reg_name(reg), "(reg)"), addr, va, vb);
+                for (uint16_t f = 0; f < reg->nfields; f++) {
+                    const cm_field_desc_t *fd = cm_reg_field(reg, f);
+                    if (fd->width == 0) continue;
+                    uint8_t fa = (uint8_t)((va >> fd->shift) & cm_mask8(fd->width));
+                    uint8_t fb = (uint8_t)((vb >> fd->shift) & cm_mask8(fd->width));
+                    if (fa == fb) continue;
+                    printfn("    %-40s [%u:%u] 0x%02X -> 0x%02X\n",
+                            cm_snapshot_name(cm_field_name(fd), "(field)"),
+                            fd->shift + fd->width - 1, fd->shift, fa, fb);
+                }
+            }
+        }
+    }
+
+    // Gap bytes read as part of a merged burst.
+    for (size_t i = 0; i < a->nspans; i++) {
+        const cm_snapshot_span_t *sp = &a->spans[i];
+        for (uint32_t k = 0; k < sp->len; k++) {
+            uint16_t addr = (uint16_t)(sp->addr + k);
+            uint8_t vb;
+            if (map[addr] || cm_snapshot_get(b, addr, &vb)) continue;
+            if (sp->data[k] == vb) continue;
+
+            ndiff++;
+            const cm_module_desc_t *mod = NULL;
+            const cm_reg_desc_t *reg = NULL;
+            unsigned inst = 0;
+            int off = cm_snapshot_owner(addr, &mod, &inst, &reg);
+            if (off > 0) {
+                printfn("%s[%u].%s+%d @0x%04X: 0x%02X -> 0x%02X\n",
+                        cm_snapshot_name(cm_module_name(mod), "(module)"), inst,
+                        cm_snapshot_name(cm_reg_name(reg), "(reg)"), off, addr,
+                        sp->data[k], vb);
+            } else {
+                printfn("(unmapped) @0x%04X: 0x%02X -> 0x%02X\n", addr, sp->data[k], vb);
+            }
+        }
+    }
+
+    free(map);
+    free(seen);
+    return ndiff;
+}
@@ -0,0 +1,89 @@
+// cm_snapshot.h
+//
+// Whole-device register snapshot for the ClockMatrix 8A3400x.
+//
+// A snapshot captures every register range mapped by the generated tables
+// (renesas_cm8a34001_tables.c) using as few burst reads as possible, and can be
+// saved to / loaded from a small binary file. Two snapshots can be diffed and
+// the differences decoded back to module / register / field names.
+//
+// File layout (all integers little-endian):
+//
+//   off  size  field
+//   0    8     magic "CMSNAP01"
+//   8    8     timestamp, ns since the Unix epoch (CLOCK_REALTIME)
+//   16   2     JTAG device id   (DPLL_GeneralStatus "JTAG DEVICE ID", 2 bytes)
+//   18   2     product id       (DPLL_GeneralStatus "PRODUCT ID", 2 bytes)
+//   20   4     table version    (cm_tables_version() of the writer)
+//   24   4     number of spans
+//   28   4     total data bytes
+//   32   ...   spans: { u16 addr, u16 len, u8 data[len] } * nspans
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t + table descriptors
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Gaps of up to CM_SNAPSHOT_MERGE_GAP unmapped bytes between two mapped
+// registers are read as part of the same burst, so it is set to what a second
+// burst costs, in byte times:
+//   - bytes on the wire: the page write (command + 4 page bytes) plus the
+//     read's command byte;
+//   - two spidev transfers (ioctl + chip select), each costing roughly 5 byte
+//     times (~40 us) at the default 1 MHz SPI clock. `dplltool --spi-stats`
+//     shows the actual per-transfer latency.
+// Below this gap, reading the unmapped bytes is cheaper than starting a second
+// burst. Merging also picks up the tail bytes of multi-byte registers whose
+// table entry only names the first byte (OUT_DIV, *_PHASE_STATUS).
+#define CM_SNAPSHOT_BURST_WIRE_BYTES 6   // page write (1 + 4) + read command (1)
+#define CM_SNAPSHOT_XFER_BYTE_TIMES  5   // fixed cost of one spidev transfer
+#define CM_SNAPSHOT_MERGE_GAP \
+    (CM_SNAPSHOT_BURST_WIRE_BYTES + 2 * CM_SNAPSHOT_XFER_BYTE_TIMES)
+
+typedef struct cm_snapshot_span {
+    uint16_t addr;
+    uint16_t len;
+    uint8_t *data;
+} cm_snapshot_span_t;
+
+typedef struct cm_snapshot {
+    uint64_t timestamp_ns;
+    uint16_t device_id;
+    uint16_t product_id;
+    uint32_t table_version;
+    size_t   nspans;
+    cm_snapshot_span_t *spans;
+} cm_snapshot_t;
+
+// Build the span list from the tables and read every span from the device.
+// On success *snap owns its memory; release it with cm_snapshot_free().
+int cm_snapshot_capture(const cm_bus_t *bus, cm_snapshot_t *snap);
+
+void cm_snapshot_free(cm_snapshot_t *snap);
+
+// Returns 0 on success, -1 on I/O error, -2 on a malformed file.
+int cm_snapshot_save(const cm_snapshot_t *snap, const char *path);
+int cm_snapshot_load(cm_snapshot_t *snap, const char *path);
+
+// Look up the value of one address. Returns 0 and fills *val if the address is
+// covered by the snapshot, -1 otherwise.
+int cm_snapshot_get(const cm_snapshot_t *snap, uint16_t addr, uint8_t *val);
+
+// Print a short header line describing the snapshot ("label: time dev ...").
+void cm_snapshot_print_header(const cm_snapshot_t *snap, const char *label,
+                              int (*printfn)(const char *fmt, ...));
+
+// Decode the differences between a and b by module / register / field.
+// Returns the number of differing registers (>= 0), or < 0 on error.
+int cm_snapshot_diff(const cm_snapshot_t *a, const cm_snapshot_t *b,
+                     int (*printfn)(const char *fmt, ...));
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,257 @@
+// cm_stats.c
+// Streaming MTIE / TDEV / ADEV with ITU-T masks (see cm_stats.h).
+
+#include "cm_stats.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// Masks
+// ---------------------------------------------------------------------------
+
+// G.8262 Table 1 / Table 2: EEC option 1, wander generation at constant
+// temperature.
+static const cm_mask_seg_t g8262_eec1_mtie[] = {
+    {0.1, 1.0, 40.0, 0.0},
+    {1.0, 100.0, 40.0, 0.1},
+    {100.0, 1000.0, 25.25, 0.2},
+};
+static const cm_mask_seg_t g8262_eec1_tdev[] = {
+    {0.1, 25.0, 3.2, 0.0},
+    {25.0, 100.0, 0.64, 0.5},
+    {100.0, 1000.0, 6.4, 0.0},
+};
+
+// G.8273.2 dTE_L noise generation. The standard measures through a 0.1 Hz
+// low-pass filter; unfiltered phase can only read higher, so a pass holds.
+static const cm_mask_seg_t g8273_2_ab_mtie[] = {{1.0, 1000.0, 40.0, 0.0}};
+static const cm_mask_seg_t g8273_2_ab_tdev[] = {{0.5, 1000.0, 4.0, 0.0}};
+static const cm_mask_seg_t g8273_2_c_mtie[] = {{1.0, 1000.0, 10.0, 0.0}};
+static const cm_mask_seg_t g8273_2_c_tdev[] = {{0.5, 1000.0, 2.0, 0.0}};
+
+#define CM_MASK_SEGS(a) (a), (sizeof(a) / sizeof((a)[0]))
+
+const cm_stats_mask_t cm_mask_g8262_eec1 = {
+    "g8262", "G.8262 EEC option 1 wander generation",
+    CM_MASK_SEGS(g8262_eec1_mtie), CM_MASK_SEGS(g8262_eec1_tdev)};
+const cm_stats_mask_t cm_mask_g8273_2_a = {
+    "g8273.2a", "G.8273.2 class A dTE_L",
+    CM_MASK_SEGS(g8273_2_ab_mtie), CM_MASK_SEGS(g8273_2_ab_tdev)};
+const cm_stats_mask_t cm_mask_g8273_2_b = {
+    "g8273.2b", "G.8273.2 class B dTE_L",
+    CM_MASK_SEGS(g8273_2_ab_mtie), CM_MASK_SEGS(g8273_2_ab_tdev)};
+const cm_stats_mask_t cm_mask_g8273_2_c = {
+    "g8273.2c", "G.8273.2 class C dTE_L",
+    CM_MASK_SEGS(g8273_2_c_mtie), CM_MASK_SEGS(g8273_2_c_tdev)};
+
+const cm_stats_mask_t *const cm_stats_masks[] = {
+    &cm_mask_g8262_eec1, &cm_mask_g8273_2_a, &cm_mask_g8273_2_b, &cm_mask_g8273_2_c,
+    NULL,
+};
+
+const cm_stats_mask_t *cm_stats_find_mask(const char *name)
+{
+    if (!name) return NULL;
+    for (size_t i = 0; cm_stats_masks[i]; i++)
+        if (strcmp(cm_stats_masks[i]->name, name) == 0) return cm_stats_masks[i];
+    return NULL;
+}
+
+double cm_stats_mask_limit(const cm_mask_seg_t *seg, size_t nseg, double tau)
+{
+    for (size_t i = 0; i < nseg; i++) {
+        // tolerate tau = n * tau0 rounding at the segment edges
+        if (tau >= seg[i].tau_lo * (1.0 - 1e-9) && tau <= seg[i].tau_hi * (1.0 + 1e-9))
+            return seg[i].coef_ns * pow(tau, seg[i].exponent) * 1e-9;
+    }
+    return -1.0;
+}
+
+// ---------------------------------------------------------------------------
+// Monotonic deques (indices into the history)
+// ---------------------------------------------------------------------------
+
+static int cm_deque_init(cm_stats_deque_t *q, uint32_t need)
+{
+    uint32_t cap = 1;
+    while (cap < need) cap <<= 1;
+    q->buf = malloc((size_t)cap * sizeof(*q->buf));
+    q->mask = cap - 1;
+    q->head = q->tail = 0;
+    return q->buf ? 0 : -1;
+}
+
+static inline uint64_t cm_deque_front(const cm_stats_deque_t *q)
+{
+    return q->buf[q->head & q->mask];
+}
+
+static inline uint64_t cm_deque_back(const cm_stats_deque_t *q)
+{
+    return q->buf[(q->tail - 1) & q->mask];
+}
+
+// ---------------------------------------------------------------------------
+// Streaming statistics
+// ---------------------------------------------------------------------------
+
+static double cm_stats_x(const cm_stats_t *st, uint64_t i)
+{
+    return st->hist[i & st->hmask];
+}
+
+int cm_stats_init(cm_stats_t *st, double tau0, double tau_max)
+{
+    static const double steps[] = {1.0, 2.0, 5.0};
+
+    if (!st || !(tau0 > 0.0) || !(tau_max >= tau0)) return -1;
+    memset(st, 0, sizeof(*st));
+    st->tau0 = tau0;
+
+    uint32_t last_n = 0;
+    for (int e = -3; e <= 5 && st->ntau < CM_STATS_MAX_TAUS; e++) {
+        for (size_t s = 0; s < 3 && st->ntau < CM_STATS_MAX_TAUS; s++) {
+            double v = steps[s] * pow(10.0, e);
+            if (v < tau0 * (1.0 - 1e-9) || v > tau_max * (1.0 + 1e-9)) continue;
+            double n = floor(v / tau0 + 0.5);
+            if (n < 1.0 || 3.0 * n + 1.0 > (double)CM_STATS_MAX_HISTORY) continue;
+            if ((uint32_t)n == last_n) continue;
+
+            cm_stats_tau_t *t = &st->tau[st->ntau++];
+            t->n = last_n = (uint32_t)n;
+            t->tau = n * tau0;
+        }
+    }
+    if (st->ntau == 0) return -1;
+
+    uint32_t hcap = 1;
+    while (hcap < 3 * last_n + 1) hcap <<= 1;
+    st->hist = calloc(hcap, sizeof(*st->hist));
+    st->hmask = hcap - 1;
+    int rc = st->hist ? 0 : -1;
+
+    for (size_t i = 0; i < st->ntau && rc == 0; i++) {
+        cm_stats_tau_t *t = &st->tau[i];
+        // n+1 samples in a window, plus the new one before the front is popped
+        if (cm_deque_init(&t->qmax, t->n + 2) || cm_deque_init(&t->qmin, t->n + 2)) rc = -1;
+    }
+    if (rc) cm_stats_free(st);
+    return rc;
+}
+
+void cm_stats_free(cm_stats_t *st)
+{
+    if (!st) return;
+    for (size_t i = 0; i < st->ntau; i++) {
+        free(st->tau[i].qmax.buf);
+        free(st->tau[i].qmin.buf);
+        st->tau[i].qmax.buf = st->tau[i].qmin.buf = NULL;
+    }
+    free(st->hist);
+    st->hist = NULL;
+    st->ntau = 0;
+}
+
+void cm_stats_gap(cm_stats_t *st)
+{
+    st->seg = st->k;
+    st->gaps++;
+    for (size_t i = 0; i < st->ntau; i++) {
+        cm_stats_tau_t *t = &st->tau[i];
+        t->qmax.head = t->qmax.tail = 0;
+        t->qmin.head = t->qmin.tail = 0;
+        t->s = 0.0;
+        t->d_run = 0;
+    }
+}
+
+// d_i = x_{i+2n} - 2 x_{i+n} + x_i
+static double cm_stats_d(const cm_stats_t *st, uint64_t i, uint32_t n)
+{
+    return cm_stats_x(st, i + 2 * (uint64_t)n) - 2.0 * cm_stats_x(st, i + n) +
+           cm_stats_x(st, i);
+}
+
+static void cm_stats_add_tau(cm_stats_t *st, cm_stats_tau_t *t, uint64_t k, double x)
+{
+    const uint64_t p = k - st->seg;  // position in the gap-free segment
+    const uint32_t n = t->n;
+
+    // MTIE: window [k-n, k]
+    while (t->qmax.tail != t->qmax.head && cm_stats_x(st, cm_deque_back(&t->qmax)) <= x)
+        t->qmax.tail--;
+    t->qmax.buf[t->qmax.tail++ & t->qmax.mask] = k;
+    while (t->qmin.tail != t->qmin.head && cm_stats_x(st, cm_deque_back(&t->qmin)) >= x)
+        t->qmin.tail--;
+    t->qmin.buf[t->qmin.tail++ & t->qmin.mask] = k;
+
+    if (p >= n) {
+        while (cm_deque_front(&t->qmax) + n < k) t->qmax.head++;
+        while (cm_deque_front(&t->qmin) + n < k) t->qmin.head++;
+        double w = cm_stats_x(st, cm_deque_front(&t->qmax)) -
+                   cm_stats_x(st, cm_deque_front(&t->qmin));
+        if (t->mtie_windows == 0 || w > t->mtie) t->mtie = w;
+        t->mtie_windows++;
+    }
+
+    // ADEV / TDEV: d_i with i = k - 2n
+    if (p < 2 * (uint64_t)n) return;
+    const uint64_t i = k - 2 * (uint64_t)n;
+    const double d = cm_stats_d(st, i, n);
+    t->sum_d2 += d * d;
+    t->avar_terms++;
+
+    t->d_run++;
+    if (t->d_run <= n) {
+        t->s += d;
+    } else if (t->d_run % n == 0) {
+        // exact re-sum of d_{i-n+1} .. d_i so rounding cannot accumulate
+        double s = 0.0;
+        for (uint64_t j = i + 1 - n; j <= i; j++) s += cm_stats_d(st, j, n);
+        t->s = s;
+    } else {
+        t->s += d - cm_stats_d(st, i - n, n);
+    }
+    if (t->d_run >= n) {
+        t->sum_s2 += t->s * t->s;
+        t->tvar_terms++;
+    }
+}
+
+void cm_stats_add(cm_stats_t *st, double x)
+{
+    const uint64_t k = st->k;
+    st->hist[k & st->hmask] = x;
+    st->k++;
+    for (size_t i = 0; i < st->ntau; i++) cm_stats_add_tau(st, &st->tau[i], k, x);
+}
+
+size_t cm_stats_report(const cm_stats_t *st, const cm_stats_mask_t *mask,
+                       cm_stats_point_t *out, size_t cap, unsigned *fails)
+{
+    size_t n = 0;
+    unsigned nfail = 0;
+
+    for (size_t i = 0; i < st->ntau && n < cap; i++) {
+        const cm_stats_tau_t *t = &st->tau[i];
+        cm_stats_point_t *pt = &out[n++];
+        pt->tau = t->tau;
+        pt->mtie = t->mtie_windows ? t->mtie : -1.0;
+        pt->adev = t->avar_terms
+                       ? sqrt(t->sum_d2 / (2.0 * t->tau * t->tau * (double)t->avar_terms))
+                       : -1.0;
+        pt->tdev = t->tvar_terms
+                       ? sqrt(t->sum_s2 / (6.0 * (double)t->n * t->n * (double)t->tvar_terms))
+                       : -1.0;
+
+        pt->mtie_limit = mask ? cm_stats_mask_limit(mask->mtie, mask->n_mtie, t->tau) : -1.0;
+        pt->tdev_limit = mask ? cm_stats_mask_limit(mask->tdev, mask->n_tdev, t->tau) : -1.0;
+        pt->mtie_ok = (pt->mtie_limit < 0.0 || pt->mtie < 0.0) ? -1 : pt->mtie <= pt->mtie_limit;
+        pt->tdev_ok = (pt->tdev_limit < 0.0 || pt->tdev < 0.0) ? -1 : pt->tdev <= pt->tdev_limit;
+        nfail += (pt->mtie_ok == 0) + (pt->tdev_ok == 0);
+    }
+    if (fails) *fails = nfail;
+    return n;
+}
@@ -0,0 +1,136 @@
+// cm_stats.h
+//
+// Streaming MTIE / TDEV / ADEV over phase-error samples, with ITU-T masks.
+//
+// Samples x_k (seconds) arrive at a fixed interval tau0 (e.g. from
+// cm_sampler). Statistics are kept for a 1-2-5 grid of observation intervals
+// tau = n * tau0 and updated per sample:
+//
+//   MTIE(n)  max over all windows of n+1 samples of (max - min). One
+//            monotonic max-deque and min-deque per tau: O(1) amortized.
+//   ADEV(n)  overlapping Allan deviation from the second differences
+//            d_i = x_{i+2n} - 2 x_{i+n} + x_i: one accumulator, O(1).
+//   TDEV(n)  overlapping sums S_j = d_j + ... + d_{j+n-1} kept as a sliding
+//            sum (re-summed exactly every n terms, so O(1) amortized without
+//            drift), TVAR = sum S_j^2 / (6 n^2 count).
+//
+// Memory is bounded: one shared history of CM_STATS_MAX_HISTORY samples
+// (TDEV needs 3n+1 of them, MTIE n+1) plus the MTIE deques. Intervals that do
+// not fit are not tracked. A gap in the input (missed sampler ticks) must be
+// reported with cm_stats_gap(): windows never span a gap, results so far are
+// kept.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_STATS_MAX_TAUS    24
+#define CM_STATS_MAX_HISTORY (1u << 16)   // samples
+
+// ---------------------------------------------------------------------------
+// Masks
+// ---------------------------------------------------------------------------
+
+// limit(tau) = coef_ns * tau^exponent for tau_lo <= tau <= tau_hi (seconds);
+// the first matching segment applies.
+typedef struct {
+    double tau_lo, tau_hi;
+    double coef_ns;
+    double exponent;
+} cm_mask_seg_t;
+
+typedef struct {
+    const char          *name;
+    const char          *desc;
+    const cm_mask_seg_t *mtie;
+    size_t               n_mtie;
+    const cm_mask_seg_t *tdev;
+    size_t               n_tdev;
+} cm_stats_mask_t;
+
+// G.8262 EEC option 1 wander generation (constant temperature).
+extern const cm_stats_mask_t cm_mask_g8262_eec1;
+// G.8273.2 T-BC/T-TSC dTE_L (applied to unfiltered phase: conservative).
+extern const cm_stats_mask_t cm_mask_g8273_2_a;
+extern const cm_stats_mask_t cm_mask_g8273_2_b;
+extern const cm_stats_mask_t cm_mask_g8273_2_c;
+
+// Find a mask by name ("g8262", "g8273.2a", ...). NULL if unknown.
+const cm_stats_mask_t *cm_stats_find_mask(const char *name);
+
+// NULL-terminated list of all masks.
+extern const cm_stats_mask_t *const cm_stats_masks[];
+
+// Limit in seconds at tau, or a negative value if tau is outside the mask.
+double cm_stats_mask_limit(const cm_mask_seg_t *seg, size_t nseg, double tau);
+
+// ---------------------------------------------------------------------------
+// Streaming statistics
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint64_t *buf;
+    uint32_t  mask;
+    uint32_t  head, tail;      // front = buf[head & mask], size = tail - head
+} cm_stats_deque_t;
+
+typedef struct {
+    double   tau;              // n * tau0
+    uint32_t n;
+
+    double   mtie;             // seconds, valid if mtie_windows > 0
+    uint64_t mtie_windows;
+    cm_stats_deque_t qmax, qmin;
+
+    double   sum_d2;           // sum of d_i^2 (ADEV)
+    uint64_t avar_terms;
+    double   s;                // current sliding S_j (TDEV)
+    uint64_t d_run;            // d_i terms since the segment started
+    double   sum_s2;           // sum of S_j^2
+    uint64_t tvar_terms;
+} cm_stats_tau_t;
+
+typedef struct {
+    double          tau0;
+    size_t          ntau;
+    cm_stats_tau_t  tau[CM_STATS_MAX_TAUS];
+
+    double         *hist;      // x_k at hist[k & hmask]
+    uint32_t        hmask;
+    uint64_t        k;         // samples added so far
+    uint64_t        seg;       // first sample of the current gap-free segment
+    uint64_t        gaps;
+} cm_stats_t;
+
+// Track every 1-2-5 interval from tau0 to tau_max that fits in the history.
+// Returns 0, or -1 on bad arguments / out of memory.
+int  cm_stats_init(cm_stats_t *st, double tau0, double tau_max);
+void cm_stats_free(cm_stats_t *st);
+
+// Add the next sample (seconds). O(number of taus) amortized.
+void cm_stats_add(cm_stats_t *st, double x);
+
+// The samples before and after this point are not contiguous.
+void cm_stats_gap(cm_stats_t *st);
+
+typedef struct {
+    double tau;
+    double mtie, tdev, adev;   // seconds (adev: dimensionless); < 0 = no data yet
+    double mtie_limit;         // seconds; < 0 = not covered by the mask
+    double tdev_limit;
+    int    mtie_ok, tdev_ok;   // 1 pass, 0 fail, -1 not checked
+} cm_stats_point_t;
+
+// Current value of every tracked tau, checked against mask (may be NULL).
+// Returns the number of points written; *fails (optional) counts failures.
+size_t cm_stats_report(const cm_stats_t *st, const cm_stats_mask_t *mask,
+                       cm_stats_point_t *out, size_t cap, unsigned *fails);
+
+#ifdef __cplusplus
+}
+#endif
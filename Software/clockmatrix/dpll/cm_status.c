@@ -0,0 +1,190 @@
+// cm_status.c
+// All-channel DPLL status snapshot (see cm_status.h).
+
+#include "cm_status.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cm_dpll_utils.h"  // cm_phase_s36_to_seconds
+
+// SPI bursts must not cross a 128-byte page (dpll_read_seq sets the page once).
+#define CM_STATUS_PAGE 0x80u
+
+// Block A holds DPLL<n>_STATUS and DPLL<n>_REF_STATUS, preceded by the
+// IN<n>_MON_STATUS bytes when the inputs are requested; block B the phases.
+#define CM_STATUS_BLK_A_MAX 64
+#define CM_STATUS_BLK_B_MAX (CM_STATUS_NUM_DPLLS * 8)
+
+typedef struct {
+    uint16_t a_addr;          // DPLL0_STATUS
+    uint16_t a_len;
+    uint16_t ref_off;         // DPLL0_REF_STATUS, from a_addr
+    uint8_t  state_shift, state_width;
+    uint8_t  lock_sticky_shift;
+    uint8_t  ho_sticky_shift;
+    uint8_t  input_shift, input_width;
+    uint16_t in_addr;         // IN0_MON_STATUS
+    uint16_t in_len;          // in_addr .. a_addr
+
+    uint16_t b_addr;          // DPLL0_PHASE_STATUS
+    uint16_t b_len;
+    uint16_t b_stride;
+} cm_status_layout_t;
+
+static cm_status_layout_t g_layout;
+static int g_layout_rc = -1;
+static pthread_once_t g_layout_once = PTHREAD_ONCE_INIT;
+
+static int cm_status_fits_page(uint16_t addr, uint16_t len, uint16_t cap)
+{
+    return len <= cap && (addr % CM_STATUS_PAGE) + len <= CM_STATUS_PAGE;
+}
+
+static int cm_status_resolve(cm_status_layout_t *l)
+{
+    const cm_module_desc_t *mod;
+    const cm_reg_desc_t *reg = NULL, *ref, *in;
+    const cm_field_desc_t *f_state, *f_lock, *f_ho, *f_input;
+    int rc = cm_find_module("Status", &mod);
+    if (rc) return rc;
+
+    // DPLL<n>_STATUS must be consecutive bytes (one byte per DPLL).
+    uint16_t first = 0;
+    for (unsigned ch = 0; ch < CM_STATUS_NUM_DPLLS; ch++) {
+        char name[32];
+        snprintf(name, sizeof(name), "DPLL%u_STATUS", ch);
+        if ((rc = cm_find_reg(mod, name, &reg)) != 0) return rc;
+        if (ch == 0) first = reg->offset;
+        else if (reg->offset != first + ch) return -1;
+    }
+    if ((rc = cm_find_field(reg, "DPLL_STATE", &f_state)) != 0 ||
+        (rc = cm_find_field(reg, "LOCK_STATE_CHANGE_STICKY", &f_lock)) != 0 ||
+        (rc = cm_find_field(reg, "HOLDOVER_STATE_CHANGE_STICKY", &f_ho)) != 0)
+        return rc;
+
+    if ((rc = cm_find_reg(mod, "DPLL{num}_REF_STATUS", &ref)) != 0 ||
+        (rc = cm_find_field(ref, "DPLL{num}_INPUT", &f_input)) != 0)
+        return rc;
+    if (ref->offset < first + CM_STATUS_NUM_DPLLS) return -1;
+
+    // IN<n>_MON_STATUS: one byte per input, ending at or before DPLL0_STATUS.
+    if ((rc = cm_find_reg(mod, "IN{num}_MON_STATUS", &in)) != 0) return rc;
+    if (in->offset + CM_STATUS_NUM_INPUTS > first) return -1;
+
+    l->a_addr = (uint16_t)(mod->bases[0] + first);
+    l->ref_off = (uint16_t)(ref->offset - first);
+    l->a_len = (uint16_t)(l->ref_off + CM_STATUS_NUM_DPLLS);
+    l->state_shift = f_state->shift;
+    l->state_width = f_state->width;
+    l->lock_sticky_shift = f_lock->shift;
+    l->ho_sticky_shift = f_ho->shift;
+    l->input_shift = f_input->shift;
+    l->input_width = f_input->width;
+    l->in_addr = (uint16_t)(mod->bases[0] + in->offset);
+    l->in_len = (uint16_t)(first - in->offset);
+
+    const cm_wide_field_desc_t *wf = &cm_wide_fields[CM_WF_DPLL_PHASE_STATUS];
+    if (wf->stride < wf->nbytes || wf->count < CM_STATUS_NUM_DPLLS) return -1;
+    if ((rc = cm_wide_field_addr(CM_WF_DPLL_PHASE_STATUS, 0, &l->b_addr)) != 0) return rc;
+    l->b_stride = wf->stride;
+    l->b_len = (uint16_t)(wf->stride * (CM_STATUS_NUM_DPLLS - 1) + wf->nbytes);
+
+    if (!cm_status_fits_page(l->in_addr, l->in_len + l->a_len, CM_STATUS_BLK_A_MAX) ||
+        !cm_status_fits_page(l->b_addr, l->b_len, CM_STATUS_BLK_B_MAX))
+        return -1;
+    return 0;
+}
+
+static void cm_status_resolve_once(void)
+{
+    g_layout_rc = cm_status_resolve(&g_layout);
+}
+
+int dpll_status_snapshot_read(const cm_bus_t *bus, unsigned flags,
+                              dpll_status_snapshot_t *snap)
+{
+    if (!bus || !snap) return -1;
+    pthread_once(&g_layout_once, cm_status_resolve_once);
+    if (g_layout_rc) return g_layout_rc;
+
+    const cm_status_layout_t *l = &g_layout;
+    uint8_t raw[CM_STATUS_BLK_A_MAX], b[CM_STATUS_BLK_B_MAX];
+    const uint8_t *a = raw;
+    memset(snap, 0, sizeof(*snap));
+
+    int rc;
+    if (flags & CM_STATUS_INPUTS) {
+        rc = bus->read(bus->user, l->in_addr, raw, (size_t)(l->in_len + l->a_len));
+        a = raw + l->in_len;
+    } else {
+        rc = bus->read(bus->user, l->a_addr, raw, l->a_len);
+    }
+    snap->bursts++;
+    if (rc) return rc;
+    if (flags & CM_STATUS_INPUTS) {
+        memcpy(snap->in_mon, raw, CM_STATUS_NUM_INPUTS);
+        snap->has_inputs = 1;
+    }
+
+    if (flags & CM_STATUS_PHASE) {
+        rc = bus->read(bus->user, l->b_addr, b, l->b_len);
+        snap->bursts++;
+        if (rc) return rc;
+        snap->has_phase = 1;
+    }
+
+    for (unsigned ch = 0; ch < CM_STATUS_NUM_DPLLS; ch++) {
+        dpll_chan_status_t *c = &snap->ch[ch];
+        uint8_t st = a[ch], ref = a[l->ref_off + ch];
+        c->state = (uint8_t)((st >> l->state_shift) & cm_mask8(l->state_width));
+        c->lock_sticky = (uint8_t)((st >> l->lock_sticky_shift) & 1u);
+        c->holdover_sticky = (uint8_t)((st >> l->ho_sticky_shift) & 1u);
+        c->ref_input = (uint8_t)((ref >> l->input_shift) & cm_mask8(l->input_width));
+        if (snap->has_phase) {
+            cm_wide_field_decode(CM_WF_DPLL_PHASE_STATUS, &b[ch * l->b_stride], &c->phase_s36);
+            c->phase_sec = cm_phase_s36_to_seconds(c->phase_s36);
+        }
+    }
+    return 0;
+}
+
+int dpll_phase_status_read(const cm_bus_t *bus, unsigned chan_mask,
+                           int64_t out_s36[CM_STATUS_NUM_DPLLS])
+{
+    const unsigned all = (1u << CM_STATUS_NUM_DPLLS) - 1u;
+    if (!bus || !out_s36 || !chan_mask || (chan_mask & ~all)) return -1;
+    pthread_once(&g_layout_once, cm_status_resolve_once);
+    if (g_layout_rc) return g_layout_rc;
+
+    const cm_status_layout_t *l = &g_layout;
+    const unsigned lo = (unsigned)__builtin_ctz(chan_mask);
+    const unsigned hi = 31u - (unsigned)__builtin_clz(chan_mask);
+    const size_t nbytes = cm_wide_fields[CM_WF_DPLL_PHASE_STATUS].nbytes;
+    uint8_t b[CM_STATUS_BLK_B_MAX];
+
+    int rc = bus->read(bus->user, (uint16_t)(l->b_addr + lo * l->b_stride), b,
+                       (hi - lo) * l->b_stride + nbytes);
+    if (rc) return rc;
+
+    for (unsigned ch = lo; ch <= hi; ch++) {
+        if (chan_mask & (1u << ch))
+            cm_wide_field_decode(CM_WF_DPLL_PHASE_STATUS, &b[(ch - lo) * l->b_stride],
+                                 &out_s36[ch]);
+    }
+    return 0;
+}
+
+const char *dpll_state_str(uint8_t state)
+{
+    switch (state) {
+    case CM_DPLL_STATE_LOCKED:   return "LOCKED";
+    case CM_DPLL_STATE_LOCKACQ:  return "LOCKACQ";
+    case CM_DPLL_STATE_LOCKREC:  return "LOCKREC";
+    case CM_DPLL_STATE_FREERUN:  return "FREERUN";
+    case CM_DPLL_STATE_HOLDOVER: return "HOLDOVER";
+    case CM_DPLL_STATE_DISABLED: return "DISABLED";
+    default:                     return "UNKNOWN";
+    }
+}
@@ -0,0 +1,74 @@
+// cm_status.h
+//
+// All-channel DPLL status snapshot from the Status module (0xC03C).
+//
+// The per-channel status lives in two contiguous blocks:
+//   0x008..0x017  IN<n>_MON_STATUS (input monitor, with CM_STATUS_INPUTS)
+//   0x018..0x029  DPLL<n>_STATUS (state + sticky bits), DPLL<n>_REF_STATUS
+//   0x0DC..0x11B  DPLL<n>_PHASE_STATUS (s36 in 5 bytes, stride 8)
+// Each block sits inside one 128-byte SPI page, so a snapshot of every DPLL
+// is one burst read (states only) or two (with phase), decoded in memory.
+// Offsets, field shifts and widths come from the register tables.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_STATUS_NUM_DPLLS  8
+#define CM_STATUS_NUM_INPUTS 16
+
+// DPLL_STATE values
+#define CM_DPLL_STATE_FREERUN  0
+#define CM_DPLL_STATE_LOCKACQ  1
+#define CM_DPLL_STATE_LOCKREC  2
+#define CM_DPLL_STATE_LOCKED   3
+#define CM_DPLL_STATE_HOLDOVER 4
+#define CM_DPLL_STATE_DISABLED 6
+
+// dpll_status_snapshot_read() flags
+#define CM_STATUS_PHASE  0x1u  // also burst-read DPLL<n>_PHASE_STATUS
+#define CM_STATUS_INPUTS 0x2u  // extend the first burst over IN<n>_MON_STATUS
+
+typedef struct {
+    uint8_t state;            // DPLL_STATE
+    uint8_t lock_sticky;      // LOCK_STATE_CHANGE_STICKY
+    uint8_t holdover_sticky;  // HOLDOVER_STATE_CHANGE_STICKY
+    uint8_t ref_input;        // DPLL<n>_REF_STATUS: input the DPLL tracks
+    int64_t phase_s36;        // DPLL<n>_PHASE_STATUS (ITDC_UI units)
+    double  phase_sec;        // phase_s36 in seconds
+} dpll_chan_status_t;
+
+typedef struct {
+    dpll_chan_status_t ch[CM_STATUS_NUM_DPLLS];
+    uint8_t  in_mon[CM_STATUS_NUM_INPUTS];  // raw IN<n>_MON_STATUS (CM_STATUS_INPUTS)
+    int      has_phase;       // CM_STATUS_PHASE was requested
+    int      has_inputs;      // CM_STATUS_INPUTS was requested
+    unsigned bursts;          // bus->read calls used for this snapshot
+} dpll_status_snapshot_t;
+
+// Read and decode the status of every DPLL (1 burst, 2 with CM_STATUS_PHASE;
+// CM_STATUS_INPUTS lengthens the first burst but adds none).
+// Returns 0, a table lookup error on first use, or the bus error.
+int dpll_status_snapshot_read(const cm_bus_t *bus, unsigned flags,
+                              dpll_status_snapshot_t *snap);
+
+// Read DPLL<n>_PHASE_STATUS for every channel in chan_mask (bit n = DPLL n)
+// with one burst over the span lowest..highest set bit. out_s36[n] is only
+// written for channels in the mask. Returns 0, -1 on bad arguments, a table
+// lookup error on first use, or the bus error.
+int dpll_phase_status_read(const cm_bus_t *bus, unsigned chan_mask,
+                           int64_t out_s36[CM_STATUS_NUM_DPLLS]);
+
+// "LOCKED", "LOCKACQ", ... ("UNKNOWN" for reserved codes).
+const char *dpll_state_str(uint8_t state);
+
+#ifdef __cplusplus
+}
+#endif
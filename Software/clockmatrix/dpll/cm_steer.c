@@ -0,0 +1,115 @@
+// cm_steer.c
+// Coordinated multi-DPLL DPLL_WR_FREQ steering (see cm_steer.h).
+
+#include "cm_steer.h"
+
+#include <string.h>
+#include <time.h>
+
+// SPI bursts must not cross a 128-byte page (dpll_read_seq sets the page once).
+#define CM_STEER_PAGE 0x80u
+
+static uint64_t cm_steer_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int cm_steer_init(cm_steer_t *s, const cm_bus_t *bus)
+{
+    if (!s || !bus) return -1;
+    memset(s, 0, sizeof(*s));
+    s->bus = bus;
+    s->nbytes = cm_wide_fields[CM_WF_DPLL_WR_FREQ].nbytes;
+
+    for (unsigned ch = 0; ch < CM_STEER_MAX_DPLLS; ch++) {
+        int rc = cm_wide_field_addr(CM_WF_DPLL_WR_FREQ, ch, &s->addr[ch]);
+        if (rc) return rc;
+        if (ch > 0 && s->addr[ch] < s->addr[ch - 1] + s->nbytes) return -1;
+    }
+
+    s->span_addr = s->addr[0];
+    s->span_len = (uint16_t)(s->addr[CM_STEER_MAX_DPLLS - 1] + s->nbytes - s->span_addr);
+    if (s->span_len > CM_STEER_MAX_SPAN ||
+        (s->span_addr % CM_STEER_PAGE) + s->span_len > CM_STEER_PAGE)
+        return -1;
+
+    return bus->read(bus->user, s->span_addr, s->filler, s->span_len);
+}
+
+int cm_steer_commit(cm_steer_t *s, unsigned chan_mask,
+                    const int64_t word_s42[CM_STEER_MAX_DPLLS], unsigned flags,
+                    cm_steer_result_t *res)
+{
+    const unsigned all = (1u << CM_STEER_MAX_DPLLS) - 1u;
+    if (!s || !s->bus || !word_s42 || !chan_mask || (chan_mask & ~all)) return -1;
+
+    cm_steer_result_t local;
+    if (!res) res = &local;
+    memset(res, 0, sizeof(*res));
+
+    // Encode everything first: a bad word must not leave a partial update.
+    uint8_t img[CM_STEER_MAX_SPAN];
+    memcpy(img, s->filler, s->span_len);
+    for (unsigned ch = 0; ch < CM_STEER_MAX_DPLLS; ch++) {
+        if (!(chan_mask & (1u << ch))) continue;
+        if (cm_wide_field_encode(CM_WF_DPLL_WR_FREQ, word_s42[ch],
+                                 &img[s->addr[ch] - s->span_addr]) != 0)
+            return -1;
+    }
+
+    // One burst per run of adjacent target channels, back to back.
+    int rc = 0;
+    const uint64_t t0 = cm_steer_now_ns();
+    for (unsigned ch = 0; ch < CM_STEER_MAX_DPLLS && rc == 0; ch++) {
+        if (!(chan_mask & (1u << ch))) continue;
+        unsigned end = ch;
+        while (end + 1 < CM_STEER_MAX_DPLLS && (chan_mask & (1u << (end + 1)))) end++;
+
+        const uint16_t off = (uint16_t)(s->addr[ch] - s->span_addr);
+        const size_t len = (size_t)(s->addr[end] + s->nbytes - s->addr[ch]);
+        rc = s->bus->write(s->bus->user, s->addr[ch], &img[off], len);
+        res->bursts++;
+        ch = end;
+    }
+    res->skew_ns = cm_steer_now_ns() - t0;
+    s->commits++;
+    s->bursts += res->bursts;
+    if (rc) return rc;
+
+    if (flags & CM_STEER_VERIFY) {
+        const unsigned lo = (unsigned)__builtin_ctz(chan_mask);
+        const unsigned hi = 31u - (unsigned)__builtin_clz(chan_mask);
+        const uint16_t off = (uint16_t)(s->addr[lo] - s->span_addr);
+        uint8_t rb[CM_STEER_MAX_SPAN];
+
+        rc = s->bus->read(s->bus->user, s->addr[lo], &rb[off],
+                          (size_t)(s->addr[hi] + s->nbytes - s->addr[lo]));
+        if (rc) return rc;
+
+        for (unsigned ch = lo; ch <= hi; ch++) {
+            if (!(chan_mask & (1u << ch))) continue;
+            cm_wide_field_decode(CM_WF_DPLL_WR_FREQ, &rb[s->addr[ch] - s->span_addr],
+                                 &res->readback[ch]);
+            if (res->readback[ch] != word_s42[ch]) res->mismatch_mask |= 1u << ch;
+        }
+        if (res->mismatch_mask) {
+            s->verify_failures++;
+            return -2;
+        }
+    }
+    return 0;
+}
+
+int cm_steer_read(const cm_steer_t *s, int64_t word_s42[CM_STEER_MAX_DPLLS])
+{
+    if (!s || !s->bus || !word_s42) return -1;
+
+    uint8_t rb[CM_STEER_MAX_SPAN];
+    int rc = s->bus->read(s->bus->user, s->span_addr, rb, s->span_len);
+    if (rc) return rc;
+    for (unsigned ch = 0; ch < CM_STEER_MAX_DPLLS; ch++)
+        cm_wide_field_decode(CM_WF_DPLL_WR_FREQ, &rb[s->addr[ch] - s->span_addr], &word_s42[ch]);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// cm_steer.h
+//
+// Coordinated DPLL_WR_FREQ steering of several write-frequency DPLLs.
+//
+// cm_write_dpll_wr_freq_s42 moves one DPLL per call (page select + burst,
+// plus a readback when tracing), so steering N DPLLs staggers their updates
+// by N round trips. cm_steer_commit encodes every word first and then issues
+// the writes back to back, with no reads in between. The DPLL_Freq_Write
+// blocks sit 8 bytes apart in one SPI page, so the target channels are
+// grouped into runs of adjacent DPLLs and each run goes out as a single
+// burst; a typical 5,6 pair is one transfer. Channels outside the mask are
+// never written. The two reserved bytes between neighbouring blocks are
+// written back with the values read at cm_steer_init.
+//
+// With CM_STEER_VERIFY the words are read back with one burst over the
+// written span and compared. cm_steer_read fetches every DPLL's word the
+// same way (one burst over the whole span).
+
+#pragma once
+
+#include <stdint.h>
+
+#include "renesas_cm8a34001_tables.h"  // cm_bus_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_STEER_MAX_DPLLS  8
+#define CM_STEER_MAX_SPAN   128   // one SPI page
+
+#define CM_STEER_VERIFY     0x01u  // batched readback after the writes
+
+typedef struct {
+    const cm_bus_t *bus;
+    uint16_t addr[CM_STEER_MAX_DPLLS];  // DPLL_WR_FREQ of each DPLL
+    uint8_t  nbytes;                    // bytes per word on the bus
+    uint16_t span_addr;                 // addr[0]
+    uint16_t span_len;                  // addr[0] .. end of addr[7]
+    uint8_t  filler[CM_STEER_MAX_SPAN]; // span image: reserved bytes as read at init
+
+    uint64_t commits;
+    uint64_t bursts;
+    uint64_t verify_failures;
+} cm_steer_t;
+
+typedef struct {
+    unsigned bursts;                          // write bursts issued
+    uint64_t skew_ns;                         // first write start to last write end
+    unsigned mismatch_mask;                   // CM_STEER_VERIFY: channels that read back wrong
+    int64_t  readback[CM_STEER_MAX_DPLLS];    // CM_STEER_VERIFY: words read back
+} cm_steer_result_t;
+
+// Resolve the DPLL_Freq_Write layout and read the reserved bytes between the
+// words (one burst). Returns 0, or non-zero if the layout is not usable
+// (not in one page, overlapping) or the bus read failed.
+int cm_steer_init(cm_steer_t *s, const cm_bus_t *bus);
+
+// Write word_s42[ch] to every DPLL in chan_mask (bit n = DPLL n) in as few
+// bursts as possible. Every word is range-checked before anything is
+// written. Returns 0, -1 on bad arguments or a word out of s42 range, the
+// bus error of the first failed burst, or (CM_STEER_VERIFY) -2 if any
+// channel read back a different word. res may be NULL.
+int cm_steer_commit(cm_steer_t *s, unsigned chan_mask,
+                    const int64_t word_s42[CM_STEER_MAX_DPLLS], unsigned flags,
+                    cm_steer_result_t *res);
+
+// Read DPLL_WR_FREQ of every DPLL with one burst. Returns 0 or the bus error.
+int cm_steer_read(const cm_steer_t *s, int64_t word_s42[CM_STEER_MAX_DPLLS]);
+
+#ifdef __cplusplus
+}
+#endif
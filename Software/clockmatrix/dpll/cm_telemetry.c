@@ -0,0 +1,136 @@
+// cm_telemetry.c
+// Shared-memory telemetry segment (see cm_telemetry.h).
+
+#include "cm_telemetry.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The body is everything after the seqlock word.
+#define CM_TELEM_BODY_OFF  offsetof(cm_telem_t, pid)
+
+// A publish is a ~1.4 KB memcpy; this many busy copies means a dead writer
+// stuck odd, not contention.
+#define CM_TELEM_READ_RETRIES 1000
+
+int cm_telem_open(cm_telem_writer_t *w, const char *path)
+{
+    if (!w || !path) return -1;
+    w->shm = NULL;
+    w->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (w->fd < 0) return -1;
+    if (flock(w->fd, LOCK_EX | LOCK_NB) != 0) {
+        close(w->fd);
+        return -2;
+    }
+
+    // The umask may have narrowed the mode; readers must not need root.
+    if (fchmod(w->fd, 0644) != 0 || ftruncate(w->fd, (off_t)sizeof(cm_telem_t)) != 0) {
+        close(w->fd);
+        return -1;
+    }
+    void *p = mmap(NULL, sizeof(cm_telem_t), PROT_READ | PROT_WRITE, MAP_SHARED, w->fd, 0);
+    if (p == MAP_FAILED) {
+        close(w->fd);
+        return -1;
+    }
+    w->shm = (cm_telem_t *)p;
+
+    // A previous writer may have died mid-publish: move seq to a fresh even
+    // value, then clear the body, then publish the header.
+    uint32_t seq = __atomic_load_n(&w->shm->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->shm->seq, seq | 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memset((char *)w->shm + CM_TELEM_BODY_OFF, 0, sizeof(cm_telem_t) - CM_TELEM_BODY_OFF);
+    w->shm->size = (uint32_t)sizeof(cm_telem_t);
+    w->shm->version = CM_TELEM_VERSION;
+    __atomic_store_n(&w->shm->magic, CM_TELEM_MAGIC, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->shm->seq, (seq | 1u) + 1u, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void cm_telem_publish(cm_telem_writer_t *w, const cm_telem_t *t)
+{
+    if (!w || !w->shm || !t) return;
+    uint32_t seq = __atomic_load_n(&w->shm->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->shm->seq, seq + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy((char *)w->shm + CM_TELEM_BODY_OFF, (const char *)t + CM_TELEM_BODY_OFF,
+           sizeof(cm_telem_t) - CM_TELEM_BODY_OFF);
+    __atomic_store_n(&w->shm->seq, seq + 2u, __ATOMIC_RELEASE);
+}
+
+void cm_telem_close(cm_telem_writer_t *w)
+{
+    if (!w || !w->shm) return;
+    munmap(w->shm, sizeof(cm_telem_t));
+    close(w->fd);  // drops the flock
+    w->shm = NULL;
+}
+
+int cm_telem_read(const char *path, cm_telem_t *out)
+{
+    if (!path || !out) return -1;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(cm_telem_t)) {
+        close(fd);
+        return -2;
+    }
+    void *p = mmap(NULL, sizeof(cm_telem_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return -1;
+    const cm_telem_t *shm = (const cm_telem_t *)p;
+
+    int rc = -3;
+    for (unsigned i = 0; i < CM_TELEM_READ_RETRIES; i++) {
+        uint32_t s1 = __atomic_load_n(&shm->seq, __ATOMIC_ACQUIRE);
+        if (s1 & 1u) continue;
+        memcpy(out, shm, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shm->seq, __ATOMIC_RELAXED) != s1) continue;
+
+        rc = (out->magic == CM_TELEM_MAGIC && out->version == CM_TELEM_VERSION &&
+              out->size == sizeof(cm_telem_t)) ? 0 : -2;
+        break;
+    }
+    munmap(p, sizeof(cm_telem_t));
+    return rc;
+}
+
+// Copy one line of src (up to '\n') into dst, NUL-terminated.
+static const char *cm_telem_line(const char *src, char *dst, size_t len)
+{
+    size_t n = strcspn(src, "\n");
+    snprintf(dst, len, "%.*s", (int)n, src);
+    return src[n] ? src + n + 1 : src + n;
+}
+
+void cm_telem_read_guard(const char *path, cm_telem_guard_t *g)
+{
+    char buf[256];
+    g->state = CM_TELEM_GUARD_MISSING;
+    g->mtime = 0;
+    g->state_text[0] = g->stamp[0] = g->msg[0] = '\0';
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    struct stat st;
+    ssize_t n = (fstat(fd, &st) == 0) ? read(fd, buf, sizeof(buf) - 1) : -1;
+    close(fd);
+    if (n < 0) return;
+    buf[n] = '\0';
+
+    const char *s = cm_telem_line(buf, g->state_text, sizeof(g->state_text));
+    s = cm_telem_line(s, g->stamp, sizeof(g->stamp));
+    cm_telem_line(s, g->msg, sizeof(g->msg));
+    g->state = strcmp(g->state_text, "OK") == 0 ? CM_TELEM_GUARD_OK : CM_TELEM_GUARD_NOT_OK;
+    g->mtime = (int64_t)st.st_mtime;
+}
@@ -0,0 +1,126 @@
+// cm_telemetry.h
+//
+// Shared-memory telemetry segment published by `dplltool monitor`.
+//
+// The status page, the CLI status script and the guards used to learn the
+// DPLL state by spawning dplltool (one SPI transaction per value). The
+// monitor already reads all of it every poll, so it publishes what it saw to
+// a fixed-layout file in /dev/shm: per-channel state, sticky history, phase,
+// WR_FREQ, combo-bus slave setting, the input monitor status bytes and the
+// guard status files. Readers map the file read-only and never touch SPI.
+//
+// Consistency is a seqlock: the writer makes `seq` odd, updates the body and
+// makes it even again. A reader copies the segment between two reads of
+// `seq` and retries if they differ or are odd. There is one writer (the
+// segment is flock()ed while open).
+//
+// The layout is fixed-width with explicit padding so sb_status_web.py can
+// decode it with struct; bump CM_TELEM_VERSION on any change. `size` is
+// sizeof(cm_telem_t).
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CM_TELEM_PATH        "/dev/shm/switchberry-telemetry"
+#define CM_TELEM_MAGIC       0x54454253u  // "SBET"
+#define CM_TELEM_VERSION     2u
+#define CM_TELEM_NUM_DPLLS   8
+#define CM_TELEM_NUM_INPUTS  16
+#define CM_TELEM_NUM_GUARDS  4
+#define CM_TELEM_MSG_LEN     96
+
+// cm_telem_chan_t.flags
+#define CM_TELEM_CH_FREQ      0x01u  // the monitor's FREQ_CH
+#define CM_TELEM_CH_GPS       0x02u  // a GPS channel (relocked by the monitor)
+#define CM_TELEM_CH_COMBO     0x04u  // combo_src/combo_en are valid
+
+// cm_telem_guard_t.state (state_text keeps line 1 as written, e.g. "WARN")
+#define CM_TELEM_GUARD_MISSING (-1)  // no status file
+#define CM_TELEM_GUARD_NOT_OK  0
+#define CM_TELEM_GUARD_OK      1
+
+typedef struct {
+    uint8_t  state;             // DPLL_STATE
+    uint8_t  lock_sticky;       // LOCK_STATE_CHANGE_STICKY at the last poll
+    uint8_t  holdover_sticky;   // HOLDOVER_STATE_CHANGE_STICKY at the last poll
+    uint8_t  ref_input;         // DPLL<n>_REF_STATUS input
+    uint8_t  flags;             // CM_TELEM_CH_*
+    uint8_t  combo_en;          // DPLL_COMBO_SLAVE_CFG_0.PRI_COMBO_SRC_EN
+    uint8_t  combo_src;         // DPLL_COMBO_SLAVE_CFG_0.PRI_COMBO_SRC_ID
+    uint8_t  reserved0;
+    uint32_t lock_changes;      // polls that saw the lock sticky bit set
+    uint32_t relocks;           // relock pulses issued on this channel
+    uint64_t sticky_hist;       // lock sticky per poll, bit 0 = last poll
+    int64_t  phase_s36;         // DPLL<n>_PHASE_STATUS
+    int64_t  wr_freq_s42;       // DPLL_WR_FREQ (units 2^-53)
+    double   phase_sec;
+    double   wr_freq_ppb;
+    double   unlocked_sec;      // monitored channels: time out of LOCKED (0 = locked)
+    double   since_change_sec;  // monitored channels: time since the last sticky
+} cm_telem_chan_t;
+
+typedef struct {
+    char     name[16];          // "clockmatrix", "ts2phc", ...
+    int32_t  state;             // CM_TELEM_GUARD_*
+    uint32_t reserved0;
+    int64_t  mtime;             // status file mtime, Unix seconds
+    char     state_text[16];    // line 1 of the status file
+    char     stamp[32];         // line 2 of the status file (ISO-8601)
+    char     msg[CM_TELEM_MSG_LEN];  // line 3
+} cm_telem_guard_t;
+
+typedef struct {
+    uint32_t magic;             // CM_TELEM_MAGIC
+    uint32_t version;           // CM_TELEM_VERSION
+    uint32_t size;              // sizeof(cm_telem_t)
+    uint32_t seq;               // seqlock, odd while the body is being written
+
+    // Body (written under seq)
+    int32_t  pid;               // writer, 0 once it stopped
+    int32_t  last_rc;           // bus result of the last poll
+    uint64_t updated_ns;        // CLOCK_REALTIME of the last publish
+    uint64_t polls;
+    uint64_t pulses;            // relock pulses, all channels
+    uint64_t bursts;            // SPI bursts issued by the monitor
+    double   poll_sec;
+    uint8_t  freq_ch;
+    uint8_t  reserved0[7];
+    uint8_t  in_mon[CM_TELEM_NUM_INPUTS];  // raw IN<n>_MON_STATUS
+    cm_telem_chan_t  ch[CM_TELEM_NUM_DPLLS];
+    cm_telem_guard_t guard[CM_TELEM_NUM_GUARDS];
+} cm_telem_t;
+
+typedef struct {
+    int         fd;
+    cm_telem_t *shm;            // NULL when not open
+} cm_telem_writer_t;
+
+// Create (or take over) the segment at path and lock it for this writer.
+// Returns 0, -1 on a file/mmap error, or -2 if another writer holds it.
+int  cm_telem_open(cm_telem_writer_t *w, const char *path);
+
+// Copy the body of *t into the segment under the seqlock.
+void cm_telem_publish(cm_telem_writer_t *w, const cm_telem_t *t);
+
+// Unmap and unlock. The file stays, so readers see the final publish.
+void cm_telem_close(cm_telem_writer_t *w);
+
+// Consistent copy of the segment at path. Returns 0, -1 if it cannot be
+// opened, -2 on a magic/version/size mismatch, or -3 if the writer kept it
+// busy for every retry.
+int  cm_telem_read(const char *path, cm_telem_t *out);
+
+// Parse a 3-line guard status file (state, timestamp, message) into g,
+// keeping g->name. Any state other than "OK" counts as CM_TELEM_GUARD_NOT_OK;
+// the token itself is kept in state_text. A missing file gives
+// CM_TELEM_GUARD_MISSING.
+void cm_telem_read_guard(const char *path, cm_telem_guard_t *g);
+
+#ifdef __cplusplus
+}
+#endif
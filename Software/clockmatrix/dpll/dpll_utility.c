@@ -26,6 +26,7 @@
 #include <limits.h>
 #include <linux/spi/spidev.h>
 #include <math.h>
+#include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -33,6 +34,19 @@
 #include <time.h>
 
 #include "cm_dpll_utils.h"
+#include "cm_freqplan.h"
+#include "cm_journal.h"
+#include "cm_json.h"
+#include "cm_monitor.h"
+#include "cm_plancache.h"
+#include "cm_sampler.h"
+#include "cm_stats.h"
+#include "cm_status.h"
+#include "cm_telemetry.h"
+#include "cm_busstat.h"
+#include "cm_metrics.h"
+#include "cm_shadow.h"
+#include "cm_snapshot.h"
 #include "linux_dpll.h"
 #include "renesas_cm8a34001_tables.h"
 #include "tcs_dpll.h"
@@ -50,6 +64,23 @@ typedef struct {
 static int g_spi_fd = -1;
 static cm_bus_t g_cm_bus;
 
+/* Optional write-through cache in front of g_cm_bus (--shadow-cache) */
+static cm_shadow_t g_shadow;
+static int g_shadow_on = 0;
+
+/* SPI counters (--spi-stats, monitor --metrics-port): g_bus_stat counts the
+ * cm_bus_t ops below the shadow cache, g_xfer_stat every spidev transfer
+ * (including page register writes) through the linux_dpll hook. */
+static cm_bus_t g_raw_bus;
+static cm_busstat_t g_bus_stat;
+static cm_busstat_t g_xfer_stat;
+static int g_spi_stats_on = 0;
+
+/* Persistent frequency-plan cache, opened on first use (--no-plan-cache) */
+static cm_plancache_t g_plancache = {-1, NULL, 0, 0, 0, 0};
+static int g_plancache_state = 0; /* 0 = not tried, 1 = open, -1 = off */
+static const char *g_plancache_path = CM_PLANCACHE_DEFAULT_PATH;
+
 /* user points to g_spi_fd */
 static int cm_spi_read8(void *user, uint16_t addr, uint8_t *val) {
   int spi_fd = *(int *)user;
@@ -91,6 +122,150 @@ static void cm_init_bus_for_spi(int spi_fd) {
   g_cm_bus.write = cm_spi_write;
 }
 
+static void dpll_xfer_stat_hook(void *user, dpll_xfer_kind_t kind,
+                                uint16_t addr, size_t len, uint64_t ns,
+                                int ok) {
+  static const cm_busop_t op[DPLL_XFER_COUNT] = {
+      [DPLL_XFER_PAGE] = CM_BUSOP_PAGE,   [DPLL_XFER_READ8] = CM_BUSOP_READ8,
+      [DPLL_XFER_WRITE8] = CM_BUSOP_WRITE8, [DPLL_XFER_READ] = CM_BUSOP_READ,
+      [DPLL_XFER_WRITE] = CM_BUSOP_WRITE,
+  };
+  cm_busstat_record(user, op[kind], addr, len, ns, ok ? 0 : -1);
+}
+
+/* Count every bus op and spidev transfer from here on. Must run before
+ * cm_enable_shadow_cache so cache hits are not counted as bus ops. */
+static void cm_enable_spi_stats(void) {
+  g_raw_bus = g_cm_bus;
+  cm_bus_init_stat(&g_cm_bus, &g_bus_stat, &g_raw_bus);
+  cm_busstat_reset(&g_xfer_stat);
+  dpll_spi_set_xfer_hook(dpll_xfer_stat_hook, &g_xfer_stat);
+  g_spi_stats_on = 1;
+}
+
+static void dpll_print_spi_ops(const char *title, const cm_busstat_t *st,
+                               unsigned nops) {
+  cm_busop_stat_t op[CM_BUSOP_COUNT];
+  cm_busmod_stat_t mod[CM_BUSSTAT_MODULES];
+  cm_busstat_snapshot(st, op, mod);
+
+  fprintf(stderr, "spi stats: %s\n", title);
+  fprintf(stderr, "  %-7s %9s %6s %9s %10s %8s %8s %8s %8s %8s\n", "op",
+          "count", "errors", "bytes", "total_ms", "mean_us", "p50_us",
+          "p90_us", "p99_us", "max_us");
+  for (unsigned i = 0; i < nops; i++) {
+    const cm_busop_stat_t *o = &op[i];
+    if (!o->calls)
+      continue;
+    fprintf(stderr,
+            "  %-7s %9llu %6llu %9llu %10.3f %8.1f %8.1f %8.1f %8.1f %8.1f\n",
+            cm_busop_name((cm_busop_t)i), (unsigned long long)o->calls,
+            (unsigned long long)o->errors, (unsigned long long)o->bytes,
+            (double)o->ns_sum / 1e6, (double)o->ns_sum / (double)o->calls / 1e3,
+            (double)cm_busop_quantile(o, 0.5) / 1e3,
+            (double)cm_busop_quantile(o, 0.9) / 1e3,
+            (double)cm_busop_quantile(o, 0.99) / 1e3,
+            (double)o->ns_max / 1e3);
+  }
+  if (nops != CM_BUSOP_COUNT)
+    return;
+
+  uint64_t total_ns = 0;
+  for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++)
+    total_ns += mod[i].ns_sum;
+  fprintf(stderr, "spi stats: spidev transfers by module\n");
+  fprintf(stderr, "  %-20s %9s %9s %10s %6s\n", "module", "count", "bytes",
+          "total_ms", "time%");
+  for (unsigned i = 0; i < CM_BUSSTAT_MODULES; i++) {
+    if (!mod[i].calls)
+      continue;
+    fprintf(stderr, "  %-20s %9llu %9llu %10.3f %5.1f%%\n",
+            cm_busstat_module_name(i), (unsigned long long)mod[i].calls,
+            (unsigned long long)mod[i].bytes, (double)mod[i].ns_sum / 1e6,
+            total_ns ? 100.0 * (double)mod[i].ns_sum / (double)total_ns : 0.0);
+  }
+}
+
+/* --spi-stats report, at exit */
+static void dpll_print_spi_stats(void) {
+  dpll_print_spi_ops("table bus ops (page write included)", &g_bus_stat,
+                     CM_BUSOP_PAGE);
+  dpll_print_spi_ops("spidev transfers", &g_xfer_stat, CM_BUSOP_COUNT);
+}
+
+/* Route g_cm_bus through the shadow cache. Falls back to the plain bus. */
+static void cm_enable_shadow_cache(void) {
+  if (cm_shadow_init(&g_shadow, &g_cm_bus) != 0) {
+    fprintf(stderr, "shadow cache: out of memory, running uncached\n");
+    return;
+  }
+  cm_shadow_bus(&g_shadow, &g_cm_bus);
+  g_shadow_on = 1;
+}
+
+/* --batch --transaction: undo journal below the shadow cache */
+static cm_journal_t g_journal;
+static int g_journal_on = 0;
+
+static int cm_enable_journal(void) {
+  if (cm_journal_init(&g_journal, &g_cm_bus) != 0) {
+    fprintf(stderr, "batch: out of memory for the undo journal\n");
+    return -1;
+  }
+  cm_journal_bus(&g_journal, &g_cm_bus);
+  g_journal_on = 1;
+  return 0;
+}
+
+/* Registers were changed behind the table bus (raw fd access, TCS/program
+ * file, EEPROM). Forget everything the shadow cache knows. */
+static void cm_invalidate_shadow_cache(void) {
+  if (g_shadow_on) {
+    cm_shadow_invalidate(&g_shadow);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+/* --json: one compact object per result line on stdout                       */
+/* -------------------------------------------------------------------------- */
+
+static int g_json = 0;
+static const char *g_json_cmd = NULL; /* canonical action name, once parsed */
+static unsigned g_json_line = 0;      /* batch line number, 0 outside --batch */
+static int g_json_emitted = 0;        /* the command wrote its own object(s) */
+static cm_json_t g_jw;
+
+/* Open a result object: {"cmd":..,["line":..,]"ok":<ok>, ...
+ * The caller adds its fields and calls dpll_json_end(). */
+static cm_json_t *dpll_json_open(int ok) {
+  cm_json_init(&g_jw, stdout);
+  cm_json_obj_begin(&g_jw, NULL);
+  cm_json_str(&g_jw, "cmd", g_json_cmd);
+  if (g_json_line)
+    cm_json_uint(&g_jw, "line", g_json_line);
+  cm_json_bool(&g_jw, "ok", ok);
+  g_json_emitted = 1;
+  return &g_jw;
+}
+
+static cm_json_t *dpll_json_begin(void) { return dpll_json_open(1); }
+
+static void dpll_json_end(cm_json_t *j) {
+  cm_json_obj_end(j);
+  cm_json_newline(j);
+}
+
+/* Commands without a result of their own (setters, loaders, failures) still
+ * produce exactly one object: {"cmd":..,"ok":<rc == 0>[,"rc":rc]}. */
+static void dpll_json_finish(int rc) {
+  if (!g_json || g_json_emitted)
+    return;
+  cm_json_t *j = dpll_json_open(rc == 0);
+  if (rc != 0)
+    cm_json_int(j, "rc", rc);
+  dpll_json_end(j);
+}
+
 #if 0
 /*
  * Example: using the generated tables (renesas_cm8a34001_tables.*)
@@ -147,6 +322,16 @@ static void usage(const char *prog) {
       "      | clear_statechg_sticky <chan>\n"
       "      | set_oper_state <chan> <NORMAL|FREERUN|HOLDOVER>\n"
       "      | get_phase <chan>\n"
+      "      | status <--all|chan>\n"
+      "      | sample <c[,c...]> [--rate <hz>] [--count <n>]\n"
+      "      | stats <chan> [--rate <hz>] [--mask <name>] [--duration <s>]\n"
+      "               [--report <s>] [--tau-max <s>]\n"
+      "      | monitor [--status-file <path>] [--poll-sec <s>]\n"
+      "                [--freq-ch <chan>] [--gps-chans <c[,c...]>]\n"
+      "                [--phase-rate <hz>] [--telemetry-file <path>]\n"
+      "                [--no-telemetry] [--metrics-port <port>]\n"
+      "                [--metrics-bind <addr>]\n"
+      "      | telemetry [--telemetry-file <path>]\n"
       "      | --set-input-freq <input> <freq_hz>\n"
       "      | --set-input-enable <input> <enable|disable>\n"
       "      | --set-chan-input <chan> <input> <priority> <enable|disable>\n"
@@ -159,11 +344,21 @@ static void usage(const char *prog) {
       "      | get-psl <chan>\n"
       "      | set-damp-factor <chan> <0..7>\n"
       "      | get-damp-factor <chan>\n"
+      "      | snapshot <file>\n"
+      "      | snapshot-diff <file_a> <file_b>\n"
+      "      | plan-outputs <Qn>=<freq_hz> [<Qn>=<freq_hz> ...]\n"
+      "      | plan (input <freq_hz> | output <freq3_hz> <freq4_hz>) "
+      "[--explain]\n"
+      "      | plan-batch [<file>|-]\n"
       "     [--spidev <path>]\n"
       "     [--spidev <path>]\n"
       "     [--spidev <path>]\n"
       "     [--busnum <n> --csnum <m>]\n"
-      "     [--hz <freq>] [--mode <0..3>] [--tcs-debug]\n"
+      "     [--hz <freq>] [--mode <0..3>] [--tcs-debug] [--shadow-cache]\n"
+      "     [--spi-stats] [--json]\n"
+      "     [--plan-heuristic] [--plan-budget-ms <ms>] [--plan-any-fod]\n"
+      "     [--plan-cache <path>] [--no-plan-cache]\n"
+      "  --batch <file|-> [--transaction] [--timing] [--json] [options...]\n"
       "\n"
       "Actions (exactly one required):\n"
       "  --read <addr>           Read 8-bit value from 16-bit DPLL register "
@@ -193,6 +388,43 @@ static void usage(const char *prog) {
       "  get_phase <chan>\n"
       "      Print signed phase measurement for <chan> in seconds (single "
       "float).\n"
+      "  status <--all|chan>\n"
+      "      One line per DPLL: state, lock/holdover sticky bits, tracked input\n"
+      "      and phase status (s). All channels come from two burst reads.\n"
+      "  sample <c[,c...]> [--rate <hz>] [--count <n>]\n"
+      "      Sample DPLL<c>_PHASE_STATUS from a thread at a fixed rate (10..1000\n"
+      "      Hz, default 100), one burst per tick. Prints one line per tick:\n"
+      "      <CLOCK_MONOTONIC_RAW s> <tick> <phase s per channel>. Tick gaps are\n"
+      "      missed ticks. Runs until --count lines or SIGINT/SIGTERM.\n"
+      "  stats <chan> [--rate <hz>] [--mask <name>] [--duration <s>]\n"
+      "        [--report <s>] [--tau-max <s>]\n"
+      "      Streaming MTIE/TDEV/ADEV of the channel's phase over a 1-2-5 tau\n"
+      "      grid (sampler at --rate, default 10 Hz), table every --report s\n"
+      "      (default 60) and at the end. --mask checks each tau against\n"
+      "      g8262 (EEC option 1) or g8273.2a|b|c (dTE_L, unfiltered); the\n"
+      "      exit status is 1 if the final table has a FAIL. --duration 0\n"
+      "      (default) runs until SIGINT/SIGTERM.\n"
+      "  monitor [--status-file <path>] [--poll-sec <s>] [--freq-ch <chan>]\n"
+      "          [--gps-chans <c[,c...]>] [--phase-rate <hz>]\n"
+      "          [--telemetry-file <path>] [--no-telemetry]\n"
+      "          [--metrics-port <port>] [--metrics-bind <addr>]\n"
+      "      Run the lock monitor / relocker in-process (the logic of\n"
+      "      fastlock_1pps_fix.sh): one burst status read per poll, relock\n"
+      "      pulses on flapping, long unlock or large phase, and the OK/NOT_OK\n"
+      "      status file (default " CM_MON_STATUS_FILE ").\n"
+      "      Defaults: --poll-sec 1 --freq-ch 5 --gps-chans 6. --phase-rate\n"
+      "      takes the phase check from a sampler thread instead of one read\n"
+      "      per check. Every poll is also published to the shared-memory\n"
+      "      telemetry segment (default " CM_TELEM_PATH ")\n"
+      "      unless --no-telemetry. --metrics-port serves OpenMetrics on\n"
+      "      http://<addr>:<port>/metrics (lock states, phase histogram,\n"
+      "      state changes, relocks, SPI op counts/latency, last EEPROM/TCS\n"
+      "      apply durations); --metrics-bind defaults to 0.0.0.0, the usual\n"
+      "      port is 9469. Runs until SIGINT/SIGTERM.\n"
+      "  telemetry [--telemetry-file <path>]\n"
+      "      Print the monitor's telemetry segment (per-channel state, sticky\n"
+      "      history, phase, WR_FREQ, input monitor status, guard states).\n"
+      "      Reads shared memory only; no SPI access, no root needed.\n"
       "\n"
       "High-level DPLL control (used by boot-time Python config):\n"
       "  set-input-freq <input> <freq_hz>   (or --set-input-freq)\n"
@@ -210,8 +442,10 @@ static void usage(const char *prog) {
       "  set-output-freq <freq3_hz> <freq4_hz>   (or --set-output-freq)\n"
       "      Configure logical outputs 3 and 4 simultaneously (they share a "
       "source/divider).\n"
-      "      Each <freq*_hz> may be integer or floating-point (e.g. 10e6, "
-      "10.000001e6).\n"
+      "      Each <freq*_hz> is an exact decimal or fraction (e.g. 10e6, "
+      "10.000001e6,\n"
+      "      10000000/3); the plan says when it is exact, else the error in "
+      "ppb.\n"
       "  set-output-divider <output_idx> <divider>   (or "
       "--set-output-divider)\n"
       "      Set integer output divider for specific output index.\n"
@@ -239,6 +473,82 @@ static void usage(const char *prog) {
       "  get-damp-factor <chan>\n"
       "      Read and print current Damping Factor.\n"
       "\n"
+      "Register snapshots (debugging):\n"
+      "  snapshot <file>\n"
+      "      Burst-read every register range mapped by the tables into a "
+      "binary\n"
+      "      snapshot (timestamp, device id and table version in the "
+      "header).\n"
+      "  snapshot-diff <file_a> <file_b>\n"
+      "      Decode the differences between two snapshots by module, register "
+      "and\n"
+      "      field name. Does not touch the SPI bus.\n"
+      "\n"
+      "Frequency planning (offline, does not touch the SPI bus):\n"
+      "  plan-outputs <Qn>=<freq_hz> [<Qn>=<freq_hz> ...]\n"
+      "      Assign the requested outputs to FODs and pick DCOs and integer\n"
+      "      dividers with the least total error, then the fewest FODs.\n"
+      "      Frequencies are exact decimals or fractions (e.g. Q10=156.25e6,\n"
+      "      Q11=1, Q9=10000000/3).\n"
+      "  --plan-heuristic        Greedy + local search instead of the exact "
+      "search.\n"
+      "  --plan-budget-ms <ms>   Time budget for --plan-heuristic (default "
+      "50).\n"
+      "  --plan-any-fod          Let any output use any FOD (default: "
+      "Switchberry\n"
+      "                          routing, Q9 on FOD5 at 500 MHz, Q10/Q11 on "
+      "FOD6).\n"
+      "  plan input <freq_hz> | plan output <freq3_hz> <freq4_hz>\n"
+      "      Print the plan set-input-freq / set-output-freq would program.\n"
+      "      Plans are kept in a persistent cache keyed by the exact "
+      "frequencies\n"
+      "      and planner version; --explain shows hit/miss and search time.\n"
+      "  --plan-cache <path>     Plan cache file (default "
+      CM_PLANCACHE_DEFAULT_PATH ").\n"
+      "  --no-plan-cache         Always search; never read or write the "
+      "cache.\n"
+      "  plan-batch [<file>|-]\n"
+      "      Plan many requests in one call, one per line (default stdin):\n"
+      "        input <freq_hz>            input M/N\n"
+      "        output <freq_hz> [...]     one DCO + dividers for all "
+      "frequencies\n"
+      "      Prints one line per request, in order: 'ok exact=.. m=.. "
+      "n_reg=..\n"
+      "      div=.. actual=.. ppb=..' or 'fail rc=..'.\n"
+      "\n"
+      "Batch mode:\n"
+      "  --batch <file|->        Run one command per line (default stdin is "
+      "'-') in\n"
+      "                          one process over one SPI session. '#' starts "
+      "a comment;\n"
+      "                          ' and \" quote. Other options on the command "
+      "line apply\n"
+      "                          to every line. All lines are checked before "
+      "any SPI\n"
+      "                          access; execution stops at the first failing "
+      "line.\n"
+      "  --transaction           On failure, restore every configuration "
+      "register the\n"
+      "                          batch wrote (volatile registers are not "
+      "restored).\n"
+      "                          --write, --flash-hex, --tcs-apply, "
+      "--prog-file and\n"
+      "                          monitor are refused.\n"
+      "  --timing                Print per-line and total time to stderr.\n"
+      "\n"
+      "Output options:\n"
+      "  --json                  Results as compact JSON, one object per line "
+      "on stdout:\n"
+      "                          {\"cmd\":..,\"ok\":..,...} (\"line\" in a "
+      "batch, \"rc\" on\n"
+      "                          failure). Commands without a result print "
+      "only cmd/ok;\n"
+      "                          sample/stats/plan-batch print one object "
+      "per record,\n"
+      "                          monitor one per log line, --batch a final "
+      "\"batch\"\n"
+      "                          summary. Diagnostics stay on stderr.\n"
+      "\n"
       "Connection options:\n"
       "  --spidev <path>         SPI node (e.g. /dev/spidev2.1). Overrides "
       "bus/cs.\n"
@@ -252,6 +562,17 @@ static void usage(const char *prog) {
       "Debug options:\n"
       "  --tcs-debug             Make TCS/TXT parsers verbose (print "
       "parsed/written registers).\n"
+      "  --shadow-cache          Serve configuration register reads (and the "
+      "read half\n"
+      "                          of field read-modify-writes) from a "
+      "write-through\n"
+      "                          cache. Status/sticky/TOD/command registers "
+      "are never\n"
+      "                          cached. Hit/miss counts go to stderr.\n"
+      "  --spi-stats             At exit, print SPI counts, bytes and latency "
+      "quantiles\n"
+      "                          per op type and time per register module to "
+      "stderr.\n"
       "\n"
       "Examples:\n"
       "  %s --read  0xC024\n"
@@ -379,6 +700,162 @@ static void flash_progress_cb(size_t written, size_t total, void *user) {
     fprintf(stderr, "\n");
 }
 
+/* -------------------------------------------------------------------------- */
+/* Frequency plans, looked up in the persistent cache before searching        */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+  int cache_used; /* cache file was available */
+  int hit;
+  double search_us; /* search time (stored value on a hit) */
+  double lookup_us; /* time spent in this call */
+} dpll_plan_info_t;
+
+static cm_plancache_t *dpll_plancache(void) {
+  if (g_plancache_state == 0) {
+    g_plancache_state =
+        (cm_plancache_open(&g_plancache, g_plancache_path) == 0) ? 1 : -1;
+  }
+  return (g_plancache_state == 1) ? &g_plancache : NULL;
+}
+
+static void dpll_plancache_close(void) {
+  if (g_plancache_state == 1) {
+    cm_plancache_close(&g_plancache);
+    g_plancache_state = 0;
+  }
+}
+
+static double usecs_since(struct timespec t0) {
+  struct timespec t1;
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  return secs_since(t1, t0) * 1e6;
+}
+
+/* dpll_compute_input_ratio() through the plan cache. */
+static int dpll_plan_input_ratio(double freq_hz, uint64_t *M, uint16_t *N_reg,
+                                 dpll_plan_info_t *info) {
+  struct timespec t0;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  memset(info, 0, sizeof(*info));
+
+  cm_plan_key_t key;
+  cm_plan_val_t val;
+  memset(&key, 0, sizeof(key));
+  memset(&val, 0, sizeof(val));
+  key.kind = CM_PLAN_INPUT_RATIO;
+  key.nfreq = 1;
+  if (cm_freq_from_double(freq_hz, &key.freq[0]) != 0) {
+    return -2;
+  }
+
+  cm_plancache_t *pc = dpll_plancache();
+  info->cache_used = (pc != NULL);
+  if (pc && cm_plancache_lookup(pc, &key, &val) == 1) {
+    *M = val.m;
+    *N_reg = (val.n == 1) ? 0 : (uint16_t)val.n;
+    info->hit = 1;
+    info->search_us = val.search_us;
+    info->lookup_us = usecs_since(t0);
+    return 0;
+  }
+
+  double actual = 0.0, err_hz = 0.0;
+  int rc = dpll_compute_input_ratio(freq_hz, M, N_reg, &actual, &err_hz);
+  info->search_us = usecs_since(t0);
+  if (rc != 0) {
+    return rc;
+  }
+
+  val.m = *M;
+  val.n = (*N_reg == 0) ? 1u : *N_reg;
+  val.err_ppb[0] = err_hz / freq_hz * 1e9;
+  val.exact = (err_hz == 0.0);
+  val.search_us = (uint32_t)info->search_us;
+  if (pc) {
+    cm_plancache_store(pc, &key, &val);
+  }
+  info->lookup_us = usecs_since(t0);
+  return 0;
+}
+
+/* cm_fp_plan_dco() for an OUT3/OUT4 pair through the plan cache. */
+static int dpll_plan_output_pair(const cm_freq_t targets[2], cm_fp_plan_t *plan,
+                                 dpll_plan_info_t *info) {
+  struct timespec t0;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  memset(info, 0, sizeof(*info));
+
+  cm_plan_key_t key;
+  cm_plan_val_t val;
+  memset(&key, 0, sizeof(key));
+  memset(&val, 0, sizeof(val));
+  key.kind = CM_PLAN_OUTPUT_PAIR;
+  key.nfreq = 2;
+  key.freq[0] = targets[0];
+  key.freq[1] = targets[1];
+
+  cm_plancache_t *pc = dpll_plancache();
+  info->cache_used = (pc != NULL);
+  if (pc && cm_plancache_lookup(pc, &key, &val) == 1) {
+    memset(plan, 0, sizeof(*plan));
+    plan->m = val.m;
+    plan->n = val.n;
+    plan->n_reg = (val.n == 1) ? 0 : (uint16_t)val.n;
+    cm_freq_make(val.m, val.n, &plan->dco);
+    plan->nout = 2;
+    for (int i = 0; i < 2; i++) {
+      plan->div[i] = val.div[i];
+      cm_freq_make(val.m, (uint64_t)val.n * val.div[i], &plan->actual[i]);
+      plan->err_ppb[i] = val.err_ppb[i];
+      plan->err_sign[i] = (val.err_ppb[i] > 0) - (val.err_ppb[i] < 0);
+    }
+    plan->exact = val.exact;
+    plan->exhaustive = 1;
+    info->hit = 1;
+    info->search_us = val.search_us;
+    info->lookup_us = usecs_since(t0);
+    return 0;
+  }
+
+  int rc = cm_fp_plan_dco(targets, 2, NULL, plan);
+  info->search_us = usecs_since(t0);
+  if (rc != 0) {
+    return rc;
+  }
+
+  val.m = plan->m;
+  val.n = plan->n;
+  for (int i = 0; i < 2; i++) {
+    val.div[i] = plan->div[i];
+    val.err_ppb[i] = plan->err_ppb[i];
+  }
+  val.exact = plan->exact;
+  val.search_us = (uint32_t)info->search_us;
+  /* Only complete searches are worth remembering. */
+  if (pc && plan->exhaustive) {
+    cm_plancache_store(pc, &key, &val);
+  }
+  info->lookup_us = usecs_since(t0);
+  return 0;
+}
+
+static void dpll_plan_explain(const dpll_plan_info_t *info) {
+  if (!info->cache_used) {
+    printf("explain: plan cache not used (%s), searched in %.1f us\n",
+           g_plancache_path, info->search_us);
+  } else if (info->hit) {
+    printf("explain: cache hit in %s (planner v%u), lookup %.1f us, original "
+           "search %.1f us\n",
+           g_plancache_path, CM_FP_PLANNER_VERSION, info->lookup_us,
+           info->search_us);
+  } else {
+    printf("explain: cache miss in %s (planner v%u), search %.1f us, "
+           "stored\n",
+           g_plancache_path, CM_FP_PLANNER_VERSION, info->search_us);
+  }
+}
+
 /* -------------------------------------------------------------------------- */
 /* High-level command stubs (fill in register-level code using g_cm_bus)      */
 /* -------------------------------------------------------------------------- */
@@ -394,15 +871,16 @@ static int dpll_cmd_set_input_freq(uint8_t input_idx, double freq_hz) {
   double target = (double)freq_hz;
   uint64_t M = 0;
   uint16_t N_reg = 0;
-  double actual = 0.0;
-  double err_hz = 0.0;
+  dpll_plan_info_t info;
 
-  int rc = dpll_compute_input_ratio(target, &M, &N_reg, &actual, &err_hz);
+  int rc = dpll_plan_input_ratio(target, &M, &N_reg, &info);
   if (rc != 0) {
     fprintf(stderr, "dpll_compute_input_ratio failed for %.6f Hz (rc=%d)\n",
             target, rc);
     return rc;
   }
+  double actual = dpll_input_freq_from_ratio(M, N_reg);
+  double err_hz = actual - target;
 
   double err_ppm = (target != 0.0) ? (err_hz / target) * 1e6 : 0.0;
 
@@ -412,38 +890,15 @@ static int dpll_cmd_set_input_freq(uint8_t input_idx, double freq_hz) {
           (unsigned)input_idx, target, actual, (unsigned long long)M,
           (unsigned)N_reg, err_hz, err_ppm);
 
-  /* Here you would:
-   *   - break M (48-bit) and N_reg (16-bit) into the appropriate bytes
-   *   - write them to the Input module registers using cm_string_write_bytes()
-   *
-   * Example for the "Input" module instance mapped from input_idx:
-   */
-
-  /* Pack M as 6 bytes LSB-first: M[0..7],8..15,...,40..47 */
-  uint8_t buf_M[6];
-  buf_M[0] = (uint8_t)(M & 0xFF);
-  buf_M[1] = (uint8_t)((M >> 8) & 0xFF);
-  buf_M[2] = (uint8_t)((M >> 16) & 0xFF);
-  buf_M[3] = (uint8_t)((M >> 24) & 0xFF);
-  buf_M[4] = (uint8_t)((M >> 32) & 0xFF);
-  buf_M[5] = (uint8_t)((M >> 40) & 0xFF);
-
-  rc = cm_string_write_bytes(&g_cm_bus, "Input", input_idx,
-                             "INPUT_IN_FREQ_M_0_7", buf_M, sizeof(buf_M));
+  /* M (48-bit) and N_reg (16-bit, 0 means 1) each go out in one burst */
+  rc = cm_write_s64_field(&g_cm_bus, CM_WF_INPUT_FREQ_M, input_idx,
+                          (int64_t)M);
   if (rc) {
     fprintf(stderr, "Failed to write M for Input[%u], rc=%d\n", input_idx, rc);
     return rc;
   }
 
-  /* Pack N as 2 bytes LSB-first: N[0..7], 8..15, stored in N_reg. */
-  uint16_t N = N_reg; // N_reg is already encoded (0 means 1), but if N!=1 you
-                      // just write it.
-  uint8_t buf_N[2];
-  buf_N[0] = (uint8_t)(N & 0xFF);
-  buf_N[1] = (uint8_t)((N >> 8) & 0xFF);
-
-  rc = cm_string_write_bytes(&g_cm_bus, "Input", input_idx,
-                             "INPUT_IN_FREQ_N_0_7", buf_N, sizeof(buf_N));
+  rc = cm_write_s64_field(&g_cm_bus, CM_WF_INPUT_FREQ_N, input_idx, N_reg);
   if (rc) {
     fprintf(stderr, "Failed to write N for Input[%u], rc=%d\n", input_idx, rc);
     return rc;
@@ -499,21 +954,16 @@ static int dpll_cmd_set_chan_input(uint8_t chan, uint8_t input_idx,
   char reg_name[32];
   sprintf(reg_name, "DPLL_REF_PRIORITY_%d", priority);
 
-  /* Now need to edit DPLL input settings */
-  cm_string_field_write8(&g_cm_bus,
-                         "DPLL_Config",  // module name from tables
-                         chan,           // instance
-                         reg_name,       // register name
-                         "PRIORITY_REF", // field name
-                         input_idx);
-
-  fprintf(stderr, "writing priority enable\n");
-  cm_string_field_write8(&g_cm_bus,
-                         "DPLL_Config", // module name from tables
-                         chan,          // instance
-                         reg_name,      // register name
-                         "PRIORITY_EN", // field name
-                         enable);
+  /* Now need to edit DPLL input settings: both fields in one RMW */
+  const cm_named_field_val_t prio[] = {
+      {"PRIORITY_REF", input_idx},
+      {"PRIORITY_EN", (uint8_t)(enable ? 1 : 0)},
+  };
+  cm_string_fields_write8(&g_cm_bus,
+                          "DPLL_Config", // module name from tables
+                          chan,          // instance
+                          reg_name,      // register name
+                          prio, sizeof(prio) / sizeof(prio[0]));
 
   /* do trigger register access */
   cm_string_trigger_rw(&g_cm_bus, "DPLL_Config", chan, "DPLL_MODE");
@@ -524,73 +974,46 @@ static int dpll_cmd_set_chan_input(uint8_t chan, uint8_t input_idx,
  * Configure logical DPLL output index (e.g. 3,4) to a given frequency in Hz.
  * For your board, output 2 is usually 1PPS, dont allow user to change; outputs
  * 3 & 4 may be arbitrary freq.
+ *
+ * Frequencies are exact fractions (e.g. 156.25e6 or 10000000/3); the plan is
+ * reported as exact only when it is proven exact in integer arithmetic.
  */
-static int dpll_cmd_set_output_freq(double freq3_hz, double freq4_hz) {
-  fprintf(stderr,
-          "dpll_cmd_set_output_freq: request OUT3=%.6f Hz, OUT4=%.6f Hz\n",
-          freq3_hz, freq4_hz);
-
-  uint64_t M = 0;
-  uint16_t N_reg = 0;
-  uint32_t D3 = 0, D4 = 0;
-  double fdco = 0.0;
-  double out3_actual = 0.0, out4_actual = 0.0;
-  double out3_err = 0.0, out4_err = 0.0;
-
-  int rc = dpll_compute_output_mndiv(freq3_hz, freq4_hz, &M, &N_reg, &D3, &D4,
-                                     &fdco, &out3_actual, &out4_actual,
-                                     &out3_err, &out4_err);
+static int dpll_cmd_set_output_freq(cm_freq_t freq3, cm_freq_t freq4) {
+  char s3[48], s4[48];
+  fprintf(stderr, "dpll_cmd_set_output_freq: request OUT3=%s Hz, OUT4=%s Hz\n",
+          cm_freq_str(freq3, s3, sizeof(s3)), cm_freq_str(freq4, s4, sizeof(s4)));
+
+  const cm_freq_t targets[2] = {freq3, freq4};
+  cm_fp_plan_t plan;
+  dpll_plan_info_t info;
+  int rc = dpll_plan_output_pair(targets, &plan, &info);
   if (rc != 0) {
-    fprintf(stderr, "dpll_compute_output_mndiv failed (rc=%d)\n", rc);
+    fprintf(stderr, "cm_fp_plan_dco failed (rc=%d)\n", rc);
     return rc;
   }
 
-  double e3_ppm = (freq3_hz != 0.0) ? (out3_err / freq3_hz) * 1e6 : 0.0;
-  double e4_ppm = (freq4_hz != 0.0) ? (out4_err / freq4_hz) * 1e6 : 0.0;
-
-  fprintf(stderr,
-          "DCO: M=%llu, N_reg=%u => F_dco=%.6f Hz (%.3f MHz)\n"
-          "  OUT3: divider=%u, actual=%.9f Hz, error=%+g Hz (%.3f ppm)\n"
-          "  OUT4: divider=%u, actual=%.9f Hz, error=%+g Hz (%.3f ppm)\n",
-          (unsigned long long)M, (unsigned)N_reg, fdco, fdco / 1e6, D3,
-          out3_actual, out3_err, e3_ppm, D4, out4_actual, out4_err, e4_ppm);
-
-  // pack M into 6 bytes LSB-first
-  uint8_t m_bytes[6] = {
-      (uint8_t)(M & 0xFF),         (uint8_t)((M >> 8) & 0xFF),
-      (uint8_t)((M >> 16) & 0xFF), (uint8_t)((M >> 24) & 0xFF),
-      (uint8_t)((M >> 32) & 0xFF), (uint8_t)((M >> 40) & 0xFF),
-  };
-  cm_string_write_bytes(&g_cm_bus, "DPLL_Ctrl", 6, "FOD_FREQ_M_7_0", m_bytes,
-                        6);
+  char sd[48];
+  fprintf(stderr, "DCO: M=%llu, N_reg=%u => F_dco=%s Hz (%.6f MHz)%s\n",
+          (unsigned long long)plan.m, (unsigned)plan.n_reg,
+          cm_freq_str(plan.dco, sd, sizeof(sd)),
+          cm_freq_to_double(plan.dco) / 1e6,
+          plan.exact ? ", exact" : "");
+  for (int i = 0; i < 2; i++) {
+    char sa[48];
+    fprintf(stderr, "  OUT%d: divider=%u, actual=%s Hz (%.9f), error=%+.6g ppb\n",
+            3 + i, plan.div[i], cm_freq_str(plan.actual[i], sa, sizeof(sa)),
+            cm_freq_to_double(plan.actual[i]), plan.err_ppb[i]);
+  }
 
-  // N_reg (0..65535)
-  uint8_t n_bytes[2] = {
-      (uint8_t)(N_reg & 0xFF),
-      (uint8_t)((N_reg >> 8) & 0xFF),
-  };
-  cm_string_write_bytes(&g_cm_bus, "DPLL_Ctrl", 6, "FOD_FREQ_N_7_0", n_bytes,
-                        2);
+  // FOD M (48-bit) and N_reg (0..65535)
+  cm_write_s64_field(&g_cm_bus, CM_WF_FOD_FREQ_M, 6, (int64_t)plan.m);
+  cm_write_s64_field(&g_cm_bus, CM_WF_FOD_FREQ_N, 6, plan.n_reg);
 
   // don't need trigger, DPLL_Ctrl, every register is trigger register!
 
-  // OUT3 divider D3 as 32-bit LSB-first
-  uint8_t d3_bytes[4] = {
-      (uint8_t)(D3 & 0xFF),
-      (uint8_t)((D3 >> 8) & 0xFF),
-      (uint8_t)((D3 >> 16) & 0xFF),
-      (uint8_t)((D3 >> 24) & 0xFF),
-  };
-  cm_string_write_bytes(&g_cm_bus, "Output", 10, "OUT_DIV", d3_bytes, 4);
-
-  // OUT4 divider D4 as 32-bit LSB-first
-  uint8_t d4_bytes[4] = {
-      (uint8_t)(D4 & 0xFF),
-      (uint8_t)((D4 >> 8) & 0xFF),
-      (uint8_t)((D4 >> 16) & 0xFF),
-      (uint8_t)((D4 >> 24) & 0xFF),
-  };
-  cm_string_write_bytes(&g_cm_bus, "Output", 11, "OUT_DIV", d4_bytes, 4);
+  // OUT3 / OUT4 dividers, 32-bit each
+  cm_write_s64_field(&g_cm_bus, CM_WF_OUT_DIV, 10, plan.div[0]);
+  cm_write_s64_field(&g_cm_bus, CM_WF_OUT_DIV, 11, plan.div[1]);
 
   // don't need trigger, OUTPUT, every register is trigger register!
 
@@ -605,16 +1028,8 @@ static int dpll_cmd_set_output_divider(uint8_t out_idx, uint32_t divider) {
   fprintf(stderr, "dpll_cmd_set_output_divider: output=%u divider=%u\n",
           out_idx, divider);
 
-  // OUT_DIV is a 32-bit register. Pack LSB first.
-  uint8_t div_bytes[4];
-  div_bytes[0] = (uint8_t)(divider & 0xFF);
-  div_bytes[1] = (uint8_t)((divider >> 8) & 0xFF);
-  div_bytes[2] = (uint8_t)((divider >> 16) & 0xFF);
-  div_bytes[3] = (uint8_t)((divider >> 24) & 0xFF);
-
-  // Write to Output module, instance = out_idx
-  int rc = cm_string_write_bytes(&g_cm_bus, "Output", out_idx, "OUT_DIV",
-                                 div_bytes, 4);
+  // OUT_DIV is a 32-bit register, written in one burst.
+  int rc = cm_write_s64_field(&g_cm_bus, CM_WF_OUT_DIV, out_idx, divider);
   if (rc) {
     fprintf(stderr, "Failed to write OUT_DIV for Output[%u], rc=%d\n", out_idx,
             rc);
@@ -641,21 +1056,16 @@ static int dpll_cmd_set_combo_slave(uint8_t chan, uint8_t master_chan,
   // We'll leave it 0 for now as verified in hardware testing often works with
   // default. However, user only asked to set primary combo bus master.
 
-  // 1. Set Source ID
-  int rc = cm_string_field_write8(&g_cm_bus, "DPLL_Config", chan,
-                                  "DPLL_COMBO_SLAVE_CFG_0", "PRI_COMBO_SRC_ID",
-                                  master_chan);
-  if (rc) {
-    fprintf(stderr, "Failed to set PRI_COMBO_SRC_ID, rc=%d\n", rc);
-    return rc;
-  }
-
-  // 2. Set Enable
-  rc = cm_string_field_write8(&g_cm_bus, "DPLL_Config", chan,
-                              "DPLL_COMBO_SLAVE_CFG_0", "PRI_COMBO_SRC_EN",
-                              enable ? 1 : 0);
+  // 1+2. Set Source ID and Enable in a single read-modify-write
+  const cm_named_field_val_t combo[] = {
+      {"PRI_COMBO_SRC_ID", master_chan},
+      {"PRI_COMBO_SRC_EN", (uint8_t)(enable ? 1 : 0)},
+  };
+  int rc = cm_string_fields_write8(&g_cm_bus, "DPLL_Config", chan,
+                                   "DPLL_COMBO_SLAVE_CFG_0", combo,
+                                   sizeof(combo) / sizeof(combo[0]));
   if (rc) {
-    fprintf(stderr, "Failed to set PRI_COMBO_SRC_EN, rc=%d\n", rc);
+    fprintf(stderr, "Failed to set PRI_COMBO_SRC_ID/EN, rc=%d\n", rc);
     return rc;
   }
 
@@ -689,6 +1099,14 @@ static int dpll_cmd_get_combo_slave(uint8_t chan) {
     return rc;
   }
 
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_bool(j, "combo_slave", en);
+    cm_json_uint(j, "combo_master", master);
+    dpll_json_end(j);
+    return 0;
+  }
   printf("Slave: %s, Master: %u\n", en ? "Enabled" : "Disabled", master);
   return 0;
 }
@@ -718,29 +1136,23 @@ static int dpll_cmd_set_loop_bw(uint8_t chan, uint16_t bw_value,
   fprintf(stderr, "dpll_cmd_set_loop_bw: chan=%u bw=%u %s\n", chan, bw_value,
           unit_names[bw_unit]);
 
-  /* BW_7_0: lower 8 bits */
+  /* BW_7_0 (lower 8 bits), BW_13_8 (upper 6 bits) and BW_UNIT cover both
+   * registers completely: one 2-byte burst write, no read-back needed. */
   uint8_t bw_lo = (uint8_t)(bw_value & 0xFF);
-  int rc = cm_string_field_write8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_BW_0",
-                                  "BW_7_0", bw_lo);
-  if (rc) {
-    fprintf(stderr, "Failed to write BW_7_0, rc=%d\n", rc);
-    return rc;
-  }
-
-  /* BW_13_8: upper 6 bits */
   uint8_t bw_hi = (uint8_t)((bw_value >> 8) & 0x3F);
-  rc = cm_string_field_write8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_BW_1",
-                              "BW_13_8", bw_hi);
-  if (rc) {
-    fprintf(stderr, "Failed to write BW_13_8, rc=%d\n", rc);
-    return rc;
-  }
-
-  /* BW_UNIT */
-  rc = cm_string_field_write8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_BW_1",
-                              "BW_UNIT", bw_unit);
+  cm_field_write_t w[3];
+  int rc = cm_string_field_resolve("DPLL_Ctrl", chan, "DPLL_BW_0", "BW_7_0",
+                                   bw_lo, &w[0]);
+  if (!rc)
+    rc = cm_string_field_resolve("DPLL_Ctrl", chan, "DPLL_BW_1", "BW_13_8",
+                                 bw_hi, &w[1]);
+  if (!rc)
+    rc = cm_string_field_resolve("DPLL_Ctrl", chan, "DPLL_BW_1", "BW_UNIT",
+                                 bw_unit, &w[2]);
+  if (!rc)
+    rc = cm_fields_write_group(&g_cm_bus, w, 3);
   if (rc) {
-    fprintf(stderr, "Failed to write BW_UNIT, rc=%d\n", rc);
+    fprintf(stderr, "Failed to write DPLL_BW_0/1, rc=%d\n", rc);
     return rc;
   }
 
@@ -780,6 +1192,16 @@ static int dpll_cmd_get_loop_bw(uint8_t chan) {
   static const char *unit_names[] = {"uHz", "mHz", "Hz", "kHz"};
   const char *uname = (bw_unit <= 3) ? unit_names[bw_unit] : "???";
 
+  if (g_json) {
+    static const double unit_hz[] = {1e-6, 1e-3, 1.0, 1e3};
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_uint(j, "bw", bw_value);
+    cm_json_str(j, "bw_unit", uname);
+    cm_json_double(j, "bw_hz", (double)bw_value * unit_hz[bw_unit & 3]);
+    dpll_json_end(j);
+    return 0;
+  }
   printf("%u %s\n", bw_value, uname);
   return 0;
 }
@@ -791,46 +1213,31 @@ static int dpll_cmd_get_loop_bw(uint8_t chan) {
 static int dpll_cmd_set_psl(uint8_t chan, uint16_t psl_ns) {
   fprintf(stderr, "dpll_cmd_set_psl: chan=%u psl=%u ns/s\n", chan, psl_ns);
 
-  /* PSL_7_0 */
-  uint8_t lo = (uint8_t)(psl_ns & 0xFF);
-  int rc = cm_string_field_write8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_PSL_7_0",
-                                  "VALUE", lo);
-  if (rc) {
-    fprintf(stderr, "Failed to write DPLL_PSL_7_0, rc=%d\n", rc);
-    return rc;
-  }
-
-  /* PSL_15_8 */
-  uint8_t hi = (uint8_t)((psl_ns >> 8) & 0xFF);
-  rc = cm_string_field_write8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_PSL_15_8",
-                              "VALUE", hi);
+  /* PSL_7_0 + PSL_15_8 in one 2-byte burst */
+  int rc = cm_write_s64_field(&g_cm_bus, CM_WF_DPLL_PSL, chan, psl_ns);
   if (rc) {
-    fprintf(stderr, "Failed to write DPLL_PSL_15_8, rc=%d\n", rc);
+    fprintf(stderr, "Failed to write DPLL_PSL_7_0/15_8, rc=%d\n", rc);
     return rc;
   }
   return 0;
 }
 
 static int dpll_cmd_get_psl(uint8_t chan) {
-  uint8_t lo = 0, hi = 0;
-  int rc;
-
-  rc = cm_string_field_read8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_PSL_7_0",
-                             "VALUE", &lo);
+  int64_t val = 0;
+  int rc = cm_read_s64_field(&g_cm_bus, CM_WF_DPLL_PSL, chan, &val);
   if (rc) {
-    fprintf(stderr, "Failed to read DPLL_PSL_7_0, rc=%d\n", rc);
+    fprintf(stderr, "Failed to read DPLL_PSL_7_0/15_8, rc=%d\n", rc);
     return rc;
   }
 
-  rc = cm_string_field_read8(&g_cm_bus, "DPLL_Ctrl", chan, "DPLL_PSL_15_8",
-                             "VALUE", &hi);
-  if (rc) {
-    fprintf(stderr, "Failed to read DPLL_PSL_15_8, rc=%d\n", rc);
-    return rc;
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_uint(j, "psl_ns_per_s", (uint64_t)val);
+    dpll_json_end(j);
+    return 0;
   }
-
-  uint16_t val = (uint16_t)lo | ((uint16_t)hi << 8);
-  printf("%u\n", val);
+  printf("%u\n", (unsigned)val);
   return 0;
 }
 
@@ -858,6 +1265,13 @@ static int dpll_cmd_get_damp_factor(uint8_t chan) {
     fprintf(stderr, "Failed to read DAMP_FTR, rc=%d\n", rc);
     return rc;
   }
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_uint(j, "damp_factor", val);
+    dpll_json_end(j);
+    return 0;
+  }
   printf("%u\n", val);
   return 0;
 }
@@ -938,6 +1352,14 @@ static int dpll_cmd_get_state(uint8_t chan) {
     fprintf(stderr, "get_state failed (chan=%u, rc=%d)\n", (unsigned)chan, rc);
     return rc;
   }
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_str(j, "state", dpll_lock_state_to_str(st));
+    cm_json_uint(j, "state_code", (unsigned)st);
+    dpll_json_end(j);
+    return 0;
+  }
   /* Script-friendly: single token */
   printf("%s\n", dpll_lock_state_to_str(st));
   return 0;
@@ -951,6 +1373,13 @@ static int dpll_cmd_get_statechg_sticky(uint8_t chan) {
             (unsigned)chan, rc);
     return rc;
   }
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_bool(j, "sticky", sticky);
+    dpll_json_end(j);
+    return 0;
+  }
   printf("%u\n", (unsigned)(sticky ? 1 : 0));
   return 0;
 }
@@ -992,95 +1421,1157 @@ static int dpll_cmd_get_phase(uint8_t chan) {
     return rc;
   }
   double secs = cm_phase_s36_to_seconds(phase_s36);
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "chan", chan);
+    cm_json_int(j, "phase_s36", phase_s36);
+    cm_json_double(j, "phase_sec", secs);
+    dpll_json_end(j);
+    return 0;
+  }
   /* Script-friendly: single float in seconds */
   printf("%.12e\n", secs);
   return 0;
 }
 
-/* -------------------------------------------------------------------------- */
+/*
+ * Status of every DPLL from one snapshot (two burst reads), one line per
+ * channel. chan < 0 prints all channels.
+ */
+static int dpll_cmd_status(int chan) {
+  dpll_status_snapshot_t snap;
+  int rc = dpll_status_snapshot_read(&g_cm_bus, CM_STATUS_PHASE, &snap);
+  if (rc != 0) {
+    fprintf(stderr, "status failed (rc=%d)\n", rc);
+    return rc;
+  }
+  cm_json_t *j = g_json ? dpll_json_begin() : NULL;
+  if (j)
+    cm_json_arr_begin(j, "dplls");
+  for (unsigned ch = 0; ch < CM_STATUS_NUM_DPLLS; ch++) {
+    if (chan >= 0 && (unsigned)chan != ch)
+      continue;
+    const dpll_chan_status_t *c = &snap.ch[ch];
+    if (j) {
+      cm_json_obj_begin(j, NULL);
+      cm_json_uint(j, "chan", ch);
+      cm_json_str(j, "state", dpll_state_str(c->state));
+      cm_json_uint(j, "state_code", c->state);
+      cm_json_bool(j, "lock_sticky", c->lock_sticky);
+      cm_json_bool(j, "holdover_sticky", c->holdover_sticky);
+      cm_json_uint(j, "ref_input", c->ref_input);
+      cm_json_int(j, "phase_s36", c->phase_s36);
+      cm_json_double(j, "phase_sec", c->phase_sec);
+      cm_json_obj_end(j);
+      continue;
+    }
+    printf("DPLL%u %-8s lock_sticky=%u holdover_sticky=%u input=%u "
+           "phase=%.12e\n",
+           ch, dpll_state_str(c->state), (unsigned)c->lock_sticky,
+           (unsigned)c->holdover_sticky, (unsigned)c->ref_input, c->phase_sec);
+  }
+  if (j) {
+    cm_json_arr_end(j);
+    dpll_json_end(j);
+  }
+  return 0;
+}
 
-int main(int argc, char **argv) {
-  if (argc < 2) {
-    usage(argv[0]);
-    return 1;
+static const char *dpll_guard_state_str(int32_t state) {
+  return state == CM_TELEM_GUARD_OK       ? "OK"
+         : state == CM_TELEM_GUARD_NOT_OK ? "NOT_OK"
+                                          : "MISSING";
+}
+
+/* telemetry --json: the whole segment as one object. Channel fields that the
+ * monitor does not maintain for a channel are null. */
+static void dpll_json_telemetry(const cm_telem_t *t, double age) {
+  cm_json_t *j = dpll_json_begin();
+  cm_json_int(j, "pid", t->pid);
+  cm_json_bool(j, "running", t->pid != 0);
+  cm_json_double(j, "age_sec", age);
+  cm_json_uint(j, "polls", t->polls);
+  cm_json_uint(j, "relocks", t->pulses);
+  cm_json_uint(j, "bursts", t->bursts);
+  cm_json_int(j, "last_rc", t->last_rc);
+
+  cm_json_arr_begin(j, "dplls");
+  for (unsigned ch = 0; ch < CM_TELEM_NUM_DPLLS; ch++) {
+    const cm_telem_chan_t *c = &t->ch[ch];
+    const int mon = (c->flags & (CM_TELEM_CH_FREQ | CM_TELEM_CH_GPS)) != 0;
+    const int gps = (c->flags & CM_TELEM_CH_GPS) != 0;
+    cm_json_obj_begin(j, NULL);
+    cm_json_uint(j, "chan", ch);
+    cm_json_str(j, "state", dpll_state_str(c->state));
+    cm_json_uint(j, "state_code", c->state);
+    cm_json_uint(j, "ref_input", c->ref_input);
+    cm_json_double(j, "phase_sec", c->phase_sec);
+    cm_json_double(j, "wr_freq_ppb", c->wr_freq_ppb);
+    cm_json_str(j, "role", gps ? "gps" : mon ? "freq" : NULL);
+    if (mon) {
+      cm_json_uint(j, "lock_changes", c->lock_changes);
+      cm_json_uint(j, "relocks", c->relocks);
+      cm_json_uint(j, "sticky_hist", c->sticky_hist);
+    } else {
+      cm_json_null(j, "lock_changes");
+      cm_json_null(j, "relocks");
+      cm_json_null(j, "sticky_hist");
+    }
+    if (gps) {
+      cm_json_double(j, "unlocked_sec", c->unlocked_sec);
+      cm_json_double(j, "since_change_sec", c->since_change_sec);
+    } else {
+      cm_json_null(j, "unlocked_sec");
+      cm_json_null(j, "since_change_sec");
+    }
+    if (c->flags & CM_TELEM_CH_COMBO) {
+      cm_json_bool(j, "combo_slave", c->combo_en);
+      cm_json_uint(j, "combo_master", c->combo_src);
+    } else {
+      cm_json_null(j, "combo_slave");
+      cm_json_null(j, "combo_master");
+    }
+    cm_json_obj_end(j);
+  }
+  cm_json_arr_end(j);
+
+  cm_json_arr_begin(j, "in_mon");
+  for (unsigned i = 0; i < CM_TELEM_NUM_INPUTS; i++)
+    cm_json_uint(j, NULL, t->in_mon[i]);
+  cm_json_arr_end(j);
+
+  cm_json_arr_begin(j, "guards");
+  for (unsigned i = 0; i < CM_TELEM_NUM_GUARDS; i++) {
+    const cm_telem_guard_t *g = &t->guard[i];
+    if (!g->name[0])
+      continue;
+    cm_json_obj_begin(j, NULL);
+    cm_json_str(j, "name", g->name);
+    cm_json_str(j, "state", dpll_guard_state_str(g->state));
+    cm_json_str(j, "state_text", g->state_text);
+    cm_json_str(j, "stamp", g->stamp);
+    cm_json_str(j, "msg", g->msg);
+    cm_json_obj_end(j);
   }
+  cm_json_arr_end(j);
+  dpll_json_end(j);
+}
 
-  int do_read = 0;
-  int do_write = 0;
-  int do_flash = 0;
-  int do_tcs_apply = 0;
-  int do_set_input_freq = 0;
-  int do_set_input_enable = 0;
-  int do_set_chan_input = 0;
-  int do_set_output_freq = 0;
-  int do_set_out2_dest = 0;
-  int do_prog_file = 0;
+/*
+ * Print the telemetry segment published by `monitor`. Offline: shared memory
+ * only, consistent through the segment's seqlock.
+ */
+static int dpll_cmd_telemetry(const char *path) {
+  cm_telem_t t;
+  int rc = cm_telem_read(path, &t);
+  if (rc != 0) {
+    fprintf(stderr, "telemetry: %s: %s (rc=%d)\n", path,
+            rc == -1   ? "cannot open (monitor not running?)"
+            : rc == -2 ? "not a telemetry segment of this version"
+                       : "writer busy",
+            rc);
+    return rc;
+  }
 
-  int do_set_output_divider = 0;
-  int do_set_combo_slave = 0;
-  int do_get_combo_slave = 0;
-  int do_set_loop_bw = 0;
-  int do_get_loop_bw = 0;
-  int do_set_psl = 0;
-  int do_get_psl = 0;
-  int do_set_damp_factor = 0;
-  int do_get_damp_factor = 0;
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  double age = (double)now.tv_sec + (double)now.tv_nsec * 1e-9 -
+               (double)t.updated_ns * 1e-9;
+  if (g_json) {
+    dpll_json_telemetry(&t, age);
+    return 0;
+  }
+  if (t.pid)
+    printf("writer pid=%d updated %.1fs ago", (int)t.pid, age);
+  else
+    printf("writer STOPPED %.1fs ago", age);
+  printf(" polls=%llu relocks=%llu bursts=%llu last_rc=%d\n",
+         (unsigned long long)t.polls, (unsigned long long)t.pulses,
+         (unsigned long long)t.bursts, (int)t.last_rc);
+
+  for (unsigned ch = 0; ch < CM_TELEM_NUM_DPLLS; ch++) {
+    const cm_telem_chan_t *c = &t.ch[ch];
+    printf("DPLL%u %-8s input=%u phase=%.12e wr_freq=%.6fppb", ch,
+           dpll_state_str(c->state), (unsigned)c->ref_input, c->phase_sec,
+           c->wr_freq_ppb);
+    if (c->flags & (CM_TELEM_CH_FREQ | CM_TELEM_CH_GPS)) {
+      printf(" %s lock_changes=%u relocks=%u sticky_hist=0x%016llx",
+             (c->flags & CM_TELEM_CH_GPS) ? "gps" : "freq",
+             (unsigned)c->lock_changes, (unsigned)c->relocks,
+             (unsigned long long)c->sticky_hist);
+      if (c->flags & CM_TELEM_CH_GPS)
+        printf(" unlocked=%.0fs since_change=%.0fs", c->unlocked_sec,
+               c->since_change_sec);
+    }
+    if (c->flags & CM_TELEM_CH_COMBO)
+      printf(" combo=%s:%u", c->combo_en ? "on" : "off",
+             (unsigned)c->combo_src);
+    printf("\n");
+  }
 
-  /* Monitor/daemon helper commands */
-  int do_get_state = 0;
-  int do_get_statechg_sticky = 0;
-  int do_clear_statechg_sticky = 0;
-  int do_set_oper_state = 0;
-  int do_get_phase = 0;
+  printf("inputs:");
+  for (unsigned i = 0; i < CM_TELEM_NUM_INPUTS; i++)
+    printf(" %02X", (unsigned)t.in_mon[i]);
+  printf("\n");
+
+  for (unsigned i = 0; i < CM_TELEM_NUM_GUARDS; i++) {
+    const cm_telem_guard_t *g = &t.guard[i];
+    if (!g->name[0])
+      continue;
+    printf("guard %-12s %-7s %s %s\n", g->name,
+           g->state == CM_TELEM_GUARD_MISSING ? "MISSING" : g->state_text,
+           g->stamp, g->msg);
+  }
+  return 0;
+}
 
-  int do_out_phase_adj_get = 0;
-  int do_out_phase_adj_set = 0;
-  int do_wr_freq_get = 0;
-  int do_wr_freq_set_word = 0;
-  int do_wr_freq_set_ppb = 0;
+static volatile sig_atomic_t g_stop_requested = 0;
 
-  uint16_t addr = 0;
-  uint8_t wdata = 0;
-  const char *hex_path = NULL;
-  const char *tcs_path = NULL;
-  const char *prog_path = NULL;
+static void dpll_stop_signal(int sig) {
+  (void)sig;
+  g_stop_requested = 1;
+}
 
-  /* High-level command parameters */
-  uint8_t hl_input_idx = 0;
-  uint8_t hl_chan = 0;
-  uint8_t hl_input_for_chan = 0;
-  uint8_t hl_priority = 0;
-  double hl_freq_hz = 0;
-  double hl_out3_hz = 0.0; /* used for set-output-freq */
-  double hl_out4_hz = 0.0; /* used for set-output-freq */
-  int hl_enable_flag = 0;
+/* SIGINT/SIGTERM end the long-running commands (monitor, sample) cleanly. */
+static void dpll_install_stop_handler(void) {
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = dpll_stop_signal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+}
 
-  uint32_t hl_divider = 0;
-  uint8_t hl_master_chan = 0;
-  uint16_t hl_bw_value = 0;
-  uint8_t hl_bw_unit = 0;
-  uint16_t hl_psl_val = 0;
-  uint8_t hl_damp_val = 0;
+static void dpll_print_sampler_stats(const cm_sampler_t *s, uint64_t lost) {
+  cm_sampler_stats_t st;
+  cm_sampler_stats(s, &st);
+  fprintf(stderr,
+          "sampler: %llu ticks at %g Hz, %llu missed, %llu read errors, "
+          "%llu lost by consumer, max burst %.1f us\n",
+          (unsigned long long)st.ticks, s->cfg.rate_hz,
+          (unsigned long long)st.missed, (unsigned long long)st.errors,
+          (unsigned long long)lost, (double)st.max_burst_ns / 1e3);
+}
 
-  /* Monitor helper parameters */
-  uint8_t mon_chan = 0;
-  const char *mon_oper_state = NULL;
+static const char *dpll_stats_result(const cm_stats_point_t *p) {
+  if (p->mtie_ok == 0 || p->tdev_ok == 0)
+    return "FAIL";
+  if (p->mtie_ok == 1 || p->tdev_ok == 1)
+    return "PASS";
+  return NULL;
+}
 
-  /* One-shot debug helpers */
-  uint32_t hl_out_idx = 0;
-  int32_t hl_phase_adj = 0;
-  uint32_t hl_dpll_idx = 0;
-  int64_t hl_wr_word_s42 = 0;
-  double hl_wr_ppb = 0.0;
+/* Negative statistics mean "not available yet / no limit": null. */
+static void dpll_json_stat(cm_json_t *j, const char *key, double v) {
+  if (v < 0.0)
+    cm_json_null(j, key);
+  else
+    cm_json_double(j, key, v);
+}
 
-  /* Defaults */
-  char spidev_path[64];
-  snprintf(spidev_path, sizeof(spidev_path), "/dev/spidev7.0");
+/* final: the end-of-run report (the exit status follows its result) */
+static void dpll_json_stats_report(unsigned chan, const cm_stats_t *st,
+                                   const cm_stats_mask_t *mask,
+                                   const cm_stats_point_t *pts, size_t n,
+                                   int final) {
+  cm_json_t *j = dpll_json_begin();
+  cm_json_uint(j, "chan", chan);
+  cm_json_bool(j, "final", final);
+  cm_json_double(j, "duration_s", (double)st->k * st->tau0);
+  cm_json_uint(j, "samples", st->k);
+  cm_json_uint(j, "gaps", st->gaps);
+  cm_json_str(j, "mask", mask ? mask->desc : NULL);
+  cm_json_arr_begin(j, "points");
+  for (size_t i = 0; i < n; i++) {
+    const cm_stats_point_t *p = &pts[i];
+    cm_json_obj_begin(j, NULL);
+    cm_json_double(j, "tau_s", p->tau);
+    dpll_json_stat(j, "mtie_s", p->mtie);
+    dpll_json_stat(j, "mtie_limit_s", p->mtie_limit);
+    dpll_json_stat(j, "tdev_s", p->tdev);
+    dpll_json_stat(j, "tdev_limit_s", p->tdev_limit);
+    dpll_json_stat(j, "adev", p->adev);
+    cm_json_str(j, "result", dpll_stats_result(p));
+    cm_json_obj_end(j);
+  }
+  cm_json_arr_end(j);
+  dpll_json_end(j);
+}
 
-  uint32_t hz = 1000000; /* 1 MHz */
-  int mode = 0;          /* SPI_MODE_0 */
+static void dpll_print_stats_report(unsigned chan, const cm_stats_t *st,
+                                    const cm_stats_mask_t *mask,
+                                    unsigned *fails_out) {
+  cm_stats_point_t pts[CM_STATS_MAX_TAUS];
+  unsigned fails = 0;
+  size_t n = cm_stats_report(st, mask, pts, CM_STATS_MAX_TAUS, &fails);
+
+  if (g_json) {
+    dpll_json_stats_report(chan, st, mask, pts, n, fails_out != NULL);
+    if (fails_out)
+      *fails_out = fails;
+    return;
+  }
 
-  /* Optional bus/cs mapping -> /dev/spidev<busnum>.<csnum> */
+  printf("# DPLL%u: %.1f s, %llu samples, %llu gaps, mask %s\n", chan,
+         (double)st->k * st->tau0, (unsigned long long)st->k,
+         (unsigned long long)st->gaps, mask ? mask->desc : "(none)");
+  printf("# %10s %10s %10s %10s %10s %11s  %s\n", "tau_s", "MTIE_ns",
+         "limit_ns", "TDEV_ns", "limit_ns", "ADEV", "result");
+  for (size_t i = 0; i < n; i++) {
+    const cm_stats_point_t *p = &pts[i];
+    const char *res = dpll_stats_result(p);
+    if (!res)
+      res = "-";
+    if (p->mtie < 0.0) {
+      printf("  %10g %10s %10s %10s %10s %11s  %s\n", p->tau, "-", "-", "-",
+             "-", "-", "(collecting)");
+      continue;
+    }
+    printf("  %10g %10.3f ", p->tau, p->mtie * 1e9);
+    if (p->mtie_limit >= 0.0)
+      printf("%10.3f ", p->mtie_limit * 1e9);
+    else
+      printf("%10s ", "-");
+    if (p->tdev >= 0.0)
+      printf("%10.3f ", p->tdev * 1e9);
+    else
+      printf("%10s ", "-");
+    if (p->tdev_limit >= 0.0)
+      printf("%10.3f ", p->tdev_limit * 1e9);
+    else
+      printf("%10s ", "-");
+    if (p->adev >= 0.0)
+      printf("%11.3e  %s\n", p->adev, res);
+    else
+      printf("%11s  %s\n", "-", res);
+  }
+  fflush(stdout);
+  if (fails_out)
+    *fails_out = fails;
+}
+
+/*
+ * MTIE / TDEV / ADEV of one DPLL's phase, computed on the device from the
+ * sampler stream and checked against an ITU-T mask. Prints a table every
+ * report_sec and at the end; returns 1 if the final table has mask failures.
+ */
+static int dpll_cmd_stats(unsigned chan, double rate_hz, double tau_max,
+                          double duration, double report_sec,
+                          const cm_stats_mask_t *mask) {
+  static cm_sampler_t sampler;
+  static cm_stats_t st;
+  if (cm_stats_init(&st, 1.0 / rate_hz, tau_max) != 0) {
+    fprintf(stderr, "stats: bad --rate / --tau-max\n");
+    return -1;
+  }
+
+  cm_sampler_cfg_t scfg;
+  memset(&scfg, 0, sizeof(scfg));
+  scfg.chan_mask = 1u << chan;
+  scfg.rate_hz = rate_hz;
+  int rc = cm_sampler_start(&sampler, &g_cm_bus, &scfg);
+  if (rc != 0) {
+    fprintf(stderr, "stats: sampler start failed (rc=%d)\n", rc);
+    cm_stats_free(&st);
+    return rc;
+  }
+  dpll_install_stop_handler();
+
+  cm_phase_cursor_t cur;
+  cm_phase_cursor_init(&sampler.ring, &cur, 0);
+  uint64_t next_tick = UINT64_MAX;
+  const uint64_t end_samples = (uint64_t)(duration * rate_hz + 0.5);
+  const uint64_t report_samples = (uint64_t)(report_sec * rate_hz + 0.5);
+  uint64_t next_report = report_samples ? report_samples : 1;
+
+  while (!g_stop_requested && (duration <= 0.0 || st.k < end_samples)) {
+    cm_phase_sample_t rec;
+    if (!cm_phase_ring_pop(&sampler.ring, &cur, &rec)) {
+      struct timespec ts = {0, 20 * 1000 * 1000};
+      nanosleep(&ts, NULL);
+      continue;
+    }
+    if (rec.rc != 0) {
+      next_tick = UINT64_MAX; /* read error: next sample starts a segment */
+      continue;
+    }
+    /* missed or lost ticks break the uniform sampling the statistics need */
+    if (next_tick != UINT64_MAX && rec.tick != next_tick && st.k > 0)
+      cm_stats_gap(&st);
+    next_tick = rec.tick + 1;
+    cm_stats_add(&st, cm_phase_s36_to_seconds(rec.phase_s36[chan]));
+
+    if (st.k >= next_report) {
+      dpll_print_stats_report(chan, &st, mask, NULL);
+      next_report += report_samples;
+    }
+  }
+
+  cm_sampler_stop(&sampler);
+  unsigned fails = 0;
+  dpll_print_stats_report(chan, &st, mask, &fails);
+  dpll_print_sampler_stats(&sampler, cur.lost);
+  cm_stats_free(&st);
+  return fails ? 1 : 0;
+}
+
+/*
+ * Lock monitor / relocker daemon (replaces fastlock_1pps_fix.sh).
+ * phase_rate_hz > 0 feeds the phase check from a sampler thread on the GPS
+ * channels; the monitor and the sampler then share the bus through a lock.
+ * metrics_port > 0 serves OpenMetrics on metrics_bind:metrics_port, with the
+ * SPI counters when cm_enable_spi_stats ran (they sit below the lock, so only
+ * transfer time is measured).
+ */
+static int dpll_cmd_monitor(cm_mon_cfg_t *cfg, double phase_rate_hz,
+                            const char *metrics_bind, unsigned metrics_port) {
+  static cm_mon_t mon;
+  static cm_sampler_t sampler;
+  static cm_metrics_t metrics;
+  cm_bus_lock_t lock;
+  cm_bus_t bus = g_cm_bus;
+  int rc;
+
+  if (metrics_port > 0) {
+    if (cm_metrics_start(&metrics, metrics_bind, metrics_port,
+                         g_spi_stats_on ? &g_bus_stat : NULL,
+                         g_spi_stats_on ? &g_xfer_stat : NULL) != 0) {
+      fprintf(stderr, "monitor: cannot serve metrics on %s:%u\n", metrics_bind,
+              metrics_port);
+      return -1;
+    }
+    cfg->status_flags |= CM_STATUS_PHASE;
+    cfg->on_poll = cm_metrics_on_poll;
+    cfg->on_poll_user = &metrics;
+  }
+
+  if (phase_rate_hz > 0.0) {
+    cm_sampler_cfg_t scfg;
+    memset(&scfg, 0, sizeof(scfg));
+    scfg.rate_hz = phase_rate_hz;
+    for (size_t i = 0; i < cfg->ngps; i++)
+      scfg.chan_mask |= 1u << cfg->gps_chans[i];
+
+    if (cm_bus_init_locked(&bus, &lock, &g_cm_bus) != 0) {
+      cm_metrics_stop(&metrics);
+      return -1;
+    }
+    rc = cm_sampler_start(&sampler, &bus, &scfg);
+    if (rc != 0) {
+      fprintf(stderr, "monitor: phase sampler start failed (rc=%d)\n", rc);
+      cm_bus_lock_destroy(&lock);
+      cm_metrics_stop(&metrics);
+      return rc;
+    }
+    cfg->phase_ring = &sampler.ring;
+  }
+
+  rc = cm_mon_init(&mon, &bus, cfg);
+  if (rc != 0) {
+    fprintf(stderr, "monitor: init failed (rc=%d)\n", rc);
+  } else {
+    dpll_install_stop_handler();
+    rc = cm_mon_run(&mon, &g_stop_requested);
+  }
+
+  if (phase_rate_hz > 0.0) {
+    cm_sampler_stop(&sampler);
+    dpll_print_sampler_stats(&sampler, mon.phase_cur.lost);
+    cm_bus_lock_destroy(&lock);
+  }
+  cm_metrics_stop(&metrics);
+  return rc;
+}
+
+/*
+ * Stream DPLL phase at a fixed rate: one line per sampler tick,
+ * "<CLOCK_MONOTONIC_RAW s> <tick> <phase s per channel...>". count == 0 runs
+ * until SIGINT/SIGTERM.
+ */
+static int dpll_cmd_sample(unsigned chan_mask, double rate_hz,
+                           uint64_t count) {
+  static cm_sampler_t sampler;
+  cm_sampler_cfg_t scfg;
+  memset(&scfg, 0, sizeof(scfg));
+  scfg.chan_mask = chan_mask;
+  scfg.rate_hz = rate_hz;
+
+  /* The main thread stays off the bus, so no lock is needed. */
+  int rc = cm_sampler_start(&sampler, &g_cm_bus, &scfg);
+  if (rc != 0) {
+    fprintf(stderr, "sample: sampler start failed (rc=%d)\n", rc);
+    return rc;
+  }
+  dpll_install_stop_handler();
+
+  if (!g_json) {
+    printf("# t_raw_s tick");
+    for (unsigned ch = 0; ch < CM_SAMPLER_MAX_CHANS; ch++)
+      if (chan_mask & (1u << ch))
+        printf(" DPLL%u", ch);
+    printf("\n");
+  }
+
+  cm_phase_cursor_t cur;
+  cm_phase_cursor_init(&sampler.ring, &cur, 0);
+  uint64_t n = 0;
+  while (!g_stop_requested && (count == 0 || n < count)) {
+    cm_phase_sample_t rec;
+    if (!cm_phase_ring_pop(&sampler.ring, &cur, &rec)) {
+      struct timespec ts = {0, 5 * 1000 * 1000};
+      nanosleep(&ts, NULL);
+      continue;
+    }
+    n++;
+    if (g_json) {
+      cm_json_t *j = dpll_json_open(rec.rc == 0);
+      if (rec.rc != 0)
+        cm_json_int(j, "rc", rec.rc);
+      cm_json_double(j, "t_raw_s", (double)rec.t_ns * 1e-9);
+      cm_json_uint(j, "tick", rec.tick);
+      if (rec.rc == 0) {
+        cm_json_arr_begin(j, "dplls");
+        for (unsigned ch = 0; ch < CM_SAMPLER_MAX_CHANS; ch++) {
+          if (!(rec.chan_mask & (1u << ch)))
+            continue;
+          cm_json_obj_begin(j, NULL);
+          cm_json_uint(j, "chan", ch);
+          cm_json_double(j, "phase_sec",
+                         cm_phase_s36_to_seconds(rec.phase_s36[ch]));
+          cm_json_obj_end(j);
+        }
+        cm_json_arr_end(j);
+      }
+      dpll_json_end(j);
+      continue;
+    }
+    if (rec.rc != 0) {
+      printf("# tick %llu read failed (rc=%d)\n", (unsigned long long)rec.tick,
+             (int)rec.rc);
+      continue;
+    }
+    printf("%llu.%09llu %llu", (unsigned long long)(rec.t_ns / 1000000000ull),
+           (unsigned long long)(rec.t_ns % 1000000000ull),
+           (unsigned long long)rec.tick);
+    for (unsigned ch = 0; ch < CM_SAMPLER_MAX_CHANS; ch++)
+      if (rec.chan_mask & (1u << ch))
+        printf(" %.12e", cm_phase_s36_to_seconds(rec.phase_s36[ch]));
+    printf("\n");
+  }
+  fflush(stdout);
+
+  cm_sampler_stop(&sampler);
+  dpll_print_sampler_stats(&sampler, cur.lost);
+  return 0;
+}
+
+static void dpll_json_snapshot_info(cm_json_t *j, const cm_snapshot_t *s) {
+  size_t bytes = 0;
+  for (size_t i = 0; i < s->nspans; i++)
+    bytes += s->spans[i].len;
+  cm_json_uint(j, "timestamp_ns", s->timestamp_ns);
+  cm_json_uint(j, "device_id", s->device_id);
+  cm_json_uint(j, "product_id", s->product_id);
+  cm_json_uint(j, "table_version", s->table_version);
+  cm_json_uint(j, "spans", s->nspans);
+  cm_json_uint(j, "bytes", bytes);
+}
+
+/* printfn for cm_snapshot_diff() when only the count is wanted */
+static int dpll_printf_none(const char *fmt, ...) {
+  (void)fmt;
+  return 0;
+}
+
+/* snapshot-diff --json: the decoder's register count plus every byte that
+ * both snapshots cover and that differs (unmapped gap bytes included). */
+static int dpll_json_snapshot_diff(const cm_snapshot_t *a,
+                                   const cm_snapshot_t *b) {
+  int ndiff = cm_snapshot_diff(a, b, dpll_printf_none);
+  if (ndiff < 0)
+    return ndiff;
+  cm_json_t *j = dpll_json_begin();
+  cm_json_obj_begin(j, "a");
+  dpll_json_snapshot_info(j, a);
+  cm_json_obj_end(j);
+  cm_json_obj_begin(j, "b");
+  dpll_json_snapshot_info(j, b);
+  cm_json_obj_end(j);
+  cm_json_int(j, "registers", ndiff);
+  cm_json_arr_begin(j, "diffs");
+  for (size_t i = 0; i < a->nspans; i++) {
+    const cm_snapshot_span_t *sp = &a->spans[i];
+    for (size_t k = 0; k < sp->len; k++) {
+      const uint16_t addr = (uint16_t)(sp->addr + k);
+      uint8_t vb;
+      if (cm_snapshot_get(b, addr, &vb) != 0 || vb == sp->data[k])
+        continue;
+      cm_json_obj_begin(j, NULL);
+      cm_json_uint(j, "addr", addr);
+      cm_json_uint(j, "a", sp->data[k]);
+      cm_json_uint(j, "b", vb);
+      cm_json_obj_end(j);
+    }
+  }
+  cm_json_arr_end(j);
+  dpll_json_end(j);
+  return 0;
+}
+
+static int dpll_cmd_snapshot(const char *path) {
+  cm_snapshot_t snap;
+  int rc = cm_snapshot_capture(&g_cm_bus, &snap);
+  if (rc != 0) {
+    fprintf(stderr, "snapshot capture failed (rc=%d)\n", rc);
+    return rc;
+  }
+  rc = cm_snapshot_save(&snap, path);
+  if (rc == 0 && g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_str(j, "path", path);
+    dpll_json_snapshot_info(j, &snap);
+    dpll_json_end(j);
+  } else if (rc == 0) {
+    cm_snapshot_print_header(&snap, path, printf);
+  }
+  cm_snapshot_free(&snap);
+  return rc;
+}
+
+static int dpll_cmd_snapshot_diff(const char *path_a, const char *path_b) {
+  cm_snapshot_t a, b;
+  if (cm_snapshot_load(&a, path_a) != 0) {
+    return -1;
+  }
+  if (cm_snapshot_load(&b, path_b) != 0) {
+    cm_snapshot_free(&a);
+    return -1;
+  }
+
+  if (g_json) {
+    int jrc = dpll_json_snapshot_diff(&a, &b);
+    cm_snapshot_free(&a);
+    cm_snapshot_free(&b);
+    return jrc;
+  }
+
+  cm_snapshot_print_header(&a, "a", printf);
+  cm_snapshot_print_header(&b, "b", printf);
+  int ndiff = cm_snapshot_diff(&a, &b, printf);
+  if (ndiff >= 0) {
+    printf("%d register(s) differ\n", ndiff);
+  }
+
+  cm_snapshot_free(&a);
+  cm_snapshot_free(&b);
+  return (ndiff < 0) ? ndiff : 0;
+}
+
+/* An exact frequency as its fraction string and as a double */
+static void dpll_json_freq(cm_json_t *j, const char *key, const char *key_hz,
+                           cm_freq_t f) {
+  char sf[48];
+  cm_json_str(j, key, cm_freq_str(f, sf, sizeof(sf)));
+  cm_json_double(j, key_hz, cm_freq_to_double(f));
+}
+
+static void dpll_json_plan_explain(cm_json_t *j,
+                                   const dpll_plan_info_t *info) {
+  cm_json_obj_begin(j, "cache");
+  cm_json_str(j, "path", g_plancache_path);
+  cm_json_bool(j, "used", info->cache_used);
+  cm_json_bool(j, "hit", info->hit);
+  cm_json_uint(j, "planner_version", CM_FP_PLANNER_VERSION);
+  cm_json_double(j, "search_us", info->search_us);
+  cm_json_double(j, "lookup_us", info->lookup_us);
+  cm_json_obj_end(j);
+}
+
+static void dpll_json_plan(int output_pair, double in_hz, uint64_t M,
+                           uint16_t N_reg, const cm_fp_plan_t *plan,
+                           const cm_freq_t out[2],
+                           const dpll_plan_info_t *info) {
+  cm_json_t *j = dpll_json_begin();
+  if (!output_pair) {
+    double actual = dpll_input_freq_from_ratio(M, N_reg);
+    cm_json_str(j, "kind", "input");
+    cm_json_double(j, "target_hz", in_hz);
+    cm_json_uint(j, "m", M);
+    cm_json_uint(j, "n_reg", N_reg);
+    cm_json_double(j, "actual_hz", actual);
+    cm_json_double(j, "err_ppb", (actual - in_hz) / in_hz * 1e9);
+    cm_json_bool(j, "exact", actual == in_hz);
+  } else {
+    cm_json_str(j, "kind", "output");
+    cm_json_uint(j, "m", plan->m);
+    cm_json_uint(j, "n_reg", plan->n_reg);
+    dpll_json_freq(j, "dco", "dco_hz", plan->dco);
+    cm_json_bool(j, "exact", plan->exact);
+    cm_json_arr_begin(j, "outputs");
+    for (int i = 0; i < 2; i++) {
+      cm_json_obj_begin(j, NULL);
+      cm_json_uint(j, "output", 3 + i);
+      dpll_json_freq(j, "target", "target_hz", out[i]);
+      cm_json_uint(j, "div", plan->div[i]);
+      dpll_json_freq(j, "actual", "actual_hz", plan->actual[i]);
+      cm_json_double(j, "err_ppb", plan->err_ppb[i]);
+      cm_json_obj_end(j);
+    }
+    cm_json_arr_end(j);
+  }
+  if (info)
+    dpll_json_plan_explain(j, info);
+  dpll_json_end(j);
+}
+
+/* Print the plan set-input-freq / set-output-freq would program. */
+static int dpll_cmd_plan(int output_pair, double in_hz,
+                         const cm_freq_t out[2], int explain) {
+  dpll_plan_info_t info;
+  int rc;
+
+  if (!output_pair) {
+    uint64_t M = 0;
+    uint16_t N_reg = 0;
+    rc = dpll_plan_input_ratio(in_hz, &M, &N_reg, &info);
+    if (rc != 0) {
+      fprintf(stderr, "input plan failed for %.6f Hz (rc=%d)\n", in_hz, rc);
+      return rc;
+    }
+    if (g_json) {
+      dpll_json_plan(0, in_hz, M, N_reg, NULL, out, explain ? &info : NULL);
+      return 0;
+    }
+    double actual = dpll_input_freq_from_ratio(M, N_reg);
+    printf("input %.9g Hz: M=%llu N_reg=%u actual=%.9f Hz error=%+.6g ppb\n",
+           in_hz, (unsigned long long)M, (unsigned)N_reg, actual,
+           (actual - in_hz) / in_hz * 1e9);
+  } else {
+    cm_fp_plan_t plan;
+    rc = dpll_plan_output_pair(out, &plan, &info);
+    if (rc != 0) {
+      fprintf(stderr, "output plan failed (rc=%d)\n", rc);
+      return rc;
+    }
+    if (g_json) {
+      dpll_json_plan(1, in_hz, 0, 0, &plan, out, explain ? &info : NULL);
+      return 0;
+    }
+    char sd[48];
+    printf("DCO: M=%llu N_reg=%u F_dco=%s Hz%s\n", (unsigned long long)plan.m,
+           (unsigned)plan.n_reg, cm_freq_str(plan.dco, sd, sizeof(sd)),
+           plan.exact ? " (exact)" : "");
+    for (int i = 0; i < 2; i++) {
+      char st[48], sa[48];
+      printf("  OUT%d: target=%s divider=%u actual=%s Hz error=%+.6g ppb\n",
+             3 + i, cm_freq_str(out[i], st, sizeof(st)), plan.div[i],
+             cm_freq_str(plan.actual[i], sa, sizeof(sa)), plan.err_ppb[i]);
+    }
+  }
+
+  if (explain) {
+    dpll_plan_explain(&info);
+  }
+  return 0;
+}
+
+/* Parse "Q10=156.25e6" (or "10=156.25e6") into a planner request. */
+static int parse_output_request(const char *s, cm_fp_request_t *out) {
+  if (!s || !out)
+    return -1;
+  if (*s == 'Q' || *s == 'q')
+    s++;
+  char *end = NULL;
+  unsigned long q = strtoul(s, &end, 10);
+  if (end == s || *end != '=' || q >= CM_FP_NUM_OUTPUTS)
+    return -1;
+  out->output = (unsigned)q;
+  return cm_freq_parse(end + 1, &out->freq);
+}
+
+static int dpll_cmd_plan_outputs(const cm_fp_request_t *req, size_t nreq,
+                                 const cm_fp_topology_t *topo,
+                                 cm_fp_mode_t mode, unsigned budget_ms) {
+  cm_fp_multi_plan_t plan;
+  int rc = cm_fp_plan_outputs(req, nreq, topo, mode, budget_ms, &plan);
+  if (rc != 0) {
+    fprintf(stderr, "cm_fp_plan_outputs failed (rc=%d)%s\n", rc,
+            (rc == -1) ? ": duplicate output or output not routable" : "");
+    return rc;
+  }
+
+  if (g_json) {
+    cm_json_t *j = dpll_json_begin();
+    cm_json_uint(j, "nreq", plan.nreq);
+    cm_json_uint(j, "nfods", plan.nfods);
+    cm_json_bool(j, "exact", plan.exact);
+    cm_json_bool(j, "optimal", plan.optimal);
+    cm_json_double(j, "total_err_ppb", plan.total_err_ppb);
+    cm_json_arr_begin(j, "fods");
+    for (int f = 0; f < CM_FP_NUM_FODS; f++) {
+      const cm_fp_plan_t *fp = &plan.fod[f];
+      if (!fp->nout)
+        continue;
+      cm_json_obj_begin(j, NULL);
+      cm_json_uint(j, "fod", (unsigned)f);
+      cm_json_uint(j, "m", fp->m);
+      cm_json_uint(j, "n_reg", fp->n_reg);
+      dpll_json_freq(j, "dco", "dco_hz", fp->dco);
+      cm_json_bool(j, "fixed", topo->fixed_dco[f].num != 0);
+      cm_json_obj_end(j);
+    }
+    cm_json_arr_end(j);
+    cm_json_arr_begin(j, "outputs");
+    for (size_t i = 0; i < plan.nreq; i++) {
+      const cm_fp_output_plan_t *o = &plan.out[i];
+      cm_json_obj_begin(j, NULL);
+      cm_json_uint(j, "output", req[i].output);
+      cm_json_int(j, "fod", o->fod);
+      dpll_json_freq(j, "target", "target_hz", req[i].freq);
+      cm_json_uint(j, "div", o->div);
+      dpll_json_freq(j, "actual", "actual_hz", o->actual);
+      cm_json_double(j, "err_ppb", o->err_ppb);
+      cm_json_obj_end(j);
+    }
+    cm_json_arr_end(j);
+    dpll_json_end(j);
+    return 0;
+  }
+
+  printf("%zu output(s) on %u FOD(s), %s, total error %.6g ppb (%s)\n",
+         plan.nreq, plan.nfods, plan.exact ? "exact" : "not exact",
+         plan.total_err_ppb,
+         plan.optimal ? "exact search" : "heuristic search");
+
+  for (int f = 0; f < CM_FP_NUM_FODS; f++) {
+    const cm_fp_plan_t *fp = &plan.fod[f];
+    if (!fp->nout)
+      continue;
+    char sd[48];
+    printf("FOD%d: M=%llu N_reg=%u DCO=%s Hz (%.6f MHz)%s\n", f,
+           (unsigned long long)fp->m, (unsigned)fp->n_reg,
+           cm_freq_str(fp->dco, sd, sizeof(sd)), cm_freq_to_double(fp->dco) / 1e6,
+           topo->fixed_dco[f].num ? " fixed" : "");
+    for (size_t i = 0; i < plan.nreq; i++) {
+      const cm_fp_output_plan_t *o = &plan.out[i];
+      if (o->fod != f)
+        continue;
+      char st[48], sa[48];
+      printf("  Q%u: target=%s div=%u actual=%s Hz error=%+.6g ppb\n",
+             req[i].output, cm_freq_str(req[i].freq, st, sizeof(st)), o->div,
+             cm_freq_str(o->actual, sa, sizeof(sa)), o->err_ppb);
+    }
+  }
+  return 0;
+}
+
+/* Parse one plan-batch line: "input <freq>" or "output <freq> [<freq> ...]".
+ * Returns 1 for a request, 0 for a blank/comment line, -1 on syntax error. */
+static int parse_batch_line(char *line, cm_fp_batch_req_t *r) {
+  char *save = NULL;
+  char *tok = strtok_r(line, " \t\r\n", &save);
+  if (!tok || tok[0] == '#')
+    return 0;
+
+  memset(r, 0, sizeof(*r));
+  if (!strcmp(tok, "input"))
+    r->kind = CM_FP_BATCH_INPUT;
+  else if (!strcmp(tok, "output"))
+    r->kind = CM_FP_BATCH_DCO;
+  else
+    return -1;
+
+  while ((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+    if (r->nfreq == CM_FP_MAX_OUTPUTS ||
+        cm_freq_parse(tok, &r->freq[r->nfreq]) != 0)
+      return -1;
+    r->nfreq++;
+  }
+  if (r->nfreq == 0 || (r->kind == CM_FP_BATCH_INPUT && r->nfreq != 1))
+    return -1;
+  return 1;
+}
+
+/* Plan every request in `path` ("-" = stdin) with one cm_fp_plan_batch()
+ * call and print one result line per request, in order, on stdout:
+ *   ok exact=<0|1> m=<M> n_reg=<N_reg> div=<d>,... actual=<f>,... ppb=<e>,...
+ *   fail rc=<rc>
+ * (--json: one object per request instead). Nothing is printed on stderr
+ * unless the file cannot be read. */
+static int dpll_cmd_plan_batch(const char *path) {
+  FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+  if (!f) {
+    perror(path);
+    return -1;
+  }
+
+  cm_fp_batch_req_t *req = NULL;
+  int *bad = NULL;
+  size_t n = 0, cap = 0;
+  char *line = NULL;
+  size_t line_cap = 0;
+  int rc = 0;
+
+  while (getline(&line, &line_cap, f) >= 0) {
+    if (n == cap) {
+      size_t ncap = cap ? cap * 2 : 64;
+      cm_fp_batch_req_t *nreq = realloc(req, ncap * sizeof(*req));
+      int *nbad = nreq ? realloc(bad, ncap * sizeof(*bad)) : NULL;
+      if (nreq)
+        req = nreq;
+      if (!nreq || !nbad) {
+        rc = -1;
+        break;
+      }
+      bad = nbad;
+      cap = ncap;
+    }
+    int prc = parse_batch_line(line, &req[n]);
+    if (prc == 0)
+      continue;
+    bad[n] = (prc < 0);
+    if (bad[n]) {
+      /* Keep the line's slot so results stay aligned with the input. */
+      memset(&req[n], 0, sizeof(req[n]));
+      req[n].kind = CM_FP_BATCH_INPUT;
+    }
+    n++;
+  }
+  free(line);
+  if (f != stdin)
+    fclose(f);
+
+  cm_fp_batch_res_t *res = (rc == 0 && n) ? malloc(n * sizeof(*res)) : NULL;
+  if (rc == 0 && n && (!res || cm_fp_plan_batch(req, n, NULL, res) < 0))
+    rc = -1;
+
+  for (size_t i = 0; rc == 0 && g_json && i < n; i++) {
+    const int prc = bad[i] ? -1 : res[i].rc;
+    cm_json_t *j = dpll_json_open(prc == 0);
+    cm_json_uint(j, "index", i);
+    if (prc != 0) {
+      cm_json_int(j, "rc", prc);
+      if (bad[i])
+        cm_json_str(j, "error", "syntax");
+      dpll_json_end(j);
+      continue;
+    }
+    const cm_fp_plan_t *pl = &res[i].plan;
+    char sa[48];
+    cm_json_bool(j, "exact", pl->exact);
+    cm_json_uint(j, "m", pl->m);
+    cm_json_uint(j, "n_reg", pl->n_reg);
+    cm_json_arr_begin(j, "div");
+    for (size_t k = 0; k < pl->nout; k++)
+      cm_json_uint(j, NULL, pl->div[k]);
+    cm_json_arr_end(j);
+    cm_json_arr_begin(j, "actual");
+    for (size_t k = 0; k < pl->nout; k++)
+      cm_json_str(j, NULL, cm_freq_str(pl->actual[k], sa, sizeof(sa)));
+    cm_json_arr_end(j);
+    cm_json_arr_begin(j, "err_ppb");
+    for (size_t k = 0; k < pl->nout; k++)
+      cm_json_double(j, NULL, pl->err_ppb[k]);
+    cm_json_arr_end(j);
+    dpll_json_end(j);
+  }
+
+  for (size_t i = 0; rc == 0 && !g_json && i < n; i++) {
+    if (bad[i]) {
+      printf("fail rc=-1 syntax\n");
+      continue;
+    }
+    if (res[i].rc != 0) {
+      printf("fail rc=%d\n", res[i].rc);
+      continue;
+    }
+    const cm_fp_plan_t *pl = &res[i].plan;
+    char sa[48];
+    printf("ok exact=%d m=%llu n_reg=%u div=", pl->exact,
+           (unsigned long long)pl->m, (unsigned)pl->n_reg);
+    for (size_t k = 0; k < pl->nout; k++)
+      printf("%s%u", k ? "," : "", pl->div[k]);
+    printf(" actual=");
+    for (size_t k = 0; k < pl->nout; k++)
+      printf("%s%s", k ? "," : "", cm_freq_str(pl->actual[k], sa, sizeof(sa)));
+    printf(" ppb=");
+    for (size_t k = 0; k < pl->nout; k++)
+      printf("%s%.9g", k ? "," : "", pl->err_ppb[k]);
+    printf("\n");
+  }
+  if (rc != 0)
+    fprintf(stderr, "plan-batch: out of memory\n");
+
+  free(res);
+  free(req);
+  free(bad);
+  return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* --batch: many commands over one spidev handle                              */
+/* -------------------------------------------------------------------------- */
+
+#define DPLL_BATCH_MAX_ARGS 64
+
+typedef struct {
+  int active;      /* dpll_run is executing a batch line */
+  int check_only;  /* validation pass: dpll_run stops before any I/O */
+  int transaction; /* --transaction: table-bus writes are journaled */
+  int spi_fd;      /* opened by the first line that needs SPI, else -1 */
+  int spi_stats;   /* --spi-stats was given: report once at the end */
+} dpll_batch_t;
+
+static dpll_batch_t g_batch = {0, 0, 0, -1, 0};
+
+/* End of an SPI session: plan cache, shadow/SPI reports, spidev handle.
+ * Runs after each command, or once after the last line of a batch. */
+static void dpll_session_close(int spi_fd, int spi_stats) {
+  dpll_plancache_close();
+
+  if (g_journal_on) {
+    cm_journal_free(&g_journal);
+    g_journal_on = 0;
+  }
+  if (g_shadow_on) {
+    fprintf(stderr, "shadow cache: %llu hits, %llu misses\n",
+            (unsigned long long)g_shadow.hits,
+            (unsigned long long)g_shadow.misses);
+    cm_shadow_free(&g_shadow);
+    g_shadow_on = 0;
+  }
+  if (spi_stats) {
+    dpll_spi_set_xfer_hook(NULL, NULL);
+    dpll_print_spi_stats();
+  }
+
+  dpll_spi_close(spi_fd);
+}
+
+/* Run one command line (argv[0] is the program name). In a batch the first
+ * command that needs SPI opens the device with its connection options and
+ * later lines reuse that handle. */
+static int dpll_run_cmd(int argc, char **argv) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  int do_read = 0;
+  int do_write = 0;
+  int do_flash = 0;
+  int do_tcs_apply = 0;
+  int do_set_input_freq = 0;
+  int do_set_input_enable = 0;
+  int do_set_chan_input = 0;
+  int do_set_output_freq = 0;
+  int do_set_out2_dest = 0;
+  int do_prog_file = 0;
+
+  int do_set_output_divider = 0;
+  int do_set_combo_slave = 0;
+  int do_get_combo_slave = 0;
+  int do_set_loop_bw = 0;
+  int do_get_loop_bw = 0;
+  int do_set_psl = 0;
+  int do_get_psl = 0;
+  int do_set_damp_factor = 0;
+  int do_get_damp_factor = 0;
+
+  /* Monitor/daemon helper commands */
+  int do_get_state = 0;
+  int do_get_statechg_sticky = 0;
+  int do_clear_statechg_sticky = 0;
+  int do_set_oper_state = 0;
+  int do_get_phase = 0;
+  int do_monitor = 0;
+  int do_telemetry = 0;
+  const char *metrics_bind = "0.0.0.0";
+  unsigned metrics_port = 0; /* 0: no exporter */
+  const char *telemetry_path = CM_TELEM_PATH;
+  int do_status = 0;
+  int do_sample = 0;
+  unsigned sample_mask = 0;
+  double sample_rate_hz = 0.0; /* 0: per-command default */
+  uint64_t sample_count = 0;
+  int do_stats = 0;
+  uint8_t stats_chan = 0;
+  double stats_duration = 0.0;
+  double stats_report = 60.0;
+  double stats_tau_max = 1000.0;
+  const cm_stats_mask_t *stats_mask = NULL;
+  double mon_phase_rate_hz = 0.0;
+  int status_chan = -1; /* -1: --all */
+  cm_mon_cfg_t mon_cfg;
+  cm_mon_cfg_defaults(&mon_cfg);
+
+  int do_out_phase_adj_get = 0;
+  int do_out_phase_adj_set = 0;
+  int do_wr_freq_get = 0;
+  int do_wr_freq_set_word = 0;
+  int do_wr_freq_set_ppb = 0;
+
+  int do_snapshot = 0;
+  int do_snapshot_diff = 0;
+  int do_plan_outputs = 0;
+  int do_plan = 0;
+  int do_plan_batch = 0;
+
+  uint16_t addr = 0;
+  uint8_t wdata = 0;
+  const char *hex_path = NULL;
+  const char *tcs_path = NULL;
+  const char *prog_path = NULL;
+  const char *snap_path = NULL;
+  const char *snap_path_b = NULL;
+
+  /* Frequency planning */
+  cm_fp_request_t plan_req[CM_FP_NUM_OUTPUTS];
+  size_t plan_nreq = 0;
+  cm_fp_mode_t plan_mode = CM_FP_MODE_EXACT;
+  unsigned plan_budget_ms = 0;
+  const cm_fp_topology_t *plan_topo = &cm_fp_topology_switchberry;
+  int plan_output_pair = 0;
+  double plan_in_hz = 0.0;
+  cm_freq_t plan_out[2] = {{0, 1}, {0, 1}};
+  int plan_explain = 0;
+  const char *plan_batch_path = "-";
+
+  /* High-level command parameters */
+  uint8_t hl_input_idx = 0;
+  uint8_t hl_chan = 0;
+  uint8_t hl_input_for_chan = 0;
+  uint8_t hl_priority = 0;
+  double hl_freq_hz = 0;
+  cm_freq_t hl_out3 = {0, 1}; /* used for set-output-freq */
+  cm_freq_t hl_out4 = {0, 1}; /* used for set-output-freq */
+  int hl_enable_flag = 0;
+
+  uint32_t hl_divider = 0;
+  uint8_t hl_master_chan = 0;
+  uint16_t hl_bw_value = 0;
+  uint8_t hl_bw_unit = 0;
+  uint16_t hl_psl_val = 0;
+  uint8_t hl_damp_val = 0;
+
+  /* Monitor helper parameters */
+  uint8_t mon_chan = 0;
+  const char *mon_oper_state = NULL;
+
+  /* One-shot debug helpers */
+  uint32_t hl_out_idx = 0;
+  int32_t hl_phase_adj = 0;
+  uint32_t hl_dpll_idx = 0;
+  int64_t hl_wr_word_s42 = 0;
+  double hl_wr_ppb = 0.0;
+
+  /* Defaults */
+  char spidev_path[64];
+  snprintf(spidev_path, sizeof(spidev_path), "/dev/spidev7.0");
+
+  uint32_t hz = 1000000; /* 1 MHz */
+  int mode = 0;          /* SPI_MODE_0 */
+
+  /* Optional bus/cs mapping -> /dev/spidev<busnum>.<csnum> */
   unsigned int busnum = 7;
   unsigned int csnum = 0;
   int have_busnum = 0;
@@ -1088,6 +2579,8 @@ int main(int argc, char **argv) {
   int spidev_overridden = 0;
 
   int tcs_debug = 0;
+  int shadow_cache = 0;
+  int spi_stats = 0;
 
   /* Parse args */
   for (int i = 1; i < argc; i++) {
@@ -1186,6 +2679,139 @@ int main(int argc, char **argv) {
       mon_chan = (uint8_t)tmp;
       do_get_phase = 1;
 
+    } else if ((!strcmp(argv[i], "status") || !strcmp(argv[i], "--status")) &&
+               i + 1 < argc) {
+      uint32_t tmp;
+      if (!strcmp(argv[i + 1], "--all") || !strcmp(argv[i + 1], "all")) {
+        status_chan = -1;
+      } else if (parse_u32(argv[i + 1], &tmp) == 0 &&
+                 tmp < CM_STATUS_NUM_DPLLS) {
+        status_chan = (int)tmp;
+      } else {
+        fprintf(stderr, "Bad status <--all|chan>\n");
+        return 1;
+      }
+      i++;
+      do_status = 1;
+
+    } else if ((!strcmp(argv[i], "sample") || !strcmp(argv[i], "--sample")) &&
+               i + 1 < argc) {
+      unsigned chans[CM_SAMPLER_MAX_CHANS];
+      size_t nchans = 0;
+      if (cm_parse_u32_list(argv[++i], chans, CM_SAMPLER_MAX_CHANS, &nchans) !=
+          0) {
+        fprintf(stderr, "Bad sample <c[,c...]>\n");
+        return 1;
+      }
+      for (size_t k = 0; k < nchans; k++) {
+        if (chans[k] >= CM_SAMPLER_MAX_CHANS) {
+          fprintf(stderr, "Bad sample channel %u\n", chans[k]);
+          return 1;
+        }
+        sample_mask |= 1u << chans[k];
+      }
+      do_sample = 1;
+    } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+      if (parse_double(argv[++i], &sample_rate_hz) != 0 ||
+          !(sample_rate_hz >= CM_SAMPLER_MIN_HZ &&
+            sample_rate_hz <= CM_SAMPLER_MAX_HZ)) {
+        fprintf(stderr, "Bad --rate <hz> (%g..%g)\n", CM_SAMPLER_MIN_HZ,
+                CM_SAMPLER_MAX_HZ);
+        return 1;
+      }
+    } else if ((!strcmp(argv[i], "stats") || !strcmp(argv[i], "--stats")) &&
+               i + 1 < argc) {
+      uint32_t tmp;
+      if (parse_u32(argv[++i], &tmp) != 0 || tmp >= CM_SAMPLER_MAX_CHANS) {
+        fprintf(stderr, "Bad stats <chan>\n");
+        return 1;
+      }
+      stats_chan = (uint8_t)tmp;
+      do_stats = 1;
+    } else if (!strcmp(argv[i], "--duration") && i + 1 < argc) {
+      if (parse_double(argv[++i], &stats_duration) != 0 ||
+          stats_duration < 0.0) {
+        fprintf(stderr, "Bad --duration <seconds>\n");
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--report") && i + 1 < argc) {
+      if (parse_double(argv[++i], &stats_report) != 0 || !(stats_report > 0.0)) {
+        fprintf(stderr, "Bad --report <seconds>\n");
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--tau-max") && i + 1 < argc) {
+      if (parse_double(argv[++i], &stats_tau_max) != 0 ||
+          !(stats_tau_max > 0.0)) {
+        fprintf(stderr, "Bad --tau-max <seconds>\n");
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--mask") && i + 1 < argc) {
+      stats_mask = cm_stats_find_mask(argv[++i]);
+      if (!stats_mask) {
+        fprintf(stderr, "Unknown --mask %s (known:", argv[i]);
+        for (size_t k = 0; cm_stats_masks[k]; k++)
+          fprintf(stderr, " %s", cm_stats_masks[k]->name);
+        fprintf(stderr, ")\n");
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+      uint32_t tmp;
+      if (parse_u32(argv[++i], &tmp) != 0) {
+        fprintf(stderr, "Bad --count <n>\n");
+        return 1;
+      }
+      sample_count = tmp;
+    } else if (!strcmp(argv[i], "--phase-rate") && i + 1 < argc) {
+      if (parse_double(argv[++i], &mon_phase_rate_hz) != 0 ||
+          !(mon_phase_rate_hz >= CM_SAMPLER_MIN_HZ &&
+            mon_phase_rate_hz <= CM_SAMPLER_MAX_HZ)) {
+        fprintf(stderr, "Bad --phase-rate <hz> (%g..%g)\n", CM_SAMPLER_MIN_HZ,
+                CM_SAMPLER_MAX_HZ);
+        return 1;
+      }
+
+    } else if (!strcmp(argv[i], "monitor") || !strcmp(argv[i], "--monitor")) {
+      do_monitor = 1;
+    } else if (!strcmp(argv[i], "--status-file") && i + 1 < argc) {
+      mon_cfg.status_file = argv[++i];
+    } else if (!strcmp(argv[i], "--telemetry-file") && i + 1 < argc) {
+      telemetry_path = argv[++i];
+      mon_cfg.telemetry_path = telemetry_path;
+    } else if (!strcmp(argv[i], "--no-telemetry")) {
+      mon_cfg.telemetry_path = NULL;
+    } else if (!strcmp(argv[i], "--metrics-port") && i + 1 < argc) {
+      uint32_t tmp;
+      if (parse_u32(argv[++i], &tmp) != 0 || tmp == 0 || tmp > 65535) {
+        fprintf(stderr, "Bad --metrics-port <port>\n");
+        return 1;
+      }
+      metrics_port = tmp;
+    } else if (!strcmp(argv[i], "--metrics-bind") && i + 1 < argc) {
+      metrics_bind = argv[++i];
+    } else if (!strcmp(argv[i], "telemetry") ||
+               !strcmp(argv[i], "--telemetry")) {
+      do_telemetry = 1;
+    } else if (!strcmp(argv[i], "--poll-sec") && i + 1 < argc) {
+      if (parse_double(argv[++i], &mon_cfg.poll_sec) != 0 ||
+          !(mon_cfg.poll_sec > 0.0)) {
+        fprintf(stderr, "Bad --poll-sec <seconds>\n");
+        return 1;
+      }
+    } else if (!strcmp(argv[i], "--freq-ch") && i + 1 < argc) {
+      uint32_t tmp;
+      if (parse_u32(argv[++i], &tmp) != 0 || tmp >= CM_MON_MAX_CHANS) {
+        fprintf(stderr, "Bad --freq-ch <chan>\n");
+        return 1;
+      }
+      mon_cfg.freq_ch = tmp;
+    } else if (!strcmp(argv[i], "--gps-chans") && i + 1 < argc) {
+      if (cm_parse_u32_list(argv[++i], mon_cfg.gps_chans, CM_MON_MAX_CHANS,
+                            &mon_cfg.ngps) != 0 ||
+          mon_cfg.ngps == 0) {
+        fprintf(stderr, "Bad --gps-chans <c[,c...]>\n");
+        return 1;
+      }
+
       /* High-level commands (accept with or without leading --) --------- */
     } else if ((!strcmp(argv[i], "set-input-freq") ||
                 !strcmp(argv[i], "--set-input-freq")) &&
@@ -1265,23 +2891,17 @@ int main(int argc, char **argv) {
       // specific utility for switchberry, could be adapted later for more
       // generic
 
-      double f3 = 0.0;
-      double f4 = 0.0;
-
-      if (parse_double(argv[++i], &f3) != 0 || f3 <= 0.0) {
-        fprintf(stderr,
-                "Bad set-output-freq freq3_hz (must be > 0, can be float)\n");
+      if (cm_freq_parse(argv[++i], &hl_out3) != 0) {
+        fprintf(stderr, "Bad set-output-freq freq3_hz (must be > 0, decimal "
+                        "or num/den)\n");
         return 1;
       }
-      if (parse_double(argv[++i], &f4) != 0 || f4 <= 0.0) {
-        fprintf(stderr,
-                "Bad set-output-freq freq4_hz (must be > 0, can be float)\n");
+      if (cm_freq_parse(argv[++i], &hl_out4) != 0) {
+        fprintf(stderr, "Bad set-output-freq freq4_hz (must be > 0, decimal "
+                        "or num/den)\n");
         return 1;
       }
 
-      hl_out3_hz = f3;
-      hl_out4_hz = f4;
-
       do_set_output_freq = 1;
 
     } else if ((!strcmp(argv[i], "set-output-divider") ||
@@ -1487,6 +3107,81 @@ int main(int argc, char **argv) {
         return 1;
       }
       do_wr_freq_set_ppb = 1;
+
+    } else if ((!strcmp(argv[i], "snapshot") ||
+                !strcmp(argv[i], "--snapshot")) &&
+               i + 1 < argc) {
+      snap_path = argv[++i];
+      do_snapshot = 1;
+
+    } else if ((!strcmp(argv[i], "snapshot-diff") ||
+                !strcmp(argv[i], "--snapshot-diff")) &&
+               i + 2 < argc) {
+      snap_path = argv[++i];
+      snap_path_b = argv[++i];
+      do_snapshot_diff = 1;
+
+    } else if ((!strcmp(argv[i], "plan-outputs") ||
+                !strcmp(argv[i], "--plan-outputs")) &&
+               i + 1 < argc) {
+      while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+        if (plan_nreq == CM_FP_NUM_OUTPUTS ||
+            parse_output_request(argv[++i], &plan_req[plan_nreq]) != 0) {
+          fprintf(stderr, "Bad plan-outputs request '%s' (want Qn=freq_hz)\n",
+                  argv[i]);
+          return 1;
+        }
+        plan_nreq++;
+      }
+      if (plan_nreq == 0) {
+        fprintf(stderr, "plan-outputs needs at least one Qn=freq_hz\n");
+        return 1;
+      }
+      do_plan_outputs = 1;
+
+    } else if (!strcmp(argv[i], "plan-batch") ||
+               !strcmp(argv[i], "--plan-batch")) {
+      if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0)
+        plan_batch_path = argv[++i];
+      do_plan_batch = 1;
+
+    } else if ((!strcmp(argv[i], "plan") || !strcmp(argv[i], "--plan")) &&
+               i + 2 < argc && !strcmp(argv[i + 1], "input")) {
+      i++;
+      if (parse_double(argv[++i], &plan_in_hz) != 0 || plan_in_hz <= 0.0) {
+        fprintf(stderr, "Bad plan input <freq_hz>\n");
+        return 1;
+      }
+      do_plan = 1;
+
+    } else if ((!strcmp(argv[i], "plan") || !strcmp(argv[i], "--plan")) &&
+               i + 3 < argc && !strcmp(argv[i + 1], "output")) {
+      i++;
+      if (cm_freq_parse(argv[++i], &plan_out[0]) != 0 ||
+          cm_freq_parse(argv[++i], &plan_out[1]) != 0) {
+        fprintf(stderr, "Bad plan output <freq3_hz> <freq4_hz>\n");
+        return 1;
+      }
+      plan_output_pair = 1;
+      do_plan = 1;
+
+    } else if (!strcmp(argv[i], "--explain")) {
+      plan_explain = 1;
+    } else if (!strcmp(argv[i], "--plan-cache") && i + 1 < argc) {
+      g_plancache_path = argv[++i];
+    } else if (!strcmp(argv[i], "--no-plan-cache")) {
+      g_plancache_state = -1;
+    } else if (!strcmp(argv[i], "--plan-heuristic")) {
+      plan_mode = CM_FP_MODE_HEURISTIC;
+    } else if (!strcmp(argv[i], "--plan-any-fod")) {
+      plan_topo = &cm_fp_topology_any;
+    } else if (!strcmp(argv[i], "--plan-budget-ms") && i + 1 < argc) {
+      uint32_t ms = 0;
+      if (parse_u32(argv[++i], &ms) != 0) {
+        fprintf(stderr, "Bad --plan-budget-ms\n");
+        return 1;
+      }
+      plan_budget_ms = ms;
       /* Connection / debug options ------------------------------------- */
     } else if (!strcmp(argv[i], "--spidev") && i + 1 < argc) {
       const char *p = argv[++i];
@@ -1517,13 +3212,20 @@ int main(int argc, char **argv) {
 
     } else if (!strcmp(argv[i], "--tcs-debug")) {
       tcs_debug = 1;
+    } else if (!strcmp(argv[i], "--shadow-cache")) {
+      shadow_cache = 1;
+    } else if (!strcmp(argv[i], "--spi-stats")) {
+      spi_stats = 1;
+    } else if (!strcmp(argv[i], "--json")) {
+      g_json = 1;
       /* arg parsing */
     } else if (!strcmp(argv[i], "--prog-file") && i + 1 < argc) {
       prog_path = argv[++i];
       do_prog_file = 1;
     } else {
       fprintf(stderr, "Unknown/invalid arg: %s\n", argv[i]);
-      usage(argv[0]);
+      if (!g_batch.active)
+        usage(argv[0]);
       return 1;
     }
   }
@@ -1537,39 +3239,150 @@ int main(int argc, char **argv) {
       do_wr_freq_set_word + do_wr_freq_set_ppb + do_set_output_divider +
       do_set_combo_slave + do_get_combo_slave + do_set_loop_bw +
       do_get_loop_bw + do_set_psl + do_get_psl + do_set_damp_factor +
-      do_get_damp_factor;
+      do_get_damp_factor + do_snapshot + do_snapshot_diff + do_plan_outputs +
+      do_plan + do_plan_batch + do_monitor + do_status + do_sample + do_stats +
+      do_telemetry;
 
   if (action_count != 1) {
     fprintf(stderr, "Specify exactly one action: "
                     "--read, --write, --flash-hex, --tcs-apply,\n"
                     "  or monitor helpers get_state, get_statechg_sticky, "
-                    "clear_statechg_sticky, set_oper_state, get_phase,\n"
+                    "clear_statechg_sticky, set_oper_state, get_phase, "
+                    "monitor, status, sample, stats, telemetry,\n"
                     "  or one of the high-level commands "
                     "set-input-freq, set-input-enable, set-chan-input,\n"
-                    "  set-output-freq, set-output-divider, set-combo-slave\n");
-    usage(argv[0]);
+                    "  set-output-freq, set-output-divider, set-combo-slave,\n"
+                    "  snapshot, snapshot-diff, plan-outputs, plan, plan-batch\n");
+    if (!g_batch.active)
+      usage(argv[0]);
     return 1;
   }
 
+  /* Canonical action name for --json ("cmd") */
+  const struct {
+    int on;
+    const char *name;
+  } actions[] = {
+      {do_read, "read"},
+      {do_write, "write"},
+      {do_flash, "flash-hex"},
+      {do_tcs_apply, "tcs-apply"},
+      {do_prog_file, "prog-file"},
+      {do_get_state, "get-state"},
+      {do_get_statechg_sticky, "get-statechg-sticky"},
+      {do_clear_statechg_sticky, "clear-statechg-sticky"},
+      {do_set_oper_state, "set-oper-state"},
+      {do_get_phase, "get-phase"},
+      {do_monitor, "monitor"},
+      {do_telemetry, "telemetry"},
+      {do_status, "status"},
+      {do_sample, "sample"},
+      {do_stats, "stats"},
+      {do_set_input_freq, "set-input-freq"},
+      {do_set_input_enable, "set-input-enable"},
+      {do_set_chan_input, "set-chan-input"},
+      {do_set_output_freq, "set-output-freq"},
+      {do_set_out2_dest, "set-out2-dest"},
+      {do_set_output_divider, "set-output-divider"},
+      {do_set_combo_slave, "set-combo-slave"},
+      {do_get_combo_slave, "get-combo-slave"},
+      {do_set_loop_bw, "set-loop-bw"},
+      {do_get_loop_bw, "get-loop-bw"},
+      {do_set_psl, "set-psl"},
+      {do_get_psl, "get-psl"},
+      {do_set_damp_factor, "set-damp-factor"},
+      {do_get_damp_factor, "get-damp-factor"},
+      {do_out_phase_adj_get, "out-phase-adj-get"},
+      {do_out_phase_adj_set, "out-phase-adj-set"},
+      {do_wr_freq_get, "wr-freq-get"},
+      {do_wr_freq_set_word, "wr-freq-set-word"},
+      {do_wr_freq_set_ppb, "wr-freq-set-ppb"},
+      {do_snapshot, "snapshot"},
+      {do_snapshot_diff, "snapshot-diff"},
+      {do_plan_outputs, "plan-outputs"},
+      {do_plan, "plan"},
+      {do_plan_batch, "plan-batch"},
+  };
+  for (size_t k = 0; k < sizeof(actions) / sizeof(actions[0]); k++) {
+    if (actions[k].on)
+      g_json_cmd = actions[k].name;
+  }
+  mon_cfg.json_log = g_json;
+
+  if (g_batch.transaction &&
+      (do_write || do_flash || do_tcs_apply || do_prog_file || do_monitor)) {
+    fprintf(stderr, "--write, --flash-hex, --tcs-apply, --prog-file and "
+                    "monitor cannot be undone; not allowed with "
+                    "--transaction\n");
+    return 1;
+  }
+  if (g_batch.check_only) {
+    return 0;
+  }
+
+  /* Offline commands: no SPI access needed */
+  if (do_telemetry) {
+    return (dpll_cmd_telemetry(telemetry_path) == 0) ? 0 : 1;
+  }
+  if (do_snapshot_diff) {
+    return (dpll_cmd_snapshot_diff(snap_path, snap_path_b) == 0) ? 0 : 1;
+  }
+  if (do_plan_batch) {
+    return (dpll_cmd_plan_batch(plan_batch_path) == 0) ? 0 : 1;
+  }
+  if (do_plan) {
+    int prc = dpll_cmd_plan(plan_output_pair, plan_in_hz, plan_out,
+                            plan_explain);
+    if (!g_batch.active)
+      dpll_plancache_close();
+    return (prc == 0) ? 0 : 1;
+  }
+  if (do_plan_outputs) {
+    return (dpll_cmd_plan_outputs(plan_req, plan_nreq, plan_topo, plan_mode,
+                                  plan_budget_ms) == 0)
+               ? 0
+               : 1;
+  }
+
   /* Build spidev path from bus/cs if user didn't explicitly give --spidev */
   if (!spidev_overridden && (have_busnum || have_csnum)) {
     snprintf(spidev_path, sizeof(spidev_path), "/dev/spidev%u.%u", busnum,
              csnum);
   }
 
-  /* Open spidev */
-  int spi_fd = dpll_spi_open(spidev_path, hz, (uint8_t)mode);
+  /* Open spidev (a batch keeps the handle of its first SPI command) */
+  int spi_fd = g_batch.spi_fd;
   if (spi_fd < 0) {
-    fprintf(stderr, "Failed to open SPI device %s\n", spidev_path);
-    return 2;
-  }
+    spi_fd = dpll_spi_open(spidev_path, hz, (uint8_t)mode);
+    if (spi_fd < 0) {
+      fprintf(stderr, "Failed to open SPI device %s\n", spidev_path);
+      return 2;
+    }
 
-  /*
-fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
-      spidev_path, hz, mode);
-  */
-  /* Initialize global cm_bus for table-driven access */
-  cm_init_bus_for_spi(spi_fd);
+    /*
+  fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
+        spidev_path, hz, mode);
+    */
+    /* Initialize global cm_bus for table-driven access */
+    cm_init_bus_for_spi(spi_fd);
+    if (spi_stats || (do_monitor && metrics_port > 0)) {
+      cm_enable_spi_stats();
+    }
+    if (g_batch.active) {
+      if (g_batch.transaction) {
+        if (cm_enable_journal() != 0) {
+          dpll_spi_close(spi_fd);
+          return 2;
+        }
+        cm_journal_begin(&g_journal);
+      }
+      g_batch.spi_fd = spi_fd;
+      g_batch.spi_stats = spi_stats;
+    }
+    if (shadow_cache) {
+      cm_enable_shadow_cache();
+    }
+  }
 
   int rc = 0;
 
@@ -1578,6 +3391,11 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
     if (dpll_read8(spi_fd, addr, &val) != DPLL_OK) {
       fprintf(stderr, "Read from 0x%04X failed\n", addr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "addr", addr);
+      cm_json_uint(j, "value", val);
+      dpll_json_end(j);
     } else {
       printf("Read 0x%02X from 0x%04X\n", val, addr);
     }
@@ -1586,9 +3404,15 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
     if (dpll_write8(spi_fd, addr, wdata) != DPLL_OK) {
       fprintf(stderr, "Write to 0x%04X failed\n", addr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "addr", addr);
+      cm_json_uint(j, "value", wdata);
+      dpll_json_end(j);
     } else {
       printf("Wrote 0x%02X to 0x%04X\n", wdata, addr);
     }
+    cm_invalidate_shadow_cache();
 
   } else if (do_flash) {
     fprintf(stderr, "Flashing EEPROM HEX: %s\n", hex_path);
@@ -1600,22 +3424,33 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
 
     dpll_result_t r =
         dpll_eeprom_flash_hex(spi_fd, hex_path, flash_progress_cb, &ctx);
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    cm_metrics_record_apply(CM_METRICS_APPLY_FILE, "eeprom",
+                            secs_since(end, ctx.start), r == DPLL_OK);
     if (r != DPLL_OK) {
       fprintf(stderr, "Flash failed.\n");
       rc = 1;
     } else {
       fprintf(stderr, "Flash complete.\n");
     }
+    cm_invalidate_shadow_cache();
 
   } else if (do_tcs_apply) {
     fprintf(stderr, "Applying TCS file: %s\n", tcs_path);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
     dpll_result_t r = dpll_apply_tcs_file(spi_fd, tcs_path, tcs_debug ? 1 : 0);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    cm_metrics_record_apply(CM_METRICS_APPLY_FILE, "tcs", secs_since(end, start),
+                            r == DPLL_OK);
     if (r != DPLL_OK) {
       fprintf(stderr, "TCS apply failed.\n");
       rc = 1;
     } else {
       fprintf(stderr, "TCS apply complete.\n");
     }
+    cm_invalidate_shadow_cache();
 
   } else if (do_get_state) {
     if (dpll_cmd_get_state(mon_chan) != 0) {
@@ -1642,6 +3477,31 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
       rc = 1;
     }
 
+  } else if (do_monitor) {
+    if (dpll_cmd_monitor(&mon_cfg, mon_phase_rate_hz, metrics_bind,
+                         metrics_port) != 0) {
+      rc = 1;
+    }
+
+  } else if (do_sample) {
+    if (dpll_cmd_sample(sample_mask,
+                        sample_rate_hz > 0.0 ? sample_rate_hz : 100.0,
+                        sample_count) != 0) {
+      rc = 1;
+    }
+
+  } else if (do_stats) {
+    if (dpll_cmd_stats(stats_chan, sample_rate_hz > 0.0 ? sample_rate_hz : 10.0,
+                       stats_tau_max, stats_duration, stats_report,
+                       stats_mask) != 0) {
+      rc = 1;
+    }
+
+  } else if (do_status) {
+    if (dpll_cmd_status(status_chan) != 0) {
+      rc = 1;
+    }
+
   } else if (do_set_input_freq) {
     if (dpll_cmd_set_input_freq(hl_input_idx, hl_freq_hz) != 0) {
       fprintf(stderr, "set-input-freq failed.\n");
@@ -1663,7 +3523,7 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
 
   } else if (do_set_output_freq) {
 
-    if (dpll_cmd_set_output_freq(hl_out3_hz, hl_out4_hz) != 0) {
+    if (dpll_cmd_set_output_freq(hl_out3, hl_out4) != 0) {
       fprintf(stderr, "set-output-freq failed.\n");
       rc = 1;
     }
@@ -1725,41 +3585,64 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
       fprintf(stderr, "out-phase-adj-get failed (out=%u), rc=%d\n", hl_out_idx,
               rr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "output", hl_out_idx);
+      cm_json_int(j, "phase_adj", adj);
+      dpll_json_end(j);
     } else {
       printf("Output[%u].OUT_PHASE_ADJ = %d (0x%08x)\n", hl_out_idx, adj,
              (uint32_t)adj);
     }
   } else if (do_out_phase_adj_set) {
     int rr = cm_write_output_phase_adj_s32(&g_cm_bus, (unsigned)hl_out_idx,
-                                           hl_phase_adj, 1, 0);
+                                           hl_phase_adj, !g_json, 0);
     if (rr != 0) {
       fprintf(stderr, "out-phase-adj-set failed (out=%u, adj=%d), rc=%d\n",
               hl_out_idx, hl_phase_adj, rr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "output", hl_out_idx);
+      cm_json_int(j, "phase_adj", hl_phase_adj);
+      dpll_json_end(j);
     } else {
       printf("Wrote Output[%u].OUT_PHASE_ADJ = %d (0x%08x)\n", hl_out_idx,
              hl_phase_adj, (uint32_t)hl_phase_adj);
     }
   } else if (do_wr_freq_get) {
     int64_t word = 0;
-    int rr =
-        cm_read_dpll_wr_freq_s42(&g_cm_bus, (unsigned)hl_dpll_idx, &word, 1);
+    int rr = cm_read_dpll_wr_freq_s42(&g_cm_bus, (unsigned)hl_dpll_idx, &word,
+                                      !g_json);
     if (rr != 0) {
       fprintf(stderr, "wr-freq-get failed (dpll=%u), rc=%d\n", hl_dpll_idx, rr);
       rc = 1;
     } else {
       double frac = ldexp((double)word, -CM_WR_FREQ_FRAC_BITS);
       double ppb = frac * 1e9;
-      printf("DPLL_Freq_Write[%u].DPLL_WR_FREQ word_s42=%lld  (~%.9f ppb)\n",
-             hl_dpll_idx, (long long)word, ppb);
+      if (g_json) {
+        cm_json_t *j = dpll_json_begin();
+        cm_json_uint(j, "chan", hl_dpll_idx);
+        cm_json_int(j, "word_s42", word);
+        cm_json_double(j, "ppb", ppb);
+        dpll_json_end(j);
+      } else {
+        printf("DPLL_Freq_Write[%u].DPLL_WR_FREQ word_s42=%lld  (~%.9f ppb)\n",
+               hl_dpll_idx, (long long)word, ppb);
+      }
     }
   } else if (do_wr_freq_set_word) {
     int rr = cm_write_dpll_wr_freq_s42(&g_cm_bus, (unsigned)hl_dpll_idx,
-                                       hl_wr_word_s42, 1, 0);
+                                       hl_wr_word_s42, !g_json, 0);
     if (rr != 0) {
       fprintf(stderr, "wr-freq-set-word failed (dpll=%u, word=%lld), rc=%d\n",
               hl_dpll_idx, (long long)hl_wr_word_s42, rr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "chan", hl_dpll_idx);
+      cm_json_int(j, "word_s42", hl_wr_word_s42);
+      dpll_json_end(j);
     } else {
       printf("Wrote DPLL_Freq_Write[%u].DPLL_WR_FREQ word_s42=%lld\n",
              hl_dpll_idx, (long long)hl_wr_word_s42);
@@ -1767,13 +3650,19 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
   } else if (do_wr_freq_set_ppb) {
     double word_d = (hl_wr_ppb / 1e9) * (double)(1ULL << CM_WR_FREQ_FRAC_BITS);
     int64_t word = (int64_t)llround(word_d);
-    int rr =
-        cm_write_dpll_wr_freq_s42(&g_cm_bus, (unsigned)hl_dpll_idx, word, 1, 0);
+    int rr = cm_write_dpll_wr_freq_s42(&g_cm_bus, (unsigned)hl_dpll_idx, word,
+                                       !g_json, 0);
     if (rr != 0) {
       fprintf(stderr,
               "wr-freq-set-ppb failed (dpll=%u, ppb=%.9f, word=%lld), rc=%d\n",
               hl_dpll_idx, hl_wr_ppb, (long long)word, rr);
       rc = 1;
+    } else if (g_json) {
+      cm_json_t *j = dpll_json_begin();
+      cm_json_uint(j, "chan", hl_dpll_idx);
+      cm_json_int(j, "word_s42", word);
+      cm_json_double(j, "ppb", hl_wr_ppb);
+      dpll_json_end(j);
     } else {
       printf(
           "Wrote DPLL_Freq_Write[%u].DPLL_WR_FREQ ~%.9f ppb (word_s42=%lld)\n",
@@ -1791,13 +3680,310 @@ fprintf(stderr, "Using spidev: %s (hz=%u, mode=%d)\n",
     } else {
       fprintf(stderr, "Programming file apply complete.\n");
     }
+    cm_invalidate_shadow_cache();
+  } else if (do_snapshot) {
+    if (dpll_cmd_snapshot(snap_path) != 0) {
+      fprintf(stderr, "snapshot failed.\n");
+      rc = 1;
+    }
   } else if (do_set_out2_dest) {
   }
 
-  dpll_spi_close(spi_fd);
+  if (!g_batch.active)
+    dpll_session_close(spi_fd, spi_stats);
   return rc;
 }
 
+/* dpll_run_cmd() plus the --json fallback object: with --json every command
+ * line produces at least one object on stdout, also when it fails. */
+static int dpll_run(int argc, char **argv) {
+  g_json = 0;
+  g_json_cmd = NULL;
+  g_json_emitted = 0;
+  /* Known before parsing, so argument errors are reported as objects too */
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json"))
+      g_json = 1;
+  }
+  int rc = dpll_run_cmd(argc, argv);
+  if (!g_batch.check_only)
+    dpll_json_finish(rc);
+  return rc;
+}
+
+/* Split a batch line into words in place: blanks separate words, '...' and
+ * "..." quote (no escapes), '#' at the start of a word ends the line.
+ * Returns the word count, or -1 on an unterminated quote / too many words. */
+static int dpll_batch_split(char *line, char **words, int max) {
+  int n = 0;
+  char *r = line;
+  for (;;) {
+    while (*r == ' ' || *r == '\t' || *r == '\r' || *r == '\n')
+      r++;
+    if (!*r || *r == '#')
+      return n;
+    if (n == max)
+      return -1;
+
+    char *w = r; /* the word is rebuilt in place without its quotes */
+    words[n++] = w;
+    while (*r && *r != ' ' && *r != '\t' && *r != '\r' && *r != '\n') {
+      if (*r == '\'' || *r == '"') {
+        char q = *r++;
+        while (*r && *r != q)
+          *w++ = *r++;
+        if (!*r)
+          return -1;
+        r++;
+      } else {
+        *w++ = *r++;
+      }
+    }
+    if (*r)
+      r++;
+    *w = '\0';
+  }
+}
+
+typedef struct {
+  unsigned lineno;
+  char *text;   /* the line as read, for the report */
+  char *words;  /* split copy that argv points into */
+  int argc;
+  char *argv[DPLL_BATCH_MAX_ARGS];
+  double ms;
+  int rc;
+  int ran;
+} dpll_batch_line_t;
+
+/*
+ * dplltool [options] --batch <file|-> [--transaction] [--timing]
+ *
+ * Every other argument (connection and debug options) is put in front of
+ * each line. All lines are parsed first; nothing runs unless every line is
+ * valid. Lines then run in order and the batch stops at the first failure.
+ * With --transaction, table-bus writes are journaled and undone on failure.
+ */
+static int dpll_batch_main(int argc, char **argv) {
+  const char *path = NULL;
+  int timing = 0;
+  int json = 0;
+  char *common[DPLL_BATCH_MAX_ARGS];
+  int ncommon = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json"))
+      json = 1; /* and passed on to every line */
+    if (!strcmp(argv[i], "--batch") && i + 1 < argc) {
+      path = argv[++i];
+    } else if (!strcmp(argv[i], "--transaction")) {
+      g_batch.transaction = 1;
+    } else if (!strcmp(argv[i], "--timing")) {
+      timing = 1;
+    } else if (ncommon < DPLL_BATCH_MAX_ARGS / 2) {
+      common[ncommon++] = argv[i];
+    } else {
+      fprintf(stderr, "batch: too many options\n");
+      return 1;
+    }
+  }
+  if (!path) {
+    fprintf(stderr, "batch: --batch needs a file (or - for stdin)\n");
+    return 1;
+  }
+
+  FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+  if (!f) {
+    fprintf(stderr, "batch: cannot open %s\n", path);
+    return 1;
+  }
+
+  dpll_batch_line_t *lines = NULL;
+  size_t nlines = 0, cap = 0;
+  char *buf = NULL;
+  size_t bufsz = 0;
+  unsigned lineno = 0;
+  int rc = 0;
+
+  /* Read and split every line */
+  while (getline(&buf, &bufsz, f) >= 0) {
+    lineno++;
+    buf[strcspn(buf, "\r\n")] = '\0';
+    char *copy = strdup(buf);
+    char *words = strdup(buf);
+    if (!copy || !words) {
+      free(copy);
+      free(words);
+      rc = 1;
+      break;
+    }
+    dpll_batch_line_t ln;
+    memset(&ln, 0, sizeof(ln));
+    ln.lineno = lineno;
+    ln.text = copy;
+    ln.words = words;
+    ln.argv[0] = argv[0];
+    for (int k = 0; k < ncommon; k++)
+      ln.argv[1 + k] = common[k];
+    int nw = dpll_batch_split(words, &ln.argv[1 + ncommon],
+                              DPLL_BATCH_MAX_ARGS - 1 - ncommon);
+    if (nw <= 0) {
+      if (nw < 0) {
+        fprintf(stderr, "batch: line %u: bad quoting or too many words\n",
+                lineno);
+        rc = 1;
+      }
+      free(copy);
+      free(words);
+      continue;
+    }
+    ln.argc = 1 + ncommon + nw;
+    if (nlines == cap) {
+      cap = cap ? cap * 2 : 32;
+      dpll_batch_line_t *nl = realloc(lines, cap * sizeof(*lines));
+      if (!nl) {
+        free(copy);
+        free(words);
+        rc = 1;
+        break;
+      }
+      lines = nl;
+    }
+    lines[nlines++] = ln;
+  }
+  free(buf);
+  if (f != stdin)
+    fclose(f);
+
+  /* Validation pass: parse every line, touch nothing */
+  unsigned failed_line = 0;
+  g_batch.active = 1;
+  g_batch.check_only = 1;
+  for (size_t i = 0; i < nlines && !rc; i++) {
+    if (dpll_run(lines[i].argc, lines[i].argv) != 0) {
+      fprintf(stderr, "batch: line %u: %s\n", lines[i].lineno, lines[i].text);
+      failed_line = lines[i].lineno;
+      rc = 1;
+    }
+  }
+  g_batch.check_only = 0;
+
+  /* Execution pass */
+  struct timespec t_all0, t_all1;
+  clock_gettime(CLOCK_MONOTONIC, &t_all0);
+  for (size_t i = 0; i < nlines && !rc; i++) {
+    struct timespec t0, t1;
+    const uint64_t bus_errors = g_journal_on ? g_journal.errors : 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    g_json_line = lines[i].lineno;
+    lines[i].rc = dpll_run(lines[i].argc, lines[i].argv);
+    g_json_line = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    /* Some commands log a failed register access and carry on; inside a
+     * transaction any bus error fails the line. The journal only exists
+     * from the first SPI line on, so compare against 0 then. */
+    if (lines[i].rc == 0 && g_journal_on && g_journal.errors != bus_errors) {
+      fprintf(stderr, "batch: line %u: register access failed\n",
+              lines[i].lineno);
+      lines[i].rc = 1;
+    }
+    lines[i].ms = secs_since(t1, t0) * 1e3;
+    lines[i].ran = 1;
+    /* Keep stdout in line order with stderr of later lines */
+    fflush(stdout);
+    if (lines[i].rc != 0) {
+      fprintf(stderr, "batch: line %u failed (rc=%d): %s\n", lines[i].lineno,
+              lines[i].rc, lines[i].text);
+      rc = lines[i].rc;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t_all1);
+
+  int rolled_back = 0;
+  size_t restored = 0, skipped = 0;
+  if (g_journal_on) {
+    if (rc != 0) {
+      int rrc = cm_journal_rollback(&g_journal, &restored, &skipped);
+      rolled_back = 1;
+      cm_invalidate_shadow_cache();
+      fprintf(stderr,
+              "batch: rolled back %zu byte(s)%s; %zu volatile/unnamed byte(s) "
+              "not restorable\n",
+              restored, rrc ? " WITH ERRORS" : "", skipped);
+      if (rrc)
+        rc = 2;
+    } else {
+      cm_journal_commit(&g_journal);
+    }
+  }
+
+  if (timing) {
+    double total = 0.0;
+    size_t ran = 0;
+    fprintf(stderr, "batch: %6s %10s %4s  %s\n", "line", "ms", "rc",
+            "command");
+    for (size_t i = 0; i < nlines; i++) {
+      if (!lines[i].ran)
+        continue;
+      ran++;
+      total += lines[i].ms;
+      fprintf(stderr, "batch: %6u %10.3f %4d  %s\n", lines[i].lineno,
+              lines[i].ms, lines[i].rc, lines[i].text);
+    }
+    fprintf(stderr,
+            "batch: ran %zu of %zu command(s) in %.3f ms (%.3f ms in "
+            "commands)\n",
+            ran, nlines, secs_since(t_all1, t_all0) * 1e3, total);
+  }
+
+  if (g_batch.spi_fd >= 0)
+    dpll_session_close(g_batch.spi_fd, g_batch.spi_stats);
+  g_batch.active = 0;
+  g_batch.spi_fd = -1;
+
+  /* --json: one summary object after the per-line results */
+  if (json) {
+    size_t ran = 0;
+    for (size_t i = 0; i < nlines; i++) {
+      if (!lines[i].ran)
+        continue;
+      ran++;
+      if (lines[i].rc != 0 && !failed_line)
+        failed_line = lines[i].lineno;
+    }
+    g_json_cmd = "batch";
+    cm_json_t *j = dpll_json_open(rc == 0);
+    if (rc != 0)
+      cm_json_int(j, "rc", rc);
+    cm_json_uint(j, "ran", ran);
+    cm_json_uint(j, "total", nlines);
+    if (failed_line)
+      cm_json_uint(j, "failed_line", failed_line);
+    else
+      cm_json_null(j, "failed_line");
+    cm_json_bool(j, "transaction", g_batch.transaction);
+    cm_json_bool(j, "rolled_back", rolled_back);
+    cm_json_uint(j, "restored_bytes", restored);
+    cm_json_uint(j, "not_restorable_bytes", skipped);
+    dpll_json_end(j);
+  }
+
+  for (size_t i = 0; i < nlines; i++) {
+    free(lines[i].text);
+    free(lines[i].words);
+  }
+  free(lines);
+  return rc;
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--batch"))
+      return dpll_batch_main(argc, argv);
+  }
+  return dpll_run(argc, argv);
+}
+
 /* -------------------------------------------------------------------------- */
 /* Register-level hook stubs                                                  */
 /*                                                                            */
@@ -19,6 +19,9 @@ set -euo pipefail
 # intervenes by cycling the channel FREERUN → NORMAL to force the DPLL to
 # re-acquire lock from scratch.
 #
+# `dplltool monitor` (cm_monitor.c) implements this same logic natively and is
+# what switchberry-dpll-monitor.service runs by default; keep the two in sync.
+#
 #
 # MONITORED CHANNELS
 # ------------------
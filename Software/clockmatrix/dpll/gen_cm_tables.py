@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Generate the packed register tables in renesas_cm8a34001_tables.c.
+
+Reads renesas_cm8a34001_regs.txt and rewrites the block between the
+BEGIN/END GENERATED markers of renesas_cm8a34001_tables.c:
+
+  - every module / register / field name goes into one NUL-separated blob
+    (cm_names[]), de-duplicated, addressed by 16-bit offsets;
+  - all field descriptors live in one pool (cm_fields[], 4 bytes each) and
+    identical field lists are shared between registers;
+  - register descriptors are 6 bytes (name, offset:12/flags:4,
+    field0:12/nfields:4).
+
+Usage: ./gen_cm_tables.py [regs.txt] [tables.c]
+"""
+import sys
+from typing import Dict, List, Tuple
+
+BEGIN = "/* ---- BEGIN GENERATED by gen_cm_tables.py from renesas_cm8a34001_regs.txt ---- */"
+END = "/* ---- END GENERATED ---- */"
+
+FLAGS = {"config": "CM_REG_CONFIG", "volatile": "CM_REG_VOLATILE"}
+
+
+# ---------- Parsing ----------
+
+def parse(path: str):
+    modules = []
+    mod = None
+    reg = None
+    for lineno, raw in enumerate(open(path), 1):
+        line = raw.strip()
+        if not line or line.startswith("#"):
+            continue
+        kw, _, rest = line.partition(" ")
+        where = "%s:%d" % (path, lineno)
+        if kw == "module":
+            mod = {"name": rest.strip(), "bases": [], "regs": []}
+            modules.append(mod)
+            reg = None
+        elif kw == "bases":
+            mod["bases"] += [int(x, 16) for x in rest.split()]
+        elif kw == "reg":
+            off, flag, name = rest.split(" ", 2)
+            if flag not in FLAGS:
+                sys.exit("%s: unknown register flag %r" % (where, flag))
+            reg = {"name": name, "offset": int(off, 16), "flag": flag, "fields": []}
+            mod["regs"].append(reg)
+        elif kw == "field":
+            shift, width, name = rest.split(" ", 2)
+            reg["fields"].append((name, int(shift), int(width)))
+        else:
+            sys.exit("%s: unknown keyword %r" % (where, kw))
+    return modules
+
+
+# ---------- Packing ----------
+
+class Names:
+    def __init__(self):
+        self.off: Dict[str, int] = {}
+        self.order: List[str] = []
+        self.size = 0
+
+    def add(self, s: str) -> int:
+        if s not in self.off:
+            self.off[s] = self.size
+            self.order.append(s)
+            self.size += len(s.encode()) + 1
+            if self.size > 0xFFFF:
+                sys.exit("name blob exceeds 64 KiB")
+        return self.off[s]
+
+
+def c_str(s: str) -> str:
+    return s.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def generate(modules) -> str:
+    names = Names()
+    pool: List[Tuple[str, int, int]] = []
+    lists: Dict[Tuple, int] = {}
+
+    def field_list(fields) -> int:
+        key = tuple(fields)
+        if not key:
+            return 0
+        if key not in lists:
+            lists[key] = len(pool)
+            pool.extend(fields)
+        return lists[key]
+
+    out: List[str] = []
+    for m in modules:
+        m["name_off"] = names.add(m["name"])
+        for r in m["regs"]:
+            r["name_off"] = names.add(r["name"])
+            for f in r["fields"]:
+                names.add(f[0])
+            r["field0"] = field_list(r["fields"])
+            if r["offset"] > 0xFFF or r["field0"] > 0xFFF or len(r["fields"]) > 15:
+                sys.exit("register %s.%s does not fit the packed descriptor"
+                         % (m["name"], r["name"]))
+
+    out.append(BEGIN)
+    out.append("")
+    out.append("#ifndef CM_STRIP_NAMES")
+    out.append("const char cm_names[] =")
+    for s in names.order:
+        out.append('    /* %4d */ "%s\\0"' % (names.off[s], c_str(s)))
+    out[-1] += ";"
+    out.append("#else")
+    out.append('const char cm_names[1] = "";')
+    out.append("#endif")
+    out.append("")
+    out.append("const cm_field_desc_t cm_fields[%d] = {" % len(pool))
+    for i, (name, shift, width) in enumerate(pool):
+        out.append("    {%d, %d, %d}, /* %3d %s */" % (names.add(name), shift, width, i, name))
+    out.append("};")
+
+    for m in modules:
+        n = m["name"]
+        bases = m["bases"]
+        out.append("")
+        out.append("static const uint16_t cm_%s_bases[%d] = {" % (n, len(bases)))
+        for i in range(0, len(bases), 8):
+            out.append("    " + ", ".join("0x%04X" % b for b in bases[i:i + 8]) + ",")
+        out.append("};")
+        out.append("static const cm_reg_desc_t cm_%s_regs[%d] = {" % (n, len(m["regs"])))
+        for r in m["regs"]:
+            out.append("    {%d, 0x%03X, %s, %d, %d}, /* %s */"
+                       % (r["name_off"], r["offset"], FLAGS[r["flag"]],
+                          r["field0"], len(r["fields"]), r["name"]))
+        out.append("};")
+        out.append("const cm_module_desc_t cm_%s_module = {" % n)
+        out.append("    %d, cm_%s_bases, %d, cm_%s_regs, %d}; /* %s */"
+                   % (m["name_off"], n, len(bases), n, len(m["regs"]), n))
+
+    out.append("")
+    out.append("const cm_module_desc_t *const cm_all_modules[] = {")
+    for m in modules:
+        out.append("    &cm_%s_module," % m["name"])
+    out.append("};")
+    out.append("const size_t cm_all_modules_count = %d;" % len(modules))
+    out.append("")
+    out.append(END)
+    return "\n".join(out)
+
+
+def main():
+    regs_path = sys.argv[1] if len(sys.argv) > 1 else "renesas_cm8a34001_regs.txt"
+    c_path = sys.argv[2] if len(sys.argv) > 2 else "renesas_cm8a34001_tables.c"
+
+    block = generate(parse(regs_path))
+
+    src = open(c_path).read()
+    try:
+        head, rest = src.split(BEGIN, 1)
+        _, tail = rest.split(END, 1)
+    except ValueError:
+        sys.exit("%s: GENERATED markers not found" % c_path)
+
+    new = head + block + tail
+    if new != src:
+        open(c_path, "w").write(new)
+        print("updated", c_path)
+
+
+if __name__ == "__main__":
+    main()
@@ -7,43 +7,52 @@
 #include <unistd.h>      // usleep, close
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
 #include <sys/ioctl.h>
 #include <linux/spi/spidev.h>
 
 /* ---------- SPI helpers (spidev) ---------- */
 
-int dpll_spi_open(const char *dev_path, uint32_t hz, uint8_t mode)
+/* Shared by dpll_spi_open() and dpll_spi_open_quiet(): errno is kept from
+ * the failing call, and only printed when verbose. */
+static int dpll_spi_open_impl(const char *dev_path, uint32_t hz, uint8_t mode,
+                              int verbose)
 {
+    const char *what = "open spidev";
+    int e;
     int fd = open(dev_path, O_RDWR);
-    if (fd < 0) {
-        perror("open spidev");
-        return -1;
-    }
+    if (fd < 0) goto fail;
 
     /* Mode 0..3 only */
     uint8_t m = mode & 0x3;
-    if (ioctl(fd, SPI_IOC_WR_MODE, &m) < 0) {
-        perror("SPI_IOC_WR_MODE");
-        close(fd);
-        return -1;
-    }
+    what = "SPI_IOC_WR_MODE";
+    if (ioctl(fd, SPI_IOC_WR_MODE, &m) < 0) goto fail;
 
     uint8_t bits = 8;
-    if (ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) {
-        perror("SPI_IOC_WR_BITS_PER_WORD");
-        close(fd);
-        return -1;
-    }
+    what = "SPI_IOC_WR_BITS_PER_WORD";
+    if (ioctl(fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) goto fail;
 
-    if (hz) {
-        if (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &hz) < 0) {
-            perror("SPI_IOC_WR_MAX_SPEED_HZ");
-            close(fd);
-            return -1;
-        }
-    }
+    what = "SPI_IOC_WR_MAX_SPEED_HZ";
+    if (hz && ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &hz) < 0) goto fail;
 
     return fd;
+
+fail:
+    e = errno;
+    if (verbose) perror(what);
+    if (fd >= 0) close(fd);
+    errno = e;
+    return -1;
+}
+
+int dpll_spi_open(const char *dev_path, uint32_t hz, uint8_t mode)
+{
+    return dpll_spi_open_impl(dev_path, hz, mode, 1);
+}
+
+int dpll_spi_open_quiet(const char *dev_path, uint32_t hz, uint8_t mode)
+{
+    return dpll_spi_open_impl(dev_path, hz, mode, 0);
 }
 
 void dpll_spi_close(int fd)
@@ -51,13 +60,28 @@ void dpll_spi_close(int fd)
     if (fd >= 0) close(fd);
 }
 
-static dpll_result_t dpll_spi_xfer(int fd,
-                                   const uint8_t *tx,
-                                   uint8_t       *rx,
-                                   size_t         len)
+/* Optional transfer observer (dpll_spi_set_xfer_hook) */
+static dpll_xfer_hook_t g_xfer_hook;
+static void            *g_xfer_hook_user;
+
+void dpll_spi_set_xfer_hook(dpll_xfer_hook_t hook, void *user)
 {
-    if (len == 0) return DPLL_OK;
+    g_xfer_hook_user = user;
+    g_xfer_hook = hook;
+}
 
+static uint64_t dpll_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static dpll_result_t dpll_spi_ioctl(int fd,
+                                    const uint8_t *tx,
+                                    uint8_t       *rx,
+                                    size_t         len)
+{
     struct spi_ioc_transfer tr;
     memset(&tr, 0, sizeof(tr));
     tr.tx_buf        = (unsigned long)tx;
@@ -73,24 +97,53 @@ static dpll_result_t dpll_spi_xfer(int fd,
     return DPLL_OK;
 }
 
+/* One spidev transfer. kind/addr/len (payload bytes, without the command
+ * byte) are only used to report the transfer to the hook, which is timed
+ * only when installed. */
+static dpll_result_t dpll_spi_xfer(int fd,
+                                   const uint8_t *tx,
+                                   uint8_t       *rx,
+                                   size_t         len,
+                                   dpll_xfer_kind_t kind,
+                                   uint16_t       addr)
+{
+    if (len == 0) return DPLL_OK;
+
+    dpll_xfer_hook_t hook = g_xfer_hook;
+    if (!hook) return dpll_spi_ioctl(fd, tx, rx, len);
+
+    const uint64_t t0 = dpll_now_ns();
+    dpll_result_t r = dpll_spi_ioctl(fd, tx, rx, len);
+    hook(g_xfer_hook_user, kind, addr, len - 1, dpll_now_ns() - t0, r == DPLL_OK);
+    return r;
+}
+
 /* ---------- Core single ops (ported from wiwistick_dpll.c) ---------- */
 
-dpll_result_t dpll_write_page(int spi_fd, const uint8_t page4[4])
+/* addr is what the hook sees: the register the page is selected for */
+static dpll_result_t dpll_write_page_for(int spi_fd, const uint8_t page4[4], uint16_t addr)
 {
-    if (spi_fd < 0 || !page4) return DPLL_ERR;
-
     uint8_t buf[1 + 4];
     buf[0] = 0x7C;                      // Page Register offset (burst write)
     memcpy(&buf[1], page4, 4);
 
-    return dpll_spi_xfer(spi_fd, buf, NULL, sizeof(buf));
+    return dpll_spi_xfer(spi_fd, buf, NULL, sizeof(buf), DPLL_XFER_PAGE, addr);
+}
+
+dpll_result_t dpll_write_page(int spi_fd, const uint8_t page4[4])
+{
+    if (spi_fd < 0 || !page4) return DPLL_ERR;
+
+    /* Page base: A15..A8 plus A7 */
+    const uint16_t base = (uint16_t)(((uint16_t)page4[1] << 8) | (page4[0] & 0x80));
+    return dpll_write_page_for(spi_fd, page4, base);
 }
 
 dpll_result_t dpll_set_page_for_addr(int spi_fd, uint16_t addr)
 {
     uint8_t page4[4];
     dpll_compute_page_from_addr(addr, page4);
-    return dpll_write_page(spi_fd, page4);
+    return dpll_write_page_for(spi_fd, page4, addr);
 }
 
 dpll_result_t dpll_write8(int spi_fd, uint16_t addr, uint8_t value)
@@ -102,7 +155,7 @@ dpll_result_t dpll_write8(int spi_fd, uint16_t addr, uint8_t value)
     buf[0] = (uint8_t)(addr & 0x7F);   // MSB=0 (write), A6..A0 in cmd
     buf[1] = value;
 
-    return dpll_spi_xfer(spi_fd, buf, NULL, sizeof(buf));
+    return dpll_spi_xfer(spi_fd, buf, NULL, sizeof(buf), DPLL_XFER_WRITE8, addr);
 }
 
 dpll_result_t dpll_read8(int spi_fd, uint16_t addr, uint8_t *value_out)
@@ -117,7 +170,8 @@ dpll_result_t dpll_read8(int spi_fd, uint16_t addr, uint8_t *value_out)
     tx[1] = 0x00;
     rx[0] = rx[1] = 0;
 
-    if (dpll_spi_xfer(spi_fd, tx, rx, sizeof(tx)) != DPLL_OK) return DPLL_ERR;
+    if (dpll_spi_xfer(spi_fd, tx, rx, sizeof(tx), DPLL_XFER_READ8, addr) != DPLL_OK)
+        return DPLL_ERR;
 
     *value_out = rx[1];
     return DPLL_OK;
@@ -140,7 +194,8 @@ dpll_result_t dpll_write_seq(int spi_fd,
     buf[0] = (uint8_t)(start_addr & 0x7F); // write cmd
     memcpy(&buf[1], data, len);
 
-    dpll_result_t r = dpll_spi_xfer(spi_fd, buf, NULL, 1 + len);
+    dpll_result_t r = dpll_spi_xfer(spi_fd, buf, NULL, 1 + len, DPLL_XFER_WRITE,
+                                    start_addr);
     free(buf);
     return r;
 }
@@ -166,7 +221,8 @@ dpll_result_t dpll_read_seq(int spi_fd,
 
     tx[0] = (uint8_t)(0x80 | (start_addr & 0x7F)); // read cmd
 
-    dpll_result_t r = dpll_spi_xfer(spi_fd, tx, rx, 1 + len);
+    dpll_result_t r = dpll_spi_xfer(spi_fd, tx, rx, 1 + len, DPLL_XFER_READ,
+                                    start_addr);
     if (r == DPLL_OK) {
         memcpy(data_out, &rx[1], len);
     }
@@ -200,7 +256,8 @@ dpll_result_t dpll_burst_write(int spi_fd,
         buf[0] = (uint8_t)(addr & 0x7F); // write cmd
         memcpy(&buf[1], data, chunk);
 
-        dpll_result_t r = dpll_spi_xfer(spi_fd, buf, NULL, 1 + chunk);
+        dpll_result_t r = dpll_spi_xfer(spi_fd, buf, NULL, 1 + chunk,
+                                        DPLL_XFER_WRITE, addr);
         free(buf);
         if (r != DPLL_OK) return r;
 
@@ -238,7 +295,8 @@ dpll_result_t dpll_burst_read(int spi_fd,
 
         tx[0] = (uint8_t)(0x80 | (addr & 0x7F)); // read cmd
 
-        dpll_result_t r = dpll_spi_xfer(spi_fd, tx, rx, 1 + chunk);
+        dpll_result_t r = dpll_spi_xfer(spi_fd, tx, rx, 1 + chunk,
+                                        DPLL_XFER_READ, addr);
         if (r == DPLL_OK) {
             memcpy(data_out, &rx[1], chunk);
         }
@@ -20,9 +20,38 @@ typedef enum {
  * Returns a file descriptor >= 0 on success, or -1 on error. */
 int  dpll_spi_open(const char *dev_path, uint32_t hz, uint8_t mode);
 
+/* Same as dpll_spi_open(), but prints nothing: on error errno is left from
+ * the failing open/ioctl. For library code (clockmatrix.c). */
+int  dpll_spi_open_quiet(const char *dev_path, uint32_t hz, uint8_t mode);
+
 /* Close fd from dpll_spi_open(). Safe to call with fd<0. */
 void dpll_spi_close(int fd);
 
+/* ---------- Transfer observer (optional) ---------- */
+
+/* Kind of one spidev transfer. Every register access is a page write
+ * followed by one data transfer; bursts split at 128-byte pages. */
+typedef enum {
+    DPLL_XFER_PAGE = 0,     /* page register write (addr = the register it
+                               selects the page for, or the page base) */
+    DPLL_XFER_READ8,
+    DPLL_XFER_WRITE8,
+    DPLL_XFER_READ,         /* sequential / burst read, one page chunk */
+    DPLL_XFER_WRITE,        /* sequential / burst write, one page chunk */
+    DPLL_XFER_COUNT
+} dpll_xfer_kind_t;
+
+/* Called after every transfer with its register address, payload length
+ * (without the command byte), duration in ns (CLOCK_MONOTONIC) and
+ * ok = 1 on success. Runs in the caller's thread. */
+typedef void (*dpll_xfer_hook_t)(void *user, dpll_xfer_kind_t kind, uint16_t addr,
+                                 size_t len, uint64_t ns, int ok);
+
+/* Install (or with hook == NULL remove) the observer for all fds. Without
+ * one, transfers are not timed. Not synchronized with running transfers:
+ * install before starting threads that use the bus. */
+void dpll_spi_set_xfer_hook(dpll_xfer_hook_t hook, void *user);
+
 /* ---------- Page computation (unchanged from wiwistick) ---------- */
 /* Compute the 4 page-register bytes for 8A34001 1-byte mode. */
 static inline void dpll_compute_page_from_addr(uint16_t addr, uint8_t page4[4])
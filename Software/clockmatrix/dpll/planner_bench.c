@@ -0,0 +1,731 @@
+// planner_bench.c
+// Hardware-free regression check + timing for the frequency planner.
+//
+// For every frequency in the corpus the input M/N solver must be at least as
+// accurate as the exhaustive scan over N it replaced, and the exact output
+// planner (cm_freqplan) must be at least as accurate as the double-based
+// dpll_compute_output_dco_and_divs(). The multi-output exact search must never
+// lose to the heuristic one, the heuristic one must stay near its time
+// budget, and a 1PPS output paired with a low-frequency companion must stay
+// exactly 1 Hz with the whole divider range searched. Finally the
+// double-based planners run over every pair of a SyncE/SDH/radio/1PPS/GNSS
+// corpus, reporting latency percentiles and the worst-case ppb error, and the
+// batch API is checked against the single-request solvers. Exits non-zero on
+// any regression.
+// Build and run with `make bench-planner`.
+
+#define _GNU_SOURCE
+
+#include "cm_freqplan.h"
+#include "renesas_cm8a34001_tables.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_MAX_M ((1ULL << 48) - 1)
+#define BENCH_MAX_N 65535U
+
+// Common telecom / GNSS / datacom reference and input frequencies (Hz).
+static const double bench_input_freqs[] = {
+    0.5,
+    1.0,            // 1PPS
+    2.0, 5.0, 10.0, 100.0, 1000.0,
+    8000.0,         // E1/T1 frame rate
+    64000.0,
+    1.023e6,        // GPS L1 C/A chipping rate
+    1.544e6,        // T1
+    2.048e6,        // E1
+    5e6, 10e6,      // lab / GNSSDO references
+    10.23e6,        // GPS P-code chipping rate
+    12.8e6, 13e6,
+    16.368e6,       // GNSS front-end TCXO
+    19.2e6, 19.44e6, 20e6,
+    24.5535e6, 25e6, 26e6,
+    30.72e6,        // LTE
+    38.88e6, 40e6, 50e6,
+    61.44e6, 62.5e6,
+    77.76e6,        // SONET/SDH
+    100e6,
+    122.88e6,       // CPRI / LTE
+    125e6,          // 1GbE
+    153.6e6,
+    155.52e6,       // OC-3
+    156.25e6,       // 10GbE
+    161.1328125e6,  // 10GbE (66/64)
+    212.5e6,
+    245.76e6,
+    311.04e6,
+    312.5e6,
+    322.265625e6,   // 25GbE
+    491.52e6,
+    625e6,
+    644.53125e6,    // 100GbE
+    // Deliberately awkward values
+    10e6 + 0.001, 10e6 / 3.0, 25e6 * 66.0 / 64.0 / 7.0,
+    1e9 / 7.0, 3.14159265358979e6, 2.718281828e7,
+};
+
+#define BENCH_N_INPUT (sizeof(bench_input_freqs) / sizeof(bench_input_freqs[0]))
+
+// OUT3/OUT4 pairs, written exactly.
+static const char *const bench_output_pairs[][2] = {
+    {"10e6", "1"},
+    {"25e6", "1"},
+    {"156.25e6", "125e6"},
+    {"161.1328125e6", "156.25e6"},
+    {"322.265625e6", "1"},
+    {"155.52e6", "125e6"},
+    {"122.88e6", "10e6"},
+    {"100e6", "10e6"},
+    {"19.44e6", "25e6"},
+    {"10000000/3", "1"},
+    {"10.000001e6", "1"},
+    {"30.72e6", "156.25e6"},
+    {"644.53125e6", "1"},
+    {"1", "1"},
+    {"8000", "2.048e6"},
+    {"24.5535e6", "26e6"},
+    {"100000000/7", "25e6"},
+    {"13e6", "1.544e6"},
+};
+
+#define BENCH_N_OUTPUT (sizeof(bench_output_pairs) / sizeof(bench_output_pairs[0]))
+
+// The solver dpll_compute_input_ratio() used to be: try every N, round M.
+static int bench_input_ratio_scan(double freq_hz, uint64_t *M_out, uint32_t *N_out)
+{
+    double best_err = INFINITY;
+    uint64_t best_M = 0;
+    uint32_t best_N = 1;
+
+    for (uint32_t N = 1; N <= BENCH_MAX_N; ++N) {
+        double M_d = freq_hz * (double)N;
+        if (M_d <= 0.0) continue;
+        uint64_t M = (uint64_t)llround(M_d);
+        if (M == 0 || M > BENCH_MAX_M) continue;
+        double err = fabs((double)M / (double)N - freq_hz);
+        if (err < best_err) {
+            best_err = err;
+            best_M = M;
+            best_N = N;
+            if (err == 0.0) break;
+        }
+    }
+    if (best_M == 0) return -1;
+    *M_out = best_M;
+    *N_out = best_N;
+    return 0;
+}
+
+// |M/N - f| with more precision than the double the chip sees.
+static long double bench_abs_err(double f, uint64_t M, uint32_t N)
+{
+    return fabsl((long double)M / (long double)N - (long double)f);
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int bench_input_ratio(void)
+{
+    int failures = 0;
+
+    printf("%-20s %16s %6s %12s %16s %6s %12s\n",
+           "freq_hz", "M", "N", "err_hz", "scan M", "N", "scan err_hz");
+
+    for (size_t i = 0; i < BENCH_N_INPUT; i++) {
+        double f = bench_input_freqs[i];
+        uint64_t M = 0, sM = 0;
+        uint16_t N_reg = 0;
+        uint32_t sN = 0;
+        double actual, err;
+
+        int rc  = dpll_compute_input_ratio(f, &M, &N_reg, &actual, &err);
+        int src = bench_input_ratio_scan(f, &sM, &sN);
+        uint32_t N = N_reg ? N_reg : 1;
+
+        if (rc || src) {
+            printf("%-20.9f solver rc=%d scan rc=%d\n", f, rc, src);
+            failures++;
+            continue;
+        }
+
+        long double e_new  = bench_abs_err(f, M, N);
+        long double e_scan = bench_abs_err(f, sM, sN);
+        int worse = e_new > e_scan;
+
+        printf("%-20.9f %16llu %6u %12.3Le %16llu %6u %12.3Le%s\n",
+               f, (unsigned long long)M, N, e_new,
+               (unsigned long long)sM, sN, e_scan, worse ? "  REGRESSION" : "");
+        failures += worse;
+    }
+
+    // Timing: whole corpus per pass.
+    const int scan_passes = 3, cf_passes = 20000;
+    volatile uint64_t sink = 0;
+
+    double t0 = bench_now();
+    for (int p = 0; p < scan_passes; p++) {
+        for (size_t i = 0; i < BENCH_N_INPUT; i++) {
+            uint64_t M; uint32_t N;
+            if (!bench_input_ratio_scan(bench_input_freqs[i], &M, &N)) sink += M + N;
+        }
+    }
+    double t_scan = (bench_now() - t0) / (scan_passes * (double)BENCH_N_INPUT);
+
+    t0 = bench_now();
+    for (int p = 0; p < cf_passes; p++) {
+        for (size_t i = 0; i < BENCH_N_INPUT; i++) {
+            uint64_t M; uint16_t N; double a, e;
+            if (!dpll_compute_input_ratio(bench_input_freqs[i], &M, &N, &a, &e)) sink += M + N;
+        }
+    }
+    double t_cf = (bench_now() - t0) / (cf_passes * (double)BENCH_N_INPUT);
+    (void)sink;
+
+    printf("\ninput M/N: %zu frequencies, %d regression(s)\n", BENCH_N_INPUT, failures);
+    printf("  scan over N:          %10.3f us/solve\n", t_scan * 1e6);
+    printf("  continued fraction:   %10.3f us/solve  (%.0fx faster)\n",
+           t_cf * 1e6, t_cf > 0 ? t_scan / t_cf : 0.0);
+
+    return failures;
+}
+
+// Sum of |actual - target| / target over both outputs, in long double.
+static long double bench_rel_cost(cm_freq_t f3, long double a3, cm_freq_t f4, long double a4)
+{
+    long double t3 = (long double)f3.num / (long double)f3.den;
+    long double t4 = (long double)f4.num / (long double)f4.den;
+    return fabsl(a3 - t3) / t3 + fabsl(a4 - t4) / t4;
+}
+
+static int bench_output_plan(void)
+{
+    int failures = 0;
+
+    printf("\n%-14s %-14s %12s %7s %12s %12s | %12s %12s\n", "OUT3", "OUT4",
+           "dco", "exact", "ppb3", "ppb4", "old ppb3", "old ppb4");
+
+    for (size_t i = 0; i < BENCH_N_OUTPUT; i++) {
+        cm_freq_t t[2];
+        if (cm_freq_parse(bench_output_pairs[i][0], &t[0]) ||
+            cm_freq_parse(bench_output_pairs[i][1], &t[1])) {
+            printf("%s/%s: parse error\n", bench_output_pairs[i][0], bench_output_pairs[i][1]);
+            failures++;
+            continue;
+        }
+
+        cm_fp_plan_t plan;
+        int rc = cm_fp_plan_dco(t, 2, NULL, &plan);
+
+        double f3 = cm_freq_to_double(t[0]), f4 = cm_freq_to_double(t[1]);
+        double fdco, a3, a4, e3, e4;
+        uint32_t d3, d4;
+        int orc = dpll_compute_output_dco_and_divs(f3, f4, &fdco, &d3, &d4,
+                                                   &a3, &a4, &e3, &e4);
+        if (rc) {
+            printf("%-14s %-14s plan rc=%d (old rc=%d)\n", bench_output_pairs[i][0],
+                   bench_output_pairs[i][1], rc, orc);
+            failures += (orc == 0);
+            continue;
+        }
+
+        // Exact plans must really divide down to the targets.
+        int bad = 0;
+        for (int k = 0; k < 2; k++) {
+            int hit = cm_freq_cmp(plan.actual[k], t[k]) == 0;
+            if (plan.exact && !hit) bad = 1;
+        }
+
+        long double dco = (long double)plan.m / (long double)plan.n;
+        long double cost = bench_rel_cost(t[0], dco / plan.div[0], t[1], dco / plan.div[1]);
+        long double old_cost = 1.0L;
+        double o3 = NAN, o4 = NAN;
+        if (orc == 0) {
+            old_cost = bench_rel_cost(t[0], (long double)fdco / d3, t[1], (long double)fdco / d4);
+            o3 = e3 / f3 * 1e9;
+            o4 = e4 / f4 * 1e9;
+        }
+        if (cost > old_cost * (1.0L + 1e-12L)) bad = 1;
+
+        printf("%-14s %-14s %12.1f %7s %12.4g %12.4g | %12.4g %12.4g%s\n",
+               bench_output_pairs[i][0], bench_output_pairs[i][1], (double)dco,
+               plan.exact ? "yes" : "no", plan.err_ppb[0], plan.err_ppb[1], o3, o4,
+               bad ? "  REGRESSION" : "");
+        failures += bad;
+    }
+
+    const int passes = 200;
+    double t0 = bench_now();
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < BENCH_N_OUTPUT; i++) {
+            cm_freq_t t[2];
+            cm_fp_plan_t plan;
+            cm_freq_parse(bench_output_pairs[i][0], &t[0]);
+            cm_freq_parse(bench_output_pairs[i][1], &t[1]);
+            cm_fp_plan_dco(t, 2, NULL, &plan);
+        }
+    }
+    double t_new = (bench_now() - t0) / (passes * (double)BENCH_N_OUTPUT);
+
+    t0 = bench_now();
+    for (int p = 0; p < passes; p++) {
+        for (size_t i = 0; i < BENCH_N_OUTPUT; i++) {
+            cm_freq_t t[2];
+            double fdco, a3, a4, e3, e4;
+            uint32_t d3, d4;
+            cm_freq_parse(bench_output_pairs[i][0], &t[0]);
+            cm_freq_parse(bench_output_pairs[i][1], &t[1]);
+            dpll_compute_output_dco_and_divs(cm_freq_to_double(t[0]), cm_freq_to_double(t[1]),
+                                             &fdco, &d3, &d4, &a3, &a4, &e3, &e4);
+        }
+    }
+    double t_old = (bench_now() - t0) / (passes * (double)BENCH_N_OUTPUT);
+
+    printf("\noutput plan: %zu pairs, %d regression(s)\n", BENCH_N_OUTPUT, failures);
+    printf("  double search:        %10.3f us/plan\n", t_old * 1e6);
+    printf("  exact rational:       %10.3f us/plan\n", t_new * 1e6);
+
+    return failures;
+}
+
+// Companions for a 1PPS output. Those with no exact plan and an anchor
+// divider range beyond CM_FP_MAX_STEPS (below ~250 Hz) used to stop early and
+// return a non-exhaustive plan; the rest are controls.
+static const char *const bench_1pps_companions[] = {
+    "1000", "1001.000001", "123.4567891", "33.3333333", "10", "7.77777777",
+    "2.718281828", "2.5", "1.000001", "0.3", "0.31415926535",
+};
+
+#define BENCH_N_1PPS (sizeof(bench_1pps_companions) / sizeof(bench_1pps_companions[0]))
+
+// cm_fp_plan_dco() must keep the 1 Hz output exact, search the whole range
+// for companions above 1 Hz, and be at least as accurate as the double-based
+// dpll_compute_output_dco_and_divs() (which stops at 1e6 dividers).
+static int bench_1pps(void)
+{
+    const cm_freq_t one = {1, 1};
+    int failures = 0;
+
+    printf("\n%-14s %12s %7s %6s %12s %12s %10s\n", "companion_hz", "dco", "exact",
+           "full", "ppb", "old ppb", "ms");
+    for (size_t i = 0; i < BENCH_N_1PPS; i++) {
+        cm_freq_t t[2];
+        if (cm_freq_parse(bench_1pps_companions[i], &t[0])) {
+            printf("%s: parse error\n", bench_1pps_companions[i]);
+            failures++;
+            continue;
+        }
+        t[1] = one;
+
+        cm_fp_plan_t plan;
+        double t0 = bench_now();
+        int rc = cm_fp_plan_dco(t, 2, NULL, &plan);
+        double dt = bench_now() - t0;
+
+        double f = cm_freq_to_double(t[0]);
+        double fdco, a3, a4, e3, e4;
+        uint32_t d3, d4;
+        int orc = dpll_compute_output_dco_and_divs(f, 1.0, &fdco, &d3, &d4,
+                                                   &a3, &a4, &e3, &e4);
+        if (rc) {
+            printf("%-14s plan rc=%d  REGRESSION\n", bench_1pps_companions[i], rc);
+            failures++;
+            continue;
+        }
+
+        int bad = plan.err_sign[1] != 0 ||
+                  (cm_freq_cmp(t[0], one) > 0 && !plan.exhaustive);
+        double old_ppb = NAN;
+        if (orc == 0) {
+            long double dco = (long double)plan.m / (long double)plan.n;
+            long double cost = bench_rel_cost(t[0], dco / plan.div[0], one, dco / plan.div[1]);
+            long double old_cost = bench_rel_cost(t[0], (long double)fdco / d3,
+                                                  one, (long double)fdco / d4);
+            if (cost > old_cost * (1.0L + 1e-12L)) bad = 1;
+            old_ppb = e3 / f * 1e9;
+        }
+
+        printf("%-14s %12.1f %7s %6s %12.4g %12.4g %10.3f%s\n", bench_1pps_companions[i],
+               (double)plan.m / plan.n, plan.exact ? "yes" : "no",
+               plan.exhaustive ? "yes" : "no", plan.err_ppb[0], old_ppb, dt * 1e3,
+               bad ? "  REGRESSION" : "");
+        failures += bad;
+    }
+
+    printf("\n1PPS companions: %zu frequencies, %d regression(s)\n", BENCH_N_1PPS, failures);
+    return failures;
+}
+
+// Whole-chip requests (Qn=freq), any output on any FOD.
+static const char *const bench_multi_sets[][CM_FP_NUM_OUTPUTS + 1] = {
+    {"Q0=161.1328125e6", "Q1=156.25e6", "Q2=125e6", "Q3=1", "Q4=19.44e6",
+     "Q5=25e6", "Q6=10e6", "Q7=122.88e6", "Q8=155.52e6", "Q9=8000",
+     "Q10=24.5535e6", "Q11=10000000/3", NULL},
+    {"Q0=156.25e6", "Q1=156.25e6", "Q2=161.1328125e6", "Q3=161.1328125e6",
+     "Q4=322.265625e6", "Q5=644.53125e6", "Q6=25e6", "Q7=1", NULL},
+    {"Q0=10.23e6", "Q1=16.368e6", "Q2=10e6", "Q3=1", "Q4=1.023e6",
+     "Q5=30.72e6", "Q6=122.88e6", "Q7=245.76e6", "Q8=19.2e6",
+     "Q9=13e6", "Q10=26e6", "Q11=38.4e6", NULL},
+    {"Q9=10e6", "Q10=156.25e6", "Q11=1", NULL},
+};
+
+#define BENCH_N_MULTI (sizeof(bench_multi_sets) / sizeof(bench_multi_sets[0]))
+
+static size_t bench_multi_parse(const char *const *set, cm_fp_request_t *req)
+{
+    size_t n = 0;
+    for (; set[n]; n++) {
+        const char *s = set[n] + 1;  // skip 'Q'
+        char *end;
+        req[n].output = (unsigned)strtoul(s, &end, 10);
+        cm_freq_parse(end + 1, &req[n].freq);
+    }
+    return n;
+}
+
+static int bench_multi_plan(void)
+{
+    int failures = 0;
+
+    printf("\n%-4s %4s | %6s %12s %10s | %6s %12s %10s\n", "set", "outs",
+           "fods", "err_ppb", "exact_ms", "fods", "err_ppb", "heur_ms");
+
+    for (size_t k = 0; k < BENCH_N_MULTI; k++) {
+        cm_fp_request_t req[CM_FP_NUM_OUTPUTS];
+        size_t n = bench_multi_parse(bench_multi_sets[k], req);
+        cm_fp_multi_plan_t ex, he;
+
+        double t0 = bench_now();
+        int rc_ex = cm_fp_plan_outputs(req, n, &cm_fp_topology_any, CM_FP_MODE_EXACT, 0, &ex);
+        double t_ex = bench_now() - t0;
+        t0 = bench_now();
+        int rc_he = cm_fp_plan_outputs(req, n, &cm_fp_topology_any, CM_FP_MODE_HEURISTIC, 0, &he);
+        double t_he = bench_now() - t0;
+
+        int bad = rc_ex != 0 ||
+                  (rc_he == 0 && (ex.total_err_ppb > he.total_err_ppb ||
+                                  (ex.total_err_ppb == he.total_err_ppb && ex.nfods > he.nfods)));
+        printf("%-4zu %4zu | %6u %12.4g %10.3f | %6u %12.4g %10.3f%s\n", k, n,
+               rc_ex ? 0 : ex.nfods, rc_ex ? NAN : ex.total_err_ppb, t_ex * 1e3,
+               rc_he ? 0 : he.nfods, rc_he ? NAN : he.total_err_ppb, t_he * 1e3,
+               bad ? "  REGRESSION" : "");
+        failures += bad;
+    }
+
+    printf("\nmulti-output plan: %zu sets, %d regression(s)\n", BENCH_N_MULTI, failures);
+    return failures;
+}
+
+// 1PPS next to low companions: every DCO search is long, so only the
+// deadline keeps the heuristic mode near its budget.
+static const char *const bench_budget_sets[][CM_FP_NUM_OUTPUTS + 1] = {
+    {"Q0=1", "Q1=7.77777777", "Q2=1001.000001", "Q3=123.4567891", NULL},
+    {"Q0=1", "Q1=7.77777777", "Q2=1001.000001", "Q3=123.4567891",
+     "Q4=2.7182818289", "Q5=10.0000001", NULL},
+};
+
+#define BENCH_N_BUDGET (sizeof(bench_budget_sets) / sizeof(bench_budget_sets[0]))
+
+// Heuristic planning must finish within a few multiples of budget_ms.
+#define BENCH_BUDGET_FACTOR 3.0
+
+static int bench_multi_budget(void)
+{
+    static const unsigned budgets_ms[] = {10, 50};
+    int failures = 0;
+
+    printf("\n%-4s %4s %10s %10s %6s %12s\n", "set", "outs", "budget_ms", "heur_ms",
+           "fods", "err_ppb");
+    for (size_t k = 0; k < BENCH_N_BUDGET; k++) {
+        cm_fp_request_t req[CM_FP_NUM_OUTPUTS];
+        size_t n = bench_multi_parse(bench_budget_sets[k], req);
+
+        for (size_t b = 0; b < sizeof(budgets_ms) / sizeof(budgets_ms[0]); b++) {
+            cm_fp_multi_plan_t he;
+            double t0 = bench_now();
+            int rc = cm_fp_plan_outputs(req, n, &cm_fp_topology_any, CM_FP_MODE_HEURISTIC,
+                                        budgets_ms[b], &he);
+            double dt_ms = (bench_now() - t0) * 1e3;
+
+            int bad = rc != 0 || dt_ms > BENCH_BUDGET_FACTOR * budgets_ms[b];
+            printf("%-4zu %4zu %10u %10.3f %6u %12.4g%s\n", k, n, budgets_ms[b], dt_ms,
+                   rc ? 0 : he.nfods, rc ? NAN : he.total_err_ppb, bad ? "  REGRESSION" : "");
+            failures += bad;
+        }
+    }
+
+    printf("\nheuristic budget: %zu sets, %d regression(s)\n", BENCH_N_BUDGET, failures);
+    return failures;
+}
+
+// ---------------------------------------------------------------------------
+// Corpus run: every realistic frequency against every other one, timing each
+// call of the three public double-based planners.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const char *family;
+    double      hz;
+} bench_corpus_freq_t;
+
+static const bench_corpus_freq_t bench_corpus[] = {
+    // SyncE / Ethernet line and reference clocks
+    {"synce", 25e6}, {"synce", 31.25e6}, {"synce", 62.5e6}, {"synce", 125e6},
+    {"synce", 156.25e6}, {"synce", 161.1328125e6}, {"synce", 312.5e6},
+    {"synce", 322.265625e6}, {"synce", 390.625e6}, {"synce", 644.53125e6},
+    {"synce", 25.78125e6}, {"synce", 53.125e6},
+    // SDH / PDH
+    {"sdh", 8000.0}, {"sdh", 1.544e6}, {"sdh", 2.048e6}, {"sdh", 19.44e6},
+    {"sdh", 38.88e6}, {"sdh", 77.76e6}, {"sdh", 155.52e6}, {"sdh", 622.08e6},
+    // Lab references
+    {"ref", 5e6}, {"ref", 10e6}, {"ref", 20e6}, {"ref", 50e6}, {"ref", 100e6},
+    // 1PPS and other low rates
+    {"pps", 1.0}, {"pps", 10.0}, {"pps", 100.0}, {"pps", 1000.0},
+    // Radio
+    {"radio", 30.72e6}, {"radio", 61.44e6}, {"radio", 122.88e6},
+    {"radio", 245.76e6}, {"radio", 491.52e6}, {"radio", 19.2e6},
+    {"radio", 38.4e6},
+    // GNSS chipping rates and front-end clocks
+    {"gnss", 1.023e6}, {"gnss", 2.046e6}, {"gnss", 0.511e6},
+    {"gnss", 5.115e6}, {"gnss", 10.23e6}, {"gnss", 16.368e6},
+    {"gnss", 16.367667e6}, {"gnss", 26e6}, {"gnss", 24.5535e6},
+    {"gnss", 40.96e6}, {"gnss", 10e6 / 3.0},
+};
+
+#define BENCH_N_CORPUS (sizeof(bench_corpus) / sizeof(bench_corpus[0]))
+
+typedef struct {
+    const char *name;
+    size_t      n;
+    size_t      fails;
+    double     *us;          // per-call latency
+    double      worst_ppb;   // max |error| over all outputs
+    double      worst_a, worst_b;
+} bench_stat_t;
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_stat_ppb(bench_stat_t *st, double err_hz, double f,
+                           double a, double b)
+{
+    double ppb = fabs(err_hz / f) * 1e9;
+    if (ppb > st->worst_ppb) {
+        st->worst_ppb = ppb;
+        st->worst_a = a;
+        st->worst_b = b;
+    }
+}
+
+static double bench_pct(const double *sorted, size_t n, double p)
+{
+    if (n == 0) return NAN;
+    size_t k = (size_t)ceil(p / 100.0 * (double)n);
+    return sorted[k ? k - 1 : 0];
+}
+
+static void bench_stat_print(bench_stat_t *st)
+{
+    qsort(st->us, st->n, sizeof(double), bench_cmp_double);
+    printf("%-34s %6zu %5zu %9.2f %9.2f %9.2f %10.2f %12.4g",
+           st->name, st->n, st->fails, bench_pct(st->us, st->n, 50),
+           bench_pct(st->us, st->n, 90), bench_pct(st->us, st->n, 99),
+           st->n ? st->us[st->n - 1] : NAN, st->worst_ppb);
+    if (st->worst_ppb > 0.0) {
+        if (isnan(st->worst_b)) printf("  @ %.9g", st->worst_a);
+        else printf("  @ %.9g/%.9g", st->worst_a, st->worst_b);
+    }
+    printf("\n");
+}
+
+static int bench_corpus_run(void)
+{
+    const size_t npairs = BENCH_N_CORPUS * BENCH_N_CORPUS;
+    bench_stat_t in  = {"dpll_compute_input_ratio", 0, 0, NULL, 0, NAN, NAN};
+    bench_stat_t dd  = {"dpll_compute_output_dco_and_divs", 0, 0, NULL, 0, NAN, NAN};
+    bench_stat_t mnd = {"dpll_compute_output_mndiv", 0, 0, NULL, 0, NAN, NAN};
+    int failures = 0;
+
+    in.us  = calloc(BENCH_N_CORPUS, sizeof(double));
+    dd.us  = calloc(npairs, sizeof(double));
+    mnd.us = calloc(npairs, sizeof(double));
+    if (!in.us || !dd.us || !mnd.us) {
+        fprintf(stderr, "planner_bench: out of memory\n");
+        free(in.us); free(dd.us); free(mnd.us);
+        return 1;
+    }
+
+    for (size_t i = 0; i < BENCH_N_CORPUS; i++) {
+        double f = bench_corpus[i].hz;
+        uint64_t M; uint16_t N; double a, e;
+        double t0 = bench_now();
+        int rc = dpll_compute_input_ratio(f, &M, &N, &a, &e);
+        in.us[in.n++] = (bench_now() - t0) * 1e6;
+        if (rc) {
+            in.fails++;
+            continue;
+        }
+        bench_stat_ppb(&in, e, f, f, NAN);
+    }
+
+    for (size_t i = 0; i < BENCH_N_CORPUS; i++) {
+        for (size_t j = 0; j < BENCH_N_CORPUS; j++) {
+            double f3 = bench_corpus[i].hz, f4 = bench_corpus[j].hz;
+            double fdco, a3, a4, e3, e4;
+            uint32_t d3, d4;
+
+            double t0 = bench_now();
+            int rc = dpll_compute_output_dco_and_divs(f3, f4, &fdco, &d3, &d4,
+                                                      &a3, &a4, &e3, &e4);
+            dd.us[dd.n++] = (bench_now() - t0) * 1e6;
+            if (rc) {
+                dd.fails++;
+            } else {
+                bench_stat_ppb(&dd, e3, f3, f3, f4);
+                bench_stat_ppb(&dd, e4, f4, f3, f4);
+            }
+
+            uint64_t M; uint16_t N_reg;
+            uint32_t md3, md4;
+            double mfdco, ma3, ma4, me3, me4;
+            t0 = bench_now();
+            int mrc = dpll_compute_output_mndiv(f3, f4, &M, &N_reg, &md3, &md4, &mfdco,
+                                                &ma3, &ma4, &me3, &me4);
+            mnd.us[mnd.n++] = (bench_now() - t0) * 1e6;
+            if (mrc) {
+                mnd.fails++;
+            } else {
+                bench_stat_ppb(&mnd, me3, f3, f3, f4);
+                bench_stat_ppb(&mnd, me4, f4, f3, f4);
+            }
+
+            // mndiv programs the plan dco_and_divs found; they must agree.
+            if (!rc != !mrc || (!rc && (md3 != d3 || md4 != d4 || mfdco != fdco))) {
+                printf("%.9g/%.9g: dco_and_divs rc=%d and mndiv rc=%d disagree  "
+                       "REGRESSION\n", f3, f4, rc, mrc);
+                failures++;
+            }
+            // A 1PPS output must stay exactly 1 Hz.
+            if (!rc && ((f3 == 1.0 && a3 != 1.0) || (f4 == 1.0 && a4 != 1.0))) {
+                printf("%.9g/%.9g: 1PPS output is %.12g/%.12g Hz  REGRESSION\n",
+                       f3, f4, a3, a4);
+                failures++;
+            }
+        }
+    }
+
+    printf("\ncorpus: %zu frequencies, %zu OUT3/OUT4 pairs (latency in us)\n",
+           BENCH_N_CORPUS, npairs);
+    printf("%-34s %6s %5s %9s %9s %9s %10s %12s\n", "planner", "calls", "fail",
+           "p50", "p90", "p99", "max", "worst_ppb");
+    bench_stat_print(&in);
+    bench_stat_print(&dd);
+    bench_stat_print(&mnd);
+
+    // Every corpus frequency is reachable as an input; failures there are bugs.
+    failures += (int)in.fails;
+
+    free(in.us);
+    free(dd.us);
+    free(mnd.us);
+    printf("\ncorpus: %d regression(s)\n", failures);
+    return failures;
+}
+
+// The batch API must return exactly what the single-request solvers return.
+static int bench_batch(void)
+{
+    const size_t n = 2 * BENCH_N_CORPUS * BENCH_N_CORPUS;
+    cm_fp_batch_req_t *req = calloc(n, sizeof(*req));
+    cm_fp_batch_res_t *res = calloc(n, sizeof(*res));
+    int failures = 0;
+
+    if (!req || !res) {
+        fprintf(stderr, "planner_bench: out of memory\n");
+        free(req); free(res);
+        return 1;
+    }
+
+    // Every pair as an output request, every frequency as an input request
+    // (repeated, as a wizard revalidating candidates would).
+    size_t k = 0;
+    for (size_t i = 0; i < BENCH_N_CORPUS; i++) {
+        for (size_t j = 0; j < BENCH_N_CORPUS; j++) {
+            req[k].kind = CM_FP_BATCH_DCO;
+            req[k].nfreq = 2;
+            cm_freq_from_double(bench_corpus[i].hz, &req[k].freq[0]);
+            cm_freq_from_double(bench_corpus[j].hz, &req[k].freq[1]);
+            k++;
+            req[k].kind = CM_FP_BATCH_INPUT;
+            req[k].nfreq = 1;
+            cm_freq_from_double(bench_corpus[j].hz, &req[k].freq[0]);
+            k++;
+        }
+    }
+
+    cm_fp_plan_batch(req, n, NULL, res);    // warm-up, as for the loop below
+    double t0 = bench_now();
+    int nok = cm_fp_plan_batch(req, n, NULL, res);
+    double t_batch = bench_now() - t0;
+
+    size_t shared = 0;
+    t0 = bench_now();
+    for (k = 0; k < n; k++) {
+        cm_fp_plan_t single;
+        int rc;
+        shared += (size_t)res[k].shared;
+        if (req[k].kind == CM_FP_BATCH_DCO) {
+            rc = cm_fp_plan_dco(req[k].freq, 2, NULL, &single);
+        } else {
+            uint64_t M; uint16_t N; double a, e;
+            rc = dpll_compute_input_ratio(cm_freq_to_double(req[k].freq[0]), &M, &N, &a, &e);
+            single.m = M;
+            single.n_reg = N;
+        }
+        int bad = rc != res[k].rc ||
+                  (rc == 0 && (single.m != res[k].plan.m || single.n_reg != res[k].plan.n_reg ||
+                               (req[k].kind == CM_FP_BATCH_DCO &&
+                                (single.div[0] != res[k].plan.div[0] ||
+                                 single.div[1] != res[k].plan.div[1]))));
+        if (bad) {
+            printf("batch request %zu differs from the single-request solver  REGRESSION\n", k);
+            failures++;
+        }
+    }
+    double t_single = bench_now() - t0;
+
+    printf("\nbatch: %zu requests (%zu shared), %d planned, %d regression(s)\n",
+           n, shared, nok, failures);
+    printf("  one batch call:       %10.3f ms\n", t_batch * 1e3);
+    printf("  one call per request: %10.3f ms\n", t_single * 1e3);
+
+    free(req);
+    free(res);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = bench_input_ratio();
+    failures += bench_output_plan();
+    failures += bench_multi_plan();
+    failures += bench_multi_budget();
+    failures += bench_1pps();
+    failures += bench_corpus_run();
+    failures += bench_batch();
+    if (failures) {
+        fprintf(stderr, "planner_bench: %d regression(s)\n", failures);
+        return 1;
+    }
+    return 0;
+}
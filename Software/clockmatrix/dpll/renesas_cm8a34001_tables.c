@@ -1,1387 +1,1267 @@
 
 /* renesas_cm8a34001_tables.c - generated tables */
 #include "renesas_cm8a34001_tables.h"
+#include "cm_freqplan.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-static const uint16_t cm_Status_bases[1] = {0xC03C};
-static const cm_field_desc_t cm_Status_reg_0_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 4, 4},
-    {CM_NAME_STR("I2CM_SPEED"), 2, 2},
-    {CM_NAME_STR("I2CM_PORT_SEL"), 0, 2},
-};
-static const cm_field_desc_t cm_Status_reg_1_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 3, 5},
-    {CM_NAME_STR("ADDRESS_SIZE"), 2, 1},
-    {CM_NAME_STR("MODE"), 0, 2},
-};
-static const cm_field_desc_t cm_Status_reg_2_fields[5] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("SPI_SDO_DELAY"), 4, 1},
-    {CM_NAME_STR("SPI_CLOCK_SELECTION"), 3, 1},
-    {CM_NAME_STR("SPI_DUPLEX_MODE"), 2, 1},
-    {CM_NAME_STR("RESERVED_0"), 0, 2},
-};
-static const cm_field_desc_t cm_Status_reg_3_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 7, 1},
-    {CM_NAME_STR("DEVICE_ADDRESS"), 0, 7},
-};
-static const cm_field_desc_t cm_Status_reg_4_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 3, 5},
-    {CM_NAME_STR("ADDRESS_SIZE"), 2, 1},
-    {CM_NAME_STR("MODE"), 0, 2},
-};
-static const cm_field_desc_t cm_Status_reg_5_fields[5] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("SPI_SDO_DELAY"), 4, 1},
-    {CM_NAME_STR("SPI_CLOCK_SELECTION"), 3, 1},
-    {CM_NAME_STR("SPI_DUPLEX_MODE"), 2, 1},
-    {CM_NAME_STR("RESERVED_0"), 0, 2},
-};
-static const cm_field_desc_t cm_Status_reg_6_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 7, 1},
-    {CM_NAME_STR("DEVICE_ADDRESS"), 0, 7},
-};
-static const cm_field_desc_t cm_Status_reg_7_fields[1] = {
-    {CM_NAME_STR(""), 0, 0}};
-static const cm_field_desc_t cm_Status_reg_8_fields[4] = {
-    {CM_NAME_STR("RESERVED"), 6, 2},
-    {CM_NAME_STR("DPLL_SYS_HOLDOVER_STATE_CHANGE_STICKY"), 5, 1},
-    {CM_NAME_STR("DPLL_SYS_LOCK_STATE_CHANGE_STICKY"), 4, 1},
-    {CM_NAME_STR("DPLL_SYS_STATE"), 0, 4},
-};
-static const cm_field_desc_t cm_Status_reg_9_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("DPLL{num}_INPUT"), 0, 5},
-};
-static const cm_field_desc_t cm_Status_reg_10_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("DPLL_SYS_INPUT"), 0, 5},
-};
-static const cm_field_desc_t cm_Status_reg_13_fields[1] = {
-    {CM_NAME_STR(""), 0, 0}};
-static const cm_field_desc_t cm_Status_reg_14_fields[1] = {
-    {CM_NAME_STR(""), 0, 0}};
-static const cm_field_desc_t cm_Status_reg_15_fields[1] = {
-    {CM_NAME_STR("FFO_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_Status_reg_16_fields[2] = {
-    {CM_NAME_STR("FFO_UNIT"), 6, 2},
-    {CM_NAME_STR("FFO_13:8"), 0, 6},
-};
-static const cm_field_desc_t cm_Status_reg_11_fields[1] = {
-    {CM_NAME_STR("FILTER_STATUS"), 0, 8},
-};
-static const cm_field_desc_t cm_Status_reg_phase_status_fields[1] = {
-    {CM_NAME_STR("PHASE_STATUS"), 0, 8},
-};
-static const cm_field_desc_t cm_Status_reg_dpll_fields[3] = {
-    {CM_NAME_STR("HOLDOVER_STATE_CHANGE_STICKY"), 5, 1},
-    {CM_NAME_STR("LOCK_STATE_CHANGE_STICKY"), 4, 1},
-    {CM_NAME_STR("DPLL_STATE"), 0, 4}};
-static const cm_reg_desc_t cm_Status_regs[] = {
-    {CM_NAME_STR("I2CM_STATUS"), 0x000, cm_Status_reg_0_fields, 3},
-    {CM_NAME_STR("SER0_STATUS"), 0x002, cm_Status_reg_1_fields, 3},
-    {CM_NAME_STR("SER0_SPI_STATUS"), 0x003, cm_Status_reg_2_fields, 5},
-    {CM_NAME_STR("SER0_I2C_STATUS"), 0x004, cm_Status_reg_3_fields, 2},
-    {CM_NAME_STR("SER1_STATUS"), 0x005, cm_Status_reg_4_fields, 3},
-    {CM_NAME_STR("SER1_SPI_STATUS"), 0x006, cm_Status_reg_5_fields, 5},
-    {CM_NAME_STR("SER1_I2C_STATUS"), 0x007, cm_Status_reg_6_fields, 2},
-    {CM_NAME_STR("IN{num}_MON_STATUS"), 0x008, cm_Status_reg_7_fields, 0},
-    {CM_NAME_STR("DPLL0_STATUS"), 0x018, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL1_STATUS"), 0x019, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL2_STATUS"), 0x01a, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL3_STATUS"), 0x01b, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL4_STATUS"), 0x01c, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL5_STATUS"), 0x01d, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL6_STATUS"), 0x01e, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("DPLL7_STATUS"), 0x01f, cm_Status_reg_dpll_fields, 3},
-    {CM_NAME_STR("SYS_DPLL"), 0x020, cm_Status_reg_8_fields, 4},
-    {CM_NAME_STR("DPLL{num}_REF_STATUS"), 0x022, cm_Status_reg_9_fields, 2},
-    {CM_NAME_STR("DPLL_SYS_REF_STATUS"), 0x02A, cm_Status_reg_10_fields, 2},
-    {CM_NAME_STR("DPLL0_FILTER_STATUS"), 0x044, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL1_FILTER_STATUS"), 0x04c, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL2_FILTER_STATUS"), 0x054, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL3_FILTER_STATUS"), 0x05c, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL4_FILTER_STATUS"), 0x064, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL5_FILTER_STATUS"), 0x06c, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL6_FILTER_STATUS"), 0x074, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL7_FILTER_STATUS"), 0x07c, cm_Status_reg_11_fields, 1},
-    {CM_NAME_STR("DPLL_SYS_FILTER_STATUS"), 0x084, cm_Status_reg_11_fields, 1},
-
-    {CM_NAME_STR("USER_GPIO0_TO_7_STATUS"), 0x08A, cm_Status_reg_13_fields, 0},
-    {CM_NAME_STR("USER_GPIO8_TO_15_STATUS"), 0x08B, cm_Status_reg_14_fields, 0},
-    {CM_NAME_STR("IN{num}_MON_FREQ_STATUS_0"), 0x08C, cm_Status_reg_15_fields,
-     1},
-    {CM_NAME_STR("IN{num}_MON_FREQ_STATUS_1"), 0x08D, cm_Status_reg_16_fields,
-     2},
-    {CM_NAME_STR("DPLL0_PHASE_STATUS"), 0x0DC,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL1_PHASE_STATUS"), 0x0E4,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL2_PHASE_STATUS"), 0x0EC,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL3_PHASE_STATUS"), 0x0F4,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL4_PHASE_STATUS"), 0x0FC,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL5_PHASE_STATUS"), 0x104,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL6_PHASE_STATUS"), 0x10C,
-     cm_Status_reg_phase_status_fields, 1},
-    {CM_NAME_STR("DPLL7_PHASE_STATUS"), 0x114,
-     cm_Status_reg_phase_status_fields, 1},
-
+/* Descriptor sizes are part of the packed layout (see gen_cm_tables.py). */
+_Static_assert(sizeof(cm_field_desc_t) == 4, "cm_field_desc_t must be 4 bytes");
+_Static_assert(sizeof(cm_reg_desc_t) == 6, "cm_reg_desc_t must be 6 bytes");
+
+/* ---- BEGIN GENERATED by gen_cm_tables.py from renesas_cm8a34001_regs.txt ---- */
+
+#ifndef CM_STRIP_NAMES
+const char cm_names[] =
+    /*    0 */ "Status\0"
+    /*    7 */ "I2CM_STATUS\0"
+    /*   19 */ "RESERVED\0"
+    /*   28 */ "I2CM_SPEED\0"
+    /*   39 */ "I2CM_PORT_SEL\0"
+    /*   53 */ "SER0_STATUS\0"
+    /*   65 */ "ADDRESS_SIZE\0"
+    /*   78 */ "MODE\0"
+    /*   83 */ "SER0_SPI_STATUS\0"
+    /*   99 */ "SPI_SDO_DELAY\0"
+    /*  113 */ "SPI_CLOCK_SELECTION\0"
+    /*  133 */ "SPI_DUPLEX_MODE\0"
+    /*  149 */ "RESERVED_0\0"
+    /*  160 */ "SER0_I2C_STATUS\0"
+    /*  176 */ "DEVICE_ADDRESS\0"
+    /*  191 */ "SER1_STATUS\0"
+    /*  203 */ "SER1_SPI_STATUS\0"
+    /*  219 */ "SER1_I2C_STATUS\0"
+    /*  235 */ "IN{num}_MON_STATUS\0"
+    /*  254 */ "DPLL0_STATUS\0"
+    /*  267 */ "HOLDOVER_STATE_CHANGE_STICKY\0"
+    /*  296 */ "LOCK_STATE_CHANGE_STICKY\0"
+    /*  321 */ "DPLL_STATE\0"
+    /*  332 */ "DPLL1_STATUS\0"
+    /*  345 */ "DPLL2_STATUS\0"
+    /*  358 */ "DPLL3_STATUS\0"
+    /*  371 */ "DPLL4_STATUS\0"
+    /*  384 */ "DPLL5_STATUS\0"
+    /*  397 */ "DPLL6_STATUS\0"
+    /*  410 */ "DPLL7_STATUS\0"
+    /*  423 */ "SYS_DPLL\0"
+    /*  432 */ "DPLL_SYS_HOLDOVER_STATE_CHANGE_STICKY\0"
+    /*  470 */ "DPLL_SYS_LOCK_STATE_CHANGE_STICKY\0"
+    /*  504 */ "DPLL_SYS_STATE\0"
+    /*  519 */ "DPLL{num}_REF_STATUS\0"
+    /*  540 */ "DPLL{num}_INPUT\0"
+    /*  556 */ "DPLL_SYS_REF_STATUS\0"
+    /*  576 */ "DPLL_SYS_INPUT\0"
+    /*  591 */ "DPLL0_FILTER_STATUS\0"
+    /*  611 */ "FILTER_STATUS\0"
+    /*  625 */ "DPLL1_FILTER_STATUS\0"
+    /*  645 */ "DPLL2_FILTER_STATUS\0"
+    /*  665 */ "DPLL3_FILTER_STATUS\0"
+    /*  685 */ "DPLL4_FILTER_STATUS\0"
+    /*  705 */ "DPLL5_FILTER_STATUS\0"
+    /*  725 */ "DPLL6_FILTER_STATUS\0"
+    /*  745 */ "DPLL7_FILTER_STATUS\0"
+    /*  765 */ "DPLL_SYS_FILTER_STATUS\0"
+    /*  788 */ "USER_GPIO0_TO_7_STATUS\0"
+    /*  811 */ "USER_GPIO8_TO_15_STATUS\0"
+    /*  835 */ "IN{num}_MON_FREQ_STATUS_0\0"
+    /*  861 */ "FFO_7_0\0"
+    /*  869 */ "IN{num}_MON_FREQ_STATUS_1\0"
+    /*  895 */ "FFO_UNIT\0"
+    /*  904 */ "FFO_13:8\0"
+    /*  913 */ "DPLL0_PHASE_STATUS\0"
+    /*  932 */ "PHASE_STATUS\0"
+    /*  945 */ "DPLL1_PHASE_STATUS\0"
+    /*  964 */ "DPLL2_PHASE_STATUS\0"
+    /*  983 */ "DPLL3_PHASE_STATUS\0"
+    /* 1002 */ "DPLL4_PHASE_STATUS\0"
+    /* 1021 */ "DPLL5_PHASE_STATUS\0"
+    /* 1040 */ "DPLL6_PHASE_STATUS\0"
+    /* 1059 */ "DPLL7_PHASE_STATUS\0"
+    /* 1078 */ "PWMEncoder\0"
+    /* 1089 */ "PWM_ENCODER_ID\0"
+    /* 1104 */ "ENCODER_ID\0"
+    /* 1115 */ "PWM_ENCODER_CNFG\0"
+    /* 1132 */ "PPS_SEL\0"
+    /* 1140 */ "SECONDARY_OUTPUT\0"
+    /* 1157 */ "TOD_SEL\0"
+    /* 1165 */ "PWM_ENCODER_SIGNATURE_0\0"
+    /* 1189 */ "FIFTH_SYMBOL\0"
+    /* 1202 */ "SIXTH_SYMBOL\0"
+    /* 1215 */ "SEVENTH_SYMBOL\0"
+    /* 1230 */ "EIGHTH_SYMBOL\0"
+    /* 1244 */ "PWM_ENCODER_SIGNATURE_1\0"
+    /* 1268 */ "FIRST_SYMBOL\0"
+    /* 1281 */ "SECOND_SYMBOL\0"
+    /* 1295 */ "THIRD_SYMBOL\0"
+    /* 1308 */ "FOURTH_SYMBOL\0"
+    /* 1322 */ "PWM_ENCODER_CMD\0"
+    /* 1338 */ "TOD_AUTO_UPDATE\0"
+    /* 1354 */ "TOD_TX\0"
+    /* 1361 */ "SIGNATURE_MODE\0"
+    /* 1376 */ "ENABLE\0"
+    /* 1383 */ "PWMDecoder\0"
+    /* 1394 */ "PWM_DECODER_CNFG\0"
+    /* 1411 */ "PPS_RATE_0_7\0"
+    /* 1424 */ "PWM_DECODER_CNFG_1\0"
+    /* 1443 */ "GENERATE_PPS\0"
+    /* 1456 */ "PPS_RATE_8_14\0"
+    /* 1470 */ "PWM_DECODER_ID\0"
+    /* 1485 */ "DECODER_ID\0"
+    /* 1496 */ "PWM_DECODER_SIGNATURE_0\0"
+    /* 1520 */ "PWM_DECODER_SIGNATURE_1\0"
+    /* 1544 */ "PWM_DECODER_CMD\0"
+    /* 1560 */ "TOD_FRAME_ACCESS_EN\0"
+    /* 1580 */ "TOD\0"
+    /* 1584 */ "TOD_CFG\0"
+    /* 1592 */ "TOD_EVEN_PPS_MODE\0"
+    /* 1610 */ "TOD_OUT_SYNC_DISABLE\0"
+    /* 1631 */ "TOD_ENABLE\0"
+    /* 1642 */ "TODWrite\0"
+    /* 1651 */ "TOD_WRITE_SUBNS\0"
+    /* 1667 */ "SUBNS\0"
+    /* 1673 */ "TOD_WRITE_NS_0_7\0"
+    /* 1690 */ "NS_0_7\0"
+    /* 1697 */ "TOD_WRITE_NS_8_15\0"
+    /* 1715 */ "NS_8_15\0"
+    /* 1723 */ "TOD_WRITE_NS_16_23\0"
+    /* 1742 */ "NS_16_23\0"
+    /* 1751 */ "TOD_WRITE_NS_24_31\0"
+    /* 1770 */ "NS_24_31\0"
+    /* 1779 */ "TOD_WRITE_SECONDS_0_7\0"
+    /* 1801 */ "SECONDS_0_7\0"
+    /* 1813 */ "TOD_WRITE_SECONDS_8_15\0"
+    /* 1836 */ "SECONDS_8_15\0"
+    /* 1849 */ "TOD_WRITE_SECONDS_16_23\0"
+    /* 1873 */ "SECONDS_16_23\0"
+    /* 1887 */ "TOD_WRITE_SECONDS_24_31\0"
+    /* 1911 */ "SECONDS_24_31\0"
+    /* 1925 */ "TOD_WRITE_SECONDS_32_39\0"
+    /* 1949 */ "SECONDS_32_39\0"
+    /* 1963 */ "TOD_WRITE_SECONDS_40_47\0"
+    /* 1987 */ "SECONDS_40_47\0"
+    /* 2001 */ "TOD_WRITE_RESERVED_0\0"
+    /* 2022 */ "TOD_WRITE_COUNTER\0"
+    /* 2040 */ "WRITE_COUNTER\0"
+    /* 2054 */ "TOD_WRITE_SELECT_CFG_0\0"
+    /* 2077 */ "PWM_DECODER_INDEX\0"
+    /* 2095 */ "REF_INDEX\0"
+    /* 2105 */ "TOD_WRITE_RESERVED_1\0"
+    /* 2126 */ "TOD_WRITE_CMD\0"
+    /* 2140 */ "TOD_WRITE_TYPE\0"
+    /* 2155 */ "TOD_WRITE_SELECTION\0"
+    /* 2175 */ "TODReadPrimary\0"
+    /* 2190 */ "TOD_READ_PRIMARY_SUBNS\0"
+    /* 2213 */ "TOD_READ_PRIMARY_NS_0_7\0"
+    /* 2237 */ "TOD_READ_PRIMARY_NS_8_15\0"
+    /* 2262 */ "TOD_READ_PRIMARY_NS_16_23\0"
+    /* 2288 */ "TOD_READ_PRIMARY_NS_24_31\0"
+    /* 2314 */ "TOD_READ_PRIMARY_SECONDS_0_7\0"
+    /* 2343 */ "TOD_READ_PRIMARY_SECONDS_8_15\0"
+    /* 2373 */ "TOD_READ_PRIMARY_SECONDS_16_23\0"
+    /* 2404 */ "TOD_READ_PRIMARY_SECONDS_24_31\0"
+    /* 2435 */ "TOD_READ_PRIMARY_SECONDS_32_39\0"
+    /* 2466 */ "TOD_READ_PRIMARY_SECONDS_40_47\0"
+    /* 2497 */ "TOD_READ_PRIMARY_COUNTER\0"
+    /* 2522 */ "READ_COUNTER\0"
+    /* 2535 */ "TOD_READ_PRIMARY_SEL_CFG_0\0"
+    /* 2562 */ "TOD_READ_PRIMARY_SEL_CFG_1\0"
+    /* 2589 */ "DPLL_INDEX\0"
+    /* 2600 */ "TOD_READ_PRIMARY_CMD\0"
+    /* 2621 */ "TOD_READ_TRIGGER_MODE\0"
+    /* 2643 */ "TOD_READ_TRIGGER\0"
+    /* 2660 */ "TODReadSecondary\0"
+    /* 2677 */ "TOD_READ_SECONDARY_SUBNS\0"
+    /* 2702 */ "TOD_READ_SECONDARY_NS_0_7\0"
+    /* 2728 */ "TOD_READ_SECONDARY_NS_8_15\0"
+    /* 2755 */ "TOD_READ_SECONDARY_NS_16_23\0"
+    /* 2783 */ "TOD_READ_SECONDARY_NS_24_31\0"
+    /* 2811 */ "TOD_READ_SECONDARY_SECONDS_0_7\0"
+    /* 2842 */ "TOD_READ_SECONDARY_SECONDS_8_15\0"
+    /* 2874 */ "TOD_READ_SECONDARY_SECONDS_16_23\0"
+    /* 2907 */ "TOD_READ_SECONDARY_SECONDS_24_31\0"
+    /* 2940 */ "TOD_READ_SECONDARY_SECONDS_32_39\0"
+    /* 2973 */ "TOD_READ_SECONDARY_SECONDS_40_47\0"
+    /* 3006 */ "TOD_READ_SECONDARY_COUNTER\0"
+    /* 3033 */ "TOD_READ_SECONDARY_SEL_CFG_0\0"
+    /* 3062 */ "TOD_READ_SECONDARY_SEL_CFG_1\0"
+    /* 3091 */ "TOD_READ_SECONDARY_CMD\0"
+    /* 3114 */ "Input\0"
+    /* 3120 */ "INPUT_IN_FREQ_M_0_7\0"
+    /* 3140 */ "M_0_7\0"
+    /* 3146 */ "INPUT_IN_FREQ_M_8_15\0"
+    /* 3167 */ "M_8_15\0"
+    /* 3174 */ "INPUT_IN_FREQ_M_16_23\0"
+    /* 3196 */ "M_16_23\0"
+    /* 3204 */ "INPUT_IN_FREQ_M_24_31\0"
+    /* 3226 */ "M_24_31\0"
+    /* 3234 */ "INPUT_IN_FREQ_M_32_39\0"
+    /* 3256 */ "M_32_39\0"
+    /* 3264 */ "INPUT_IN_FREQ_M_40_47\0"
+    /* 3286 */ "M_40_47\0"
+    /* 3294 */ "INPUT_IN_FREQ_N_0_7\0"
+    /* 3314 */ "N_0_7\0"
+    /* 3320 */ "INPUT_IN_FREQ_N_8_15\0"
+    /* 3341 */ "N_8_15\0"
+    /* 3348 */ "INPUT_IN_DIV_0_7\0"
+    /* 3365 */ "IN_DIV_0_7\0"
+    /* 3376 */ "INPUT_IN_DIV_8_15\0"
+    /* 3394 */ "IN_DIV_8_15\0"
+    /* 3406 */ "INPUT_IN_PHASE_0_7\0"
+    /* 3425 */ "IN_PHASE_0_7\0"
+    /* 3438 */ "INPUT_IN_PHASE_8_15\0"
+    /* 3458 */ "IN_PHASE_8_15\0"
+    /* 3472 */ "INPUT_IN_SYNC\0"
+    /* 3486 */ "FRAME_SYNC_PULSE_EN\0"
+    /* 3506 */ "FRAME_SYNC_RESAMPLE_EDGE\0"
+    /* 3531 */ "FRAME_SYNC_RESAMPLE_EN\0"
+    /* 3554 */ "FRAME_SYNC_PULSE\0"
+    /* 3571 */ "INPUT_IN_MODE\0"
+    /* 3585 */ "DPLL_PRED\0"
+    /* 3595 */ "MUX_GPIO_IN\0"
+    /* 3607 */ "IN_DIFF\0"
+    /* 3615 */ "IN_PNMODE\0"
+    /* 3625 */ "IN_INVERSE\0"
+    /* 3636 */ "IN_EN\0"
+    /* 3642 */ "Output\0"
+    /* 3649 */ "OUT_DIV\0"
+    /* 3657 */ "Value\0"
+    /* 3663 */ "OUT_PHASE_ADJ_7_0\0"
+    /* 3681 */ "OUT_PHASE_ADJ_15_8\0"
+    /* 3700 */ "OUT_PHASE_ADJ_23_16\0"
+    /* 3720 */ "OUT_PHASE_ADJ_31_24\0"
+    /* 3740 */ "REFMON\0"
+    /* 3747 */ "REF_MON_IN_MON_FREQ_CFG\0"
+    /* 3771 */ "VLD_INTERVAL\0"
+    /* 3784 */ "FREQ_OFFS_LIM\0"
+    /* 3798 */ "REF_MON_IN_MON_FREQ_VLD_INTV\0"
+    /* 3827 */ "VLD_INTERVAL_SHORT\0"
+    /* 3846 */ "REF_MON_IN_MON_TRANS_THRESHOLD_0_7\0"
+    /* 3881 */ "IN_MON_TRANS_THRESHOLD_0_7\0"
+    /* 3908 */ "REF_MON_IN_MON_TRANS_THRESHOLD_8_15\0"
+    /* 3944 */ "IN_MON_TRANS_THRESHOLD_8_15\0"
+    /* 3972 */ "REF_MON_IN_MON_TRANS_PERIOD_0_7\0"
+    /* 4004 */ "IN_MON_TRANS_PERIOD_0_7\0"
+    /* 4028 */ "REF_MON_IN_MON_TRANS_PERIOD_8_15\0"
+    /* 4061 */ "IN_MON_TRANS_PERIOD_8_15\0"
+    /* 4086 */ "REF_MON_IN_MON_ACT_CFG\0"
+    /* 4109 */ "QUAL_TIMER\0"
+    /* 4120 */ "DSQUAL_TIMER\0"
+    /* 4133 */ "ACT_LIM\0"
+    /* 4141 */ "REF_MON_IN_MON_LOS_TOLERANCE_0_7\0"
+    /* 4174 */ "IN_MON_LOS_TOLERANCE_0_7\0"
+    /* 4199 */ "REF_MON_IN_MON_LOS_TOLERANCE_8_15\0"
+    /* 4233 */ "IN_MON_LOS_TOLERANCE_8_15\0"
+    /* 4259 */ "REF_MON_IN_MON_LOS_CFG\0"
+    /* 4282 */ "LOS_GAP\0"
+    /* 4290 */ "LOS_MARGIN\0"
+    /* 4301 */ "REF_MON_IN_MON_CFG\0"
+    /* 4320 */ "DIV_OR_NON_DIV_CLK_SELECT\0"
+    /* 4346 */ "TRANS_DETECTOR_EN\0"
+    /* 4364 */ "MASK_ACTIVITY\0"
+    /* 4378 */ "MASK_FREQ\0"
+    /* 4388 */ "MASK_LOS\0"
+    /* 4397 */ "EN\0"
+    /* 4400 */ "PWM_USER_DATA\0"
+    /* 4414 */ "PWM_USER_DATA_PWM_SRC_ENCODER_ID\0"
+    /* 4447 */ "PWM_USER_DATA_PWM_DST_DECODER_ID\0"
+    /* 4480 */ "PWM_USER_DATA_PWM_USER_DATA_SIZE\0"
+    /* 4513 */ "BYTES\0"
+    /* 4519 */ "PWM_USER_DATA_PWM_USER_DATA_CMD_STS\0"
+    /* 4555 */ "COMMAND_STATUS\0"
+    /* 4570 */ "EEPROM\0"
+    /* 4577 */ "EEPROM_I2C_ADDR\0"
+    /* 4593 */ "I2C_ADDR\0"
+    /* 4602 */ "EEPROM_SIZE\0"
+    /* 4614 */ "EEPROM_OFFSET_LOW\0"
+    /* 4632 */ "EEPROM_OFFSET\0"
+    /* 4646 */ "EEPROM_OFFSET_HIGH\0"
+    /* 4665 */ "EEPROM_CMD_LOW\0"
+    /* 4680 */ "EEPROM_CMD\0"
+    /* 4691 */ "EEPROM_CMD_HIGH\0"
+    /* 4707 */ "EEPROM_DATA\0"
+    /* 4719 */ "BYTE_OTP_EEPROM_PWM_BUFF_{i}\0"
+    /* 4748 */ "DATA\0"
+    /* 4753 */ "OUTPUT_TDC_CFG\0"
+    /* 4768 */ "OUTPUT_TDC_CFG_GBL_0_0_7\0"
+    /* 4793 */ "FAST_LOCK_ENABLE_DELAY_0_7\0"
+    /* 4820 */ "OUTPUT_TDC_CFG_GBL_0_8_15\0"
+    /* 4846 */ "FAST_LOCK_ENABLE_DELAY_8_15\0"
+    /* 4874 */ "OUTPUT_TDC_CFG_GBL_1_0_7\0"
+    /* 4899 */ "FAST_LOCK_DISABLE_DELAY_0_7\0"
+    /* 4927 */ "OUTPUT_TDC_CFG_GBL_1_8_15\0"
+    /* 4953 */ "FAST_LOCK_DISABLE_DELAY_8_15\0"
+    /* 4982 */ "OUTPUT_TDC_CFG_GBL_2\0"
+    /* 5003 */ "REF_SEL\0"
+    /* 5011 */ "OUTPUT_TDC\0"
+    /* 5022 */ "OUTPUT_TDC_CTRL_0_0_7\0"
+    /* 5044 */ "SAMPLES_0_7\0"
+    /* 5056 */ "OUTPUT_TDC_CTRL_0_8_15\0"
+    /* 5079 */ "SAMPLES_8_15\0"
+    /* 5092 */ "OUTPUT_TDC_CTRL_1_0_7\0"
+    /* 5114 */ "TARGET_PHASE_OFFSET_0_7\0"
+    /* 5138 */ "OUTPUT_TDC_CTRL_1_8_15\0"
+    /* 5161 */ "TARGET_PHASE_OFFSET_8_15\0"
+    /* 5186 */ "OUTPUT_TDC_CTRL_2\0"
+    /* 5204 */ "ALIGN_TARGET_MASK\0"
+    /* 5222 */ "OUTPUT_TDC_CTRL_3\0"
+    /* 5240 */ "TARGET_INDEX\0"
+    /* 5253 */ "SOURCE_INDEX\0"
+    /* 5266 */ "OUTPUT_TDC_CTRL_4\0"
+    /* 5284 */ "DISABLE_MEASUREMENT_FILTER\0"
+    /* 5311 */ "ALIGN_THRESHOLD_COUNT\0"
+    /* 5333 */ "ALIGN_RESET\0"
+    /* 5345 */ "TYPE\0"
+    /* 5350 */ "GO\0"
+    /* 5353 */ "INPUT_TDC\0"
+    /* 5363 */ "INPUT_TDC_SDM_FRAC_0_7\0"
+    /* 5386 */ "SDM_FRAC_0_7\0"
+    /* 5399 */ "INPUT_TDC_SDM_FRAC_8_15\0"
+    /* 5423 */ "SDM_FRAC_8_15\0"
+    /* 5437 */ "INPUT_TDC_SDM_MOD_0_7\0"
+    /* 5459 */ "SDM_MOD_0_7\0"
+    /* 5471 */ "INPUT_TDC_SDM_MOD_8_15\0"
+    /* 5494 */ "SDM_MOD_8_15\0"
+    /* 5507 */ "INPUT_TDC_FBD_CTRL\0"
+    /* 5526 */ "FBD_USER_CONFIG_EN\0"
+    /* 5545 */ "FBD_INTEGER\0"
+    /* 5557 */ "INPUT_TDC_CTRL\0"
+    /* 5572 */ "SDM_ORDER\0"
+    /* 5582 */ "PWM_SYNC_ENCODER\0"
+    /* 5599 */ "PWM_SYNC_ENCODER_PAYLOAD_CNFG\0"
+    /* 5629 */ "PAYLOAD_CH_EN_7\0"
+    /* 5645 */ "PAYLOAD_CH_EN_6\0"
+    /* 5661 */ "PAYLOAD_CH_EN_5\0"
+    /* 5677 */ "PAYLOAD_CH_EN_4\0"
+    /* 5693 */ "PAYLOAD_CH_EN_3\0"
+    /* 5709 */ "PAYLOAD_CH_EN_2\0"
+    /* 5725 */ "PAYLOAD_CH_EN_1\0"
+    /* 5741 */ "PAYLOAD_CH_EN_0\0"
+    /* 5757 */ "PWM_SYNC_ENCODER_PAYLOAD_SQUELCH_CNFG\0"
+    /* 5795 */ "PAYLOAD_SQUELCH_7\0"
+    /* 5813 */ "PAYLOAD_SQUELCH_6\0"
+    /* 5831 */ "PAYLOAD_SQUELCH_5\0"
+    /* 5849 */ "PAYLOAD_SQUELCH_4\0"
+    /* 5867 */ "PAYLOAD_SQUELCH_3\0"
+    /* 5885 */ "PAYLOAD_SQUELCH_2\0"
+    /* 5903 */ "PAYLOAD_SQUELCH_1\0"
+    /* 5921 */ "PAYLOAD_SQUELCH_0\0"
+    /* 5939 */ "PWM_SYNC_ENCODER_CMD\0"
+    /* 5960 */ "PWM_SYNC_PHASE_CORR_DISABLE\0"
+    /* 5988 */ "PWM_SYNC\0"
+    /* 5997 */ "PWM_SYNC_DECODER\0"
+    /* 6014 */ "PWM_SYNC_DECODER_PAYLOAD_CNFG_0\0"
+    /* 6046 */ "SRC_CH_IDX_1\0"
+    /* 6059 */ "SRC_CH_IDX_0\0"
+    /* 6072 */ "PWM_SYNC_DECODER_PAYLOAD_CNFG_1\0"
+    /* 6104 */ "SRC_CH_IDX_3\0"
+    /* 6117 */ "SRC_CH_IDX_2\0"
+    /* 6130 */ "PWM_SYNC_DECODER_PAYLOAD_CNFG_2\0"
+    /* 6162 */ "SRC_CH_IDX_5\0"
+    /* 6175 */ "SRC_CH_IDX_4\0"
+    /* 6188 */ "PWM_SYNC_DECODER_PAYLOAD_CNFG_3\0"
+    /* 6220 */ "SRC_CH_IDX_7\0"
+    /* 6233 */ "SRC_CH_IDX_6\0"
+    /* 6246 */ "PWM_SYNC_DECODER_CMD\0"
+    /* 6267 */ "PWM_OUTPUT_SQUELCH\0"
+    /* 6286 */ "PWM_CO_LOCATED_CR\0"
+    /* 6304 */ "PWM_SYNC_CR_IDX\0"
+    /* 6320 */ "PWM_Rx_Info\0"
+    /* 6332 */ "PWM_TOD_SUBNS\0"
+    /* 6346 */ "VALUE\0"
+    /* 6352 */ "PWM_TOD_NS_7_0\0"
+    /* 6367 */ "PWM_TOD_NS_15_8\0"
+    /* 6383 */ "PWM_TOD_NS_23_16\0"
+    /* 6400 */ "PWM_TOD_NS_31_24\0"
+    /* 6417 */ "PWM_TOD_SEC_7_0\0"
+    /* 6433 */ "PWM_TOD_SEC_15_8\0"
+    /* 6450 */ "PWM_TOD_SEC_23_16\0"
+    /* 6468 */ "PWM_TOD_SEC_31_24\0"
+    /* 6486 */ "PWM_TOD_SEC_39_32\0"
+    /* 6504 */ "PWM_RandID\0"
+    /* 6515 */ "PWM_TOD_SEC_47_40\0"
+    /* 6533 */ "DataFlag\0"
+    /* 6542 */ "HandshakeData\0"
+    /* 6556 */ "PWM_Transaction_ID\0"
+    /* 6575 */ "DPLL_Ctrl\0"
+    /* 6585 */ "DPLL_DECIMATOR_BW_MULT\0"
+    /* 6608 */ "DPLL_BW_0\0"
+    /* 6618 */ "BW_7_0\0"
+    /* 6625 */ "DPLL_BW_1\0"
+    /* 6635 */ "BW_13_8\0"
+    /* 6643 */ "BW_UNIT\0"
+    /* 6651 */ "DPLL_PSL_7_0\0"
+    /* 6664 */ "DPLL_PSL_15_8\0"
+    /* 6678 */ "DPLL_LOOP_FILTER_CFG\0"
+    /* 6699 */ "DAMP_FTR\0"
+    /* 6708 */ "DPLL_PHASE_OFFSET_CFG_7_0\0"
+    /* 6734 */ "DPLL_PHASE_OFFSET_CFG_15_8\0"
+    /* 6761 */ "DPLL_PHASE_OFFSET_CFG_23_16\0"
+    /* 6789 */ "DPLL_PHASE_OFFSET_CFG_31_24\0"
+    /* 6817 */ "DPLL_PHASE_OFFSET_CFG_35_32\0"
+    /* 6845 */ "DPLL_FINE_PHASE_ADV_CFG_7_0\0"
+    /* 6873 */ "DPLL_FINE_PHASE_ADV_CFG_12_8\0"
+    /* 6902 */ "FOD_FREQ_M_7_0\0"
+    /* 6917 */ "FOD_FREQ_M_15_8\0"
+    /* 6933 */ "FOD_FREQ_M_23_16\0"
+    /* 6950 */ "FOD_FREQ_M_31_24\0"
+    /* 6967 */ "FOD_FREQ_M_39_32\0"
+    /* 6984 */ "FOD_FREQ_M_47_40\0"
+    /* 7001 */ "FOD_FREQ_N_7_0\0"
+    /* 7016 */ "FOD_FREQ_N_15_8\0"
+    /* 7032 */ "DPLL_FRAME_PULSE_SYNC\0"
+    /* 7054 */ "DPLL_Freq_Write\0"
+    /* 7070 */ "DPLL_WR_FREQ_7_0\0"
+    /* 7087 */ "DPLL_WR_FREQ_15_8\0"
+    /* 7105 */ "DPLL_WR_FREQ_23_16\0"
+    /* 7124 */ "DPLL_WR_FREQ_31_24\0"
+    /* 7143 */ "DPLL_WR_FREQ_39_32\0"
+    /* 7162 */ "DPLL_WR_FREQ_41_40\0"
+    /* 7181 */ "Reserved\0"
+    /* 7190 */ "DPLL_Config\0"
+    /* 7202 */ "DPLL_DCO_INC_DEC_SIZE_7_0\0"
+    /* 7228 */ "DCO_INC_DEC_SIZE_7_0\0"
+    /* 7249 */ "DPLL_DCO_INC_DEC_SIZE_15_8\0"
+    /* 7276 */ "DCO_INC_DEC_SIZE_15_8\0"
+    /* 7298 */ "DPLL_CTRL_0\0"
+    /* 7310 */ "FORCE_LOCK_INPUT\0"
+    /* 7327 */ "GLOBAL_SYNC_EN\0"
+    /* 7342 */ "REVERTIVE_EN\0"
+    /* 7355 */ "HITLESS_EN\0"
+    /* 7366 */ "DPLL_CTRL_1\0"
+    /* 7378 */ "HITLESS_TYPE\0"
+    /* 7391 */ "FB_SELECT_REF\0"
+    /* 7405 */ "FB_SELECT_REF_EN\0"
+    /* 7422 */ "DPLL_CTRL_2\0"
+    /* 7434 */ "FRAME_SYNC_PULSE_RESYNC_EN\0"
+    /* 7461 */ "FRAME_SYNC_MODE\0"
+    /* 7477 */ "EXT_FB_REF_SELECT\0"
+    /* 7495 */ "EXT_FB_EN\0"
+    /* 7505 */ "DPLL_UPDATE_RATE_CFG\0"
+    /* 7526 */ "UPDATE_RATE_CFG\0"
+    /* 7542 */ "DPLL_FILTER_STATUS_UPDATE_CFG\0"
+    /* 7572 */ "FILTER_STATUS_UPDATE_EN\0"
+    /* 7596 */ "FILTER_STATUS_SELECT_CNFG\0"
+    /* 7622 */ "DPLL_HO_ADVCD_HISTORY\0"
+    /* 7644 */ "HISTORY\0"
+    /* 7652 */ "DPLL_HO_ADVCD_BW_7_0\0"
+    /* 7673 */ "DPLL_HO_ADVCD_BW_15_8\0"
+    /* 7695 */ "DPLL_HO_CFG\0"
+    /* 7707 */ "HOLDOVER_MODE\0"
+    /* 7721 */ "DPLL_LOCK_0\0"
+    /* 7733 */ "PHASE_UNIT\0"
+    /* 7744 */ "PHASE_LOCK_MAX_ERROR\0"
+    /* 7765 */ "DPLL_LOCK_1\0"
+    /* 7777 */ "PHASE_MON_DUR\0"
+    /* 7791 */ "DPLL_LOCK_2\0"
+    /* 7803 */ "FFO_LOCK_MAX_ERROR\0"
+    /* 7822 */ "DPLL_LOCK_3\0"
+    /* 7834 */ "FFO_MON_DUR\0"
+    /* 7846 */ "DPLL_REF_PRIORITY_0\0"
+    /* 7866 */ "PRIORITY_GROUP_NUMBER\0"
+    /* 7888 */ "PRIORITY_REF\0"
+    /* 7901 */ "PRIORITY_EN\0"
+    /* 7913 */ "DPLL_REF_PRIORITY_1\0"
+    /* 7933 */ "DPLL_REF_PRIORITY_2\0"
+    /* 7953 */ "DPLL_REF_PRIORITY_3\0"
+    /* 7973 */ "DPLL_TRANS_CTRL\0"
+    /* 7989 */ "TRANS_SUPPRESS_EN\0"
+    /* 8007 */ "TRANS_DETECT_EN\0"
+    /* 8023 */ "DPLL_FASTLOCK_CFG_0\0"
+    /* 8043 */ "LOCK_REC_PULL_IN_EN\0"
+    /* 8063 */ "LOCK_REC_FAST_ACQ_EN\0"
+    /* 8084 */ "LOCK_REC_PHASE_SNAP_EN\0"
+    /* 8107 */ "LOCK_REC_FREQ_SNAP_EN\0"
+    /* 8129 */ "LOCK_ACQ_PULL_IN_EN\0"
+    /* 8149 */ "LOCK_ACQ_FAST_ACQ_EN\0"
+    /* 8170 */ "LOCK_ACQ_PHASE_SNAP_EN\0"
+    /* 8193 */ "LOCK_ACQ_FREQ_SNAP_EN\0"
+    /* 8215 */ "DPLL_FASTLOCK_CFG_1\0"
+    /* 8235 */ "PRE_FAST_ACQ_TIMER\0"
+    /* 8254 */ "DPLL_MAX_FREQ_OFFSET\0"
+    /* 8275 */ "MAX_FFO\0"
+    /* 8283 */ "DPLL_FASTLOCK_PSL\0"
+    /* 8301 */ "DPLL_FASTLOCK_PSL_7_0\0"
+    /* 8323 */ "DPLL_FASTLOCK_PSL_15_8\0"
+    /* 8346 */ "DPLL_FASTLOCK_FSL\0"
+    /* 8364 */ "DPLL_FASTLOCK_FSL_7_0\0"
+    /* 8386 */ "DPLL_FASTLOCK_FSL_15_8\0"
+    /* 8409 */ "DPLL_FASTLOCK_BW\0"
+    /* 8426 */ "DPLL_FASTLOCK_BW_7_0\0"
+    /* 8447 */ "DPLL_FASTLOCK_BW_15_8\0"
+    /* 8469 */ "DPLL_WRITE_FREQ_TIMER\0"
+    /* 8491 */ "WRITE_FREQ_TIMEOUT_CNFG_7_0\0"
+    /* 8519 */ "DPLL_WRITE_FREQ_TIMER_15_8\0"
+    /* 8546 */ "WRITE_FREQ_TIMEOUT_CNFG_15_8\0"
+    /* 8575 */ "DPLL_WRITE_PHASE_TIMER\0"
+    /* 8598 */ "WRITE_PHASE_TIMEOUT_CNFG_7_0\0"
+    /* 8627 */ "DPLL_WRITE_PHASE_TIMER_15_8\0"
+    /* 8655 */ "WRITE_PHASE_TIMEOUT_CNFG_15_8\0"
+    /* 8685 */ "DPLL_PRED_CFG\0"
+    /* 8699 */ "WP_PRED\0"
+    /* 8707 */ "PRED_EN\0"
+    /* 8715 */ "DPLL_TOD_SYNC_CFG\0"
+    /* 8733 */ "TOD_SYNC_SOURCE\0"
+    /* 8749 */ "TOD_SYNC_EN\0"
+    /* 8761 */ "DPLL_COMBO_SLAVE_CFG_0\0"
+    /* 8784 */ "PRI_COMBO_SRC_EN\0"
+    /* 8801 */ "PRI_COMBO_SRC_FILTERED_CNFG\0"
+    /* 8829 */ "PRI_COMBO_SRC_ID\0"
+    /* 8846 */ "DPLL_COMBO_SLAVE_CFG_1\0"
+    /* 8869 */ "SEC_COMBO_SRC_EN\0"
+    /* 8886 */ "SEC_COMBO_SRC_FILTERED_CNFG\0"
+    /* 8914 */ "SEC_COMBO_SRC_ID\0"
+    /* 8931 */ "DPLL_SLAVE_REF_CFG\0"
+    /* 8950 */ "SLAVE_REFERENCE\0"
+    /* 8966 */ "DPLL_REF_MODE\0"
+    /* 8980 */ "DPLL_PHASE_MEASUREMENT_CFG\0"
+    /* 9007 */ "PFD_FB_CLK_SEL\0"
+    /* 9022 */ "PFD_REF_CLK_SEL\0"
+    /* 9038 */ "DPLL_MODE\0"
+    /* 9048 */ "WRITE_TIMER_MODE\0"
+    /* 9065 */ "PLL_MODE\0"
+    /* 9074 */ "STATE_MODE\0"
+    /* 9085 */ "DPLL_GeneralStatus\0"
+    /* 9104 */ "EEPROM_STATUS_7_0\0"
+    /* 9122 */ "EEPROM_STATUS_8_15\0"
+    /* 9141 */ "MAJOR RELEASE\0"
+    /* 9155 */ "MINOR RELEASE\0"
+    /* 9169 */ "HOTFIX RELEASE\0"
+    /* 9184 */ "JTAG DEVICE ID\0"
+    /* 9199 */ "PRODUCT ID\0";
+#else
+const char cm_names[1] = "";
+#endif
+
+const cm_field_desc_t cm_fields[286] = {
+    {19, 4, 4}, /*   0 RESERVED */
+    {28, 2, 2}, /*   1 I2CM_SPEED */
+    {39, 0, 2}, /*   2 I2CM_PORT_SEL */
+    {19, 3, 5}, /*   3 RESERVED */
+    {65, 2, 1}, /*   4 ADDRESS_SIZE */
+    {78, 0, 2}, /*   5 MODE */
+    {19, 5, 3}, /*   6 RESERVED */
+    {99, 4, 1}, /*   7 SPI_SDO_DELAY */
+    {113, 3, 1}, /*   8 SPI_CLOCK_SELECTION */
+    {133, 2, 1}, /*   9 SPI_DUPLEX_MODE */
+    {149, 0, 2}, /*  10 RESERVED_0 */
+    {19, 7, 1}, /*  11 RESERVED */
+    {176, 0, 7}, /*  12 DEVICE_ADDRESS */
+    {267, 5, 1}, /*  13 HOLDOVER_STATE_CHANGE_STICKY */
+    {296, 4, 1}, /*  14 LOCK_STATE_CHANGE_STICKY */
+    {321, 0, 4}, /*  15 DPLL_STATE */
+    {19, 6, 2}, /*  16 RESERVED */
+    {432, 5, 1}, /*  17 DPLL_SYS_HOLDOVER_STATE_CHANGE_STICKY */
+    {470, 4, 1}, /*  18 DPLL_SYS_LOCK_STATE_CHANGE_STICKY */
+    {504, 0, 4}, /*  19 DPLL_SYS_STATE */
+    {19, 5, 3}, /*  20 RESERVED */
+    {540, 0, 5}, /*  21 DPLL{num}_INPUT */
+    {19, 5, 3}, /*  22 RESERVED */
+    {576, 0, 5}, /*  23 DPLL_SYS_INPUT */
+    {611, 0, 8}, /*  24 FILTER_STATUS */
+    {861, 0, 8}, /*  25 FFO_7_0 */
+    {895, 6, 2}, /*  26 FFO_UNIT */
+    {904, 0, 6}, /*  27 FFO_13:8 */
+    {932, 0, 8}, /*  28 PHASE_STATUS */
+    {1104, 0, 8}, /*  29 ENCODER_ID */
+    {1132, 3, 1}, /*  30 PPS_SEL */
+    {1140, 2, 1}, /*  31 SECONDARY_OUTPUT */
+    {1157, 0, 2}, /*  32 TOD_SEL */
+    {1189, 6, 2}, /*  33 FIFTH_SYMBOL */
+    {1202, 4, 2}, /*  34 SIXTH_SYMBOL */
+    {1215, 2, 2}, /*  35 SEVENTH_SYMBOL */
+    {1230, 0, 2}, /*  36 EIGHTH_SYMBOL */
+    {1268, 6, 1}, /*  37 FIRST_SYMBOL */
+    {1281, 4, 2}, /*  38 SECOND_SYMBOL */
+    {1295, 2, 2}, /*  39 THIRD_SYMBOL */
+    {1308, 0, 2}, /*  40 FOURTH_SYMBOL */
+    {1338, 3, 1}, /*  41 TOD_AUTO_UPDATE */
+    {1354, 2, 1}, /*  42 TOD_TX */
+    {1361, 1, 1}, /*  43 SIGNATURE_MODE */
+    {1376, 0, 1}, /*  44 ENABLE */
+    {1411, 0, 8}, /*  45 PPS_RATE_0_7 */
+    {1443, 7, 1}, /*  46 GENERATE_PPS */
+    {1456, 0, 7}, /*  47 PPS_RATE_8_14 */
+    {1485, 0, 8}, /*  48 DECODER_ID */
+    {1560, 2, 1}, /*  49 TOD_FRAME_ACCESS_EN */
+    {1361, 1, 1}, /*  50 SIGNATURE_MODE */
+    {1376, 0, 1}, /*  51 ENABLE */
+    {1592, 2, 1}, /*  52 TOD_EVEN_PPS_MODE */
+    {1610, 1, 1}, /*  53 TOD_OUT_SYNC_DISABLE */
+    {1631, 0, 1}, /*  54 TOD_ENABLE */
+    {1667, 0, 8}, /*  55 SUBNS */
+    {1690, 0, 8}, /*  56 NS_0_7 */
+    {1715, 0, 8}, /*  57 NS_8_15 */
+    {1742, 0, 8}, /*  58 NS_16_23 */
+    {1770, 0, 8}, /*  59 NS_24_31 */
+    {1801, 0, 8}, /*  60 SECONDS_0_7 */
+    {1836, 0, 8}, /*  61 SECONDS_8_15 */
+    {1873, 0, 8}, /*  62 SECONDS_16_23 */
+    {1911, 0, 8}, /*  63 SECONDS_24_31 */
+    {1949, 0, 8}, /*  64 SECONDS_32_39 */
+    {1987, 0, 8}, /*  65 SECONDS_40_47 */
+    {19, 0, 8}, /*  66 RESERVED */
+    {2040, 0, 8}, /*  67 WRITE_COUNTER */
+    {2077, 4, 4}, /*  68 PWM_DECODER_INDEX */
+    {2095, 0, 4}, /*  69 REF_INDEX */
+    {2140, 4, 2}, /*  70 TOD_WRITE_TYPE */
+    {2155, 0, 4}, /*  71 TOD_WRITE_SELECTION */
+    {2522, 0, 8}, /*  72 READ_COUNTER */
+    {2589, 0, 3}, /*  73 DPLL_INDEX */
+    {2621, 4, 1}, /*  74 TOD_READ_TRIGGER_MODE */
+    {2643, 0, 4}, /*  75 TOD_READ_TRIGGER */
+    {3140, 0, 8}, /*  76 M_0_7 */
+    {3167, 0, 8}, /*  77 M_8_15 */
+    {3196, 0, 8}, /*  78 M_16_23 */
+    {3226, 0, 8}, /*  79 M_24_31 */
+    {3256, 0, 8}, /*  80 M_32_39 */
+    {3286, 0, 8}, /*  81 M_40_47 */
+    {3314, 0, 8}, /*  82 N_0_7 */
+    {3341, 0, 8}, /*  83 N_8_15 */
+    {3365, 0, 8}, /*  84 IN_DIV_0_7 */
+    {3394, 0, 8}, /*  85 IN_DIV_8_15 */
+    {3425, 0, 8}, /*  86 IN_PHASE_0_7 */
+    {3458, 0, 8}, /*  87 IN_PHASE_8_15 */
+    {3486, 7, 1}, /*  88 FRAME_SYNC_PULSE_EN */
+    {3506, 6, 1}, /*  89 FRAME_SYNC_RESAMPLE_EDGE */
+    {3531, 5, 1}, /*  90 FRAME_SYNC_RESAMPLE_EN */
+    {3554, 0, 5}, /*  91 FRAME_SYNC_PULSE */
+    {3585, 7, 1}, /*  92 DPLL_PRED */
+    {3595, 6, 1}, /*  93 MUX_GPIO_IN */
+    {3607, 5, 1}, /*  94 IN_DIFF */
+    {3615, 4, 1}, /*  95 IN_PNMODE */
+    {3625, 3, 1}, /*  96 IN_INVERSE */
+    {3636, 0, 1}, /*  97 IN_EN */
+    {3657, 0, 8}, /*  98 Value */
+    {3771, 3, 4}, /*  99 VLD_INTERVAL */
+    {3784, 0, 3}, /* 100 FREQ_OFFS_LIM */
+    {3827, 0, 8}, /* 101 VLD_INTERVAL_SHORT */
+    {3881, 0, 8}, /* 102 IN_MON_TRANS_THRESHOLD_0_7 */
+    {3944, 0, 8}, /* 103 IN_MON_TRANS_THRESHOLD_8_15 */
+    {4004, 0, 8}, /* 104 IN_MON_TRANS_PERIOD_0_7 */
+    {4061, 0, 8}, /* 105 IN_MON_TRANS_PERIOD_8_15 */
+    {4109, 5, 2}, /* 106 QUAL_TIMER */
+    {4120, 3, 2}, /* 107 DSQUAL_TIMER */
+    {4133, 0, 3}, /* 108 ACT_LIM */
+    {4174, 0, 8}, /* 109 IN_MON_LOS_TOLERANCE_0_7 */
+    {4233, 0, 8}, /* 110 IN_MON_LOS_TOLERANCE_8_15 */
+    {4282, 1, 2}, /* 111 LOS_GAP */
+    {4290, 0, 1}, /* 112 LOS_MARGIN */
+    {4320, 5, 1}, /* 113 DIV_OR_NON_DIV_CLK_SELECT */
+    {4346, 4, 1}, /* 114 TRANS_DETECTOR_EN */
+    {4364, 3, 1}, /* 115 MASK_ACTIVITY */
+    {4378, 2, 1}, /* 116 MASK_FREQ */
+    {4388, 1, 1}, /* 117 MASK_LOS */
+    {4397, 0, 1}, /* 118 EN */
+    {4513, 0, 8}, /* 119 BYTES */
+    {4555, 0, 8}, /* 120 COMMAND_STATUS */
+    {19, 7, 1}, /* 121 RESERVED */
+    {4593, 0, 7}, /* 122 I2C_ADDR */
+    {4632, 0, 8}, /* 123 EEPROM_OFFSET */
+    {4680, 0, 8}, /* 124 EEPROM_CMD */
+    {4748, 0, 8}, /* 125 DATA */
+    {4793, 0, 8}, /* 126 FAST_LOCK_ENABLE_DELAY_0_7 */
+    {4846, 0, 8}, /* 127 FAST_LOCK_ENABLE_DELAY_8_15 */
+    {4899, 0, 8}, /* 128 FAST_LOCK_DISABLE_DELAY_0_7 */
+    {4953, 0, 8}, /* 129 FAST_LOCK_DISABLE_DELAY_8_15 */
+    {19, 2, 6}, /* 130 RESERVED */
+    {5003, 1, 1}, /* 131 REF_SEL */
+    {1376, 0, 1}, /* 132 ENABLE */
+    {5044, 0, 8}, /* 133 SAMPLES_0_7 */
+    {5079, 0, 8}, /* 134 SAMPLES_8_15 */
+    {5114, 0, 8}, /* 135 TARGET_PHASE_OFFSET_0_7 */
+    {5161, 0, 8}, /* 136 TARGET_PHASE_OFFSET_8_15 */
+    {5204, 0, 8}, /* 137 ALIGN_TARGET_MASK */
+    {5240, 4, 4}, /* 138 TARGET_INDEX */
+    {5253, 0, 4}, /* 139 SOURCE_INDEX */
+    {5284, 7, 1}, /* 140 DISABLE_MEASUREMENT_FILTER */
+    {5311, 4, 3}, /* 141 ALIGN_THRESHOLD_COUNT */
+    {5333, 3, 1}, /* 142 ALIGN_RESET */
+    {5345, 2, 1}, /* 143 TYPE */
+    {78, 1, 1}, /* 144 MODE */
+    {5350, 0, 1}, /* 145 GO */
+    {5386, 0, 8}, /* 146 SDM_FRAC_0_7 */
+    {5423, 0, 8}, /* 147 SDM_FRAC_8_15 */
+    {5459, 0, 8}, /* 148 SDM_MOD_0_7 */
+    {5494, 0, 8}, /* 149 SDM_MOD_8_15 */
+    {5526, 7, 1}, /* 150 FBD_USER_CONFIG_EN */
+    {5545, 0, 7}, /* 151 FBD_INTEGER */
+    {5572, 1, 2}, /* 152 SDM_ORDER */
+    {5003, 0, 1}, /* 153 REF_SEL */
+    {5629, 7, 1}, /* 154 PAYLOAD_CH_EN_7 */
+    {5645, 6, 1}, /* 155 PAYLOAD_CH_EN_6 */
+    {5661, 5, 1}, /* 156 PAYLOAD_CH_EN_5 */
+    {5677, 4, 1}, /* 157 PAYLOAD_CH_EN_4 */
+    {5693, 3, 1}, /* 158 PAYLOAD_CH_EN_3 */
+    {5709, 2, 1}, /* 159 PAYLOAD_CH_EN_2 */
+    {5725, 1, 1}, /* 160 PAYLOAD_CH_EN_1 */
+    {5741, 0, 1}, /* 161 PAYLOAD_CH_EN_0 */
+    {5795, 7, 1}, /* 162 PAYLOAD_SQUELCH_7 */
+    {5813, 6, 1}, /* 163 PAYLOAD_SQUELCH_6 */
+    {5831, 5, 1}, /* 164 PAYLOAD_SQUELCH_5 */
+    {5849, 4, 1}, /* 165 PAYLOAD_SQUELCH_4 */
+    {5867, 3, 1}, /* 166 PAYLOAD_SQUELCH_3 */
+    {5885, 2, 1}, /* 167 PAYLOAD_SQUELCH_2 */
+    {5903, 1, 1}, /* 168 PAYLOAD_SQUELCH_1 */
+    {5921, 0, 1}, /* 169 PAYLOAD_SQUELCH_0 */
+    {5960, 1, 1}, /* 170 PWM_SYNC_PHASE_CORR_DISABLE */
+    {5988, 0, 1}, /* 171 PWM_SYNC */
+    {5725, 7, 1}, /* 172 PAYLOAD_CH_EN_1 */
+    {6046, 4, 3}, /* 173 SRC_CH_IDX_1 */
+    {5741, 3, 1}, /* 174 PAYLOAD_CH_EN_0 */
+    {6059, 0, 3}, /* 175 SRC_CH_IDX_0 */
+    {5693, 7, 1}, /* 176 PAYLOAD_CH_EN_3 */
+    {6104, 4, 3}, /* 177 SRC_CH_IDX_3 */
+    {5709, 3, 1}, /* 178 PAYLOAD_CH_EN_2 */
+    {6117, 0, 3}, /* 179 SRC_CH_IDX_2 */
+    {5661, 7, 1}, /* 180 PAYLOAD_CH_EN_5 */
+    {6162, 4, 3}, /* 181 SRC_CH_IDX_5 */
+    {5677, 3, 1}, /* 182 PAYLOAD_CH_EN_4 */
+    {6175, 0, 3}, /* 183 SRC_CH_IDX_4 */
+    {5629, 7, 1}, /* 184 PAYLOAD_CH_EN_7 */
+    {6220, 4, 3}, /* 185 SRC_CH_IDX_7 */
+    {5645, 3, 1}, /* 186 PAYLOAD_CH_EN_6 */
+    {6233, 0, 3}, /* 187 SRC_CH_IDX_6 */
+    {6267, 6, 1}, /* 188 PWM_OUTPUT_SQUELCH */
+    {6286, 5, 1}, /* 189 PWM_CO_LOCATED_CR */
+    {6304, 1, 4}, /* 190 PWM_SYNC_CR_IDX */
+    {5988, 0, 1}, /* 191 PWM_SYNC */
+    {6346, 0, 8}, /* 192 VALUE */
+    {6346, 0, 8}, /* 193 VALUE */
+    {6504, 0, 8}, /* 194 PWM_RandID */
+    {6346, 0, 8}, /* 195 VALUE */
+    {6533, 7, 1}, /* 196 DataFlag */
+    {6542, 5, 2}, /* 197 HandshakeData */
+    {6556, 0, 5}, /* 198 PWM_Transaction_ID */
+    {6618, 0, 8}, /* 199 BW_7_0 */
+    {6635, 0, 6}, /* 200 BW_13_8 */
+    {6643, 6, 2}, /* 201 BW_UNIT */
+    {6699, 0, 4}, /* 202 DAMP_FTR */
+    {6346, 0, 4}, /* 203 VALUE */
+    {6346, 0, 5}, /* 204 VALUE */
+    {6346, 0, 1}, /* 205 VALUE */
+    {6346, 0, 2}, /* 206 VALUE */
+    {7181, 2, 6}, /* 207 Reserved */
+    {7228, 0, 8}, /* 208 DCO_INC_DEC_SIZE_7_0 */
+    {7276, 0, 8}, /* 209 DCO_INC_DEC_SIZE_15_8 */
+    {7310, 3, 5}, /* 210 FORCE_LOCK_INPUT */
+    {7327, 2, 1}, /* 211 GLOBAL_SYNC_EN */
+    {7342, 1, 1}, /* 212 REVERTIVE_EN */
+    {7355, 0, 1}, /* 213 HITLESS_EN */
+    {7378, 5, 1}, /* 214 HITLESS_TYPE */
+    {7391, 1, 4}, /* 215 FB_SELECT_REF */
+    {7405, 0, 1}, /* 216 FB_SELECT_REF_EN */
+    {7434, 7, 1}, /* 217 FRAME_SYNC_PULSE_RESYNC_EN */
+    {7461, 5, 2}, /* 218 FRAME_SYNC_MODE */
+    {7477, 1, 4}, /* 219 EXT_FB_REF_SELECT */
+    {7495, 0, 1}, /* 220 EXT_FB_EN */
+    {7526, 0, 2}, /* 221 UPDATE_RATE_CFG */
+    {7572, 2, 1}, /* 222 FILTER_STATUS_UPDATE_EN */
+    {7596, 0, 2}, /* 223 FILTER_STATUS_SELECT_CNFG */
+    {7644, 0, 6}, /* 224 HISTORY */
+    {7652, 0, 8}, /* 225 DPLL_HO_ADVCD_BW_7_0 */
+    {6643, 6, 2}, /* 226 BW_UNIT */
+    {7673, 0, 6}, /* 227 DPLL_HO_ADVCD_BW_15_8 */
+    {7707, 0, 3}, /* 228 HOLDOVER_MODE */
+    {7733, 6, 2}, /* 229 PHASE_UNIT */
+    {7744, 0, 6}, /* 230 PHASE_LOCK_MAX_ERROR */
+    {7777, 0, 8}, /* 231 PHASE_MON_DUR */
+    {895, 6, 2}, /* 232 FFO_UNIT */
+    {7803, 0, 6}, /* 233 FFO_LOCK_MAX_ERROR */
+    {7834, 0, 8}, /* 234 FFO_MON_DUR */
+    {7866, 6, 2}, /* 235 PRIORITY_GROUP_NUMBER */
+    {7888, 1, 5}, /* 236 PRIORITY_REF */
+    {7901, 0, 1}, /* 237 PRIORITY_EN */
+    {19, 2, 6}, /* 238 RESERVED */
+    {7989, 1, 1}, /* 239 TRANS_SUPPRESS_EN */
+    {8007, 0, 1}, /* 240 TRANS_DETECT_EN */
+    {8043, 7, 1}, /* 241 LOCK_REC_PULL_IN_EN */
+    {8063, 6, 1}, /* 242 LOCK_REC_FAST_ACQ_EN */
+    {8084, 5, 1}, /* 243 LOCK_REC_PHASE_SNAP_EN */
+    {8107, 4, 1}, /* 244 LOCK_REC_FREQ_SNAP_EN */
+    {8129, 3, 1}, /* 245 LOCK_ACQ_PULL_IN_EN */
+    {8149, 2, 1}, /* 246 LOCK_ACQ_FAST_ACQ_EN */
+    {8170, 1, 1}, /* 247 LOCK_ACQ_PHASE_SNAP_EN */
+    {8193, 0, 1}, /* 248 LOCK_ACQ_FREQ_SNAP_EN */
+    {8235, 4, 4}, /* 249 PRE_FAST_ACQ_TIMER */
+    {6699, 0, 4}, /* 250 DAMP_FTR */
+    {8275, 0, 8}, /* 251 MAX_FFO */
+    {8301, 0, 8}, /* 252 DPLL_FASTLOCK_PSL_7_0 */
+    {8323, 0, 8}, /* 253 DPLL_FASTLOCK_PSL_15_8 */
+    {8364, 0, 8}, /* 254 DPLL_FASTLOCK_FSL_7_0 */
+    {8386, 0, 8}, /* 255 DPLL_FASTLOCK_FSL_15_8 */
+    {8426, 0, 8}, /* 256 DPLL_FASTLOCK_BW_7_0 */
+    {6643, 6, 2}, /* 257 BW_UNIT */
+    {8447, 0, 6}, /* 258 DPLL_FASTLOCK_BW_15_8 */
+    {8491, 0, 8}, /* 259 WRITE_FREQ_TIMEOUT_CNFG_7_0 */
+    {8546, 0, 8}, /* 260 WRITE_FREQ_TIMEOUT_CNFG_15_8 */
+    {8598, 0, 8}, /* 261 WRITE_PHASE_TIMEOUT_CNFG_7_0 */
+    {8655, 0, 8}, /* 262 WRITE_PHASE_TIMEOUT_CNFG_15_8 */
+    {19, 2, 6}, /* 263 RESERVED */
+    {8699, 1, 1}, /* 264 WP_PRED */
+    {8707, 0, 1}, /* 265 PRED_EN */
+    {19, 3, 5}, /* 266 RESERVED */
+    {8733, 1, 2}, /* 267 TOD_SYNC_SOURCE */
+    {8749, 0, 1}, /* 268 TOD_SYNC_EN */
+    {19, 5, 3}, /* 269 RESERVED */
+    {8784, 5, 1}, /* 270 PRI_COMBO_SRC_EN */
+    {8801, 4, 1}, /* 271 PRI_COMBO_SRC_FILTERED_CNFG */
+    {8829, 0, 4}, /* 272 PRI_COMBO_SRC_ID */
+    {19, 5, 3}, /* 273 RESERVED */
+    {8869, 5, 1}, /* 274 SEC_COMBO_SRC_EN */
+    {8886, 4, 1}, /* 275 SEC_COMBO_SRC_FILTERED_CNFG */
+    {8914, 0, 4}, /* 276 SEC_COMBO_SRC_ID */
+    {19, 4, 4}, /* 277 RESERVED */
+    {8950, 0, 4}, /* 278 SLAVE_REFERENCE */
+    {19, 3, 5}, /* 279 RESERVED */
+    {78, 0, 3}, /* 280 MODE */
+    {9007, 4, 4}, /* 281 PFD_FB_CLK_SEL */
+    {9022, 0, 4}, /* 282 PFD_REF_CLK_SEL */
+    {9048, 6, 1}, /* 283 WRITE_TIMER_MODE */
+    {9065, 3, 3}, /* 284 PLL_MODE */
+    {9074, 0, 3}, /* 285 STATE_MODE */
+};
+
+static const uint16_t cm_Status_bases[1] = {
+    0xC03C,
+};
+static const cm_reg_desc_t cm_Status_regs[40] = {
+    {7, 0x000, CM_REG_VOLATILE, 0, 3}, /* I2CM_STATUS */
+    {53, 0x002, CM_REG_VOLATILE, 3, 3}, /* SER0_STATUS */
+    {83, 0x003, CM_REG_VOLATILE, 6, 5}, /* SER0_SPI_STATUS */
+    {160, 0x004, CM_REG_VOLATILE, 11, 2}, /* SER0_I2C_STATUS */
+    {191, 0x005, CM_REG_VOLATILE, 3, 3}, /* SER1_STATUS */
+    {203, 0x006, CM_REG_VOLATILE, 6, 5}, /* SER1_SPI_STATUS */
+    {219, 0x007, CM_REG_VOLATILE, 11, 2}, /* SER1_I2C_STATUS */
+    {235, 0x008, CM_REG_VOLATILE, 0, 0}, /* IN{num}_MON_STATUS */
+    {254, 0x018, CM_REG_VOLATILE, 13, 3}, /* DPLL0_STATUS */
+    {332, 0x019, CM_REG_VOLATILE, 13, 3}, /* DPLL1_STATUS */
+    {345, 0x01A, CM_REG_VOLATILE, 13, 3}, /* DPLL2_STATUS */
+    {358, 0x01B, CM_REG_VOLATILE, 13, 3}, /* DPLL3_STATUS */
+    {371, 0x01C, CM_REG_VOLATILE, 13, 3}, /* DPLL4_STATUS */
+    {384, 0x01D, CM_REG_VOLATILE, 13, 3}, /* DPLL5_STATUS */
+    {397, 0x01E, CM_REG_VOLATILE, 13, 3}, /* DPLL6_STATUS */
+    {410, 0x01F, CM_REG_VOLATILE, 13, 3}, /* DPLL7_STATUS */
+    {423, 0x020, CM_REG_VOLATILE, 16, 4}, /* SYS_DPLL */
+    {519, 0x022, CM_REG_VOLATILE, 20, 2}, /* DPLL{num}_REF_STATUS */
+    {556, 0x02A, CM_REG_VOLATILE, 22, 2}, /* DPLL_SYS_REF_STATUS */
+    {591, 0x044, CM_REG_VOLATILE, 24, 1}, /* DPLL0_FILTER_STATUS */
+    {625, 0x04C, CM_REG_VOLATILE, 24, 1}, /* DPLL1_FILTER_STATUS */
+    {645, 0x054, CM_REG_VOLATILE, 24, 1}, /* DPLL2_FILTER_STATUS */
+    {665, 0x05C, CM_REG_VOLATILE, 24, 1}, /* DPLL3_FILTER_STATUS */
+    {685, 0x064, CM_REG_VOLATILE, 24, 1}, /* DPLL4_FILTER_STATUS */
+    {705, 0x06C, CM_REG_VOLATILE, 24, 1}, /* DPLL5_FILTER_STATUS */
+    {725, 0x074, CM_REG_VOLATILE, 24, 1}, /* DPLL6_FILTER_STATUS */
+    {745, 0x07C, CM_REG_VOLATILE, 24, 1}, /* DPLL7_FILTER_STATUS */
+    {765, 0x084, CM_REG_VOLATILE, 24, 1}, /* DPLL_SYS_FILTER_STATUS */
+    {788, 0x08A, CM_REG_VOLATILE, 0, 0}, /* USER_GPIO0_TO_7_STATUS */
+    {811, 0x08B, CM_REG_VOLATILE, 0, 0}, /* USER_GPIO8_TO_15_STATUS */
+    {835, 0x08C, CM_REG_VOLATILE, 25, 1}, /* IN{num}_MON_FREQ_STATUS_0 */
+    {869, 0x08D, CM_REG_VOLATILE, 26, 2}, /* IN{num}_MON_FREQ_STATUS_1 */
+    {913, 0x0DC, CM_REG_VOLATILE, 28, 1}, /* DPLL0_PHASE_STATUS */
+    {945, 0x0E4, CM_REG_VOLATILE, 28, 1}, /* DPLL1_PHASE_STATUS */
+    {964, 0x0EC, CM_REG_VOLATILE, 28, 1}, /* DPLL2_PHASE_STATUS */
+    {983, 0x0F4, CM_REG_VOLATILE, 28, 1}, /* DPLL3_PHASE_STATUS */
+    {1002, 0x0FC, CM_REG_VOLATILE, 28, 1}, /* DPLL4_PHASE_STATUS */
+    {1021, 0x104, CM_REG_VOLATILE, 28, 1}, /* DPLL5_PHASE_STATUS */
+    {1040, 0x10C, CM_REG_VOLATILE, 28, 1}, /* DPLL6_PHASE_STATUS */
+    {1059, 0x114, CM_REG_VOLATILE, 28, 1}, /* DPLL7_PHASE_STATUS */
 };
 const cm_module_desc_t cm_Status_module = {
-    CM_NAME_STR("Status"), cm_Status_bases, 1, cm_Status_regs,
-    (uint16_t)(sizeof(cm_Status_regs) / sizeof(cm_Status_regs[0]))};
+    0, cm_Status_bases, 1, cm_Status_regs, 40}; /* Status */
 
-static const uint16_t cm_PWMEncoder_bases[8] = {0xCB00, 0xCB08, 0xCB10, 0xCB18,
-                                                0xCB20, 0xCB28, 0xCB30, 0xCB38};
-static const cm_field_desc_t cm_PWMEncoder_reg_0_fields[1] = {
-    {CM_NAME_STR("ENCODER_ID"), 0, 8},
-};
-static const cm_field_desc_t cm_PWMEncoder_reg_1_fields[3] = {
-    {CM_NAME_STR("PPS_SEL"), 3, 1},
-    {CM_NAME_STR("SECONDARY_OUTPUT"), 2, 1},
-    {CM_NAME_STR("TOD_SEL"), 0, 2},
-};
-static const cm_field_desc_t cm_PWMEncoder_reg_2_fields[4] = {
-    {CM_NAME_STR("FIFTH_SYMBOL"), 6, 2},
-    {CM_NAME_STR("SIXTH_SYMBOL"), 4, 2},
-    {CM_NAME_STR("SEVENTH_SYMBOL"), 2, 2},
-    {CM_NAME_STR("EIGHTH_SYMBOL"), 0, 2},
-};
-static const cm_field_desc_t cm_PWMEncoder_reg_3_fields[4] = {
-    {CM_NAME_STR("FIRST_SYMBOL"), 6, 1},
-    {CM_NAME_STR("SECOND_SYMBOL"), 4, 2},
-    {CM_NAME_STR("THIRD_SYMBOL"), 2, 2},
-    {CM_NAME_STR("FOURTH_SYMBOL"), 0, 2},
-};
-static const cm_field_desc_t cm_PWMEncoder_reg_4_fields[4] = {
-    {CM_NAME_STR("TOD_AUTO_UPDATE"), 3, 1},
-    {CM_NAME_STR("TOD_TX"), 2, 1},
-    {CM_NAME_STR("SIGNATURE_MODE"), 1, 1},
-    {CM_NAME_STR("ENABLE"), 0, 1},
+static const uint16_t cm_PWMEncoder_bases[8] = {
+    0xCB00, 0xCB08, 0xCB10, 0xCB18, 0xCB20, 0xCB28, 0xCB30, 0xCB38,
 };
 static const cm_reg_desc_t cm_PWMEncoder_regs[5] = {
-    {CM_NAME_STR("PWM_ENCODER_ID"), 0x000, cm_PWMEncoder_reg_0_fields, 1},
-    {CM_NAME_STR("PWM_ENCODER_CNFG"), 0x001, cm_PWMEncoder_reg_1_fields, 3},
-    {CM_NAME_STR("PWM_ENCODER_SIGNATURE_0"), 0x002, cm_PWMEncoder_reg_2_fields,
-     4},
-    {CM_NAME_STR("PWM_ENCODER_SIGNATURE_1"), 0x003, cm_PWMEncoder_reg_3_fields,
-     4},
-    {CM_NAME_STR("PWM_ENCODER_CMD"), 0x004, cm_PWMEncoder_reg_4_fields, 4},
+    {1089, 0x000, CM_REG_CONFIG, 29, 1}, /* PWM_ENCODER_ID */
+    {1115, 0x001, CM_REG_CONFIG, 30, 3}, /* PWM_ENCODER_CNFG */
+    {1165, 0x002, CM_REG_CONFIG, 33, 4}, /* PWM_ENCODER_SIGNATURE_0 */
+    {1244, 0x003, CM_REG_CONFIG, 37, 4}, /* PWM_ENCODER_SIGNATURE_1 */
+    {1322, 0x004, CM_REG_VOLATILE, 41, 4}, /* PWM_ENCODER_CMD */
 };
 const cm_module_desc_t cm_PWMEncoder_module = {
-    CM_NAME_STR("PWMEncoder"), cm_PWMEncoder_bases, 8, cm_PWMEncoder_regs, 5};
+    1078, cm_PWMEncoder_bases, 8, cm_PWMEncoder_regs, 5}; /* PWMEncoder */
 
 static const uint16_t cm_PWMDecoder_bases[16] = {
     0xCB40, 0xCB48, 0xCB50, 0xCB58, 0xCB60, 0xCB68, 0xCB70, 0xCB80,
-    0xCB88, 0xCB90, 0xCB98, 0xCBA0, 0xCBA8, 0xCBB0, 0xCBB8, 0xCBC0};
-static const cm_field_desc_t cm_PWMDecoder_reg_0_fields[1] = {
-    {CM_NAME_STR("PPS_RATE_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_PWMDecoder_reg_1_fields[2] = {
-    {CM_NAME_STR("GENERATE_PPS"), 7, 1},
-    {CM_NAME_STR("PPS_RATE_8_14"), 0, 7},
-};
-static const cm_field_desc_t cm_PWMDecoder_reg_2_fields[1] = {
-    {CM_NAME_STR("DECODER_ID"), 0, 8},
-};
-static const cm_field_desc_t cm_PWMDecoder_reg_3_fields[4] = {
-    {CM_NAME_STR("FIFTH_SYMBOL"), 6, 2},
-    {CM_NAME_STR("SIXTH_SYMBOL"), 4, 2},
-    {CM_NAME_STR("SEVENTH_SYMBOL"), 2, 2},
-    {CM_NAME_STR("EIGHTH_SYMBOL"), 0, 2},
-};
-static const cm_field_desc_t cm_PWMDecoder_reg_4_fields[4] = {
-    {CM_NAME_STR("FIRST_SYMBOL"), 6, 1},
-    {CM_NAME_STR("SECOND_SYMBOL"), 4, 2},
-    {CM_NAME_STR("THIRD_SYMBOL"), 2, 2},
-    {CM_NAME_STR("FOURTH_SYMBOL"), 0, 2},
-};
-static const cm_field_desc_t cm_PWMDecoder_reg_5_fields[3] = {
-    {CM_NAME_STR("TOD_FRAME_ACCESS_EN"), 2, 1},
-    {CM_NAME_STR("SIGNATURE_MODE"), 1, 1},
-    {CM_NAME_STR("ENABLE"), 0, 1},
+    0xCB88, 0xCB90, 0xCB98, 0xCBA0, 0xCBA8, 0xCBB0, 0xCBB8, 0xCBC0,
 };
 static const cm_reg_desc_t cm_PWMDecoder_regs[6] = {
-    {CM_NAME_STR("PWM_DECODER_CNFG"), 0x000, cm_PWMDecoder_reg_0_fields, 1},
-    {CM_NAME_STR("PWM_DECODER_CNFG_1"), 0x001, cm_PWMDecoder_reg_1_fields, 2},
-    {CM_NAME_STR("PWM_DECODER_ID"), 0x002, cm_PWMDecoder_reg_2_fields, 1},
-    {CM_NAME_STR("PWM_DECODER_SIGNATURE_0"), 0x003, cm_PWMDecoder_reg_3_fields,
-     4},
-    {CM_NAME_STR("PWM_DECODER_SIGNATURE_1"), 0x004, cm_PWMDecoder_reg_4_fields,
-     4},
-    {CM_NAME_STR("PWM_DECODER_CMD"), 0x005, cm_PWMDecoder_reg_5_fields, 3},
+    {1394, 0x000, CM_REG_CONFIG, 45, 1}, /* PWM_DECODER_CNFG */
+    {1424, 0x001, CM_REG_CONFIG, 46, 2}, /* PWM_DECODER_CNFG_1 */
+    {1470, 0x002, CM_REG_CONFIG, 48, 1}, /* PWM_DECODER_ID */
+    {1496, 0x003, CM_REG_CONFIG, 33, 4}, /* PWM_DECODER_SIGNATURE_0 */
+    {1520, 0x004, CM_REG_CONFIG, 37, 4}, /* PWM_DECODER_SIGNATURE_1 */
+    {1544, 0x005, CM_REG_VOLATILE, 49, 3}, /* PWM_DECODER_CMD */
 };
 const cm_module_desc_t cm_PWMDecoder_module = {
-    CM_NAME_STR("PWMDecoder"), cm_PWMDecoder_bases, 16, cm_PWMDecoder_regs, 6};
+    1383, cm_PWMDecoder_bases, 16, cm_PWMDecoder_regs, 6}; /* PWMDecoder */
 
-static const uint16_t cm_TOD_bases[4] = {0xCBC8, 0xCBCC, 0xCBD0, 0xCBD2};
-static const cm_field_desc_t cm_TOD_reg_0_fields[3] = {
-    {CM_NAME_STR("TOD_EVEN_PPS_MODE"), 2, 1},
-    {CM_NAME_STR("TOD_OUT_SYNC_DISABLE"), 1, 1},
-    {CM_NAME_STR("TOD_ENABLE"), 0, 1},
+static const uint16_t cm_TOD_bases[4] = {
+    0xCBC8, 0xCBCC, 0xCBD0, 0xCBD2,
 };
 static const cm_reg_desc_t cm_TOD_regs[1] = {
-    {CM_NAME_STR("TOD_CFG"), 0x000, cm_TOD_reg_0_fields, 3},
+    {1584, 0x000, CM_REG_CONFIG, 52, 3}, /* TOD_CFG */
 };
-const cm_module_desc_t cm_TOD_module = {CM_NAME_STR("TOD"), cm_TOD_bases, 4,
-                                        cm_TOD_regs, 1};
+const cm_module_desc_t cm_TOD_module = {
+    1580, cm_TOD_bases, 4, cm_TOD_regs, 1}; /* TOD */
 
-static const uint16_t cm_TODWrite_bases[4] = {0xCC00, 0xCC10, 0xCC20, 0xCC30};
-static const cm_field_desc_t cm_TODWrite_reg_0_fields[1] = {
-    {CM_NAME_STR("SUBNS"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_1_fields[1] = {
-    {CM_NAME_STR("NS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_2_fields[1] = {
-    {CM_NAME_STR("NS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_3_fields[1] = {
-    {CM_NAME_STR("NS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_4_fields[1] = {
-    {CM_NAME_STR("NS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_5_fields[1] = {
-    {CM_NAME_STR("SECONDS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_6_fields[1] = {
-    {CM_NAME_STR("SECONDS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_7_fields[1] = {
-    {CM_NAME_STR("SECONDS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_8_fields[1] = {
-    {CM_NAME_STR("SECONDS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_9_fields[1] = {
-    {CM_NAME_STR("SECONDS_32_39"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_10_fields[1] = {
-    {CM_NAME_STR("SECONDS_40_47"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_11_fields[1] = {
-    {CM_NAME_STR("RESERVED"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_12_fields[1] = {
-    {CM_NAME_STR("WRITE_COUNTER"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_13_fields[2] = {
-    {CM_NAME_STR("PWM_DECODER_INDEX"), 4, 4},
-    {CM_NAME_STR("REF_INDEX"), 0, 4},
-};
-static const cm_field_desc_t cm_TODWrite_reg_14_fields[1] = {
-    {CM_NAME_STR("RESERVED"), 0, 8},
-};
-static const cm_field_desc_t cm_TODWrite_reg_15_fields[2] = {
-    {CM_NAME_STR("TOD_WRITE_TYPE"), 4, 2},
-    {CM_NAME_STR("TOD_WRITE_SELECTION"), 0, 4},
+static const uint16_t cm_TODWrite_bases[4] = {
+    0xCC00, 0xCC10, 0xCC20, 0xCC30,
 };
 static const cm_reg_desc_t cm_TODWrite_regs[16] = {
-    {CM_NAME_STR("TOD_WRITE_SUBNS"), 0x000, cm_TODWrite_reg_0_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_NS_0_7"), 0x001, cm_TODWrite_reg_1_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_NS_8_15"), 0x002, cm_TODWrite_reg_2_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_NS_16_23"), 0x003, cm_TODWrite_reg_3_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_NS_24_31"), 0x004, cm_TODWrite_reg_4_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_0_7"), 0x005, cm_TODWrite_reg_5_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_8_15"), 0x006, cm_TODWrite_reg_6_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_16_23"), 0x007, cm_TODWrite_reg_7_fields,
-     1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_24_31"), 0x008, cm_TODWrite_reg_8_fields,
-     1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_32_39"), 0x009, cm_TODWrite_reg_9_fields,
-     1},
-    {CM_NAME_STR("TOD_WRITE_SECONDS_40_47"), 0x00A, cm_TODWrite_reg_10_fields,
-     1},
-    {CM_NAME_STR("TOD_WRITE_RESERVED_0"), 0x00B, cm_TODWrite_reg_11_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_COUNTER"), 0x00C, cm_TODWrite_reg_12_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_SELECT_CFG_0"), 0x00D, cm_TODWrite_reg_13_fields,
-     2},
-    {CM_NAME_STR("TOD_WRITE_RESERVED_1"), 0x00E, cm_TODWrite_reg_14_fields, 1},
-    {CM_NAME_STR("TOD_WRITE_CMD"), 0x00F, cm_TODWrite_reg_15_fields, 2},
+    {1651, 0x000, CM_REG_CONFIG, 55, 1}, /* TOD_WRITE_SUBNS */
+    {1673, 0x001, CM_REG_CONFIG, 56, 1}, /* TOD_WRITE_NS_0_7 */
+    {1697, 0x002, CM_REG_CONFIG, 57, 1}, /* TOD_WRITE_NS_8_15 */
+    {1723, 0x003, CM_REG_CONFIG, 58, 1}, /* TOD_WRITE_NS_16_23 */
+    {1751, 0x004, CM_REG_CONFIG, 59, 1}, /* TOD_WRITE_NS_24_31 */
+    {1779, 0x005, CM_REG_CONFIG, 60, 1}, /* TOD_WRITE_SECONDS_0_7 */
+    {1813, 0x006, CM_REG_CONFIG, 61, 1}, /* TOD_WRITE_SECONDS_8_15 */
+    {1849, 0x007, CM_REG_CONFIG, 62, 1}, /* TOD_WRITE_SECONDS_16_23 */
+    {1887, 0x008, CM_REG_CONFIG, 63, 1}, /* TOD_WRITE_SECONDS_24_31 */
+    {1925, 0x009, CM_REG_CONFIG, 64, 1}, /* TOD_WRITE_SECONDS_32_39 */
+    {1963, 0x00A, CM_REG_CONFIG, 65, 1}, /* TOD_WRITE_SECONDS_40_47 */
+    {2001, 0x00B, CM_REG_CONFIG, 66, 1}, /* TOD_WRITE_RESERVED_0 */
+    {2022, 0x00C, CM_REG_VOLATILE, 67, 1}, /* TOD_WRITE_COUNTER */
+    {2054, 0x00D, CM_REG_CONFIG, 68, 2}, /* TOD_WRITE_SELECT_CFG_0 */
+    {2105, 0x00E, CM_REG_CONFIG, 66, 1}, /* TOD_WRITE_RESERVED_1 */
+    {2126, 0x00F, CM_REG_VOLATILE, 70, 2}, /* TOD_WRITE_CMD */
 };
 const cm_module_desc_t cm_TODWrite_module = {
-    CM_NAME_STR("TODWrite"), cm_TODWrite_bases, 4, cm_TODWrite_regs, 16};
+    1642, cm_TODWrite_bases, 4, cm_TODWrite_regs, 16}; /* TODWrite */
 
-static const uint16_t cm_TODReadPrimary_bases[4] = {0xCC40, 0xCC50, 0xCC60,
-                                                    0xCC80};
-static const cm_field_desc_t cm_TODReadPrimary_reg_0_fields[1] = {
-    {CM_NAME_STR("SUBNS"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_1_fields[1] = {
-    {CM_NAME_STR("NS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_2_fields[1] = {
-    {CM_NAME_STR("NS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_3_fields[1] = {
-    {CM_NAME_STR("NS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_4_fields[1] = {
-    {CM_NAME_STR("NS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_5_fields[1] = {
-    {CM_NAME_STR("SECONDS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_6_fields[1] = {
-    {CM_NAME_STR("SECONDS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_7_fields[1] = {
-    {CM_NAME_STR("SECONDS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_8_fields[1] = {
-    {CM_NAME_STR("SECONDS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_9_fields[1] = {
-    {CM_NAME_STR("SECONDS_32_39"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_10_fields[1] = {
-    {CM_NAME_STR("SECONDS_40_47"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_11_fields[1] = {
-    {CM_NAME_STR("READ_COUNTER"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_12_fields[2] = {
-    {CM_NAME_STR("PWM_DECODER_INDEX"), 4, 4},
-    {CM_NAME_STR("REF_INDEX"), 0, 4},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_13_fields[1] = {
-    {CM_NAME_STR("DPLL_INDEX"), 0, 3},
-};
-static const cm_field_desc_t cm_TODReadPrimary_reg_14_fields[2] = {
-    {CM_NAME_STR("TOD_READ_TRIGGER_MODE"), 4, 1},
-    {CM_NAME_STR("TOD_READ_TRIGGER"), 0, 4},
+static const uint16_t cm_TODReadPrimary_bases[4] = {
+    0xCC40, 0xCC50, 0xCC60, 0xCC80,
 };
 static const cm_reg_desc_t cm_TODReadPrimary_regs[15] = {
-    {CM_NAME_STR("TOD_READ_PRIMARY_SUBNS"), 0x000,
-     cm_TODReadPrimary_reg_0_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_NS_0_7"), 0x001,
-     cm_TODReadPrimary_reg_1_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_NS_8_15"), 0x002,
-     cm_TODReadPrimary_reg_2_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_NS_16_23"), 0x003,
-     cm_TODReadPrimary_reg_3_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_NS_24_31"), 0x004,
-     cm_TODReadPrimary_reg_4_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_0_7"), 0x005,
-     cm_TODReadPrimary_reg_5_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_8_15"), 0x006,
-     cm_TODReadPrimary_reg_6_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_16_23"), 0x007,
-     cm_TODReadPrimary_reg_7_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_24_31"), 0x008,
-     cm_TODReadPrimary_reg_8_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_32_39"), 0x009,
-     cm_TODReadPrimary_reg_9_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS_40_47"), 0x00A,
-     cm_TODReadPrimary_reg_10_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_COUNTER"), 0x00B,
-     cm_TODReadPrimary_reg_11_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SEL_CFG_0"), 0x00C,
-     cm_TODReadPrimary_reg_12_fields, 2},
-    {CM_NAME_STR("TOD_READ_PRIMARY_SEL_CFG_1"), 0x00D,
-     cm_TODReadPrimary_reg_13_fields, 1},
-    {CM_NAME_STR("TOD_READ_PRIMARY_CMD"), 0x00E,
-     cm_TODReadPrimary_reg_14_fields, 2},
+    {2190, 0x000, CM_REG_VOLATILE, 55, 1}, /* TOD_READ_PRIMARY_SUBNS */
+    {2213, 0x001, CM_REG_VOLATILE, 56, 1}, /* TOD_READ_PRIMARY_NS_0_7 */
+    {2237, 0x002, CM_REG_VOLATILE, 57, 1}, /* TOD_READ_PRIMARY_NS_8_15 */
+    {2262, 0x003, CM_REG_VOLATILE, 58, 1}, /* TOD_READ_PRIMARY_NS_16_23 */
+    {2288, 0x004, CM_REG_VOLATILE, 59, 1}, /* TOD_READ_PRIMARY_NS_24_31 */
+    {2314, 0x005, CM_REG_VOLATILE, 60, 1}, /* TOD_READ_PRIMARY_SECONDS_0_7 */
+    {2343, 0x006, CM_REG_VOLATILE, 61, 1}, /* TOD_READ_PRIMARY_SECONDS_8_15 */
+    {2373, 0x007, CM_REG_VOLATILE, 62, 1}, /* TOD_READ_PRIMARY_SECONDS_16_23 */
+    {2404, 0x008, CM_REG_VOLATILE, 63, 1}, /* TOD_READ_PRIMARY_SECONDS_24_31 */
+    {2435, 0x009, CM_REG_VOLATILE, 64, 1}, /* TOD_READ_PRIMARY_SECONDS_32_39 */
+    {2466, 0x00A, CM_REG_VOLATILE, 65, 1}, /* TOD_READ_PRIMARY_SECONDS_40_47 */
+    {2497, 0x00B, CM_REG_VOLATILE, 72, 1}, /* TOD_READ_PRIMARY_COUNTER */
+    {2535, 0x00C, CM_REG_CONFIG, 68, 2}, /* TOD_READ_PRIMARY_SEL_CFG_0 */
+    {2562, 0x00D, CM_REG_CONFIG, 73, 1}, /* TOD_READ_PRIMARY_SEL_CFG_1 */
+    {2600, 0x00E, CM_REG_VOLATILE, 74, 2}, /* TOD_READ_PRIMARY_CMD */
 };
 const cm_module_desc_t cm_TODReadPrimary_module = {
-    CM_NAME_STR("TODReadPrimary"), cm_TODReadPrimary_bases, 4,
-    cm_TODReadPrimary_regs, 15};
+    2175, cm_TODReadPrimary_bases, 4, cm_TODReadPrimary_regs, 15}; /* TODReadPrimary */
 
-static const uint16_t cm_TODReadSecondary_bases[4] = {0xCC90, 0xCCA0, 0xCCB0,
-                                                      0xCCC0};
-static const cm_field_desc_t cm_TODReadSecondary_reg_0_fields[1] = {
-    {CM_NAME_STR("SUBNS"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_1_fields[1] = {
-    {CM_NAME_STR("NS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_2_fields[1] = {
-    {CM_NAME_STR("NS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_3_fields[1] = {
-    {CM_NAME_STR("NS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_4_fields[1] = {
-    {CM_NAME_STR("NS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_5_fields[1] = {
-    {CM_NAME_STR("SECONDS_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_6_fields[1] = {
-    {CM_NAME_STR("SECONDS_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_7_fields[1] = {
-    {CM_NAME_STR("SECONDS_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_8_fields[1] = {
-    {CM_NAME_STR("SECONDS_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_9_fields[1] = {
-    {CM_NAME_STR("SECONDS_32_39"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_10_fields[1] = {
-    {CM_NAME_STR("SECONDS_40_47"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_11_fields[1] = {
-    {CM_NAME_STR("READ_COUNTER"), 0, 8},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_12_fields[2] = {
-    {CM_NAME_STR("PWM_DECODER_INDEX"), 4, 4},
-    {CM_NAME_STR("REF_INDEX"), 0, 4},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_13_fields[1] = {
-    {CM_NAME_STR("DPLL_INDEX"), 0, 3},
-};
-static const cm_field_desc_t cm_TODReadSecondary_reg_14_fields[2] = {
-    {CM_NAME_STR("TOD_READ_TRIGGER_MODE"), 4, 1},
-    {CM_NAME_STR("TOD_READ_TRIGGER"), 0, 4},
+static const uint16_t cm_TODReadSecondary_bases[4] = {
+    0xCC90, 0xCCA0, 0xCCB0, 0xCCC0,
 };
 static const cm_reg_desc_t cm_TODReadSecondary_regs[15] = {
-    {CM_NAME_STR("TOD_READ_SECONDARY_SUBNS"), 0x000,
-     cm_TODReadSecondary_reg_0_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_NS_0_7"), 0x001,
-     cm_TODReadSecondary_reg_1_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_NS_8_15"), 0x002,
-     cm_TODReadSecondary_reg_2_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_NS_16_23"), 0x003,
-     cm_TODReadSecondary_reg_3_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_NS_24_31"), 0x004,
-     cm_TODReadSecondary_reg_4_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_0_7"), 0x005,
-     cm_TODReadSecondary_reg_5_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_8_15"), 0x006,
-     cm_TODReadSecondary_reg_6_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_16_23"), 0x007,
-     cm_TODReadSecondary_reg_7_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_24_31"), 0x008,
-     cm_TODReadSecondary_reg_8_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_32_39"), 0x009,
-     cm_TODReadSecondary_reg_9_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS_40_47"), 0x00A,
-     cm_TODReadSecondary_reg_10_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_COUNTER"), 0x00B,
-     cm_TODReadSecondary_reg_11_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SEL_CFG_0"), 0x00C,
-     cm_TODReadSecondary_reg_12_fields, 2},
-    {CM_NAME_STR("TOD_READ_SECONDARY_SEL_CFG_1"), 0x00D,
-     cm_TODReadSecondary_reg_13_fields, 1},
-    {CM_NAME_STR("TOD_READ_SECONDARY_CMD"), 0x00E,
-     cm_TODReadSecondary_reg_14_fields, 2},
+    {2677, 0x000, CM_REG_VOLATILE, 55, 1}, /* TOD_READ_SECONDARY_SUBNS */
+    {2702, 0x001, CM_REG_VOLATILE, 56, 1}, /* TOD_READ_SECONDARY_NS_0_7 */
+    {2728, 0x002, CM_REG_VOLATILE, 57, 1}, /* TOD_READ_SECONDARY_NS_8_15 */
+    {2755, 0x003, CM_REG_VOLATILE, 58, 1}, /* TOD_READ_SECONDARY_NS_16_23 */
+    {2783, 0x004, CM_REG_VOLATILE, 59, 1}, /* TOD_READ_SECONDARY_NS_24_31 */
+    {2811, 0x005, CM_REG_VOLATILE, 60, 1}, /* TOD_READ_SECONDARY_SECONDS_0_7 */
+    {2842, 0x006, CM_REG_VOLATILE, 61, 1}, /* TOD_READ_SECONDARY_SECONDS_8_15 */
+    {2874, 0x007, CM_REG_VOLATILE, 62, 1}, /* TOD_READ_SECONDARY_SECONDS_16_23 */
+    {2907, 0x008, CM_REG_VOLATILE, 63, 1}, /* TOD_READ_SECONDARY_SECONDS_24_31 */
+    {2940, 0x009, CM_REG_VOLATILE, 64, 1}, /* TOD_READ_SECONDARY_SECONDS_32_39 */
+    {2973, 0x00A, CM_REG_VOLATILE, 65, 1}, /* TOD_READ_SECONDARY_SECONDS_40_47 */
+    {3006, 0x00B, CM_REG_VOLATILE, 72, 1}, /* TOD_READ_SECONDARY_COUNTER */
+    {3033, 0x00C, CM_REG_CONFIG, 68, 2}, /* TOD_READ_SECONDARY_SEL_CFG_0 */
+    {3062, 0x00D, CM_REG_CONFIG, 73, 1}, /* TOD_READ_SECONDARY_SEL_CFG_1 */
+    {3091, 0x00E, CM_REG_VOLATILE, 74, 2}, /* TOD_READ_SECONDARY_CMD */
 };
 const cm_module_desc_t cm_TODReadSecondary_module = {
-    CM_NAME_STR("TODReadSecondary"), cm_TODReadSecondary_bases, 4,
-    cm_TODReadSecondary_regs, 15};
+    2660, cm_TODReadSecondary_bases, 4, cm_TODReadSecondary_regs, 15}; /* TODReadSecondary */
 
 static const uint16_t cm_Input_bases[16] = {
     0xC1B0, 0xC1C0, 0xC1D0, 0xC200, 0xC210, 0xC220, 0xC230, 0xC240,
-    0xC250, 0xC260, 0xC280, 0xC290, 0xC2A0, 0xC2B0, 0xC2C0, 0xC2D0};
-static const cm_field_desc_t cm_Input_reg_0_fields[1] = {
-    {CM_NAME_STR("M_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_1_fields[1] = {
-    {CM_NAME_STR("M_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_2_fields[1] = {
-    {CM_NAME_STR("M_16_23"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_3_fields[1] = {
-    {CM_NAME_STR("M_24_31"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_4_fields[1] = {
-    {CM_NAME_STR("M_32_39"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_5_fields[1] = {
-    {CM_NAME_STR("M_40_47"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_6_fields[1] = {
-    {CM_NAME_STR("N_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_7_fields[1] = {
-    {CM_NAME_STR("N_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_8_fields[1] = {
-    {CM_NAME_STR("IN_DIV_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_9_fields[1] = {
-    {CM_NAME_STR("IN_DIV_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_10_fields[1] = {
-    {CM_NAME_STR("IN_PHASE_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_11_fields[1] = {
-    {CM_NAME_STR("IN_PHASE_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_Input_reg_12_fields[4] = {
-    {CM_NAME_STR("FRAME_SYNC_PULSE_EN"), 7, 1},
-    {CM_NAME_STR("FRAME_SYNC_RESAMPLE_EDGE"), 6, 1},
-    {CM_NAME_STR("FRAME_SYNC_RESAMPLE_EN"), 5, 1},
-    {CM_NAME_STR("FRAME_SYNC_PULSE"), 0, 5},
-};
-static const cm_field_desc_t cm_Input_reg_13_fields[6] = {
-    {CM_NAME_STR("DPLL_PRED"), 7, 1},  {CM_NAME_STR("MUX_GPIO_IN"), 6, 1},
-    {CM_NAME_STR("IN_DIFF"), 5, 1},    {CM_NAME_STR("IN_PNMODE"), 4, 1},
-    {CM_NAME_STR("IN_INVERSE"), 3, 1}, {CM_NAME_STR("IN_EN"), 0, 1},
+    0xC250, 0xC260, 0xC280, 0xC290, 0xC2A0, 0xC2B0, 0xC2C0, 0xC2D0,
 };
 static const cm_reg_desc_t cm_Input_regs[14] = {
-    {CM_NAME_STR("INPUT_IN_FREQ_M_0_7"), 0x000, cm_Input_reg_0_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_M_8_15"), 0x001, cm_Input_reg_1_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_M_16_23"), 0x002, cm_Input_reg_2_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_M_24_31"), 0x003, cm_Input_reg_3_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_M_32_39"), 0x004, cm_Input_reg_4_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_M_40_47"), 0x005, cm_Input_reg_5_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_N_0_7"), 0x006, cm_Input_reg_6_fields, 1},
-    {CM_NAME_STR("INPUT_IN_FREQ_N_8_15"), 0x007, cm_Input_reg_7_fields, 1},
-    {CM_NAME_STR("INPUT_IN_DIV_0_7"), 0x008, cm_Input_reg_8_fields, 1},
-    {CM_NAME_STR("INPUT_IN_DIV_8_15"), 0x009, cm_Input_reg_9_fields, 1},
-    {CM_NAME_STR("INPUT_IN_PHASE_0_7"), 0x00A, cm_Input_reg_10_fields, 1},
-    {CM_NAME_STR("INPUT_IN_PHASE_8_15"), 0x00B, cm_Input_reg_11_fields, 1},
-    {CM_NAME_STR("INPUT_IN_SYNC"), 0x00C, cm_Input_reg_12_fields, 4},
-    {CM_NAME_STR("INPUT_IN_MODE"), 0x00D, cm_Input_reg_13_fields, 6},
-};
-const cm_module_desc_t cm_Input_module = {CM_NAME_STR("Input"), cm_Input_bases,
-                                          16, cm_Input_regs, 14};
-
-static const uint16_t cm_Output_bases[12] = {0xCA14, 0xCA24, 0xCA34, 0xCA44,
-                                             0xCA54, 0xCA64, 0xCA80, 0xCA90,
-                                             0xCAA0, 0xCAB0, 0xCAC0, 0xCAD0};
-static const cm_field_desc_t cm_Output_reg_0_fields[1] = {
-    {CM_NAME_STR("Value"), 0, 8},
-};
-static const cm_field_desc_t cm_Output_reg_1_fields[1] = {
-    {CM_NAME_STR("Value"), 0, 8},
-};
-static const cm_field_desc_t cm_Output_reg_2_fields[1] = {
-    {CM_NAME_STR("Value"), 0, 8},
-};
-static const cm_field_desc_t cm_Output_reg_3_fields[1] = {
-    {CM_NAME_STR("Value"), 0, 8},
-};
-static const cm_field_desc_t cm_Output_reg_4_fields[1] = {
-    {CM_NAME_STR("Value"), 0, 8},
-};
-static const cm_reg_desc_t cm_Output_regs[6] = {
-    {CM_NAME_STR("OUT_DIV"), 0x000, cm_Output_reg_0_fields,
-     1}, // dont care about fields
-    {CM_NAME_STR("OUT_PHASE_ADJ_7_0"), 0x00C, cm_Output_reg_0_fields, 1},
-    {CM_NAME_STR("OUT_PHASE_ADJ_15_8"), 0x00D, cm_Output_reg_1_fields, 1},
-    {CM_NAME_STR("OUT_PHASE_ADJ_23_16"), 0x00E, cm_Output_reg_2_fields, 1},
-    {CM_NAME_STR("OUT_PHASE_ADJ_31_24"), 0x00F, cm_Output_reg_3_fields, 1},
-    {CM_NAME_STR("OUT_CTRL_1"), 0x009, cm_Output_reg_4_fields, 1},
+    {3120, 0x000, CM_REG_CONFIG, 76, 1}, /* INPUT_IN_FREQ_M_0_7 */
+    {3146, 0x001, CM_REG_CONFIG, 77, 1}, /* INPUT_IN_FREQ_M_8_15 */
+    {3174, 0x002, CM_REG_CONFIG, 78, 1}, /* INPUT_IN_FREQ_M_16_23 */
+    {3204, 0x003, CM_REG_CONFIG, 79, 1}, /* INPUT_IN_FREQ_M_24_31 */
+    {3234, 0x004, CM_REG_CONFIG, 80, 1}, /* INPUT_IN_FREQ_M_32_39 */
+    {3264, 0x005, CM_REG_CONFIG, 81, 1}, /* INPUT_IN_FREQ_M_40_47 */
+    {3294, 0x006, CM_REG_CONFIG, 82, 1}, /* INPUT_IN_FREQ_N_0_7 */
+    {3320, 0x007, CM_REG_CONFIG, 83, 1}, /* INPUT_IN_FREQ_N_8_15 */
+    {3348, 0x008, CM_REG_CONFIG, 84, 1}, /* INPUT_IN_DIV_0_7 */
+    {3376, 0x009, CM_REG_CONFIG, 85, 1}, /* INPUT_IN_DIV_8_15 */
+    {3406, 0x00A, CM_REG_CONFIG, 86, 1}, /* INPUT_IN_PHASE_0_7 */
+    {3438, 0x00B, CM_REG_CONFIG, 87, 1}, /* INPUT_IN_PHASE_8_15 */
+    {3472, 0x00C, CM_REG_CONFIG, 88, 4}, /* INPUT_IN_SYNC */
+    {3571, 0x00D, CM_REG_CONFIG, 92, 6}, /* INPUT_IN_MODE */
+};
+const cm_module_desc_t cm_Input_module = {
+    3114, cm_Input_bases, 16, cm_Input_regs, 14}; /* Input */
+
+static const uint16_t cm_Output_bases[12] = {
+    0xCA14, 0xCA24, 0xCA34, 0xCA44, 0xCA54, 0xCA64, 0xCA80, 0xCA90,
+    0xCAA0, 0xCAB0, 0xCAC0, 0xCAD0,
+};
+static const cm_reg_desc_t cm_Output_regs[5] = {
+    {3649, 0x000, CM_REG_CONFIG, 98, 1}, /* OUT_DIV */
+    {3663, 0x00C, CM_REG_CONFIG, 98, 1}, /* OUT_PHASE_ADJ_7_0 */
+    {3681, 0x00D, CM_REG_CONFIG, 98, 1}, /* OUT_PHASE_ADJ_15_8 */
+    {3700, 0x00E, CM_REG_CONFIG, 98, 1}, /* OUT_PHASE_ADJ_23_16 */
+    {3720, 0x00F, CM_REG_CONFIG, 98, 1}, /* OUT_PHASE_ADJ_31_24 */
 };
 const cm_module_desc_t cm_Output_module = {
-    CM_NAME_STR("Output"), cm_Output_bases, 12, cm_Output_regs, 5};
+    3642, cm_Output_bases, 12, cm_Output_regs, 5}; /* Output */
 
 static const uint16_t cm_REFMON_bases[16] = {
     0xC2E0, 0xC2EC, 0xC300, 0xC30C, 0xC318, 0xC324, 0xC330, 0xC33C,
-    0xC348, 0xC354, 0xC360, 0xC36C, 0xC380, 0xC38C, 0xC398, 0xC3A4};
-static const cm_field_desc_t cm_REFMON_reg_0_fields[2] = {
-    {CM_NAME_STR("VLD_INTERVAL"), 3, 4},
-    {CM_NAME_STR("FREQ_OFFS_LIM"), 0, 3},
-};
-static const cm_field_desc_t cm_REFMON_reg_1_fields[1] = {
-    {CM_NAME_STR("VLD_INTERVAL_SHORT"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_2_fields[1] = {
-    {CM_NAME_STR("IN_MON_TRANS_THRESHOLD_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_3_fields[1] = {
-    {CM_NAME_STR("IN_MON_TRANS_THRESHOLD_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_4_fields[1] = {
-    {CM_NAME_STR("IN_MON_TRANS_PERIOD_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_5_fields[1] = {
-    {CM_NAME_STR("IN_MON_TRANS_PERIOD_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_6_fields[3] = {
-    {CM_NAME_STR("QUAL_TIMER"), 5, 2},
-    {CM_NAME_STR("DSQUAL_TIMER"), 3, 2},
-    {CM_NAME_STR("ACT_LIM"), 0, 3},
-};
-static const cm_field_desc_t cm_REFMON_reg_7_fields[1] = {
-    {CM_NAME_STR("IN_MON_LOS_TOLERANCE_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_8_fields[1] = {
-    {CM_NAME_STR("IN_MON_LOS_TOLERANCE_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_REFMON_reg_9_fields[2] = {
-    {CM_NAME_STR("LOS_GAP"), 1, 2},
-    {CM_NAME_STR("LOS_MARGIN"), 0, 1},
-};
-static const cm_field_desc_t cm_REFMON_reg_10_fields[6] = {
-    {CM_NAME_STR("DIV_OR_NON_DIV_CLK_SELECT"), 5, 1},
-    {CM_NAME_STR("TRANS_DETECTOR_EN"), 4, 1},
-    {CM_NAME_STR("MASK_ACTIVITY"), 3, 1},
-    {CM_NAME_STR("MASK_FREQ"), 2, 1},
-    {CM_NAME_STR("MASK_LOS"), 1, 1},
-    {CM_NAME_STR("EN"), 0, 1},
+    0xC348, 0xC354, 0xC360, 0xC36C, 0xC380, 0xC38C, 0xC398, 0xC3A4,
 };
 static const cm_reg_desc_t cm_REFMON_regs[11] = {
-    {CM_NAME_STR("REF_MON_IN_MON_FREQ_CFG"), 0x000, cm_REFMON_reg_0_fields, 2},
-    {CM_NAME_STR("REF_MON_IN_MON_FREQ_VLD_INTV"), 0x001, cm_REFMON_reg_1_fields,
-     1},
-    {CM_NAME_STR("REF_MON_IN_MON_TRANS_THRESHOLD_0_7"), 0x002,
-     cm_REFMON_reg_2_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_TRANS_THRESHOLD_8_15"), 0x003,
-     cm_REFMON_reg_3_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_TRANS_PERIOD_0_7"), 0x004,
-     cm_REFMON_reg_4_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_TRANS_PERIOD_8_15"), 0x005,
-     cm_REFMON_reg_5_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_ACT_CFG"), 0x006, cm_REFMON_reg_6_fields, 3},
-    {CM_NAME_STR("REF_MON_IN_MON_LOS_TOLERANCE_0_7"), 0x008,
-     cm_REFMON_reg_7_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_LOS_TOLERANCE_8_15"), 0x009,
-     cm_REFMON_reg_8_fields, 1},
-    {CM_NAME_STR("REF_MON_IN_MON_LOS_CFG"), 0x00A, cm_REFMON_reg_9_fields, 2},
-    {CM_NAME_STR("REF_MON_IN_MON_CFG"), 0x00B, cm_REFMON_reg_10_fields, 6},
+    {3747, 0x000, CM_REG_CONFIG, 99, 2}, /* REF_MON_IN_MON_FREQ_CFG */
+    {3798, 0x001, CM_REG_CONFIG, 101, 1}, /* REF_MON_IN_MON_FREQ_VLD_INTV */
+    {3846, 0x002, CM_REG_CONFIG, 102, 1}, /* REF_MON_IN_MON_TRANS_THRESHOLD_0_7 */
+    {3908, 0x003, CM_REG_CONFIG, 103, 1}, /* REF_MON_IN_MON_TRANS_THRESHOLD_8_15 */
+    {3972, 0x004, CM_REG_CONFIG, 104, 1}, /* REF_MON_IN_MON_TRANS_PERIOD_0_7 */
+    {4028, 0x005, CM_REG_CONFIG, 105, 1}, /* REF_MON_IN_MON_TRANS_PERIOD_8_15 */
+    {4086, 0x006, CM_REG_CONFIG, 106, 3}, /* REF_MON_IN_MON_ACT_CFG */
+    {4141, 0x008, CM_REG_CONFIG, 109, 1}, /* REF_MON_IN_MON_LOS_TOLERANCE_0_7 */
+    {4199, 0x009, CM_REG_CONFIG, 110, 1}, /* REF_MON_IN_MON_LOS_TOLERANCE_8_15 */
+    {4259, 0x00A, CM_REG_CONFIG, 111, 2}, /* REF_MON_IN_MON_LOS_CFG */
+    {4301, 0x00B, CM_REG_CONFIG, 113, 6}, /* REF_MON_IN_MON_CFG */
 };
 const cm_module_desc_t cm_REFMON_module = {
-    CM_NAME_STR("REFMON"), cm_REFMON_bases, 16, cm_REFMON_regs, 11};
+    3740, cm_REFMON_bases, 16, cm_REFMON_regs, 11}; /* REFMON */
 
-static const uint16_t cm_PWM_USER_DATA_bases[1] = {0xCBC8};
-static const cm_field_desc_t cm_PWM_USER_DATA_reg_0_fields[1] = {
-    {CM_NAME_STR("ENCODER_ID"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_USER_DATA_reg_1_fields[1] = {
-    {CM_NAME_STR("DECODER_ID"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_USER_DATA_reg_2_fields[1] = {
-    {CM_NAME_STR("BYTES"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_USER_DATA_reg_3_fields[1] = {
-    {CM_NAME_STR("COMMAND_STATUS"), 0, 8},
+static const uint16_t cm_PWM_USER_DATA_bases[1] = {
+    0xCBC8,
 };
 static const cm_reg_desc_t cm_PWM_USER_DATA_regs[4] = {
-    {CM_NAME_STR("PWM_USER_DATA_PWM_SRC_ENCODER_ID"), 0x000,
-     cm_PWM_USER_DATA_reg_0_fields, 1},
-    {CM_NAME_STR("PWM_USER_DATA_PWM_DST_DECODER_ID"), 0x001,
-     cm_PWM_USER_DATA_reg_1_fields, 1},
-    {CM_NAME_STR("PWM_USER_DATA_PWM_USER_DATA_SIZE"), 0x002,
-     cm_PWM_USER_DATA_reg_2_fields, 1},
-    {CM_NAME_STR("PWM_USER_DATA_PWM_USER_DATA_CMD_STS"), 0x003,
-     cm_PWM_USER_DATA_reg_3_fields, 1},
-};
-const cm_module_desc_t cm_PWM_USER_DATA_module = {CM_NAME_STR("PWM_USER_DATA"),
-                                                  cm_PWM_USER_DATA_bases, 1,
-                                                  cm_PWM_USER_DATA_regs, 4};
-
-static const uint16_t cm_EEPROM_bases[1] = {0xCF68};
-static const cm_field_desc_t cm_EEPROM_reg_0_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 7, 1},
-    {CM_NAME_STR("I2C_ADDR"), 0, 7},
-};
-static const cm_field_desc_t cm_EEPROM_reg_1_fields[1] = {
-    {CM_NAME_STR("BYTES"), 0, 8},
-};
-static const cm_field_desc_t cm_EEPROM_reg_2_fields[1] = {
-    {CM_NAME_STR("EEPROM_OFFSET"), 0, 8},
+    {4414, 0x000, CM_REG_CONFIG, 29, 1}, /* PWM_USER_DATA_PWM_SRC_ENCODER_ID */
+    {4447, 0x001, CM_REG_CONFIG, 48, 1}, /* PWM_USER_DATA_PWM_DST_DECODER_ID */
+    {4480, 0x002, CM_REG_CONFIG, 119, 1}, /* PWM_USER_DATA_PWM_USER_DATA_SIZE */
+    {4519, 0x003, CM_REG_VOLATILE, 120, 1}, /* PWM_USER_DATA_PWM_USER_DATA_CMD_STS */
 };
-static const cm_field_desc_t cm_EEPROM_reg_3_fields[1] = {
-    {CM_NAME_STR("EEPROM_OFFSET"), 0, 8},
-};
-static const cm_field_desc_t cm_EEPROM_reg_4_fields[1] = {
-    {CM_NAME_STR("EEPROM_CMD"), 0, 8},
-};
-static const cm_field_desc_t cm_EEPROM_reg_5_fields[1] = {
-    {CM_NAME_STR("EEPROM_CMD"), 0, 8},
+const cm_module_desc_t cm_PWM_USER_DATA_module = {
+    4400, cm_PWM_USER_DATA_bases, 1, cm_PWM_USER_DATA_regs, 4}; /* PWM_USER_DATA */
+
+static const uint16_t cm_EEPROM_bases[1] = {
+    0xCF68,
 };
 static const cm_reg_desc_t cm_EEPROM_regs[6] = {
-    {CM_NAME_STR("EEPROM_I2C_ADDR"), 0x000, cm_EEPROM_reg_0_fields, 2},
-    {CM_NAME_STR("EEPROM_SIZE"), 0x001, cm_EEPROM_reg_1_fields, 1},
-    {CM_NAME_STR("EEPROM_OFFSET_LOW"), 0x002, cm_EEPROM_reg_2_fields, 1},
-    {CM_NAME_STR("EEPROM_OFFSET_HIGH"), 0x003, cm_EEPROM_reg_3_fields, 1},
-    {CM_NAME_STR("EEPROM_CMD_LOW"), 0x004, cm_EEPROM_reg_4_fields, 1},
-    {CM_NAME_STR("EEPROM_CMD_HIGH"), 0x005, cm_EEPROM_reg_5_fields, 1},
+    {4577, 0x000, CM_REG_CONFIG, 121, 2}, /* EEPROM_I2C_ADDR */
+    {4602, 0x001, CM_REG_CONFIG, 119, 1}, /* EEPROM_SIZE */
+    {4614, 0x002, CM_REG_CONFIG, 123, 1}, /* EEPROM_OFFSET_LOW */
+    {4646, 0x003, CM_REG_CONFIG, 123, 1}, /* EEPROM_OFFSET_HIGH */
+    {4665, 0x004, CM_REG_VOLATILE, 124, 1}, /* EEPROM_CMD_LOW */
+    {4691, 0x005, CM_REG_VOLATILE, 124, 1}, /* EEPROM_CMD_HIGH */
 };
 const cm_module_desc_t cm_EEPROM_module = {
-    CM_NAME_STR("EEPROM"), cm_EEPROM_bases, 1, cm_EEPROM_regs, 6};
+    4570, cm_EEPROM_bases, 1, cm_EEPROM_regs, 6}; /* EEPROM */
 
-static const uint16_t cm_EEPROM_DATA_bases[1] = {0xCF80};
-static const cm_field_desc_t cm_EEPROM_DATA_reg_0_fields[1] = {
-    {CM_NAME_STR("DATA"), 0, 8},
+static const uint16_t cm_EEPROM_DATA_bases[1] = {
+    0xCF80,
 };
 static const cm_reg_desc_t cm_EEPROM_DATA_regs[1] = {
-    {CM_NAME_STR("BYTE_OTP_EEPROM_PWM_BUFF_{i}"), 0x000,
-     cm_EEPROM_DATA_reg_0_fields, 1},
+    {4719, 0x000, CM_REG_VOLATILE, 125, 1}, /* BYTE_OTP_EEPROM_PWM_BUFF_{i} */
 };
-const cm_module_desc_t cm_EEPROM_DATA_module = {CM_NAME_STR("EEPROM_DATA"),
-                                                cm_EEPROM_DATA_bases, 1,
-                                                cm_EEPROM_DATA_regs, 1};
+const cm_module_desc_t cm_EEPROM_DATA_module = {
+    4707, cm_EEPROM_DATA_bases, 1, cm_EEPROM_DATA_regs, 1}; /* EEPROM_DATA */
 
-static const uint16_t cm_OUTPUT_TDC_CFG_bases[1] = {0xCCD0};
-static const cm_field_desc_t cm_OUTPUT_TDC_CFG_reg_0_fields[1] = {
-    {CM_NAME_STR("FAST_LOCK_ENABLE_DELAY_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_CFG_reg_1_fields[1] = {
-    {CM_NAME_STR("FAST_LOCK_ENABLE_DELAY_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_CFG_reg_2_fields[1] = {
-    {CM_NAME_STR("FAST_LOCK_DISABLE_DELAY_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_CFG_reg_3_fields[1] = {
-    {CM_NAME_STR("FAST_LOCK_DISABLE_DELAY_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_CFG_reg_4_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 2, 6},
-    {CM_NAME_STR("REF_SEL"), 1, 1},
-    {CM_NAME_STR("ENABLE"), 0, 1},
+static const uint16_t cm_OUTPUT_TDC_CFG_bases[1] = {
+    0xCCD0,
 };
 static const cm_reg_desc_t cm_OUTPUT_TDC_CFG_regs[5] = {
-    {CM_NAME_STR("OUTPUT_TDC_CFG_GBL_0_0_7"), 0x000,
-     cm_OUTPUT_TDC_CFG_reg_0_fields, 1},
-    {CM_NAME_STR("OUTPUT_TDC_CFG_GBL_0_8_15"), 0x001,
-     cm_OUTPUT_TDC_CFG_reg_1_fields, 1},
-    {CM_NAME_STR("OUTPUT_TDC_CFG_GBL_1_0_7"), 0x002,
-     cm_OUTPUT_TDC_CFG_reg_2_fields, 1},
-    {CM_NAME_STR("OUTPUT_TDC_CFG_GBL_1_8_15"), 0x003,
-     cm_OUTPUT_TDC_CFG_reg_3_fields, 1},
-    {CM_NAME_STR("OUTPUT_TDC_CFG_GBL_2"), 0x004, cm_OUTPUT_TDC_CFG_reg_4_fields,
-     3},
+    {4768, 0x000, CM_REG_CONFIG, 126, 1}, /* OUTPUT_TDC_CFG_GBL_0_0_7 */
+    {4820, 0x001, CM_REG_CONFIG, 127, 1}, /* OUTPUT_TDC_CFG_GBL_0_8_15 */
+    {4874, 0x002, CM_REG_CONFIG, 128, 1}, /* OUTPUT_TDC_CFG_GBL_1_0_7 */
+    {4927, 0x003, CM_REG_CONFIG, 129, 1}, /* OUTPUT_TDC_CFG_GBL_1_8_15 */
+    {4982, 0x004, CM_REG_CONFIG, 130, 3}, /* OUTPUT_TDC_CFG_GBL_2 */
 };
 const cm_module_desc_t cm_OUTPUT_TDC_CFG_module = {
-    CM_NAME_STR("OUTPUT_TDC_CFG"), cm_OUTPUT_TDC_CFG_bases, 1,
-    cm_OUTPUT_TDC_CFG_regs, 5};
+    4753, cm_OUTPUT_TDC_CFG_bases, 1, cm_OUTPUT_TDC_CFG_regs, 5}; /* OUTPUT_TDC_CFG */
 
-static const uint16_t cm_OUTPUT_TDC_bases[4] = {0xCD00, 0xCD08, 0xCD10, 0xCD18};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_0_fields[1] = {
-    {CM_NAME_STR("SAMPLES_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_1_fields[1] = {
-    {CM_NAME_STR("SAMPLES_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_2_fields[1] = {
-    {CM_NAME_STR("TARGET_PHASE_OFFSET_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_3_fields[1] = {
-    {CM_NAME_STR("TARGET_PHASE_OFFSET_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_4_fields[1] = {
-    {CM_NAME_STR("ALIGN_TARGET_MASK"), 0, 8},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_5_fields[2] = {
-    {CM_NAME_STR("TARGET_INDEX"), 4, 4},
-    {CM_NAME_STR("SOURCE_INDEX"), 0, 4},
-};
-static const cm_field_desc_t cm_OUTPUT_TDC_reg_6_fields[6] = {
-    {CM_NAME_STR("DISABLE_MEASUREMENT_FILTER"), 7, 1},
-    {CM_NAME_STR("ALIGN_THRESHOLD_COUNT"), 4, 3},
-    {CM_NAME_STR("ALIGN_RESET"), 3, 1},
-    {CM_NAME_STR("TYPE"), 2, 1},
-    {CM_NAME_STR("MODE"), 1, 1},
-    {CM_NAME_STR("GO"), 0, 1},
+static const uint16_t cm_OUTPUT_TDC_bases[4] = {
+    0xCD00, 0xCD08, 0xCD10, 0xCD18,
 };
 static const cm_reg_desc_t cm_OUTPUT_TDC_regs[7] = {
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_0_0_7"), 0x000, cm_OUTPUT_TDC_reg_0_fields,
-     1},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_0_8_15"), 0x001, cm_OUTPUT_TDC_reg_1_fields,
-     1},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_1_0_7"), 0x002, cm_OUTPUT_TDC_reg_2_fields,
-     1},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_1_8_15"), 0x003, cm_OUTPUT_TDC_reg_3_fields,
-     1},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_2"), 0x004, cm_OUTPUT_TDC_reg_4_fields, 1},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_3"), 0x005, cm_OUTPUT_TDC_reg_5_fields, 2},
-    {CM_NAME_STR("OUTPUT_TDC_CTRL_4"), 0x006, cm_OUTPUT_TDC_reg_6_fields, 6},
+    {5022, 0x000, CM_REG_CONFIG, 133, 1}, /* OUTPUT_TDC_CTRL_0_0_7 */
+    {5056, 0x001, CM_REG_CONFIG, 134, 1}, /* OUTPUT_TDC_CTRL_0_8_15 */
+    {5092, 0x002, CM_REG_CONFIG, 135, 1}, /* OUTPUT_TDC_CTRL_1_0_7 */
+    {5138, 0x003, CM_REG_CONFIG, 136, 1}, /* OUTPUT_TDC_CTRL_1_8_15 */
+    {5186, 0x004, CM_REG_CONFIG, 137, 1}, /* OUTPUT_TDC_CTRL_2 */
+    {5222, 0x005, CM_REG_CONFIG, 138, 2}, /* OUTPUT_TDC_CTRL_3 */
+    {5266, 0x006, CM_REG_VOLATILE, 140, 6}, /* OUTPUT_TDC_CTRL_4 */
 };
 const cm_module_desc_t cm_OUTPUT_TDC_module = {
-    CM_NAME_STR("OUTPUT_TDC"), cm_OUTPUT_TDC_bases, 4, cm_OUTPUT_TDC_regs, 7};
+    5011, cm_OUTPUT_TDC_bases, 4, cm_OUTPUT_TDC_regs, 7}; /* OUTPUT_TDC */
 
-static const uint16_t cm_INPUT_TDC_bases[1] = {0xCD20};
-static const cm_field_desc_t cm_INPUT_TDC_reg_0_fields[1] = {
-    {CM_NAME_STR("SDM_FRAC_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_INPUT_TDC_reg_1_fields[1] = {
-    {CM_NAME_STR("SDM_FRAC_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_INPUT_TDC_reg_2_fields[1] = {
-    {CM_NAME_STR("SDM_MOD_0_7"), 0, 8},
-};
-static const cm_field_desc_t cm_INPUT_TDC_reg_3_fields[1] = {
-    {CM_NAME_STR("SDM_MOD_8_15"), 0, 8},
-};
-static const cm_field_desc_t cm_INPUT_TDC_reg_4_fields[2] = {
-    {CM_NAME_STR("FBD_USER_CONFIG_EN"), 7, 1},
-    {CM_NAME_STR("FBD_INTEGER"), 0, 7},
-};
-static const cm_field_desc_t cm_INPUT_TDC_reg_5_fields[2] = {
-    {CM_NAME_STR("SDM_ORDER"), 1, 2},
-    {CM_NAME_STR("REF_SEL"), 0, 1},
+static const uint16_t cm_INPUT_TDC_bases[1] = {
+    0xCD20,
 };
 static const cm_reg_desc_t cm_INPUT_TDC_regs[6] = {
-    {CM_NAME_STR("INPUT_TDC_SDM_FRAC_0_7"), 0x000, cm_INPUT_TDC_reg_0_fields,
-     1},
-    {CM_NAME_STR("INPUT_TDC_SDM_FRAC_8_15"), 0x001, cm_INPUT_TDC_reg_1_fields,
-     1},
-    {CM_NAME_STR("INPUT_TDC_SDM_MOD_0_7"), 0x002, cm_INPUT_TDC_reg_2_fields, 1},
-    {CM_NAME_STR("INPUT_TDC_SDM_MOD_8_15"), 0x003, cm_INPUT_TDC_reg_3_fields,
-     1},
-    {CM_NAME_STR("INPUT_TDC_FBD_CTRL"), 0x004, cm_INPUT_TDC_reg_4_fields, 2},
-    {CM_NAME_STR("INPUT_TDC_CTRL"), 0x005, cm_INPUT_TDC_reg_5_fields, 2},
+    {5363, 0x000, CM_REG_CONFIG, 146, 1}, /* INPUT_TDC_SDM_FRAC_0_7 */
+    {5399, 0x001, CM_REG_CONFIG, 147, 1}, /* INPUT_TDC_SDM_FRAC_8_15 */
+    {5437, 0x002, CM_REG_CONFIG, 148, 1}, /* INPUT_TDC_SDM_MOD_0_7 */
+    {5471, 0x003, CM_REG_CONFIG, 149, 1}, /* INPUT_TDC_SDM_MOD_8_15 */
+    {5507, 0x004, CM_REG_CONFIG, 150, 2}, /* INPUT_TDC_FBD_CTRL */
+    {5557, 0x005, CM_REG_CONFIG, 152, 2}, /* INPUT_TDC_CTRL */
 };
 const cm_module_desc_t cm_INPUT_TDC_module = {
-    CM_NAME_STR("INPUT_TDC"), cm_INPUT_TDC_bases, 1, cm_INPUT_TDC_regs, 6};
+    5353, cm_INPUT_TDC_bases, 1, cm_INPUT_TDC_regs, 6}; /* INPUT_TDC */
 
 static const uint16_t cm_PWM_SYNC_ENCODER_bases[8] = {
-    0xCD80, 0xCD84, 0xCD88, 0xCD8C, 0xCD90, 0xCD94, 0xCD98, 0xCD9C};
-static const cm_field_desc_t cm_PWM_SYNC_ENCODER_reg_0_fields[8] = {
-    {CM_NAME_STR("PAYLOAD_CH_EN_7"), 7, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_6"), 6, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_5"), 5, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_4"), 4, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_3"), 3, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_2"), 2, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_1"), 1, 1},
-    {CM_NAME_STR("PAYLOAD_CH_EN_0"), 0, 1},
-};
-static const cm_field_desc_t cm_PWM_SYNC_ENCODER_reg_1_fields[8] = {
-    {CM_NAME_STR("PAYLOAD_SQUELCH_7"), 7, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_6"), 6, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_5"), 5, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_4"), 4, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_3"), 3, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_2"), 2, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_1"), 1, 1},
-    {CM_NAME_STR("PAYLOAD_SQUELCH_0"), 0, 1},
-};
-static const cm_field_desc_t cm_PWM_SYNC_ENCODER_reg_2_fields[2] = {
-    {CM_NAME_STR("PWM_SYNC_PHASE_CORR_DISABLE"), 1, 1},
-    {CM_NAME_STR("PWM_SYNC"), 0, 1},
+    0xCD80, 0xCD84, 0xCD88, 0xCD8C, 0xCD90, 0xCD94, 0xCD98, 0xCD9C,
 };
 static const cm_reg_desc_t cm_PWM_SYNC_ENCODER_regs[3] = {
-    {CM_NAME_STR("PWM_SYNC_ENCODER_PAYLOAD_CNFG"), 0x000,
-     cm_PWM_SYNC_ENCODER_reg_0_fields, 8},
-    {CM_NAME_STR("PWM_SYNC_ENCODER_PAYLOAD_SQUELCH_CNFG"), 0x001,
-     cm_PWM_SYNC_ENCODER_reg_1_fields, 8},
-    {CM_NAME_STR("PWM_SYNC_ENCODER_CMD"), 0x002,
-     cm_PWM_SYNC_ENCODER_reg_2_fields, 2},
+    {5599, 0x000, CM_REG_CONFIG, 154, 8}, /* PWM_SYNC_ENCODER_PAYLOAD_CNFG */
+    {5757, 0x001, CM_REG_CONFIG, 162, 8}, /* PWM_SYNC_ENCODER_PAYLOAD_SQUELCH_CNFG */
+    {5939, 0x002, CM_REG_VOLATILE, 170, 2}, /* PWM_SYNC_ENCODER_CMD */
 };
 const cm_module_desc_t cm_PWM_SYNC_ENCODER_module = {
-    CM_NAME_STR("PWM_SYNC_ENCODER"), cm_PWM_SYNC_ENCODER_bases, 8,
-    cm_PWM_SYNC_ENCODER_regs, 3};
+    5582, cm_PWM_SYNC_ENCODER_bases, 8, cm_PWM_SYNC_ENCODER_regs, 3}; /* PWM_SYNC_ENCODER */
 
 static const uint16_t cm_PWM_SYNC_DECODER_bases[16] = {
     0xCE00, 0xCE06, 0xCE0C, 0xCE12, 0xCE18, 0xCE1E, 0xCE24, 0xCE2A,
-    0xCE30, 0xCE36, 0xCE3C, 0xCE42, 0xCE48, 0xCE4E, 0xCE54, 0xCE5A};
-static const cm_field_desc_t cm_PWM_SYNC_DECODER_reg_0_fields[4] = {
-    {CM_NAME_STR("PAYLOAD_CH_EN_1"), 7, 1},
-    {CM_NAME_STR("SRC_CH_IDX_1"), 4, 3},
-    {CM_NAME_STR("PAYLOAD_CH_EN_0"), 3, 1},
-    {CM_NAME_STR("SRC_CH_IDX_0"), 0, 3},
-};
-static const cm_field_desc_t cm_PWM_SYNC_DECODER_reg_1_fields[4] = {
-    {CM_NAME_STR("PAYLOAD_CH_EN_3"), 7, 1},
-    {CM_NAME_STR("SRC_CH_IDX_3"), 4, 3},
-    {CM_NAME_STR("PAYLOAD_CH_EN_2"), 3, 1},
-    {CM_NAME_STR("SRC_CH_IDX_2"), 0, 3},
-};
-static const cm_field_desc_t cm_PWM_SYNC_DECODER_reg_2_fields[4] = {
-    {CM_NAME_STR("PAYLOAD_CH_EN_5"), 7, 1},
-    {CM_NAME_STR("SRC_CH_IDX_5"), 4, 3},
-    {CM_NAME_STR("PAYLOAD_CH_EN_4"), 3, 1},
-    {CM_NAME_STR("SRC_CH_IDX_4"), 0, 3},
-};
-static const cm_field_desc_t cm_PWM_SYNC_DECODER_reg_3_fields[4] = {
-    {CM_NAME_STR("PAYLOAD_CH_EN_7"), 7, 1},
-    {CM_NAME_STR("SRC_CH_IDX_7"), 4, 3},
-    {CM_NAME_STR("PAYLOAD_CH_EN_6"), 3, 1},
-    {CM_NAME_STR("SRC_CH_IDX_6"), 0, 3},
-};
-static const cm_field_desc_t cm_PWM_SYNC_DECODER_reg_4_fields[4] = {
-    {CM_NAME_STR("PWM_OUTPUT_SQUELCH"), 6, 1},
-    {CM_NAME_STR("PWM_CO_LOCATED_CR"), 5, 1},
-    {CM_NAME_STR("PWM_SYNC_CR_IDX"), 1, 4},
-    {CM_NAME_STR("PWM_SYNC"), 0, 1},
+    0xCE30, 0xCE36, 0xCE3C, 0xCE42, 0xCE48, 0xCE4E, 0xCE54, 0xCE5A,
 };
 static const cm_reg_desc_t cm_PWM_SYNC_DECODER_regs[5] = {
-    {CM_NAME_STR("PWM_SYNC_DECODER_PAYLOAD_CNFG_0"), 0x000,
-     cm_PWM_SYNC_DECODER_reg_0_fields, 4},
-    {CM_NAME_STR("PWM_SYNC_DECODER_PAYLOAD_CNFG_1"), 0x001,
-     cm_PWM_SYNC_DECODER_reg_1_fields, 4},
-    {CM_NAME_STR("PWM_SYNC_DECODER_PAYLOAD_CNFG_2"), 0x002,
-     cm_PWM_SYNC_DECODER_reg_2_fields, 4},
-    {CM_NAME_STR("PWM_SYNC_DECODER_PAYLOAD_CNFG_3"), 0x003,
-     cm_PWM_SYNC_DECODER_reg_3_fields, 4},
-    {CM_NAME_STR("PWM_SYNC_DECODER_CMD"), 0x004,
-     cm_PWM_SYNC_DECODER_reg_4_fields, 4},
+    {6014, 0x000, CM_REG_CONFIG, 172, 4}, /* PWM_SYNC_DECODER_PAYLOAD_CNFG_0 */
+    {6072, 0x001, CM_REG_CONFIG, 176, 4}, /* PWM_SYNC_DECODER_PAYLOAD_CNFG_1 */
+    {6130, 0x002, CM_REG_CONFIG, 180, 4}, /* PWM_SYNC_DECODER_PAYLOAD_CNFG_2 */
+    {6188, 0x003, CM_REG_CONFIG, 184, 4}, /* PWM_SYNC_DECODER_PAYLOAD_CNFG_3 */
+    {6246, 0x004, CM_REG_VOLATILE, 188, 4}, /* PWM_SYNC_DECODER_CMD */
 };
 const cm_module_desc_t cm_PWM_SYNC_DECODER_module = {
-    CM_NAME_STR("PWM_SYNC_DECODER"), cm_PWM_SYNC_DECODER_bases, 16,
-    cm_PWM_SYNC_DECODER_regs, 5};
+    5997, cm_PWM_SYNC_DECODER_bases, 16, cm_PWM_SYNC_DECODER_regs, 5}; /* PWM_SYNC_DECODER */
 
-static const uint16_t cm_PWM_Rx_Info_bases[1] = {0xCE80};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_0_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_1_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_2_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_3_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_4_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_5_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_6_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_7_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_8_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_9_fields[2] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-    {CM_NAME_STR("PWM_RandID"), 0, 8},
-};
-static const cm_field_desc_t cm_PWM_Rx_Info_reg_10_fields[4] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-    {CM_NAME_STR("DataFlag"), 7, 1},
-    {CM_NAME_STR("HandshakeData"), 5, 2},
-    {CM_NAME_STR("PWM_Transaction_ID"), 0, 5},
+static const uint16_t cm_PWM_Rx_Info_bases[1] = {
+    0xCE80,
 };
 static const cm_reg_desc_t cm_PWM_Rx_Info_regs[11] = {
-    {CM_NAME_STR("PWM_TOD_SUBNS"), 0x000, cm_PWM_Rx_Info_reg_0_fields, 1},
-    {CM_NAME_STR("PWM_TOD_NS_7_0"), 0x001, cm_PWM_Rx_Info_reg_1_fields, 1},
-    {CM_NAME_STR("PWM_TOD_NS_15_8"), 0x002, cm_PWM_Rx_Info_reg_2_fields, 1},
-    {CM_NAME_STR("PWM_TOD_NS_23_16"), 0x003, cm_PWM_Rx_Info_reg_3_fields, 1},
-    {CM_NAME_STR("PWM_TOD_NS_31_24"), 0x004, cm_PWM_Rx_Info_reg_4_fields, 1},
-    {CM_NAME_STR("PWM_TOD_SEC_7_0"), 0x005, cm_PWM_Rx_Info_reg_5_fields, 1},
-    {CM_NAME_STR("PWM_TOD_SEC_15_8"), 0x006, cm_PWM_Rx_Info_reg_6_fields, 1},
-    {CM_NAME_STR("PWM_TOD_SEC_23_16"), 0x007, cm_PWM_Rx_Info_reg_7_fields, 1},
-    {CM_NAME_STR("PWM_TOD_SEC_31_24"), 0x008, cm_PWM_Rx_Info_reg_8_fields, 1},
-    {CM_NAME_STR("PWM_TOD_SEC_39_32"), 0x009, cm_PWM_Rx_Info_reg_9_fields, 2},
-    {CM_NAME_STR("PWM_TOD_SEC_47_40"), 0x00A, cm_PWM_Rx_Info_reg_10_fields, 4},
-};
-const cm_module_desc_t cm_PWM_Rx_Info_module = {CM_NAME_STR("PWM_Rx_Info"),
-                                                cm_PWM_Rx_Info_bases, 1,
-                                                cm_PWM_Rx_Info_regs, 11};
-
-static const uint16_t cm_DPLL_Ctrl_bases[8] = {0xC600, 0xC63C, 0xC680, 0xC6BC,
-                                               0xC700, 0xC73C, 0xC780, 0xC7BC};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_0_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_1_fields[1] = {
-    {CM_NAME_STR("BW_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_2_fields[2] = {
-    {CM_NAME_STR("BW_13_8"), 0, 6},
-    {CM_NAME_STR("BW_UNIT"), 6, 2},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_3_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_4_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_5_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_6_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_7_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_8_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_9_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_10_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_11_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 5},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_12_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_13_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_14_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_15_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_16_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_17_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_18_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_19_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_20_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Ctrl_reg_21_fields[1] = {
-    {CM_NAME_STR("DAMP_FTR"), 0, 4},
+    {6332, 0x000, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_SUBNS */
+    {6352, 0x001, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_NS_7_0 */
+    {6367, 0x002, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_NS_15_8 */
+    {6383, 0x003, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_NS_23_16 */
+    {6400, 0x004, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_NS_31_24 */
+    {6417, 0x005, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_SEC_7_0 */
+    {6433, 0x006, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_SEC_15_8 */
+    {6450, 0x007, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_SEC_23_16 */
+    {6468, 0x008, CM_REG_VOLATILE, 192, 1}, /* PWM_TOD_SEC_31_24 */
+    {6486, 0x009, CM_REG_VOLATILE, 193, 2}, /* PWM_TOD_SEC_39_32 */
+    {6515, 0x00A, CM_REG_VOLATILE, 195, 4}, /* PWM_TOD_SEC_47_40 */
+};
+const cm_module_desc_t cm_PWM_Rx_Info_module = {
+    6320, cm_PWM_Rx_Info_bases, 1, cm_PWM_Rx_Info_regs, 11}; /* PWM_Rx_Info */
+
+static const uint16_t cm_DPLL_Ctrl_bases[8] = {
+    0xC600, 0xC63C, 0xC680, 0xC6BC, 0xC700, 0xC73C, 0xC780, 0xC7BC,
 };
 static const cm_reg_desc_t cm_DPLL_Ctrl_regs[22] = {
-    {CM_NAME_STR("DPLL_DECIMATOR_BW_MULT"), 0x003, cm_DPLL_Ctrl_reg_0_fields,
-     1},
-    {CM_NAME_STR("DPLL_BW_0"), 0x004, cm_DPLL_Ctrl_reg_1_fields, 1},
-    {CM_NAME_STR("DPLL_BW_1"), 0x005, cm_DPLL_Ctrl_reg_2_fields, 2},
-    {CM_NAME_STR("DPLL_PSL_7_0"), 0x006, cm_DPLL_Ctrl_reg_3_fields, 1},
-    {CM_NAME_STR("DPLL_PSL_15_8"), 0x007, cm_DPLL_Ctrl_reg_4_fields, 1},
-    {CM_NAME_STR("DPLL_LOOP_FILTER_CFG"), 0x008, cm_DPLL_Ctrl_reg_21_fields, 1},
-    {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG_7_0"), 0x014, cm_DPLL_Ctrl_reg_5_fields,
-     1},
-    {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG_15_8"), 0x015,
-     cm_DPLL_Ctrl_reg_6_fields, 1},
-    {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG_23_16"), 0x016,
-     cm_DPLL_Ctrl_reg_7_fields, 1},
-    {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG_31_24"), 0x017,
-     cm_DPLL_Ctrl_reg_8_fields, 1},
-    {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG_35_32"), 0x018,
-     cm_DPLL_Ctrl_reg_9_fields, 1},
-    {CM_NAME_STR("DPLL_FINE_PHASE_ADV_CFG_7_0"), 0x01A,
-     cm_DPLL_Ctrl_reg_10_fields, 1},
-    {CM_NAME_STR("DPLL_FINE_PHASE_ADV_CFG_12_8"), 0x01B,
-     cm_DPLL_Ctrl_reg_11_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_7_0"), 0x01C, cm_DPLL_Ctrl_reg_12_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_15_8"), 0x01D, cm_DPLL_Ctrl_reg_13_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_23_16"), 0x01E, cm_DPLL_Ctrl_reg_14_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_31_24"), 0x01F, cm_DPLL_Ctrl_reg_15_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_39_32"), 0x020, cm_DPLL_Ctrl_reg_16_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_M_47_40"), 0x021, cm_DPLL_Ctrl_reg_17_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_N_7_0"), 0x022, cm_DPLL_Ctrl_reg_18_fields, 1},
-    {CM_NAME_STR("FOD_FREQ_N_15_8"), 0x023, cm_DPLL_Ctrl_reg_19_fields, 1},
-    {CM_NAME_STR("DPLL_FRAME_PULSE_SYNC"), 0x03B, cm_DPLL_Ctrl_reg_20_fields,
-     1},
+    {6585, 0x003, CM_REG_CONFIG, 192, 1}, /* DPLL_DECIMATOR_BW_MULT */
+    {6608, 0x004, CM_REG_CONFIG, 199, 1}, /* DPLL_BW_0 */
+    {6625, 0x005, CM_REG_CONFIG, 200, 2}, /* DPLL_BW_1 */
+    {6651, 0x006, CM_REG_CONFIG, 192, 1}, /* DPLL_PSL_7_0 */
+    {6664, 0x007, CM_REG_CONFIG, 192, 1}, /* DPLL_PSL_15_8 */
+    {6678, 0x008, CM_REG_CONFIG, 202, 1}, /* DPLL_LOOP_FILTER_CFG */
+    {6708, 0x014, CM_REG_CONFIG, 192, 1}, /* DPLL_PHASE_OFFSET_CFG_7_0 */
+    {6734, 0x015, CM_REG_CONFIG, 192, 1}, /* DPLL_PHASE_OFFSET_CFG_15_8 */
+    {6761, 0x016, CM_REG_CONFIG, 192, 1}, /* DPLL_PHASE_OFFSET_CFG_23_16 */
+    {6789, 0x017, CM_REG_CONFIG, 192, 1}, /* DPLL_PHASE_OFFSET_CFG_31_24 */
+    {6817, 0x018, CM_REG_CONFIG, 203, 1}, /* DPLL_PHASE_OFFSET_CFG_35_32 */
+    {6845, 0x01A, CM_REG_CONFIG, 192, 1}, /* DPLL_FINE_PHASE_ADV_CFG_7_0 */
+    {6873, 0x01B, CM_REG_CONFIG, 204, 1}, /* DPLL_FINE_PHASE_ADV_CFG_12_8 */
+    {6902, 0x01C, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_7_0 */
+    {6917, 0x01D, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_15_8 */
+    {6933, 0x01E, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_23_16 */
+    {6950, 0x01F, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_31_24 */
+    {6967, 0x020, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_39_32 */
+    {6984, 0x021, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_M_47_40 */
+    {7001, 0x022, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_N_7_0 */
+    {7016, 0x023, CM_REG_CONFIG, 192, 1}, /* FOD_FREQ_N_15_8 */
+    {7032, 0x03B, CM_REG_VOLATILE, 205, 1}, /* DPLL_FRAME_PULSE_SYNC */
 };
 const cm_module_desc_t cm_DPLL_Ctrl_module = {
-    CM_NAME_STR("DPLL_Ctrl"), cm_DPLL_Ctrl_bases, 8, cm_DPLL_Ctrl_regs, 22};
+    6575, cm_DPLL_Ctrl_bases, 8, cm_DPLL_Ctrl_regs, 22}; /* DPLL_Ctrl */
 
 static const uint16_t cm_DPLL_Freq_Write_bases[8] = {
-    0xC838, 0xC840, 0xC848, 0xC850, 0xC858, 0xC860, 0xC868, 0xC870};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_0_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_1_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_2_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_3_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_4_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Freq_Write_reg_5_fields[2] = {
-    {CM_NAME_STR("VALUE"), 0, 2},
-    {CM_NAME_STR("Reserved"), 2, 6},
+    0xC838, 0xC840, 0xC848, 0xC850, 0xC858, 0xC860, 0xC868, 0xC870,
 };
 static const cm_reg_desc_t cm_DPLL_Freq_Write_regs[6] = {
-    {CM_NAME_STR("DPLL_WR_FREQ_7_0"), 0x000, cm_DPLL_Freq_Write_reg_0_fields,
-     1},
-    {CM_NAME_STR("DPLL_WR_FREQ_15_8"), 0x001, cm_DPLL_Freq_Write_reg_1_fields,
-     1},
-    {CM_NAME_STR("DPLL_WR_FREQ_23_16"), 0x002, cm_DPLL_Freq_Write_reg_2_fields,
-     1},
-    {CM_NAME_STR("DPLL_WR_FREQ_31_24"), 0x003, cm_DPLL_Freq_Write_reg_3_fields,
-     1},
-    {CM_NAME_STR("DPLL_WR_FREQ_39_32"), 0x004, cm_DPLL_Freq_Write_reg_4_fields,
-     1},
-    {CM_NAME_STR("DPLL_WR_FREQ_41_40"), 0x005, cm_DPLL_Freq_Write_reg_5_fields,
-     2},
+    {7070, 0x000, CM_REG_CONFIG, 192, 1}, /* DPLL_WR_FREQ_7_0 */
+    {7087, 0x001, CM_REG_CONFIG, 192, 1}, /* DPLL_WR_FREQ_15_8 */
+    {7105, 0x002, CM_REG_CONFIG, 192, 1}, /* DPLL_WR_FREQ_23_16 */
+    {7124, 0x003, CM_REG_CONFIG, 192, 1}, /* DPLL_WR_FREQ_31_24 */
+    {7143, 0x004, CM_REG_CONFIG, 192, 1}, /* DPLL_WR_FREQ_39_32 */
+    {7162, 0x005, CM_REG_CONFIG, 206, 2}, /* DPLL_WR_FREQ_41_40 */
 };
 const cm_module_desc_t cm_DPLL_Freq_Write_module = {
-    CM_NAME_STR("DPLL_Freq_Write"), cm_DPLL_Freq_Write_bases, 8,
-    cm_DPLL_Freq_Write_regs, 6};
+    7054, cm_DPLL_Freq_Write_bases, 8, cm_DPLL_Freq_Write_regs, 6}; /* DPLL_Freq_Write */
 
 static const uint16_t cm_DPLL_Config_bases[8] = {
-    0xC3B0, 0xC400, 0xC438, 0xC480, 0xC4B8, 0xC500, 0xC538, 0xC580};
-static const cm_field_desc_t cm_DPLL_Config_reg_0_fields[1] = {
-    {CM_NAME_STR("DCO_INC_DEC_SIZE_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_1_fields[1] = {
-    {CM_NAME_STR("DCO_INC_DEC_SIZE_15_8"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_2_fields[4] = {
-    {CM_NAME_STR("FORCE_LOCK_INPUT"), 3, 5},
-    {CM_NAME_STR("GLOBAL_SYNC_EN"), 2, 1},
-    {CM_NAME_STR("REVERTIVE_EN"), 1, 1},
-    {CM_NAME_STR("HITLESS_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_3_fields[3] = {
-    {CM_NAME_STR("HITLESS_TYPE"), 5, 1},
-    {CM_NAME_STR("FB_SELECT_REF"), 1, 4},
-    {CM_NAME_STR("FB_SELECT_REF_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_4_fields[4] = {
-    {CM_NAME_STR("FRAME_SYNC_PULSE_RESYNC_EN"), 7, 1},
-    {CM_NAME_STR("FRAME_SYNC_MODE"), 5, 2},
-    {CM_NAME_STR("EXT_FB_REF_SELECT"), 1, 4},
-    {CM_NAME_STR("EXT_FB_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_5_fields[1] = {
-    {CM_NAME_STR("UPDATE_RATE_CFG"), 0, 2},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_6_fields[2] = {
-    {CM_NAME_STR("FILTER_STATUS_UPDATE_EN"), 2, 1},
-    {CM_NAME_STR("FILTER_STATUS_SELECT_CNFG"), 0, 2},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_7_fields[1] = {
-    {CM_NAME_STR("HISTORY"), 0, 6},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_8_fields[1] = {
-    {CM_NAME_STR("DPLL_HO_ADVCD_BW_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_9_fields[2] = {
-    {CM_NAME_STR("BW_UNIT"), 6, 2},
-    {CM_NAME_STR("DPLL_HO_ADVCD_BW_15_8"), 0, 6},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_10_fields[1] = {
-    {CM_NAME_STR("HOLDOVER_MODE"), 0, 3},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_11_fields[2] = {
-    {CM_NAME_STR("PHASE_UNIT"), 6, 2},
-    {CM_NAME_STR("PHASE_LOCK_MAX_ERROR"), 0, 6},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_12_fields[1] = {
-    {CM_NAME_STR("PHASE_MON_DUR"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_13_fields[2] = {
-    {CM_NAME_STR("FFO_UNIT"), 6, 2},
-    {CM_NAME_STR("FFO_LOCK_MAX_ERROR"), 0, 6},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_14_fields[1] = {
-    {CM_NAME_STR("FFO_MON_DUR"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_15_fields[3] = {
-    {CM_NAME_STR("PRIORITY_GROUP_NUMBER"), 6, 2},
-    {CM_NAME_STR("PRIORITY_REF"), 1, 5},
-    {CM_NAME_STR("PRIORITY_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_16_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 2, 6},
-    {CM_NAME_STR("TRANS_SUPPRESS_EN"), 1, 1},
-    {CM_NAME_STR("TRANS_DETECT_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_17_fields[8] = {
-    {CM_NAME_STR("LOCK_REC_PULL_IN_EN"), 7, 1},
-    {CM_NAME_STR("LOCK_REC_FAST_ACQ_EN"), 6, 1},
-    {CM_NAME_STR("LOCK_REC_PHASE_SNAP_EN"), 5, 1},
-    {CM_NAME_STR("LOCK_REC_FREQ_SNAP_EN"), 4, 1},
-    {CM_NAME_STR("LOCK_ACQ_PULL_IN_EN"), 3, 1},
-    {CM_NAME_STR("LOCK_ACQ_FAST_ACQ_EN"), 2, 1},
-    {CM_NAME_STR("LOCK_ACQ_PHASE_SNAP_EN"), 1, 1},
-    {CM_NAME_STR("LOCK_ACQ_FREQ_SNAP_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_18_fields[2] = {
-    {CM_NAME_STR("PRE_FAST_ACQ_TIMER"), 4, 4},
-    {CM_NAME_STR("DAMP_FTR"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_19_fields[1] = {
-    {CM_NAME_STR("MAX_FFO"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_20_fields[1] = {
-    {CM_NAME_STR("DPLL_FASTLOCK_PSL_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_21_fields[1] = {
-    {CM_NAME_STR("DPLL_FASTLOCK_PSL_15_8"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_22_fields[1] = {
-    {CM_NAME_STR("DPLL_FASTLOCK_FSL_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_23_fields[1] = {
-    {CM_NAME_STR("DPLL_FASTLOCK_FSL_15_8"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_24_fields[1] = {
-    {CM_NAME_STR("DPLL_FASTLOCK_BW_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_25_fields[2] = {
-    {CM_NAME_STR("BW_UNIT"), 6, 2},
-    {CM_NAME_STR("DPLL_FASTLOCK_BW_15_8"), 0, 6},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_26_fields[1] = {
-    {CM_NAME_STR("WRITE_FREQ_TIMEOUT_CNFG_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_27_fields[1] = {
-    {CM_NAME_STR("WRITE_FREQ_TIMEOUT_CNFG_15_8"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_28_fields[1] = {
-    {CM_NAME_STR("WRITE_PHASE_TIMEOUT_CNFG_7_0"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_29_fields[1] = {
-    {CM_NAME_STR("WRITE_PHASE_TIMEOUT_CNFG_15_8"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_30_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 2, 6},
-    {CM_NAME_STR("WP_PRED"), 1, 1},
-    {CM_NAME_STR("PRED_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_31_fields[3] = {
-    {CM_NAME_STR("RESERVED"), 3, 5},
-    {CM_NAME_STR("TOD_SYNC_SOURCE"), 1, 2},
-    {CM_NAME_STR("TOD_SYNC_EN"), 0, 1},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_32_fields[4] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("PRI_COMBO_SRC_EN"), 5, 1},
-    {CM_NAME_STR("PRI_COMBO_SRC_FILTERED_CNFG"), 4, 1},
-    {CM_NAME_STR("PRI_COMBO_SRC_ID"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_33_fields[4] = {
-    {CM_NAME_STR("RESERVED"), 5, 3},
-    {CM_NAME_STR("SEC_COMBO_SRC_EN"), 5, 1},
-    {CM_NAME_STR("SEC_COMBO_SRC_FILTERED_CNFG"), 4, 1},
-    {CM_NAME_STR("SEC_COMBO_SRC_ID"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_34_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 4, 4},
-    {CM_NAME_STR("SLAVE_REFERENCE"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_35_fields[2] = {
-    {CM_NAME_STR("RESERVED"), 3, 5},
-    {CM_NAME_STR("MODE"), 0, 3},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_36_fields[2] = {
-    {CM_NAME_STR("PFD_FB_CLK_SEL"), 4, 4},
-    {CM_NAME_STR("PFD_REF_CLK_SEL"), 0, 4},
-};
-static const cm_field_desc_t cm_DPLL_Config_reg_37_fields[3] = {
-    {CM_NAME_STR("WRITE_TIMER_MODE"), 6, 1},
-    {CM_NAME_STR("PLL_MODE"), 3, 3},
-    {CM_NAME_STR("STATE_MODE"), 0, 3},
+    0xC3B0, 0xC400, 0xC438, 0xC480, 0xC4B8, 0xC500, 0xC538, 0xC580,
 };
 static const cm_reg_desc_t cm_DPLL_Config_regs[41] = {
-    {CM_NAME_STR("DPLL_DCO_INC_DEC_SIZE_7_0"), 0x000,
-     cm_DPLL_Config_reg_0_fields, 1},
-    {CM_NAME_STR("DPLL_DCO_INC_DEC_SIZE_15_8"), 0x001,
-     cm_DPLL_Config_reg_1_fields, 1},
-    {CM_NAME_STR("DPLL_CTRL_0"), 0x002, cm_DPLL_Config_reg_2_fields, 4},
-    {CM_NAME_STR("DPLL_CTRL_1"), 0x003, cm_DPLL_Config_reg_3_fields, 3},
-    {CM_NAME_STR("DPLL_CTRL_2"), 0x004, cm_DPLL_Config_reg_4_fields, 4},
-    {CM_NAME_STR("DPLL_UPDATE_RATE_CFG"), 0x005, cm_DPLL_Config_reg_5_fields,
-     1},
-    {CM_NAME_STR("DPLL_FILTER_STATUS_UPDATE_CFG"), 0x006,
-     cm_DPLL_Config_reg_6_fields, 2},
-    {CM_NAME_STR("DPLL_HO_ADVCD_HISTORY"), 0x007, cm_DPLL_Config_reg_7_fields,
-     1},
-    {CM_NAME_STR("DPLL_HO_ADVCD_BW_7_0"), 0x008, cm_DPLL_Config_reg_8_fields,
-     1},
-    {CM_NAME_STR("DPLL_HO_ADVCD_BW_15_8"), 0x009, cm_DPLL_Config_reg_9_fields,
-     2},
-    {CM_NAME_STR("DPLL_HO_CFG"), 0x00A, cm_DPLL_Config_reg_10_fields, 1},
-    {CM_NAME_STR("DPLL_LOCK_0"), 0x00B, cm_DPLL_Config_reg_11_fields, 2},
-    {CM_NAME_STR("DPLL_LOCK_1"), 0x00C, cm_DPLL_Config_reg_12_fields, 1},
-    {CM_NAME_STR("DPLL_LOCK_2"), 0x00D, cm_DPLL_Config_reg_13_fields, 2},
-    {CM_NAME_STR("DPLL_LOCK_3"), 0x00E, cm_DPLL_Config_reg_14_fields, 1},
-    {CM_NAME_STR("DPLL_REF_PRIORITY_0"), 0x00F, cm_DPLL_Config_reg_15_fields,
-     3},
-    {CM_NAME_STR("DPLL_REF_PRIORITY_1"), 0x010, cm_DPLL_Config_reg_15_fields,
-     3},
-    {CM_NAME_STR("DPLL_REF_PRIORITY_2"), 0x011, cm_DPLL_Config_reg_15_fields,
-     3},
-    {CM_NAME_STR("DPLL_REF_PRIORITY_3"), 0x012, cm_DPLL_Config_reg_15_fields,
-     3},
-    {CM_NAME_STR("DPLL_TRANS_CTRL"), 0x022, cm_DPLL_Config_reg_16_fields, 3},
-    {CM_NAME_STR("DPLL_FASTLOCK_CFG_0"), 0x023, cm_DPLL_Config_reg_17_fields,
-     8},
-    {CM_NAME_STR("DPLL_FASTLOCK_CFG_1"), 0x024, cm_DPLL_Config_reg_18_fields,
-     2},
-    {CM_NAME_STR("DPLL_MAX_FREQ_OFFSET"), 0x025, cm_DPLL_Config_reg_19_fields,
-     1},
-    {CM_NAME_STR("DPLL_FASTLOCK_PSL"), 0x026, cm_DPLL_Config_reg_20_fields, 1},
-    {CM_NAME_STR("DPLL_FASTLOCK_PSL_15_8"), 0x027, cm_DPLL_Config_reg_21_fields,
-     1},
-    {CM_NAME_STR("DPLL_FASTLOCK_FSL"), 0x028, cm_DPLL_Config_reg_22_fields, 1},
-    {CM_NAME_STR("DPLL_FASTLOCK_FSL_15_8"), 0x029, cm_DPLL_Config_reg_23_fields,
-     1},
-    {CM_NAME_STR("DPLL_FASTLOCK_BW"), 0x02A, cm_DPLL_Config_reg_24_fields, 1},
-    {CM_NAME_STR("DPLL_FASTLOCK_BW_15_8"), 0x02B, cm_DPLL_Config_reg_25_fields,
-     2},
-    {CM_NAME_STR("DPLL_WRITE_FREQ_TIMER"), 0x02C, cm_DPLL_Config_reg_26_fields,
-     1},
-    {CM_NAME_STR("DPLL_WRITE_FREQ_TIMER_15_8"), 0x02D,
-     cm_DPLL_Config_reg_27_fields, 1},
-    {CM_NAME_STR("DPLL_WRITE_PHASE_TIMER"), 0x02E, cm_DPLL_Config_reg_28_fields,
-     1},
-    {CM_NAME_STR("DPLL_WRITE_PHASE_TIMER_15_8"), 0x02F,
-     cm_DPLL_Config_reg_29_fields, 1},
-    {CM_NAME_STR("DPLL_PRED_CFG"), 0x030, cm_DPLL_Config_reg_30_fields, 3},
-    {CM_NAME_STR("DPLL_TOD_SYNC_CFG"), 0x031, cm_DPLL_Config_reg_31_fields, 3},
-    {CM_NAME_STR("DPLL_COMBO_SLAVE_CFG_0"), 0x032, cm_DPLL_Config_reg_32_fields,
-     4},
-    {CM_NAME_STR("DPLL_COMBO_SLAVE_CFG_1"), 0x033, cm_DPLL_Config_reg_33_fields,
-     4},
-    {CM_NAME_STR("DPLL_SLAVE_REF_CFG"), 0x034, cm_DPLL_Config_reg_34_fields, 2},
-    {CM_NAME_STR("DPLL_REF_MODE"), 0x035, cm_DPLL_Config_reg_35_fields, 2},
-    {CM_NAME_STR("DPLL_PHASE_MEASUREMENT_CFG"), 0x036,
-     cm_DPLL_Config_reg_36_fields, 2},
-    {CM_NAME_STR("DPLL_MODE"), 0x037, cm_DPLL_Config_reg_37_fields, 3},
-};
-const cm_module_desc_t cm_DPLL_Config_module = {CM_NAME_STR("DPLL_Config"),
-                                                cm_DPLL_Config_bases, 8,
-                                                cm_DPLL_Config_regs, 41};
-
-static const uint16_t cm_DPLL_GeneralStatus_bases[1] = {0xC014};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_0_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_1_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_2_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_3_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_4_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_5_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
-};
-static const cm_field_desc_t cm_DPLL_GeneralStatus_reg_6_fields[1] = {
-    {CM_NAME_STR("VALUE"), 0, 8},
+    {7202, 0x000, CM_REG_CONFIG, 208, 1}, /* DPLL_DCO_INC_DEC_SIZE_7_0 */
+    {7249, 0x001, CM_REG_CONFIG, 209, 1}, /* DPLL_DCO_INC_DEC_SIZE_15_8 */
+    {7298, 0x002, CM_REG_CONFIG, 210, 4}, /* DPLL_CTRL_0 */
+    {7366, 0x003, CM_REG_CONFIG, 214, 3}, /* DPLL_CTRL_1 */
+    {7422, 0x004, CM_REG_CONFIG, 217, 4}, /* DPLL_CTRL_2 */
+    {7505, 0x005, CM_REG_CONFIG, 221, 1}, /* DPLL_UPDATE_RATE_CFG */
+    {7542, 0x006, CM_REG_CONFIG, 222, 2}, /* DPLL_FILTER_STATUS_UPDATE_CFG */
+    {7622, 0x007, CM_REG_CONFIG, 224, 1}, /* DPLL_HO_ADVCD_HISTORY */
+    {7652, 0x008, CM_REG_CONFIG, 225, 1}, /* DPLL_HO_ADVCD_BW_7_0 */
+    {7673, 0x009, CM_REG_CONFIG, 226, 2}, /* DPLL_HO_ADVCD_BW_15_8 */
+    {7695, 0x00A, CM_REG_CONFIG, 228, 1}, /* DPLL_HO_CFG */
+    {7721, 0x00B, CM_REG_CONFIG, 229, 2}, /* DPLL_LOCK_0 */
+    {7765, 0x00C, CM_REG_CONFIG, 231, 1}, /* DPLL_LOCK_1 */
+    {7791, 0x00D, CM_REG_CONFIG, 232, 2}, /* DPLL_LOCK_2 */
+    {7822, 0x00E, CM_REG_CONFIG, 234, 1}, /* DPLL_LOCK_3 */
+    {7846, 0x00F, CM_REG_CONFIG, 235, 3}, /* DPLL_REF_PRIORITY_0 */
+    {7913, 0x010, CM_REG_CONFIG, 235, 3}, /* DPLL_REF_PRIORITY_1 */
+    {7933, 0x011, CM_REG_CONFIG, 235, 3}, /* DPLL_REF_PRIORITY_2 */
+    {7953, 0x012, CM_REG_CONFIG, 235, 3}, /* DPLL_REF_PRIORITY_3 */
+    {7973, 0x022, CM_REG_CONFIG, 238, 3}, /* DPLL_TRANS_CTRL */
+    {8023, 0x023, CM_REG_CONFIG, 241, 8}, /* DPLL_FASTLOCK_CFG_0 */
+    {8215, 0x024, CM_REG_CONFIG, 249, 2}, /* DPLL_FASTLOCK_CFG_1 */
+    {8254, 0x025, CM_REG_CONFIG, 251, 1}, /* DPLL_MAX_FREQ_OFFSET */
+    {8283, 0x026, CM_REG_CONFIG, 252, 1}, /* DPLL_FASTLOCK_PSL */
+    {8323, 0x027, CM_REG_CONFIG, 253, 1}, /* DPLL_FASTLOCK_PSL_15_8 */
+    {8346, 0x028, CM_REG_CONFIG, 254, 1}, /* DPLL_FASTLOCK_FSL */
+    {8386, 0x029, CM_REG_CONFIG, 255, 1}, /* DPLL_FASTLOCK_FSL_15_8 */
+    {8409, 0x02A, CM_REG_CONFIG, 256, 1}, /* DPLL_FASTLOCK_BW */
+    {8447, 0x02B, CM_REG_CONFIG, 257, 2}, /* DPLL_FASTLOCK_BW_15_8 */
+    {8469, 0x02C, CM_REG_CONFIG, 259, 1}, /* DPLL_WRITE_FREQ_TIMER */
+    {8519, 0x02D, CM_REG_CONFIG, 260, 1}, /* DPLL_WRITE_FREQ_TIMER_15_8 */
+    {8575, 0x02E, CM_REG_CONFIG, 261, 1}, /* DPLL_WRITE_PHASE_TIMER */
+    {8627, 0x02F, CM_REG_CONFIG, 262, 1}, /* DPLL_WRITE_PHASE_TIMER_15_8 */
+    {8685, 0x030, CM_REG_CONFIG, 263, 3}, /* DPLL_PRED_CFG */
+    {8715, 0x031, CM_REG_CONFIG, 266, 3}, /* DPLL_TOD_SYNC_CFG */
+    {8761, 0x032, CM_REG_CONFIG, 269, 4}, /* DPLL_COMBO_SLAVE_CFG_0 */
+    {8846, 0x033, CM_REG_CONFIG, 273, 4}, /* DPLL_COMBO_SLAVE_CFG_1 */
+    {8931, 0x034, CM_REG_CONFIG, 277, 2}, /* DPLL_SLAVE_REF_CFG */
+    {8966, 0x035, CM_REG_CONFIG, 279, 2}, /* DPLL_REF_MODE */
+    {8980, 0x036, CM_REG_CONFIG, 281, 2}, /* DPLL_PHASE_MEASUREMENT_CFG */
+    {9038, 0x037, CM_REG_CONFIG, 283, 3}, /* DPLL_MODE */
+};
+const cm_module_desc_t cm_DPLL_Config_module = {
+    7190, cm_DPLL_Config_bases, 8, cm_DPLL_Config_regs, 41}; /* DPLL_Config */
+
+static const uint16_t cm_DPLL_GeneralStatus_bases[1] = {
+    0xC014,
 };
 static const cm_reg_desc_t cm_DPLL_GeneralStatus_regs[7] = {
-    {CM_NAME_STR("EEPROM_STATUS_7_0"), 0x008,
-     cm_DPLL_GeneralStatus_reg_0_fields, 1},
-    {CM_NAME_STR("EEPROM_STATUS_8_15"), 0x009,
-     cm_DPLL_GeneralStatus_reg_1_fields, 1},
-    {CM_NAME_STR("MAJOR RELEASE"), 0x010, cm_DPLL_GeneralStatus_reg_2_fields,
-     1},
-    {CM_NAME_STR("MINOR RELEASE"), 0x011, cm_DPLL_GeneralStatus_reg_3_fields,
-     1},
-    {CM_NAME_STR("HOTFIX RELEASE"), 0x012, cm_DPLL_GeneralStatus_reg_4_fields,
-     1},
-    {CM_NAME_STR("JTAG DEVICE ID"), 0x01C, cm_DPLL_GeneralStatus_reg_5_fields,
-     1},
-    {CM_NAME_STR("PRODUCT ID"), 0x01E, cm_DPLL_GeneralStatus_reg_6_fields, 1},
+    {9104, 0x008, CM_REG_VOLATILE, 192, 1}, /* EEPROM_STATUS_7_0 */
+    {9122, 0x009, CM_REG_VOLATILE, 192, 1}, /* EEPROM_STATUS_8_15 */
+    {9141, 0x010, CM_REG_CONFIG, 192, 1}, /* MAJOR RELEASE */
+    {9155, 0x011, CM_REG_CONFIG, 192, 1}, /* MINOR RELEASE */
+    {9169, 0x012, CM_REG_CONFIG, 192, 1}, /* HOTFIX RELEASE */
+    {9184, 0x01C, CM_REG_CONFIG, 192, 1}, /* JTAG DEVICE ID */
+    {9199, 0x01E, CM_REG_CONFIG, 192, 1}, /* PRODUCT ID */
 };
 const cm_module_desc_t cm_DPLL_GeneralStatus_module = {
-    CM_NAME_STR("DPLL_GeneralStatus"), cm_DPLL_GeneralStatus_bases, 1,
-    cm_DPLL_GeneralStatus_regs, 7};
+    9085, cm_DPLL_GeneralStatus_bases, 1, cm_DPLL_GeneralStatus_regs, 7}; /* DPLL_GeneralStatus */
 
 const cm_module_desc_t *const cm_all_modules[] = {
     &cm_Status_module,
@@ -1406,9 +1286,63 @@ const cm_module_desc_t *const cm_all_modules[] = {
     &cm_DPLL_Ctrl_module,
     &cm_DPLL_Freq_Write_module,
     &cm_DPLL_Config_module,
-    &cm_DPLL_GeneralStatus_module};
+    &cm_DPLL_GeneralStatus_module,
+};
 const size_t cm_all_modules_count = 23;
 
+/* ---- END GENERATED ---- */
+
+/* Wide logical fields, indexed by cm_wide_field_id_t. All little-endian on
+ * the 8A3400x. */
+const cm_wide_field_desc_t cm_wide_fields[CM_WF_COUNT] = {
+    [CM_WF_DPLL_PHASE_STATUS] = {CM_NAME_STR("DPLL_PHASE_STATUS"),
+                                 &cm_Status_module, 0x0DC, 8, 8, 5, 36,
+                                 CM_WIDE_SIGNED},
+    [CM_WF_DPLL_WR_FREQ] = {CM_NAME_STR("DPLL_WR_FREQ"),
+                            &cm_DPLL_Freq_Write_module, 0x000, 0, 0, 6, 42,
+                            CM_WIDE_SIGNED},
+    [CM_WF_DPLL_PSL] = {CM_NAME_STR("DPLL_PSL"), &cm_DPLL_Ctrl_module, 0x006,
+                        0, 0, 2, 16, 0},
+    [CM_WF_DPLL_PHASE_OFFSET] = {CM_NAME_STR("DPLL_PHASE_OFFSET_CFG"),
+                                 &cm_DPLL_Ctrl_module, 0x014, 0, 0, 5, 36,
+                                 CM_WIDE_SIGNED},
+    [CM_WF_DPLL_FINE_PHASE_ADV] = {CM_NAME_STR("DPLL_FINE_PHASE_ADV_CFG"),
+                                   &cm_DPLL_Ctrl_module, 0x01A, 0, 0, 2, 13,
+                                   CM_WIDE_SIGNED},
+    [CM_WF_FOD_FREQ_M] = {CM_NAME_STR("FOD_FREQ_M"), &cm_DPLL_Ctrl_module,
+                          0x01C, 0, 0, 6, 48, 0},
+    [CM_WF_FOD_FREQ_N] = {CM_NAME_STR("FOD_FREQ_N"), &cm_DPLL_Ctrl_module,
+                          0x022, 0, 0, 2, 16, 0},
+    [CM_WF_INPUT_FREQ_M] = {CM_NAME_STR("INPUT_IN_FREQ_M"), &cm_Input_module,
+                            0x000, 0, 0, 6, 48, 0},
+    [CM_WF_INPUT_FREQ_N] = {CM_NAME_STR("INPUT_IN_FREQ_N"), &cm_Input_module,
+                            0x006, 0, 0, 2, 16, 0},
+    [CM_WF_INPUT_DIV] = {CM_NAME_STR("INPUT_IN_DIV"), &cm_Input_module, 0x008,
+                         0, 0, 2, 16, 0},
+    [CM_WF_INPUT_PHASE] = {CM_NAME_STR("INPUT_IN_PHASE"), &cm_Input_module,
+                           0x00A, 0, 0, 2, 16, CM_WIDE_SIGNED},
+    [CM_WF_OUT_DIV] = {CM_NAME_STR("OUT_DIV"), &cm_Output_module, 0x000, 0, 0,
+                       4, 32, 0},
+    [CM_WF_OUT_PHASE_ADJ] = {CM_NAME_STR("OUT_PHASE_ADJ"), &cm_Output_module,
+                             0x00C, 0, 0, 4, 32, CM_WIDE_SIGNED},
+    [CM_WF_TOD_WRITE_NS] = {CM_NAME_STR("TOD_WRITE_NS"), &cm_TODWrite_module,
+                            0x001, 0, 0, 4, 32, 0},
+    [CM_WF_TOD_WRITE_SECONDS] = {CM_NAME_STR("TOD_WRITE_SECONDS"),
+                                 &cm_TODWrite_module, 0x005, 0, 0, 6, 48, 0},
+    [CM_WF_TOD_READ_PRIMARY_NS] = {CM_NAME_STR("TOD_READ_PRIMARY_NS"),
+                                   &cm_TODReadPrimary_module, 0x001, 0, 0, 4,
+                                   32, 0},
+    [CM_WF_TOD_READ_PRIMARY_SEC] = {CM_NAME_STR("TOD_READ_PRIMARY_SECONDS"),
+                                    &cm_TODReadPrimary_module, 0x005, 0, 0, 6,
+                                    48, 0},
+    [CM_WF_TOD_READ_SECONDARY_NS] = {CM_NAME_STR("TOD_READ_SECONDARY_NS"),
+                                     &cm_TODReadSecondary_module, 0x001, 0, 0,
+                                     4, 32, 0},
+    [CM_WF_TOD_READ_SECONDARY_SEC] = {CM_NAME_STR("TOD_READ_SECONDARY_SECONDS"),
+                                      &cm_TODReadSecondary_module, 0x005, 0, 0,
+                                      6, 48, 0},
+};
+
 int cm_dump_module(const cm_bus_t *bus, const cm_module_desc_t *mod,
                    unsigned inst, int (*printfn)(const char *fmt, ...)) {
   if (!mod || !bus || !printfn)
@@ -1416,27 +1350,103 @@ int cm_dump_module(const cm_bus_t *bus, const cm_module_desc_t *mod,
   if (inst >= mod->count)
     return -2;
   uint16_t base = mod->bases[inst];
-  printfn("== %s[%u] @ 0x%04X ==\n", mod->name ? mod->name : "(module)", inst,
-          base);
+  const char *mname = cm_module_name(mod);
+  printfn("== %s[%u] @ 0x%04X ==\n", mname ? mname : "(module)", inst, base);
   for (uint16_t i = 0; i < mod->nregs; ++i) {
     const cm_reg_desc_t *r = &mod->regs[i];
     uint8_t v = 0;
     int rc = cm_read8(bus, (uint16_t)(base + r->offset), &v);
     if (rc)
       return rc;
-    printfn("  %-40s @+0x%03X = 0x%02X\n", r->name ? r->name : "(reg)",
-            r->offset, v);
+    const char *rname = cm_reg_name(r);
+    printfn("  %-40s @+0x%03X = 0x%02X\n", rname ? rname : "(reg)",
+            (unsigned)r->offset, v);
     for (uint16_t f = 0; f < r->nfields; ++f) {
-      const cm_field_desc_t *fd = &r->fields[f];
+      const cm_field_desc_t *fd = cm_reg_field(r, f);
+      const char *fname = cm_field_name(fd);
       uint8_t fv = (uint8_t)((v >> fd->shift) & cm_mask8(fd->width));
-      printfn("      %-32s [%2u:%u] = 0x%02X\n",
-              fd->name ? fd->name : "(field)", fd->shift + fd->width - 1,
-              fd->shift, fv);
+      printfn("      %-32s [%2u:%u] = 0x%02X\n", fname ? fname : "(field)",
+              fd->shift + fd->width - 1, fd->shift, fv);
     }
   }
   return 0;
 }
 
+static uint32_t cm_fnv1a(uint32_t h, uint32_t v, unsigned nbytes) {
+  for (unsigned i = 0; i < nbytes; ++i) {
+    h ^= (v >> (8 * i)) & 0xFFu;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+uint32_t cm_tables_version(void) {
+  uint32_t h = 2166136261u;
+  h = cm_fnv1a(h, (uint32_t)cm_all_modules_count, 2);
+  for (size_t m = 0; m < cm_all_modules_count; ++m) {
+    const cm_module_desc_t *mod = cm_all_modules[m];
+    h = cm_fnv1a(h, mod->count, 2);
+    for (uint16_t i = 0; i < mod->count; ++i)
+      h = cm_fnv1a(h, mod->bases[i], 2);
+    h = cm_fnv1a(h, mod->nregs, 2);
+    for (uint16_t r = 0; r < mod->nregs; ++r) {
+      const cm_reg_desc_t *reg = &mod->regs[r];
+      h = cm_fnv1a(h, reg->offset, 2);
+      h = cm_fnv1a(h, reg->nfields, 2);
+      for (uint16_t f = 0; f < reg->nfields; ++f) {
+        const cm_field_desc_t *fd = cm_reg_field(reg, f);
+        h = cm_fnv1a(h, (uint32_t)fd->shift | ((uint32_t)fd->width << 8), 2);
+      }
+    }
+  }
+  return h;
+}
+
+/* Register span of each module instance (last offset + 1), filled on first
+ * use. Concurrent first calls compute the same values. */
+static uint16_t cm_module_span[sizeof(cm_all_modules) / sizeof(cm_all_modules[0])];
+static int cm_module_span_ready;
+
+static void cm_module_spans_init(void) {
+  for (size_t m = 0; m < cm_all_modules_count; ++m) {
+    const cm_module_desc_t *mod = cm_all_modules[m];
+    uint16_t span = 0;
+    for (uint16_t r = 0; r < mod->nregs; ++r)
+      if (mod->regs[r].offset + 1u > span)
+        span = (uint16_t)(mod->regs[r].offset + 1u);
+    __atomic_store_n(&cm_module_span[m], span, __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&cm_module_span_ready, 1, __ATOMIC_RELEASE);
+}
+
+int cm_module_for_addr(uint16_t addr, size_t *mod_index_out,
+                       unsigned *inst_out) {
+  if (!__atomic_load_n(&cm_module_span_ready, __ATOMIC_ACQUIRE))
+    cm_module_spans_init();
+
+  int found = 0;
+  uint16_t best_base = 0;
+  for (size_t m = 0; m < cm_all_modules_count; ++m) {
+    const cm_module_desc_t *mod = cm_all_modules[m];
+    const uint16_t span = __atomic_load_n(&cm_module_span[m], __ATOMIC_RELAXED);
+    for (uint16_t i = 0; i < mod->count; ++i) {
+      const uint16_t base = mod->bases[i];
+      if (addr < base || addr - base >= span)
+        continue;
+      /* Overlapping spans: the instance starting closest below wins. */
+      if (found && base < best_base)
+        continue;
+      found = 1;
+      best_base = base;
+      if (mod_index_out)
+        *mod_index_out = m;
+      if (inst_out)
+        *inst_out = i;
+    }
+  }
+  return found ? 0 : -2;
+}
+
 /* ---- String-based lookup helpers implementation ------------------------- */
 
 int cm_find_module(const char *name, const cm_module_desc_t **mod_out) {
@@ -1446,11 +1456,12 @@ int cm_find_module(const char *name, const cm_module_desc_t **mod_out) {
 
   for (size_t i = 0; i < cm_all_modules_count; ++i) {
     const cm_module_desc_t *m = cm_all_modules[i];
-    if (!m || !m->name) {
-      /* CM_STRIP_NAMES may set names NULL; skip in that case. */
+    const char *mname = m ? cm_module_name(m) : NULL;
+    if (!mname) {
+      /* CM_STRIP_NAMES: no names to match against. */
       continue;
     }
-    if (strcmp(m->name, name) == 0) {
+    if (strcmp(mname, name) == 0) {
       *mod_out = m;
       return 0;
     }
@@ -1466,10 +1477,11 @@ int cm_find_reg(const cm_module_desc_t *mod, const char *reg_name,
 
   for (uint16_t i = 0; i < mod->nregs; ++i) {
     const cm_reg_desc_t *r = &mod->regs[i];
-    if (!r->name)
+    const char *rname = cm_reg_name(r);
+    if (!rname)
       continue;
-    // fprintf(stderr, "Debug cm_find_reg, i=%d, name = %s\r\n", i, r->name);
-    if (strcmp(r->name, reg_name) == 0) {
+    // fprintf(stderr, "Debug cm_find_reg, i=%d, name = %s\r\n", i, rname);
+    if (strcmp(rname, reg_name) == 0) {
       *reg_out = r;
       return 0;
     }
@@ -1484,10 +1496,11 @@ int cm_find_field(const cm_reg_desc_t *reg, const char *field_name,
   *field_out = NULL;
 
   for (uint16_t i = 0; i < reg->nfields; ++i) {
-    const cm_field_desc_t *f = &reg->fields[i];
-    if (!f->name)
+    const cm_field_desc_t *f = cm_reg_field(reg, i);
+    const char *fname = cm_field_name(f);
+    if (!fname)
       continue;
-    if (strcmp(f->name, field_name) == 0) {
+    if (strcmp(fname, field_name) == 0) {
       *field_out = f;
       return 0;
     }
@@ -1669,10 +1682,296 @@ int cm_string_read_bytes(const cm_bus_t *bus, const char *mod_name,
   return bus->read(bus->user, addr, data, len);
 }
 
+/* ---- Multi-field writes ---- */
+
+#define CM_FIELDS_PAGE_SIZE 0x80u /* bus->read/write stay inside one page */
+
+typedef struct {
+  uint16_t addr;
+  uint8_t mask; /* bits being written */
+  uint8_t bits; /* new values of those bits */
+} cm_byte_update_t;
+
+static void cm_byte_update_apply(cm_byte_update_t *u, unsigned shift,
+                                 unsigned width, uint8_t value) {
+  uint8_t m = (uint8_t)(cm_mask8(width) << shift);
+  u->mask |= m;
+  u->bits = (uint8_t)((u->bits & (uint8_t)~m) | ((value << shift) & m));
+}
+
+/* Single register: read only if some bits are kept, then one write. */
+static int cm_byte_update_write(const cm_bus_t *bus,
+                                const cm_byte_update_t *u) {
+  uint8_t v = 0;
+  if (u->mask != 0xFF) {
+    int rc = cm_read8(bus, u->addr, &v);
+    if (rc)
+      return rc;
+  }
+  v = (uint8_t)((v & (uint8_t)~u->mask) | u->bits);
+  return cm_write8(bus, u->addr, v);
+}
+
+static int cm_byte_update_cmp(const void *a, const void *b) {
+  const cm_byte_update_t *x = (const cm_byte_update_t *)a;
+  const cm_byte_update_t *y = (const cm_byte_update_t *)b;
+  return (int)x->addr - (int)y->addr;
+}
+
+int cm_fields_write8(const cm_bus_t *bus, uint16_t addr,
+                     const cm_field_val_t *vals, size_t n) {
+  if (!bus || !vals || n == 0)
+    return -1;
+
+  cm_byte_update_t u = {addr, 0, 0};
+  for (size_t i = 0; i < n; i++)
+    cm_byte_update_apply(&u, vals[i].shift, vals[i].width, vals[i].value);
+  return cm_byte_update_write(bus, &u);
+}
+
+/* One read (if needed) + one write for consecutive updates u[0..n). */
+static int cm_fields_write_span(const cm_bus_t *bus, const cm_byte_update_t *u,
+                                size_t n) {
+  uint8_t buf[CM_FIELDS_PAGE_SIZE];
+  int need_read = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (u[i].mask != 0xFF)
+      need_read = 1;
+  }
+
+  memset(buf, 0, n);
+  if (need_read) {
+    int rc = bus->read(bus->user, u[0].addr, buf, n);
+    if (rc)
+      return rc;
+  }
+  for (size_t i = 0; i < n; i++)
+    buf[i] = (uint8_t)((buf[i] & (uint8_t)~u[i].mask) | u[i].bits);
+
+  return bus->write(bus->user, u[0].addr, buf, n);
+}
+
+int cm_fields_write_group(const cm_bus_t *bus, const cm_field_write_t *writes,
+                          size_t n) {
+  if (!bus || !writes || n == 0)
+    return -1;
+
+  cm_byte_update_t *u = (cm_byte_update_t *)malloc(n * sizeof(*u));
+  if (!u)
+    return -1;
+
+  /* Merge per address, keeping the caller's order for overlapping bits. */
+  size_t nu = 0;
+  for (size_t i = 0; i < n; i++) {
+    size_t j = 0;
+    while (j < nu && u[j].addr != writes[i].addr)
+      j++;
+    if (j == nu) {
+      u[nu].addr = writes[i].addr;
+      u[nu].mask = 0;
+      u[nu].bits = 0;
+      nu++;
+    }
+    cm_byte_update_apply(&u[j], writes[i].shift, writes[i].width,
+                         writes[i].value);
+  }
+  qsort(u, nu, sizeof(*u), cm_byte_update_cmp);
+
+  int rc = 0;
+  size_t start = 0;
+  while (start < nu && rc == 0) {
+    size_t end = start + 1;
+    while (end < nu && u[end].addr == (uint16_t)(u[end - 1].addr + 1) &&
+           (u[end].addr / CM_FIELDS_PAGE_SIZE) ==
+               (u[start].addr / CM_FIELDS_PAGE_SIZE))
+      end++;
+    rc = cm_fields_write_span(bus, &u[start], end - start);
+    start = end;
+  }
+
+  free(u);
+  return rc;
+}
+
+int cm_string_fields_write8(const cm_bus_t *bus, const char *mod_name,
+                            unsigned inst, const char *reg_name,
+                            const cm_named_field_val_t *vals, size_t n) {
+  if (!bus || !vals || n == 0)
+    return -1;
+
+  const cm_module_desc_t *mod = NULL;
+  const cm_reg_desc_t *reg = NULL;
+  uint16_t addr = 0;
+  int rc = cm_resolve_reg_addr(&mod, &reg, &addr, mod_name, inst, reg_name);
+  if (rc) {
+    fprintf(stderr, "cm_string_fields_write8, resolve_reg_addr fail\n");
+    return rc;
+  }
+
+  cm_byte_update_t u = {addr, 0, 0};
+  for (size_t i = 0; i < n; i++) {
+    const cm_field_desc_t *field = NULL;
+    rc = cm_find_field(reg, vals[i].field_name, &field);
+    if (rc) {
+      fprintf(stderr, "cm_string_fields_write8, cm_find_field %s fail\n",
+              vals[i].field_name ? vals[i].field_name : "(null)");
+      return rc;
+    }
+    cm_byte_update_apply(&u, field->shift, field->width, vals[i].value);
+  }
+  return cm_byte_update_write(bus, &u);
+}
+
+int cm_string_field_resolve(const char *mod_name, unsigned inst,
+                            const char *reg_name, const char *field_name,
+                            uint8_t value, cm_field_write_t *out) {
+  if (!out)
+    return -1;
+
+  const cm_module_desc_t *mod = NULL;
+  const cm_reg_desc_t *reg = NULL;
+  uint16_t addr = 0;
+  int rc = cm_resolve_reg_addr(&mod, &reg, &addr, mod_name, inst, reg_name);
+  if (rc)
+    return rc;
+
+  const cm_field_desc_t *field = NULL;
+  rc = cm_find_field(reg, field_name, &field);
+  if (rc) {
+    fprintf(stderr, "cm_string_field_resolve, cm_find_field %s fail\n",
+            field_name ? field_name : "(null)");
+    return rc;
+  }
+
+  out->addr = addr;
+  out->shift = field->shift;
+  out->width = field->width;
+  out->value = value;
+  return 0;
+}
+
+/* ---- Wide logical fields ---- */
+
+int cm_find_wide_field(const char *name, cm_wide_field_id_t *id_out) {
+  if (!name || !id_out)
+    return -1;
+
+  for (unsigned i = 0; i < CM_WF_COUNT; i++) {
+    if (cm_wide_fields[i].name && strcmp(cm_wide_fields[i].name, name) == 0) {
+      *id_out = (cm_wide_field_id_t)i;
+      return 0;
+    }
+  }
+  return -2; /* not found */
+}
+
+int cm_wide_field_addr(cm_wide_field_id_t id, unsigned inst,
+                       uint16_t *addr_out) {
+  if ((unsigned)id >= CM_WF_COUNT || !addr_out)
+    return -1;
+
+  const cm_wide_field_desc_t *wf = &cm_wide_fields[id];
+  if (wf->stride) {
+    if (inst >= wf->count)
+      return -3; /* bad instance index */
+    *addr_out = (uint16_t)(wf->mod->bases[0] + wf->offset + inst * wf->stride);
+  } else {
+    if (inst >= wf->mod->count)
+      return -3; /* bad instance index */
+    *addr_out = (uint16_t)(wf->mod->bases[inst] + wf->offset);
+  }
+  return 0;
+}
+
+int cm_wide_field_decode(cm_wide_field_id_t id, const uint8_t *buf,
+                         int64_t *out) {
+  if ((unsigned)id >= CM_WF_COUNT || !buf || !out)
+    return -1;
+
+  const cm_wide_field_desc_t *wf = &cm_wide_fields[id];
+  uint64_t u = 0;
+  for (unsigned i = 0; i < wf->nbytes; i++) {
+    unsigned b = (wf->flags & CM_WIDE_BIG_ENDIAN) ? (wf->nbytes - 1u - i) : i;
+    u |= (uint64_t)buf[b] << (8 * i);
+  }
+
+  if (wf->bits < 64) {
+    uint64_t mask = (1ULL << wf->bits) - 1ULL;
+    u &= mask;
+    if ((wf->flags & CM_WIDE_SIGNED) && (u & (1ULL << (wf->bits - 1))))
+      u |= ~mask; /* sign extend */
+  }
+  *out = (int64_t)u;
+  return 0;
+}
+
+int cm_wide_field_encode(cm_wide_field_id_t id, int64_t value, uint8_t *buf) {
+  if ((unsigned)id >= CM_WF_COUNT || !buf)
+    return -1;
+
+  const cm_wide_field_desc_t *wf = &cm_wide_fields[id];
+  uint64_t u = (uint64_t)value;
+  if (wf->bits < 64) {
+    if (wf->flags & CM_WIDE_SIGNED) {
+      int64_t lim = (int64_t)(1ULL << (wf->bits - 1));
+      if (value < -lim || value >= lim)
+        return -4; /* out of range */
+    } else if (value < 0 || (uint64_t)value >> wf->bits) {
+      return -4; /* out of range */
+    }
+    u &= (1ULL << wf->bits) - 1ULL;
+  }
+
+  for (unsigned i = 0; i < wf->nbytes; i++) {
+    unsigned b = (wf->flags & CM_WIDE_BIG_ENDIAN) ? (wf->nbytes - 1u - i) : i;
+    buf[b] = (uint8_t)(u >> (8 * i));
+  }
+  return 0;
+}
+
+int cm_read_s64_field(const cm_bus_t *bus, cm_wide_field_id_t id,
+                      unsigned inst, int64_t *out) {
+  if (!bus || !out)
+    return -1;
+
+  uint16_t addr = 0;
+  int rc = cm_wide_field_addr(id, inst, &addr);
+  if (rc)
+    return rc;
+
+  uint8_t buf[8] = {0};
+  rc = bus->read(bus->user, addr, buf, cm_wide_fields[id].nbytes);
+  if (rc)
+    return rc;
+
+  return cm_wide_field_decode(id, buf, out);
+}
+
+int cm_write_s64_field(const cm_bus_t *bus, cm_wide_field_id_t id,
+                       unsigned inst, int64_t value) {
+  if (!bus)
+    return -1;
+
+  uint16_t addr = 0;
+  int rc = cm_wide_field_addr(id, inst, &addr);
+  if (rc)
+    return rc;
+
+  uint8_t buf[8];
+  rc = cm_wide_field_encode(id, value, buf);
+  if (rc)
+    return rc;
+  return bus->write(bus->user, addr, buf, cm_wide_fields[id].nbytes);
+}
+
 #define DPLL_MAX_M ((1ULL << 48) - 1)
 #define DPLL_MAX_N (65535U)
 
 /* Compute best 48-bit M and 16-bit N (1..65535) such that M/N ≈ freq_hz.
+ *
+ * This is the best rational approximation of the exact value of freq_hz
+ * under those bounds (see cm_fp_best_ratio()); it matches or beats a scan
+ * of every N.
  *
  * On success:
  *   *M_out        = 48-bit numerator
@@ -1692,38 +1991,11 @@ int dpll_compute_input_ratio(double freq_hz, uint64_t *M_out,
     return -2; // non-positive frequency
   }
 
-  double best_err = DBL_MAX;
+  cm_u128 num = 0, den = 1;
   uint64_t best_M = 0;
   uint32_t best_N = 1;
-
-  /* Brute-force search over N in [1..DPLL_MAX_N] */
-  for (uint32_t N = 1; N <= DPLL_MAX_N; ++N) {
-    double m_real = freq_hz * (double)N;
-
-    if (m_real > (double)DPLL_MAX_M) {
-      /* For your typical ranges (1..250 MHz), this never triggers,
-       * but the check keeps it safe if someone passes something wild.
-       */
-      continue;
-    }
-
-    uint64_t M = (uint64_t)llround(m_real);
-    double realized = (double)M / (double)N;
-    double err = fabs(realized - freq_hz);
-
-    if (err < best_err) {
-      best_err = err;
-      best_M = M;
-      best_N = N;
-
-      /* Early-exit if we hit exact representation */
-      if (err == 0.0) {
-        break;
-      }
-    }
-  }
-
-  if (best_M == 0 && best_N == 1) {
+  if (cm_fp_exact_double(freq_hz, &num, &den) ||
+      cm_fp_best_ratio(num, den, DPLL_MAX_M, DPLL_MAX_N, &best_M, &best_N)) {
     /* Could not find anything reasonable (should not happen for sane freq) */
     return -3;
   }
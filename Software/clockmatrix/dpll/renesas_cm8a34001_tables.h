@@ -5,6 +5,7 @@
  *
  * This provides:
  *  - const tables for modules: bases[], registers[], fields[] with human-readable names
+ *    (generated by gen_cm_tables.py from renesas_cm8a34001_regs.txt; run `make tables`)
  *  - a tiny bus shim + generic helpers
  *  - utility dump/peek APIs for iteration
  *
@@ -68,27 +69,66 @@ static inline int cm_field_write8(const cm_bus_t *b, uint16_t a, unsigned sh, un
   #define CM_NAME_STR(x) NULL
 #endif
 
+/* Packed descriptors.
+ *
+ * The module/register/field tables are generated by gen_cm_tables.py from
+ * renesas_cm8a34001_regs.txt. Names live in one NUL-separated blob,
+ * cm_names[], and descriptors hold 16-bit offsets into it; all field
+ * descriptors live in one pool, cm_fields[], and each register points at its
+ * first field by index. Use cm_module_name() / cm_reg_name() /
+ * cm_field_name() / cm_reg_field() rather than the raw members.
+ *
+ * With CM_STRIP_NAMES the blob is empty and the name accessors return NULL.
+ */
 typedef struct cm_field_desc {
-    const char *name;   /* may be NULL if CM_STRIP_NAMES */
-    uint8_t     shift;
-    uint8_t     width;
-} cm_field_desc_t;
+    uint16_t name;          /* offset into cm_names[] */
+    uint8_t  shift;
+    uint8_t  width;
+} cm_field_desc_t;           /* 4 bytes */
+
+/* Register flags (cm_reg_desc_t.flags).
+ *  CM_REG_CONFIG   - plain configuration; only changes when the host writes it,
+ *                    so a read-back value may be cached.
+ *  CM_REG_VOLATILE - status, counters, command/trigger and read-data registers
+ *                    that the device updates on its own (or whose write has a
+ *                    side effect); always go to the bus.
+ */
+#define CM_REG_CONFIG   0x00u
+#define CM_REG_VOLATILE 0x01u
 
 typedef struct cm_reg_desc {
-    const char *name;   /* may be NULL if CM_STRIP_NAMES */
-    uint16_t    offset;
-    const cm_field_desc_t *fields;
-    uint16_t    nfields;
-} cm_reg_desc_t;
+    uint16_t name;          /* offset into cm_names[] */
+    uint16_t offset  : 12;  /* from the module base */
+    uint16_t flags   : 4;   /* CM_REG_* */
+    uint16_t field0  : 12;  /* index of the first field in cm_fields[] */
+    uint16_t nfields : 4;
+} cm_reg_desc_t;             /* 6 bytes */
 
 typedef struct cm_module_desc {
-    const char *name;   /* may be NULL if CM_STRIP_NAMES */
+    uint16_t name;          /* offset into cm_names[] */
     const uint16_t *bases;
     uint16_t        count;
     const cm_reg_desc_t *regs;
     uint16_t        nregs;
 } cm_module_desc_t;
 
+extern const char cm_names[];
+extern const cm_field_desc_t cm_fields[];
+
+static inline const char *cm_name_at(uint16_t off)
+{
+#ifndef CM_STRIP_NAMES
+    return &cm_names[off];
+#else
+    (void)off;
+    return NULL;
+#endif
+}
+static inline const char *cm_module_name(const cm_module_desc_t *m){ return cm_name_at(m->name); }
+static inline const char *cm_reg_name(const cm_reg_desc_t *r){ return cm_name_at(r->name); }
+static inline const char *cm_field_name(const cm_field_desc_t *f){ return cm_name_at(f->name); }
+static inline const cm_field_desc_t *cm_reg_field(const cm_reg_desc_t *r, unsigned i){ return &cm_fields[r->field0 + i]; }
+
 /* ---- Declarations for all modules ---- */
 extern const cm_module_desc_t cm_Status_module;
 extern const cm_module_desc_t cm_PWMEncoder_module;
@@ -125,6 +165,21 @@ extern const size_t cm_all_modules_count;
 int cm_dump_module(const cm_bus_t *bus, const cm_module_desc_t *mod, unsigned inst,
                    int (*printfn)(const char *fmt, ...));
 
+/* ---- Utility: table layout version ----
+ * 32-bit FNV-1a hash over every module base, register offset and field
+ * shift/width. Names are not included, so CM_STRIP_NAMES builds agree with
+ * full builds. Stored in register snapshots to detect table mismatches.
+ */
+uint32_t cm_tables_version(void);
+
+/* ---- Utility: module owning an address ----
+ * Finds the module instance whose register span (base .. last register
+ * offset) contains addr; *mod_index_out indexes cm_all_modules[]. Either out
+ * pointer may be NULL. Returns 0, or -2 for an address outside every module.
+ * Linear in the number of instances (~150 compares).
+ */
+int cm_module_for_addr(uint16_t addr, size_t *mod_index_out, unsigned *inst_out);
+
 
 
 /* ---- String-based lookup helpers -----------------------------------------
@@ -215,6 +270,150 @@ int cm_string_read_bytes(const cm_bus_t *bus,
                          size_t len);
 
 
+/* ---- Multi-field writes ---------------------------------------------------
+ *
+ * Every cm_field_write8() / cm_string_field_write8() is a full SPI
+ * read-modify-write. When several fields of one register (or of a few
+ * neighbouring registers) change together, collect them and write them in
+ * one go instead:
+ *
+ *   - fields of the same register are merged into one read and one write;
+ *   - the read is skipped when the fields cover all 8 bits;
+ *   - cm_fields_write_group() sorts by address and emits one burst read and
+ *     one burst write per run of consecutive addresses (split at the 128-byte
+ *     page boundary). Gaps are never written.
+ *
+ * Later entries for overlapping bits win. All return 0 on success, non-zero
+ * on the first lookup or bus error.
+ */
+typedef struct cm_field_val {
+    uint8_t shift;
+    uint8_t width;
+    uint8_t value;
+} cm_field_val_t;
+
+typedef struct cm_field_write {
+    uint16_t addr;
+    uint8_t  shift;
+    uint8_t  width;
+    uint8_t  value;
+} cm_field_write_t;
+
+typedef struct cm_named_field_val {
+    const char *field_name;
+    uint8_t     value;
+} cm_named_field_val_t;
+
+/* Write n fields of the register at addr with one read and one write. */
+int cm_fields_write8(const cm_bus_t *bus, uint16_t addr,
+                     const cm_field_val_t *vals, size_t n);
+
+/* Write n fields spread over any registers; one burst per contiguous span. */
+int cm_fields_write_group(const cm_bus_t *bus,
+                          const cm_field_write_t *writes, size_t n);
+
+/* Same as cm_fields_write8(), with fields looked up by name. */
+int cm_string_fields_write8(const cm_bus_t *bus,
+                            const char *mod_name,
+                            unsigned inst,
+                            const char *reg_name,
+                            const cm_named_field_val_t *vals,
+                            size_t n);
+
+/* Resolve module/instance/reg/field names into one cm_fields_write_group()
+ * entry (value is the new field value). */
+int cm_string_field_resolve(const char *mod_name,
+                            unsigned inst,
+                            const char *reg_name,
+                            const char *field_name,
+                            uint8_t value,
+                            cm_field_write_t *out);
+
+#ifndef __cplusplus
+/* CM_FIELDS_WRITE8(bus, addr, {shift, width, value}, ...) */
+#define CM_FIELDS_WRITE8(bus, addr, ...)                                      \
+    cm_fields_write8((bus), (addr), (const cm_field_val_t[]){__VA_ARGS__},    \
+                     sizeof((const cm_field_val_t[]){__VA_ARGS__}) /          \
+                         sizeof(cm_field_val_t))
+#endif
+
+/* ---- Wide (multi-byte) logical fields -------------------------------------
+ *
+ * Values that span several consecutive byte registers (48-bit M, 42-bit
+ * DPLL_WR_FREQ, 36-bit phase status, TOD seconds, ...). Each entry records
+ * where the lowest-addressed byte lives, how many bytes are on the bus, how
+ * many bits are significant, signedness and byte order. The accessors move
+ * a whole value with one bus->read / bus->write burst, so multi-byte values
+ * are never torn across transfers.
+ *
+ * Instances: if stride == 0 the instance selects mod->bases[inst] (e.g.
+ * DPLL_Ctrl[5]); otherwise the value repeats inside instance 0 every
+ * `stride` bytes, `count` times (e.g. Status DPLL<n>_PHASE_STATUS).
+ */
+#define CM_WIDE_SIGNED     0x01u /* two's complement in `bits` bits */
+#define CM_WIDE_BIG_ENDIAN 0x02u /* most significant byte at the lowest address */
+
+typedef enum cm_wide_field_id {
+    CM_WF_DPLL_PHASE_STATUS,      /* Status, s36 in 5 bytes, per DPLL      */
+    CM_WF_DPLL_WR_FREQ,           /* DPLL_Freq_Write, s42 in 6 bytes       */
+    CM_WF_DPLL_PSL,               /* DPLL_Ctrl, u16                        */
+    CM_WF_DPLL_PHASE_OFFSET,      /* DPLL_Ctrl, s36 in 5 bytes             */
+    CM_WF_DPLL_FINE_PHASE_ADV,    /* DPLL_Ctrl, s13 in 2 bytes             */
+    CM_WF_FOD_FREQ_M,             /* DPLL_Ctrl, u48                        */
+    CM_WF_FOD_FREQ_N,             /* DPLL_Ctrl, u16 (0 encodes 1)          */
+    CM_WF_INPUT_FREQ_M,           /* Input, u48                            */
+    CM_WF_INPUT_FREQ_N,           /* Input, u16 (0 encodes 1)              */
+    CM_WF_INPUT_DIV,              /* Input, u16                            */
+    CM_WF_INPUT_PHASE,            /* Input, s16                            */
+    CM_WF_OUT_DIV,                /* Output, u32                           */
+    CM_WF_OUT_PHASE_ADJ,          /* Output, s32                           */
+    CM_WF_TOD_WRITE_NS,           /* TODWrite, u32                         */
+    CM_WF_TOD_WRITE_SECONDS,      /* TODWrite, u48                         */
+    CM_WF_TOD_READ_PRIMARY_NS,    /* TODReadPrimary, u32                   */
+    CM_WF_TOD_READ_PRIMARY_SEC,   /* TODReadPrimary, u48                   */
+    CM_WF_TOD_READ_SECONDARY_NS,  /* TODReadSecondary, u32                 */
+    CM_WF_TOD_READ_SECONDARY_SEC, /* TODReadSecondary, u48                 */
+    CM_WF_COUNT
+} cm_wide_field_id_t;
+
+typedef struct cm_wide_field_desc {
+    const char *name;             /* may be NULL if CM_STRIP_NAMES */
+    const cm_module_desc_t *mod;
+    uint16_t    offset;           /* lowest-addressed byte, from the base */
+    uint16_t    stride;           /* 0: per module instance, see above */
+    uint8_t     count;            /* instances when stride != 0 */
+    uint8_t     nbytes;           /* bytes on the bus, 1..8 */
+    uint8_t     bits;             /* significant bits, 1..64 */
+    uint8_t     flags;            /* CM_WIDE_* */
+} cm_wide_field_desc_t;
+
+extern const cm_wide_field_desc_t cm_wide_fields[CM_WF_COUNT];
+
+/* Look up a wide field by name (e.g. "DPLL_WR_FREQ"). */
+int cm_find_wide_field(const char *name, cm_wide_field_id_t *id_out);
+
+/* Absolute address of the first byte of wide field `id`, instance `inst`. */
+int cm_wide_field_addr(cm_wide_field_id_t id, unsigned inst, uint16_t *addr_out);
+
+/* Decode one wide field from its `nbytes` bus bytes (e.g. a slice of a
+ * larger burst), with the same sign extension as cm_read_s64_field. */
+int cm_wide_field_decode(cm_wide_field_id_t id, const uint8_t *buf,
+                         int64_t *out);
+
+/* Encode `value` into the `nbytes` bus bytes of wide field `id` (the inverse
+ * of cm_wide_field_decode). Returns -4 if it does not fit in `bits`. */
+int cm_wide_field_encode(cm_wide_field_id_t id, int64_t value, uint8_t *buf);
+
+/* Read one wide field in a single burst. Signed fields are sign-extended
+ * from `bits`; bits above `bits` in the top byte are ignored. */
+int cm_read_s64_field(const cm_bus_t *bus, cm_wide_field_id_t id,
+                      unsigned inst, int64_t *out);
+
+/* Write one wide field in a single burst. Returns -4 if value does not fit
+ * in `bits` (signed or unsigned as described). Unused high bits are 0. */
+int cm_write_s64_field(const cm_bus_t *bus, cm_wide_field_id_t id,
+                       unsigned inst, int64_t value);
+
 
 // general clockmatrix utility functions for input and output setting
 int dpll_compute_input_ratio(double freq_hz,
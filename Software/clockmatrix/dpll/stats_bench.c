@@ -0,0 +1,233 @@
+// stats_bench.c
+// Hardware-free regression check + timing for the streaming statistics.
+//
+// Feeds synthetic phase records (white + random-walk noise with drift, a
+// monotonic ramp with steps, a sinusoid) through cm_stats and recomputes
+// every tracked tau by brute force from the whole record: MTIE as the max
+// (max - min) over every window of n+1 samples, ADEV and TDEV straight from
+// their definitions with long double sums. Records are long enough to wrap
+// the engine's history several times and include gaps, some shorter than a
+// window. MTIE and the window/term counts must match exactly, ADEV and TDEV
+// to 1e-9 relative. Exits non-zero on any mismatch. Build and run with
+// `make bench-stats`.
+
+#define _GNU_SOURCE
+
+#include "cm_stats.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_REL_TOL 1e-9
+
+typedef enum { REC_NOISE, REC_RAMP, REC_SINE } bench_rec_kind_t;
+
+typedef struct {
+    const char      *name;
+    bench_rec_kind_t kind;
+    double           tau0;
+    double           tau_max;
+    size_t           nsamp;
+    size_t           gap_every;   // 0 = no periodic gaps
+    size_t           short_seg;   // if set, a second gap this many samples after each gap
+} bench_rec_t;
+
+static const bench_rec_t bench_recs[] = {
+    {"noise+rw+drift", REC_NOISE, 1.0, 1000.0, 20000, 7000, 5},
+    {"ramp+steps", REC_RAMP, 0.125, 100.0, 12000, 0, 0},
+    {"sine+noise", REC_SINE, 1.0, 2000.0, 30000, 9000, 1500},
+};
+
+#define BENCH_N_RECS (sizeof(bench_recs) / sizeof(bench_recs[0]))
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Deterministic xorshift64* so every run checks the same records.
+static uint64_t bench_rng = 0x9E3779B97F4A7C15ULL;
+
+static double bench_uniform(void)
+{
+    bench_rng ^= bench_rng >> 12;
+    bench_rng ^= bench_rng << 25;
+    bench_rng ^= bench_rng >> 27;
+    return (double)((bench_rng * 0x2545F4914F6CDD1DULL) >> 11) * 0x1.0p-53;
+}
+
+static double bench_gauss(void)
+{
+    double u = bench_uniform(), v = bench_uniform();
+    return sqrt(-2.0 * log(u + 0x1.0p-60)) * cos(2.0 * M_PI * v);
+}
+
+// Phase record (seconds); gap[k] = 1 if sample k does not follow k-1.
+static void bench_make_record(const bench_rec_t *r, double *x, uint8_t *gap)
+{
+    double rw = 0.0;
+    for (size_t k = 0; k < r->nsamp; k++) {
+        switch (r->kind) {
+        case REC_NOISE:
+            rw += 0.1e-9 * bench_gauss();
+            x[k] = 5e-9 * bench_gauss() + rw + 1e-12 * (double)k * r->tau0;
+            break;
+        case REC_RAMP:
+            // ties and strictly monotonic runs stress the deque pops
+            x[k] = 1e-12 * (double)(k / 3) + 100e-9 * (double)(k / 777);
+            break;
+        case REC_SINE:
+            x[k] = 10e-9 * sin(2.0 * M_PI * (double)k / 300.0) + 0.5e-9 * bench_gauss();
+            break;
+        }
+        gap[k] = 0;
+        if (r->gap_every && k > 0) {
+            size_t m = k % r->gap_every;
+            gap[k] = m == 0 || (r->short_seg && m == r->short_seg);
+        }
+    }
+}
+
+typedef struct {
+    double   mtie, adev, tdev;
+    uint64_t mtie_windows, avar_terms, tvar_terms;
+} bench_ref_t;
+
+// Everything from the definitions, segment by segment.
+static void bench_reference(const double *x, const uint8_t *gap, size_t nsamp,
+                            uint32_t n, double tau, bench_ref_t *ref)
+{
+    long double sum_d2 = 0.0L, sum_s2 = 0.0L;
+    double *d = malloc(nsamp * sizeof(*d));
+
+    ref->mtie = 0.0;
+    ref->mtie_windows = ref->avar_terms = ref->tvar_terms = 0;
+
+    size_t a = 0;
+    while (a < nsamp && d) {
+        size_t b = a + 1;             // segment [a, b)
+        while (b < nsamp && !gap[b]) b++;
+        const size_t len = b - a;
+
+        for (size_t w = a; w + n < b; w++) {
+            double hi = x[w], lo = x[w];
+            for (size_t j = w; j <= w + n; j++) {
+                if (x[j] > hi) hi = x[j];
+                if (x[j] < lo) lo = x[j];
+            }
+            if (ref->mtie_windows == 0 || hi - lo > ref->mtie) ref->mtie = hi - lo;
+            ref->mtie_windows++;
+        }
+
+        size_t nd = len > 2 * (size_t)n ? len - 2 * (size_t)n : 0;
+        for (size_t i = 0; i < nd; i++) {
+            d[i] = x[a + i + 2 * n] - 2.0 * x[a + i + n] + x[a + i];
+            sum_d2 += (long double)d[i] * d[i];
+            ref->avar_terms++;
+        }
+        for (size_t j = 0; j + n <= nd; j++) {
+            long double s = 0.0L;
+            for (size_t i = j; i < j + n; i++) s += d[i];
+            sum_s2 += s * s;
+            ref->tvar_terms++;
+        }
+        a = b;
+    }
+    free(d);
+
+    ref->adev = ref->avar_terms
+                    ? sqrt((double)(sum_d2 / (2.0L * tau * tau * (long double)ref->avar_terms)))
+                    : -1.0;
+    ref->tdev = ref->tvar_terms
+                    ? sqrt((double)(sum_s2 / (6.0L * n * n * (long double)ref->tvar_terms)))
+                    : -1.0;
+    if (ref->mtie_windows == 0) ref->mtie = -1.0;
+}
+
+static double bench_rel_err(double got, double want)
+{
+    if (got == want) return 0.0;
+    return fabs(got - want) / fmax(fabs(want), 1e-30);
+}
+
+static int bench_record(const bench_rec_t *r)
+{
+    double *x = malloc(r->nsamp * sizeof(*x));
+    uint8_t *gap = malloc(r->nsamp);
+    cm_stats_t st;
+    int failures = 0;
+
+    if (!x || !gap || cm_stats_init(&st, r->tau0, r->tau_max) != 0) {
+        fprintf(stderr, "stats_bench: out of memory\n");
+        free(x); free(gap);
+        return 1;
+    }
+    bench_make_record(r, x, gap);
+
+    double t0 = bench_now();
+    for (size_t k = 0; k < r->nsamp; k++) {
+        if (gap[k]) cm_stats_gap(&st);
+        cm_stats_add(&st, x[k]);
+    }
+    double t_stream = bench_now() - t0;
+
+    cm_stats_point_t pts[CM_STATS_MAX_TAUS];
+    size_t npts = cm_stats_report(&st, NULL, pts, CM_STATS_MAX_TAUS, NULL);
+
+    printf("\n%s: %zu samples, tau0 %g s, %llu gap(s), history %u\n",
+           r->name, r->nsamp, r->tau0, (unsigned long long)st.gaps, st.hmask + 1);
+    printf("%10s %6s %12s %12s %12s %10s %10s\n",
+           "tau_s", "n", "mtie_ns", "adev", "tdev_ns", "adev_rel", "tdev_rel");
+
+    double worst = 0.0, t_ref = 0.0;
+    for (size_t i = 0; i < npts; i++) {
+        const cm_stats_tau_t *t = &st.tau[i];
+        bench_ref_t ref;
+        t0 = bench_now();
+        bench_reference(x, gap, r->nsamp, t->n, t->tau, &ref);
+        t_ref += bench_now() - t0;
+
+        double ea = bench_rel_err(pts[i].adev, ref.adev);
+        double et = bench_rel_err(pts[i].tdev, ref.tdev);
+        int bad = pts[i].mtie != ref.mtie || t->mtie_windows != ref.mtie_windows ||
+                  t->avar_terms != ref.avar_terms || t->tvar_terms != ref.tvar_terms ||
+                  ea > BENCH_REL_TOL || et > BENCH_REL_TOL;
+        if (ea > worst) worst = ea;
+        if (et > worst) worst = et;
+
+        printf("%10g %6u %12.4f %12.4e %12.4f %10.1e %10.1e%s\n",
+               t->tau, t->n, pts[i].mtie * 1e9, pts[i].adev, pts[i].tdev * 1e9, ea, et,
+               bad ? "  MISMATCH" : "");
+        if (bad) {
+            printf("    reference: mtie %.17g (%llu windows), adev %.17g (%llu), "
+                   "tdev %.17g (%llu)\n",
+                   ref.mtie, (unsigned long long)ref.mtie_windows, ref.adev,
+                   (unsigned long long)ref.avar_terms, ref.tdev,
+                   (unsigned long long)ref.tvar_terms);
+            failures++;
+        }
+    }
+    printf("  worst relative error %.1e; streaming %.1f ns/sample (%zu taus), "
+           "brute force %.1f ms\n",
+           worst, t_stream * 1e9 / (double)r->nsamp, npts, t_ref * 1e3);
+
+    cm_stats_free(&st);
+    free(x);
+    free(gap);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+    for (size_t i = 0; i < BENCH_N_RECS; i++) failures += bench_record(&bench_recs[i]);
+    if (failures) {
+        fprintf(stderr, "stats_bench: %d mismatch(es)\n", failures);
+        return 1;
+    }
+    return 0;
+}
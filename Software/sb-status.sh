@@ -63,7 +63,11 @@ echo
 
 # 4. DPLL Hardware
 echo "[DPLL Hardware]"
-if [[ -x "$DPLLTOOL" ]]; then
+# The DPLL monitor publishes every poll to shared memory; read that first so
+# no SPI transactions (or sudo) are needed while it runs.
+if python3 "$SOFTWARE_DIR/sb_status_web.py" --dpll-text 2>/dev/null; then
+    :
+elif [[ -x "$DPLLTOOL" ]]; then
     # Helper to get state with sudo
     get_dpll_state() {
         sudo "$DPLLTOOL" get-state "$1" 2>/dev/null || echo "Error"
@@ -20,13 +20,17 @@ import json
 import os
 import argparse
 import html
+import mmap
+import struct
 import threading
 import tempfile
+import time
 
 DEFAULT_PORT = 8080
 DEFAULT_HTTPS_PORT = 8443
 CONFIG_PATH = "/etc/startup-dpll.json"
 DPLLTOOL = "/usr/local/sbin/dplltool"
+TELEMETRY_PATH = "/dev/shm/switchberry-telemetry"
 CERT_DIR = "/etc/switchberry"
 CERT_FILE = os.path.join(CERT_DIR, "status-web.pem")
 
@@ -173,7 +177,20 @@ STATUS_FILES = {
 }
 
 def get_timesync_status():
-    """Read guard-script status files for ts2phc, phc2sys, and chrony."""
+    """Read guard-script status files for ts2phc, phc2sys, and chrony
+       (as mirrored in the telemetry segment when the monitor runs)."""
+    telem = read_telemetry()
+    if telem:
+        results = []
+        for label, path in STATUS_FILES.items():
+            name = label.split()[0]
+            state, ts, detail = telem["guards"].get(name, ("MISSING", "", ""))
+            if state == "MISSING":
+                results.append((label, "NOT_RUNNING", "", "status file not found"))
+            else:
+                results.append((label, state, ts, detail))
+        return results
+
     results = []
     for label, path in STATUS_FILES.items():
         try:
@@ -207,17 +224,134 @@ def get_service_status():
     return active, inactive
 
 
+# Telemetry segment published by `dplltool monitor` (cm_telemetry.h, version 2).
+TELEM_MAGIC = 0x54454253
+TELEM_VERSION = 2
+TELEM_HDR = struct.Struct("<IIII")                 # magic, version, size, seq
+TELEM_BODY = struct.Struct("<iiQQQQdB7x16s")       # pid .. in_mon
+TELEM_CHAN = struct.Struct("<BBBBBBBxIIQqqdddd")   # cm_telem_chan_t
+TELEM_GUARD = struct.Struct("<16siIq16s32s96s")    # cm_telem_guard_t
+TELEM_NUM_DPLLS = 8
+TELEM_NUM_GUARDS = 4
+TELEM_SIZE = (TELEM_HDR.size + TELEM_BODY.size + TELEM_NUM_DPLLS * TELEM_CHAN.size +
+              TELEM_NUM_GUARDS * TELEM_GUARD.size)
+TELEM_CH_COMBO = 0x04
+
+DPLL_STATES = {0: "FREERUN", 1: "LOCKACQ", 2: "LOCKREC", 3: "LOCKED", 4: "HOLDOVER",
+               6: "DISABLED"}
+
+
+def _cstr(b):
+    return b.split(b"\0", 1)[0].decode(errors="replace")
+
+
+def read_telemetry(path=TELEMETRY_PATH):
+    """Read the monitor's telemetry segment without touching SPI.
+
+    Returns a dict, or None if there is no fresh segment (monitor stopped,
+    not running, or a different layout). The writer holds `seq` odd while
+    updating, so the copy is retried until it was taken between two equal,
+    even reads of `seq`.
+    """
+    try:
+        with open(path, "rb") as f:
+            mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    except (OSError, ValueError):
+        return None
+    buf = None
+    try:
+        for _ in range(100):
+            seq = struct.unpack_from("<I", mm, 12)[0]
+            if seq & 1:
+                continue
+            data = mm[:]
+            if struct.unpack_from("<I", mm, 12)[0] == seq:
+                buf = data
+                break
+    finally:
+        mm.close()
+    if buf is None or len(buf) < TELEM_SIZE:
+        return None
+    magic, version, size, _ = TELEM_HDR.unpack_from(buf, 0)
+    if magic != TELEM_MAGIC or version != TELEM_VERSION or size != TELEM_SIZE:
+        return None
+
+    pid, last_rc, updated_ns, polls, pulses, bursts, poll_sec, freq_ch, in_mon = \
+        TELEM_BODY.unpack_from(buf, TELEM_HDR.size)
+    age = time.time() - updated_ns * 1e-9
+    if not pid or age > max(5.0, 5 * poll_sec):
+        return None
+
+    off = TELEM_HDR.size + TELEM_BODY.size
+    chans = []
+    for _ in range(TELEM_NUM_DPLLS):
+        (state, lock_sticky, _ho, ref_input, flags, combo_en, combo_src, lock_changes,
+         relocks, sticky_hist, _ps36, _wr, phase_sec, wr_freq_ppb, unlocked_sec,
+         since_change_sec) = TELEM_CHAN.unpack_from(buf, off)
+        off += TELEM_CHAN.size
+        chans.append({
+            "state": DPLL_STATES.get(state, "UNKNOWN"),
+            "input": ref_input,
+            "flags": flags,
+            "combo_en": combo_en,
+            "combo_src": combo_src,
+            "lock_changes": lock_changes,
+            "relocks": relocks,
+            "sticky_hist": sticky_hist,
+            "phase_sec": phase_sec,
+            "wr_freq_ppb": wr_freq_ppb,
+            "unlocked_sec": unlocked_sec,
+            "since_change_sec": since_change_sec,
+        })
+    guards = {}
+    for _ in range(TELEM_NUM_GUARDS):
+        name, gstate, _r, mtime, text, stamp, msg = TELEM_GUARD.unpack_from(buf, off)
+        off += TELEM_GUARD.size
+        if name[0]:
+            # Same state text as reading the status file directly
+            state = (_cstr(text).strip() or "UNKNOWN") if gstate >= 0 else "MISSING"
+            guards[_cstr(name)] = (state, _cstr(stamp), _cstr(msg))
+    return {"pid": pid, "age": age, "last_rc": last_rc, "polls": polls, "relocks": pulses,
+            "bursts": bursts, "freq_ch": freq_ch, "in_mon": list(in_mon), "ch": chans,
+            "guards": guards}
+
+
+DPLL_CHANNELS = [(5, "Ch5 (Freq)"), (6, "Ch6 (Time)")]
+
+
+def combo_str(c):
+    """Same text as `dplltool get-combo-slave`."""
+    if not c["flags"] & TELEM_CH_COMBO:
+        return "Unknown"
+    return f"Slave: {'Enabled' if c['combo_en'] else 'Disabled'}, Master: {c['combo_src']}"
+
+
 def get_dpll_status():
-    """Query DPLL channel states."""
+    """Query DPLL channel states (telemetry segment, else dplltool)."""
+    telem = read_telemetry()
+    if telem:
+        return [(label, telem["ch"][ch]["state"], combo_str(telem["ch"][ch]))
+                for ch, label in DPLL_CHANNELS]
     if not os.path.isfile(DPLLTOOL):
         return [("DPLL", "dplltool not found", "")]
-    results = []
-    for ch in [5, 6]:
-        label = "Ch5 (Freq)" if ch == 5 else "Ch6 (Time)"
-        state = run_cmd(["sudo", DPLLTOOL, "get-state", str(ch)])
-        combo = run_cmd(["sudo", DPLLTOOL, "get-combo-slave", str(ch)])
-        results.append((label, state, combo))
-    return results
+    # One dplltool process / SPI session for every query, one JSON object
+    # per line (plus the batch summary, which is skipped).
+    script = "".join(f"get-state {ch}\nget-combo-slave {ch}\n"
+                     for ch, _ in DPLL_CHANNELS)
+    try:
+        r = subprocess.run(["sudo", DPLLTOOL, "--json", "--batch", "-"],
+                           input=script, capture_output=True, text=True,
+                           timeout=5)
+        objs = [json.loads(line) for line in r.stdout.splitlines() if line]
+    except Exception as e:
+        return [("DPLL", f"Error: {e}", "")]
+    state = {o["chan"]: o["state"] for o in objs
+             if o.get("cmd") == "get-state" and o["ok"]}
+    combo = {o["chan"]: (f"Slave: {'Enabled' if o['combo_slave'] else 'Disabled'}, "
+                         f"Master: {o['combo_master']}")
+             for o in objs if o.get("cmd") == "get-combo-slave" and o["ok"]}
+    return [(label, state.get(ch, "Unknown"), combo.get(ch, "Unknown"))
+            for ch, label in DPLL_CHANNELS]
 
 
 def get_ptp_role():
@@ -680,8 +814,23 @@ def main():
     parser.add_argument("--port", "-p", type=int, default=DEFAULT_PORT, help="HTTP port")
     parser.add_argument("--https-port", type=int, default=DEFAULT_HTTPS_PORT, help="HTTPS port")
     parser.add_argument("--no-https", action="store_true", help="Disable HTTPS")
+    parser.add_argument("--dpll-text", action="store_true",
+                        help="Print DPLL status from the telemetry segment and exit "
+                             "(exit 1 if the monitor is not publishing)")
     args = parser.parse_args()
 
+    if args.dpll_text:
+        telem = read_telemetry()
+        if not telem:
+            return 1
+        for ch, label in DPLL_CHANNELS:
+            c = telem["ch"][ch]
+            print(f"  Channel {ch} ({label.split('(')[1]}: {c['state']}")
+            print(f"    {combo_str(c)}")
+            print(f"    phase={c['phase_sec']:.3e}s wr_freq={c['wr_freq_ppb']:.3f}ppb "
+                  f"lock_changes={c['lock_changes']} relocks={c['relocks']}")
+        return 0
+
     # Start HTTPS in a background thread
     if not args.no_https:
         cert = ensure_self_signed_cert()
@@ -701,4 +850,4 @@ def main():
 
 
 if __name__ == "__main__":
-    main()
+    raise SystemExit(main())